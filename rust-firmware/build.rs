@@ -11,6 +11,7 @@ fn main() {
         
         // Add libcrypt0 source files
         build.file("src/crypto/libcrypt0/src/crypt0.c")
+             .file("src/crypto/libcrypt0/src/crypt0_address.c")
              .file("src/crypto/libcrypt0/src/crypt0_aes_ccm.c")
              .file("src/crypto/libcrypt0/src/crypt0_bech32.c")
              .file("src/crypto/libcrypt0/src/crypt0_bip32.c")
@@ -18,8 +19,11 @@ fn main() {
              .file("src/crypto/libcrypt0/src/crypt0_bip39_english.c")
              .file("src/crypto/libcrypt0/src/crypt0_crc.c")
              .file("src/crypto/libcrypt0/src/crypt0_ed25519.c")
+             .file("src/crypto/libcrypt0/src/crypt0_ed25519_portable.c")
+             .file("src/crypto/libcrypt0/src/crypt0_hash_batch.c")
              .file("src/crypto/libcrypt0/src/crypt0_hmac.c")
              .file("src/crypto/libcrypt0/src/crypt0_hw_keys.c")
+             .file("src/crypto/libcrypt0/src/crypt0_keccak.c")
              .file("src/crypto/libcrypt0/src/crypt0_key.c")
              .file("src/crypto/libcrypt0/src/crypt0_log.c")
              .file("src/crypto/libcrypt0/src/crypt0_pbkdf2.c")
@@ -27,8 +31,13 @@ fn main() {
              .file("src/crypto/libcrypt0/src/crypt0_rlp.c")
              .file("src/crypto/libcrypt0/src/crypt0_rng.c")
              .file("src/crypto/libcrypt0/src/crypt0_secp256k1.c")
+             .file("src/crypto/libcrypt0/src/crypt0_secp256k1_batch.c")
              .file("src/crypto/libcrypt0/src/crypt0_sha.c")
+             .file("src/crypto/libcrypt0/src/crypt0_sha2.c")
+             .file("src/crypto/libcrypt0/src/crypt0_sha2_x86.c")
              .file("src/crypto/libcrypt0/src/intc_impl.c")
+             .file("src/crypto/libcrypt0/lib/secp256k1/src/precomputed_ecmult.c")
+             .file("src/crypto/libcrypt0/lib/secp256k1/src/precomputed_ecmult_gen.c")
              .file("src/crypto/crc16_ccitt/crc16_ccitt.c");
 
         // Add include directories
@@ -42,43 +51,41 @@ fn main() {
              .include("src/crypto/libcrypt0/lib/intc")
              .include("src/crypto/crc16_ccitt");
 
-        // Set compiler flags
+        // Set compiler flags, the simulator uses the portable crypto backend
         build.flag("-DCRYPT0_SIMULATION")
-             .flag("-DHITO_PLATFORM_DESKTOP")
-             .flag("-DCRYPT0_USE_OPENSSL");
-             
-        // Add OpenSSL include paths for macOS (common locations)
-        #[cfg(target_os = "macos")]
-        {
-            // Try Homebrew OpenSSL first
-            if std::path::Path::new("/opt/homebrew/include/openssl").exists() {
-                build.include("/opt/homebrew/include");
-            } else if std::path::Path::new("/usr/local/include/openssl").exists() {
-                build.include("/usr/local/include");
-            }
+             .flag("-DHITO_PLATFORM_DESKTOP");
+
+        // libsecp256k1 precomputed table sizes, the firmware's 8 and 4 so the
+        // simulator verifies and signs with the device tables. Set
+        // CRYPT0_ECMULT_WINDOW_SIZE=15 for the library default, see
+        // libcrypt0/tests-desktop/ECMULT_REPORT.md
+        let ecmult_window = env_or("CRYPT0_ECMULT_WINDOW_SIZE", "8");
+        let ecmult_gen_bits = env_or("CRYPT0_ECMULT_GEN_PREC_BITS", "4");
+        match ecmult_window.parse::<u32>() {
+            Ok(2..=15) => {}
+            _ => panic!("CRYPT0_ECMULT_WINDOW_SIZE must be 2..15"),
         }
+        if !["2", "4", "8"].contains(&ecmult_gen_bits.as_str()) {
+            panic!("CRYPT0_ECMULT_GEN_PREC_BITS must be 2, 4 or 8");
+        }
+        build.define("ECMULT_WINDOW_SIZE", ecmult_window.as_str())
+             .define("ECMULT_GEN_PREC_BITS", ecmult_gen_bits.as_str())
+             .define("ENABLE_MODULE_RECOVERY", None)
+             .define("ENABLE_MODULE_ECDH", None);
 
         build.compile("crypt0");
 
         println!("cargo:rustc-link-lib=static=crypt0");
-        
-        // Link OpenSSL for crypto functions on desktop
-        #[cfg(target_os = "macos")]
-        {
-            println!("cargo:rustc-link-lib=dylib=crypto");
-            println!("cargo:rustc-link-lib=dylib=ssl");
-        }
-        
-        #[cfg(target_os = "linux")]
-        {
-            println!("cargo:rustc-link-lib=dylib=crypto");
-            println!("cargo:rustc-link-lib=dylib=ssl");
-        }
-        
+
         #[cfg(target_os = "windows")]
         {
-            println!("cargo:rustc-link-lib=dylib=libcrypto");
-            println!("cargo:rustc-link-lib=dylib=libssl");
+            println!("cargo:rustc-link-lib=dylib=bcrypt");
         }
     }
 }
+
+#[cfg(feature = "minifb")]
+fn env_or(name: &str, default: &str) -> String {
+    println!("cargo:rerun-if-env-changed={}", name);
+    std::env::var(name).unwrap_or_else(|_| default.to_string())
+}
@@ -1,6 +1,13 @@
 use super::ffi;
 use core::ffi::c_char;
 
+/// Compressed public key (33 bytes) then chain code (32 bytes)
+pub type PubNode = [u8; 65];
+
+/// Public key of a secp256k1 compressed point: size of each key of
+/// crypt0_bip32_ckd_pub_batch
+pub const PUBKEY_COMPRESSED_BYTES: usize = 33;
+
 pub fn crypt0_bech32_encode(data: &[u8], buf: &mut [u8]) -> Result<usize, ()> {
     unsafe {
         let result = ffi::crypt0_bech32_encode(data.as_ptr(), data.len() as i32, buf.as_mut_ptr() as *mut c_char, buf.len() as i32);
@@ -10,4 +17,102 @@ pub fn crypt0_bech32_encode(data: &[u8], buf: &mut [u8]) -> Result<usize, ()> {
             Err(())
         }
     }
-}
\ No newline at end of file
+}
+
+/// Public child derivation of a non-hardened index, no private key needed
+pub fn crypt0_bip32_ckd_pub(parent: &PubNode, index: u32) -> Result<PubNode, ()> {
+    let mut child = [0u8; 65];
+    let rc = unsafe { ffi::crypt0_bip32_ckd_pub(parent.as_ptr(), index, child.as_mut_ptr()) };
+    if rc == ffi::CRYPT0_OK { Ok(child) } else { Err(()) }
+}
+
+/// Public keys of the children first.. of parent, 33 bytes each, as many as
+/// fit pubkeys. The point sums of each CRYPT0_BIP32_CKD_PUB_CHUNK children
+/// share one inversion, the scratch is on the stack. A child BIP32 skips is
+/// left as 33 zero bytes, the count of those is returned
+pub fn crypt0_bip32_ckd_pub_batch(parent: &PubNode, first: u32, pubkeys: &mut [u8]) -> Result<usize, ()> {
+    let mut scratch = [0u8; ffi::CRYPT0_BIP32_CKD_PUB_CHUNK_SCRATCH_BYTES];
+    // the C side sizes the chunk, a mismatch fails instead of overrunning
+    if unsafe { ffi::crypt0_bip32_ckd_pub_chunk_scratch_bytes } != scratch.len() {
+        return Err(());
+    }
+
+    let chunk_bytes = ffi::CRYPT0_BIP32_CKD_PUB_CHUNK * PUBKEY_COMPRESSED_BYTES;
+    let n = pubkeys.len() / PUBKEY_COMPRESSED_BYTES;
+    let mut skipped = 0;
+    for (i, chunk) in pubkeys[..n * PUBKEY_COMPRESSED_BYTES].chunks_mut(chunk_bytes).enumerate() {
+        let index = first.checked_add((i * ffi::CRYPT0_BIP32_CKD_PUB_CHUNK) as u32).ok_or(())?;
+        let rc = unsafe {
+            ffi::crypt0_bip32_ckd_pub_batch(parent.as_ptr(), index, chunk.len() / PUBKEY_COMPRESSED_BYTES,
+                chunk.as_mut_ptr(), scratch.as_mut_ptr() as *mut core::ffi::c_void, scratch.len())
+        };
+        if rc < 0 {
+            return Err(());
+        }
+        skipped += rc as usize;
+    }
+    Ok(skipped)
+}
+
+/// Resumable PBKDF2, see crypt0_pbkdf2_ctx. The first iteration runs in new(),
+/// the rest is advanced with step() in slices that fit a frame.
+pub struct Pbkdf2 {
+    ctx: ffi::crypt0_pbkdf2_ctx,
+}
+
+impl Pbkdf2 {
+    fn new(hash: u32, iterations: u32, pass: &[u8], salt: &[u8]) -> Result<Self, ()> {
+        let mut p = Pbkdf2 {
+            ctx: ffi::crypt0_pbkdf2_ctx { state: [0; 32], hash: 0, iterations: 0, done: 0 },
+        };
+        let rc = unsafe {
+            ffi::crypt0_pbkdf2_init(&mut p.ctx, hash, iterations,
+                pass.as_ptr(), pass.len() as u16, salt.as_ptr(), salt.len() as u16)
+        };
+        if rc == ffi::CRYPT0_OK { Ok(p) } else { Err(()) }
+    }
+
+    pub fn new_sha256(iterations: u32, pass: &[u8], salt: &[u8]) -> Result<Self, ()> {
+        Self::new(ffi::CRYPT0_PBKDF2_HMAC_SHA256, iterations, pass, salt)
+    }
+
+    pub fn new_sha512(iterations: u32, pass: &[u8], salt: &[u8]) -> Result<Self, ()> {
+        Self::new(ffi::CRYPT0_PBKDF2_HMAC_SHA512, iterations, pass, salt)
+    }
+
+    /// Runs at most n iterations, returns how many are left
+    pub fn step(&mut self, n: u32) -> u32 {
+        unsafe { ffi::crypt0_pbkdf2_step(&mut self.ctx, n) }
+    }
+
+    pub fn remaining(&self) -> u32 {
+        self.ctx.iterations - self.ctx.done
+    }
+
+    pub fn progress(&self) -> u8 {
+        if self.ctx.iterations == 0 { 100 }
+        else { ((self.ctx.done as u64 * 100) / self.ctx.iterations as u64) as u8 }
+    }
+
+    pub fn finish(&mut self, key: &mut [u8]) -> Result<(), ()> {
+        let rc = unsafe { ffi::crypt0_pbkdf2_finish(&mut self.ctx, key.as_mut_ptr(), key.len() as u16) };
+        if rc == ffi::CRYPT0_OK { Ok(()) } else { Err(()) }
+    }
+}
+
+impl Drop for Pbkdf2 {
+    fn drop(&mut self) {
+        unsafe { ffi::crypt0_pbkdf2_wipe(&mut self.ctx) }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn ckd_pub_chunk_scratch_matches_c() {
+        assert_eq!(unsafe { ffi::crypt0_bip32_ckd_pub_chunk_scratch_bytes },
+            ffi::CRYPT0_BIP32_CKD_PUB_CHUNK_SCRATCH_BYTES);
+    }
+}
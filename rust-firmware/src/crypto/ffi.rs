@@ -1,6 +1,39 @@
-use core::ffi::{c_char, c_int};
+use core::ffi::{c_char, c_int, c_void};
+
+pub const CRYPT0_PBKDF2_HMAC_SHA256: u32 = 0;
+pub const CRYPT0_PBKDF2_HMAC_SHA512: u32 = 1;
+
+// mirrors crypt0_pbkdf2_ctx from crypt0_pbkdf2.h, holds the keyed HMAC
+// midstates: no Clone or Copy, crypt0::Pbkdf2 wipes it on drop
+#[repr(C)]
+pub struct crypt0_pbkdf2_ctx {
+  pub state: [u64; 32],
+  pub hash: u32,
+  pub iterations: u32,
+  pub done: u32,
+}
+
+const _: () = assert!(core::mem::size_of::<crypt0_pbkdf2_ctx>() == 272);
+
+// mirrors crypt0_ed25519_keypair from crypt0_ed25519.h, holds the expanded
+// secret: no Clone or Copy, the one in vault::ed25519_slot is wiped on lock
+#[repr(C)]
+pub struct crypt0_ed25519_keypair {
+  pub secret: [u8; 64],
+  pub public: [u8; 32],
+}
+
+const _: () = assert!(core::mem::size_of::<crypt0_ed25519_keypair>() == 96);
+
+/// CRYPT0_BIP32_CKD_PUB_CHUNK from crypt0_bip32.h
+pub const CRYPT0_BIP32_CKD_PUB_CHUNK: usize = 16;
+/// CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(CRYPT0_BIP32_CKD_PUB_CHUNK), 32 bytes
+/// and CRYPT0_SECP256K1_BATCH_SCRATCH_PER_KEY per child plus 16, checked
+/// against the C value crypt0_bip32_ckd_pub_chunk_scratch_bytes
+pub const CRYPT0_BIP32_CKD_PUB_CHUNK_SCRATCH_BYTES: usize = CRYPT0_BIP32_CKD_PUB_CHUNK * (32 + 256) + 16;
 
 extern "C" {
+  pub static crypt0_bip32_ckd_pub_chunk_scratch_bytes: usize;
   pub fn crypt0_bech32_encode(data: *const u8, datalen: c_int, buf: *mut c_char, buflen: c_int) -> c_int;
   pub fn crypt0_bip39_entropy_to_seed_en(
     entropy: *const u8,
@@ -8,6 +41,40 @@ extern "C" {
     seed: *mut u8,
     seed_len: usize
   ) -> c_int;
+  pub fn crypt0_bip32_seed_to_secret(seed: *const u8, secret: *mut u8) -> c_int;
+  pub fn crypt0_bip32_derive_secret_index_pub(secret: *mut u8, index: u32, public: *const u8) -> c_int;
+  pub fn crypt0_slip10_seed_to_secret(curve: c_int, seed: *const u8, secret: *mut u8) -> c_int;
+  pub fn crypt0_slip10_derive_secret_index(curve: c_int, secret: *mut u8, index: u32) -> c_int;
+  pub fn crypt0_bip32_ckd_pub(parent: *const u8, index: u32, child: *mut u8) -> c_int;
+  pub fn crypt0_bip32_ckd_pub_batch(
+    parent: *const u8,
+    first: u32,
+    n: usize,
+    public: *mut u8,
+    scratch: *mut c_void,
+    scratch_len: usize
+  ) -> c_int;
+  pub fn crypt0_secp256k1_public_key_compressed(
+    private: *const u8,
+    private_len: usize,
+    public: *mut u8,
+    public_len: usize
+  ) -> c_int;
+  pub fn crypt0_ed25519_keypair_init(
+    keypair: *mut crypt0_ed25519_keypair,
+    private: *const u8,
+    private_len: usize
+  ) -> c_int;
+  pub fn crypt0_ed25519_keypair_sign(
+    keypair: *const crypt0_ed25519_keypair,
+    message: *const u8,
+    message_len: usize,
+    sig: *mut u8,
+    sig_len: usize
+  ) -> c_int;
+  pub fn crypt0_ed25519_keypair_wipe(keypair: *mut crypt0_ed25519_keypair);
+  pub fn crypt0_hash160(msg: *const u8, msg_len: usize, hash: *mut u8);
+  pub fn crypt0_memzero(buf: *mut c_void, len: usize);
   pub fn crypt0_crc16_ccitt(data: *const u8, len: usize) -> u16;
   pub fn crypt0_encrypt_aes_ccm(
     plaintext: *const u8,
@@ -31,6 +98,18 @@ extern "C" {
     key: *mut u8,
     key_len: u32
   ) -> c_int;
+  pub fn crypt0_pbkdf2_init(
+    ctx: *mut crypt0_pbkdf2_ctx,
+    hash: u32,
+    iterations: u32,
+    pass: *const u8,
+    pass_len: u16,
+    salt: *const u8,
+    salt_len: u16
+  ) -> c_int;
+  pub fn crypt0_pbkdf2_step(ctx: *mut crypt0_pbkdf2_ctx, n: u32) -> u32;
+  pub fn crypt0_pbkdf2_finish(ctx: *mut crypt0_pbkdf2_ctx, key: *mut u8, key_len: u16) -> c_int;
+  pub fn crypt0_pbkdf2_wipe(ctx: *mut crypt0_pbkdf2_ctx);
   pub fn crypt0_rng(output: *mut u8, len: usize) -> bool;
   pub fn crypt0_decrypt_aes_ccm(
     encrypted: *const u8,
@@ -48,3 +127,6 @@ extern "C" {
 }
 
 pub const CRYPT0_OK: c_int = 0;
+pub const CRYPT0_BIP32_INDEX_HARDENED: u32 = 0x80000000;
+pub const CRYPT0_SLIP10_SECP256K1: c_int = 0;
+pub const CRYPT0_SLIP10_ED25519: c_int = 1;
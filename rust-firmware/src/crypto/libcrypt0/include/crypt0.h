@@ -86,12 +86,23 @@ enum {
 //
 int crypt0_init();
 
+/**
+ * free the per thread working contexts of the OpenSSL backend, call before
+ * a thread that used libcrypt0 exits, no-op on other backends
+ */
+void crypt0_release_thread(void);
+
 /**
  * convert crypto signature from ber to raw format, 
  * returns CRYPT0_OK on success, raw buffer should be 0x40 bytes
  */
 int crypt0_sig_ber2raw(const uint8_t * ber, uint8_t * raw);
 
+/**
+ * wipe secret material, the write is not optimized away by the compiler
+ */
+void crypt0_memzero(void * buf, size_t len);
+
 //int crypt0_rng(uint8_t * rng, size_t rnglen);
 
 #ifdef __cplusplus
@@ -0,0 +1,63 @@
+#ifndef __crypt0_address_h_included__
+#define __crypt0_address_h_included__
+
+/**
+ * Address ranges of an account: consecutive receive or change addresses
+ * from the account extended public key, for wallets scanning up to the gap
+ * limit. Children come from public derivation with batched point sums, the
+ * public keys are hashed in lanes and the addresses encoded in one pass.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "crypt0_bip32.h"
+
+/** coins, their BIP44 coin types as in crypt0_bip32_seed_to_account_pubkey */
+#define CRYPT0_COIN_BTC      0
+#define CRYPT0_COIN_BTC_TEST 1
+#define CRYPT0_COIN_LTC      2
+#define CRYPT0_COIN_DOGE     3
+
+/** address formats */
+#define CRYPT0_ADDRESS_P2PKH  0 // base58check of version byte | hash160
+#define CRYPT0_ADDRESS_P2WPKH 1 // bech32 witness v0 of hash160, not DOGE
+
+/** longest address with its terminating zero */
+#define CRYPT0_ADDRESS_MAX_BYTES 64
+
+/** children derived and hashed together, the scratch is sized for it */
+#define CRYPT0_ADDRESS_RANGE_CHUNK 16
+
+/** scratch crypt0_address_range needs for any count, any alignment */
+#define CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES \
+  (CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(CRYPT0_ADDRESS_RANGE_CHUNK) + \
+   CRYPT0_ADDRESS_RANGE_CHUNK * (33 + 20 + 21 + 32))
+
+/** arena crypt0_address_range needs for count addresses at most */
+#define CRYPT0_ADDRESS_RANGE_OUT_BYTES(count) ((count) * CRYPT0_ADDRESS_MAX_BYTES)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Addresses of children start .. start + count - 1 of chain (0 receive,
+ * 1 change) under a 78 byte account extended public key, written to out as
+ * zero terminated strings back to back. A child BIP32 skips (invalid key,
+ * about 1 in 2^127) is an empty string, so string i is always child
+ * start + i. scratch is caller memory of CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES,
+ * the same for any count.
+ * returns the bytes written to out, CRYPT0_ERR_FMT for an unknown coin or
+ * format, a hardened index or P2WPKH on DOGE, CRYPT0_ERR_OUTBUF_LEN if out
+ * or scratch is short, CRYPT0_ERR_IMPORT_KEY for an invalid key
+ */
+int crypt0_address_range(const uint8_t * xpub, uint32_t chain, uint32_t start,
+    size_t count, int coin, int format, char * out, size_t outlen,
+    void * scratch, size_t scratchlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__crypt0_address_h_included__
@@ -5,6 +5,56 @@
 #define ACCOUNT_PKEY_LEN 78
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "crypt0_secp256k1.h"
+
+/** deepest path crypt0_bip32 derives */
+#define CRYPT0_BIP32_MAX_DEPTH 10
+
+/** 
+ * binary path: depth byte, then depth indexes of 4 bytes big endian, the
+ * way hardware wallet APDUs carry it
+ */
+#define CRYPT0_BIP32_PATH_BYTES(depth) (1 + 4 * (depth))
+#define CRYPT0_BIP32_PATH_MAX_BYTES CRYPT0_BIP32_PATH_BYTES(CRYPT0_BIP32_MAX_DEPTH)
+
+/** 
+ * SLIP-10 curves of crypt0_slip10_*, BIP32 is SLIP-10 on secp256k1. ed25519
+ * has hardened derivation only
+ */
+#define CRYPT0_SLIP10_SECP256K1 0 // "Bitcoin seed"
+#define CRYPT0_SLIP10_ED25519   1 // "ed25519 seed", NEAR, Solana, TON
+
+/** public node: compressed public key (33 bytes) then chain code (32 bytes) */
+#define CRYPT0_BIP32_PUBNODE_BYTES 65
+
+/** scratch crypt0_bip32_ckd_pub_batch needs for n children, any alignment */
+#define CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(n) \
+  (32 * (n) + CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n))
+
+/** children per crypt0_bip32_ckd_pub_batch call with a fixed scratch */
+#define CRYPT0_BIP32_CKD_PUB_CHUNK 16
+
+/** 
+ * Derivation cursor, keeps every node of the last derived path with the
+ * public key of each node once known. Deriving a path that shares a prefix
+ * with the previous one starts at the deepest common node, e.g. siblings
+ * m/84'/0'/0'/0/i cost one child derivation each and reuse the parent
+ * public key. About 1 KiB, holds secrets: crypt0_bip32_cursor_wipe after use
+ */
+typedef struct {
+  uint8_t depth;          // nodes 1..depth follow index[0..depth-1]
+  uint8_t curve;          // CRYPT0_SLIP10_*, crypt0_slip10_cursor_init
+  uint16_t pub_ready;     // bit n: pub[n] is the public key of node n
+  uint32_t index[CRYPT0_BIP32_MAX_DEPTH];
+  uint8_t node[CRYPT0_BIP32_MAX_DEPTH + 1][64];  // 0 is the master secret
+  uint8_t pub[CRYPT0_BIP32_MAX_DEPTH + 1][33];
+} crypt0_bip32_cursor;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * Converts seed to secret - chaincode (32 bytes) + private key (32 bytes)
@@ -25,6 +75,14 @@ int crypt0_bip32_seed_to_secret_custom(const uint8_t * seed, uint8_t * secret,
  */
 int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index);
 
+/**
+ * crypt0_bip32_derive_secret_index with the compressed public key of secret
+ * (33 bytes) the caller already has, saves the point multiplication of a
+ * non-hardened index. pub NULL computes it
+ */
+int crypt0_bip32_derive_secret_index_pub(uint8_t * secret, uint32_t index,
+    const uint8_t * pub);
+
 /**
  * Derives chaincode and private key by index, modifies secret
  * returns secret length on success, negative error code otherwise
@@ -33,11 +91,86 @@ int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index);
 int crypt0_bip32_derive_secret_index_near(uint8_t * secret, uint32_t index);
 
 /**
- * Derives chaincode and private key by index, modifies secret
- * returns secret length on success, negative error code otherwise
+ * Derives chaincode and private key of a binary path (CRYPT0_BIP32_PATH_BYTES)
+ * from secret, modifies secret
+ * returns CRYPT0_OK on success, negative error code otherwise
  */
 int crypt0_bip32_derive_secret_path(uint8_t * secret, const uint8_t * path);
 
+/**
+ * Parses a path string "m/84'/0'/0'/0/5" (h or H for hardened too) to the
+ * binary path, returns its length or CRYPT0_ERR_FMT
+ */
+int crypt0_bip32_path_from_string(const char * str, uint8_t * path, size_t pathlen);
+
+/** Starts a cursor at the master secret of seed */
+int crypt0_bip32_cursor_init(crypt0_bip32_cursor * cursor, const uint8_t * seed);
+
+/**
+ * SLIP-10 on curve (CRYPT0_SLIP10_*): master secret of a 64 byte seed,
+ * child and path derivation, the cursor of crypt0_bip32_cursor_derive on
+ * curve. Listing accounts through a cursor derives only the levels below
+ * the prefix they share, e.g. m/44'/501'/i'/0' costs two HMACs per account.
+ * returns CRYPT0_OK, CRYPT0_ERR_FMT for an unknown curve or a non-hardened
+ * index on ed25519
+ */
+int crypt0_slip10_seed_to_secret(int curve, const uint8_t * seed, uint8_t * secret);
+int crypt0_slip10_derive_secret_index(int curve, uint8_t * secret, uint32_t index);
+int crypt0_slip10_derive_secret_path(int curve, uint8_t * secret, const uint8_t * path);
+int crypt0_slip10_cursor_init(crypt0_bip32_cursor * cursor, int curve, const uint8_t * seed);
+
+/** 
+ * Derives the secret of a binary path from the cursor's master secret,
+ * reusing the nodes it shares with the previously derived path
+ * returns CRYPT0_OK on success, negative error code otherwise
+ */
+int crypt0_bip32_cursor_derive(crypt0_bip32_cursor * cursor, const uint8_t * path,
+    uint8_t * secret);
+
+void crypt0_bip32_cursor_wipe(crypt0_bip32_cursor * cursor);
+
+/** 
+ * Account extended public key (78 bytes) of m/bip_standard/coin/account from
+ * a cursor, see crypt0_bip32_seed_to_account_pubkey, secp256k1 coins only
+ */
+int crypt0_bip32_cursor_account_pubkey(crypt0_bip32_cursor * cursor, uint8_t * pubkey,
+    int bip_standard, int coin, int account);
+
 int crypt0_bip32_seed_to_account_pubkey(const uint8_t * m_seed, uint8_t * pubkey, int bip_standard, int coin, int account);
 
+/** public node of a secret (private key, chain code), one point multiplication */
+int crypt0_bip32_secret_to_pubnode(const uint8_t * secret, uint8_t * pubnode);
+
+/** public node of a 78 byte extended public key */
+void crypt0_bip32_pubnode_from_xpub(const uint8_t * xpub, uint8_t * pubnode);
+
+/**
+ * Public child derivation (CKDpub), child public node of a non-hardened
+ * index from the parent public node, no private key involved
+ * returns CRYPT0_OK, CRYPT0_ERR_FMT for a hardened index or
+ * CRYPT0_ERR_IMPORT_KEY for an invalid parent or child (BIP32: skip the index)
+ */
+int crypt0_bip32_ckd_pub(const uint8_t * parent, uint32_t index, uint8_t * child);
+
+/**
+ * Public keys of the n non-hardened children first .. first + n - 1 of a
+ * public node, 33 bytes each back to back, e.g. receive addresses from the
+ * m/84'/0'/0'/0 node. The parent chain code is keyed once and the n point
+ * sums share one inversion. scratch is caller memory of
+ * CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(n). An invalid child (BIP32: skip the
+ * index) has its 33 bytes zeroed, the other children are still derived
+ * returns the number of skipped children (CRYPT0_OK if none), errors as
+ * crypt0_bip32_ckd_pub for a hardened index, an invalid parent or a short
+ * scratch
+ */
+int crypt0_bip32_ckd_pub_batch(const uint8_t * parent, uint32_t first, size_t n,
+    uint8_t * pubs, void * scratch, size_t scratchlen);
+
+/** CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(CRYPT0_BIP32_CKD_PUB_CHUNK), for FFI */
+extern const size_t crypt0_bip32_ckd_pub_chunk_scratch_bytes;
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif//__crypt0_bip32_h_included__
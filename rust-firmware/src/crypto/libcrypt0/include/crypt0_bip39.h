@@ -5,6 +5,12 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "crypt0_pbkdf2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define CRYPT0_BIP39_MNEMONIC_MAXBYTES 215 //(9 * 24)
 
 extern const char * crypt0_bip39_english[];
@@ -24,6 +30,14 @@ int crypt0_bip39_entropy_to_mnemonic_en(const uint8_t * entropy,
 int crypt0_bip39_mnemonic_to_seed(const uint8_t * mnemonic, 
     uint16_t mnemonic_len, uint8_t * seed, uint16_t seed_len);
 
+/**
+ * Same as crypt0_bip39_mnemonic_to_seed, but only keys ctx, the 2048 
+ * iterations are run with crypt0_pbkdf2_step and the seed is read with
+ * crypt0_pbkdf2_finish
+ */
+int crypt0_bip39_mnemonic_to_seed_init(crypt0_pbkdf2_ctx * ctx,
+    const uint8_t * mnemonic, uint16_t mnemonic_len);
+
 /**
  * Convert entropy to seed using english mnemonic
  * returns CRYPT0_OK on success, negative error code otherwise
@@ -36,7 +50,45 @@ bool crypt0_bip39_mnemonic_to_entropy(
     const uint16_t * mnemonic, uint16_t mnemonic_len,
     uint8_t * entropy, uint16_t entropy_len);
 
+/** crypt0_bip39_next_letters bit of a prefix that is a whole word */
+#define CRYPT0_BIP39_WORD_COMPLETE (1u << 26)
+
+/** 
+ * index 0..2047 of word (len letters, lowercase, no terminating zero needed)
+ * in crypt0_bip39_english through a perfect hash of its first 4 letters,
+ * CRYPT0_ERR_FMT if it is not a word of the list
+ */
+int crypt0_bip39_word_index(const char * word, size_t len);
+
+/** 
+ * letters that continue prefix towards a word of the list, bit i for 'a' + i,
+ * plus CRYPT0_BIP39_WORD_COMPLETE if prefix is a word itself, 0 if no word
+ * starts with prefix. first and count (either may be NULL) get the range of
+ * crypt0_bip39_english starting with prefix, for word entry autocomplete
+ */
+uint32_t crypt0_bip39_next_letters(const char * prefix, size_t len,
+    uint16_t * first, uint16_t * count);
+
+/** 
+ * indexes of the words of an english mnemonic separated by any ASCII
+ * whitespace (spaces, tabs, line breaks), returns the
+ * word count, CRYPT0_ERR_FMT for a word not in the list, 
+ * CRYPT0_ERR_OUTBUF_LEN for more than max_words words
+ */
+int crypt0_bip39_mnemonic_to_indexes(const uint8_t * mnemonic, uint16_t mnemonic_len,
+    uint16_t * indexes, uint16_t max_words);
+
+/** english mnemonic text to entropy, checksum included, see above */
+bool crypt0_bip39_mnemonic_en_to_entropy(const uint8_t * mnemonic, uint16_t mnemonic_len,
+    uint8_t * entropy, uint16_t entropy_len);
+
 int crypt0_ton_mnemonic_to_seed(const uint8_t *mnemonic_str, uint16_t mnemonic_len, uint8_t *seed_out, uint32_t seed_len);
+int crypt0_ton_entropy_to_seed(const uint8_t *entropy, uint16_t entropy_len, uint8_t *seed_out);
+
+/** Resumable crypt0_ton_entropy_to_seed, 100000 iterations, see above */
+int crypt0_ton_entropy_to_seed_init(crypt0_pbkdf2_ctx * ctx,
+    const uint8_t * entropy, uint16_t entropy_len);
+
 bool crypt0_bip39_ton_mnemonic_to_entropy(
     const uint8_t *mnemonic, uint16_t mnemonic_len, 
     uint8_t *entropy, uint16_t entropy_len);
@@ -51,4 +103,8 @@ typedef struct
     uint32_t address_index;
 } bip_path_data;
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif//__crypt0_bip39_h_included__
@@ -7,6 +7,9 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #define CRYPT0_ED25519_PRIVKEY_BYTES 32
 #define CRYPT0_ED25519_PUBKEY_BYTES  32
@@ -14,10 +17,27 @@
 #define CRYPT0_ED25519_HASH_BYTES_32 32
 #define CRYPT0_ED25519_HASH_BYTES_64 64
 
+/** 
+ * Expanded key pair for repeated signing: the clamped scalar and nonce prefix
+ * of SHA-512(priv) and the matching public key, computed once by
+ * crypt0_ed25519_keypair_init. Holds secrets, crypt0_ed25519_keypair_wipe it
+ */
+typedef struct {
+  uint8_t secret[64];   // clamped scalar | nonce prefix
+  uint8_t pub[CRYPT0_ED25519_PUBKEY_BYTES];
+} crypt0_ed25519_keypair;
+
 /** convert secret key to public */
 int crypt0_ed25519_public_key(const uint8_t * priv, size_t privlen, 
         uint8_t * pub, size_t publen);
 
+/** 
+ * n public keys from n 32 byte private keys packed back to back, pub gets
+ * n * 32 bytes. The affine conversion of every 8 keys shares one field
+ * inversion, nothing is allocated. returns 0, -1 for a NULL buffer
+ */
+int crypt0_ed25519_public_keys(const uint8_t * priv, size_t n, uint8_t * pub);
+
 /** sign sha256 hash 
  * @param message - message to sign
  * @param messagelen - message length
@@ -36,4 +56,36 @@ int crypt0_ed25519_sign(
 
 int crypt0_ed25519_derive_secret_index(uint8_t * secret, uint32_t index);
 
+/** expands the 32 byte private key and computes its public key, returns 0 or -1 */
+int crypt0_ed25519_keypair_init(crypt0_ed25519_keypair * keypair,
+        const uint8_t * priv, size_t privlen);
+
+/** 
+ * signs message with an expanded key pair, same signature as
+ * crypt0_ed25519_sign without hashing the private key or taking a public key
+ * that may not match it. returns 0, -1 if siglen is not 64
+ */
+int crypt0_ed25519_keypair_sign(const crypt0_ed25519_keypair * keypair,
+        const uint8_t * message, size_t messagelen, uint8_t * sig, size_t siglen);
+
+void crypt0_ed25519_keypair_wipe(crypt0_ed25519_keypair * keypair);
+
+/** 
+ * Portable implementation behind crypt0_ed25519_public_key(s) / sign on
+ * every backend, arguments as in ocrypto
+ */
+void crypt0_ed25519_portable_public_key(uint8_t * pub, const uint8_t * priv);
+void crypt0_ed25519_portable_public_keys(uint8_t * pub, const uint8_t * priv, size_t n);
+void crypt0_ed25519_portable_sign(uint8_t * sig, const uint8_t * message,
+    size_t messagelen, const uint8_t * priv, const uint8_t * pub);
+
+/** az gets the clamped scalar | nonce prefix of priv, pub its public key */
+void crypt0_ed25519_portable_expand(uint8_t * az, uint8_t * pub, const uint8_t * priv);
+void crypt0_ed25519_portable_sign_expanded(uint8_t * sig, const uint8_t * message,
+    size_t messagelen, const uint8_t * az, const uint8_t * pub);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif//__crypt0_ed25519_h_included__
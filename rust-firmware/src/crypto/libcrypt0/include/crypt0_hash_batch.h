@@ -0,0 +1,28 @@
+#ifndef __crypt0_hash_batch_h_included__
+#define __crypt0_hash_batch_h_included__
+
+/**
+ * Multi-buffer hashing of n equal length inputs packed back to back, e.g. a
+ * run of 33 byte compressed public keys. Inputs are hashed side by side in
+ * SIMD lanes (8 with avx2 on x86 hosts) or interleaved two at a time in
+ * scalar code. Results are identical to hashing every input on its own.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** out gets n 20 byte ripemd160(sha256(in_i)) digests */
+void crypt0_hash160_batch(const uint8_t * in, size_t len, size_t n, uint8_t * out);
+
+/** out gets n 32 byte sha256(sha256(in_i)) digests */
+void crypt0_dsha256_batch(const uint8_t * in, size_t len, size_t n, uint8_t * out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__crypt0_hash_batch_h_included__
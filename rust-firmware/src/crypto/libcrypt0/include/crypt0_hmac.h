@@ -2,6 +2,13 @@
 #define __crypt0_hmac_h_included__
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "crypt0_sha2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * Calculate HMAC SHA512 
@@ -13,4 +20,40 @@ int crypt0_hmac_sha512(const uint8_t * key, uint16_t key_len,
 int crypt0_hmac_sha256(const uint8_t * key, uint16_t key_len, 
   const uint8_t * msg, uint16_t msg_len, uint8_t * digest);
 
+/**
+ * Streaming HMAC, init keys the context and the keyed state can be kept and
+ * cloned to authenticate many messages under one key without re-keying
+ */
+typedef struct {
+  crypt0_sha256_ctx inner;
+  uint32_t ostate[8];
+} crypt0_hmac_sha256_ctx;
+
+typedef struct {
+  crypt0_sha512_ctx inner;
+  uint64_t ostate[8];
+} crypt0_hmac_sha512_ctx;
+
+void crypt0_hmac_sha256_init(crypt0_hmac_sha256_ctx * ctx,
+  const uint8_t * key, size_t key_len);
+void crypt0_hmac_sha256_update(crypt0_hmac_sha256_ctx * ctx,
+  const uint8_t * msg, size_t msg_len);
+/** Writes 32 bytes digest and wipes ctx */
+void crypt0_hmac_sha256_final(crypt0_hmac_sha256_ctx * ctx, uint8_t * digest);
+void crypt0_hmac_sha256_clone(crypt0_hmac_sha256_ctx * dst,
+  const crypt0_hmac_sha256_ctx * src);
+
+void crypt0_hmac_sha512_init(crypt0_hmac_sha512_ctx * ctx,
+  const uint8_t * key, size_t key_len);
+void crypt0_hmac_sha512_update(crypt0_hmac_sha512_ctx * ctx,
+  const uint8_t * msg, size_t msg_len);
+/** Writes 64 bytes digest and wipes ctx */
+void crypt0_hmac_sha512_final(crypt0_hmac_sha512_ctx * ctx, uint8_t * digest);
+void crypt0_hmac_sha512_clone(crypt0_hmac_sha512_ctx * dst,
+  const crypt0_hmac_sha512_ctx * src);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif//__crypt0_hmac_h_included__
@@ -0,0 +1,35 @@
+#ifndef __crypt0_keccak_h_included__
+#define __crypt0_keccak_h_included__
+
+/**
+ * Keccak-f[1600] permutation behind crypt0_sha3_keccak and friends. The state
+ * is 25 64-bit lanes, lane i = x + 5 * y, in the layout SHA3IUF uses.
+ */
+
+#include <stdint.h>
+
+/** Implementations, one of them is picked at build time by CRYPT0_KECCAK_IMPL */
+#define CRYPT0_KECCAK_IMPL_REF 0  // loop based reference, the original SHA3IUF code
+#define CRYPT0_KECCAK_IMPL_LC  1  // unrolled 64-bit with lane complementing
+#define CRYPT0_KECCAK_IMPL_BI  2  // 32-bit bit-interleaved, for Cortex-M
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Permutation used by the sponge: LC on 64-bit targets, BI on 32-bit ones */
+void crypt0_keccakf1600(uint64_t state[25]);
+
+/** Individual implementations, for tests and benchmarks */
+void crypt0_keccakf1600_ref(uint64_t state[25]);
+void crypt0_keccakf1600_lc(uint64_t state[25]);
+void crypt0_keccakf1600_bi(uint64_t state[25]);
+
+/** "ref", "lc" or "bi" */
+const char * crypt0_keccakf1600_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__crypt0_keccak_h_included__
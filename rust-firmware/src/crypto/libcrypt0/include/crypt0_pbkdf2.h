@@ -3,10 +3,72 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPT0_PBKDF2_SALT_MAXBYTES 64
+
+typedef enum {
+  CRYPT0_PBKDF2_HMAC_SHA256 = 0,
+  CRYPT0_PBKDF2_HMAC_SHA512 = 1,
+} crypt0_pbkdf2_hash_t;
+
+/**
+ * Resumable PBKDF2 state, keeps the keyed HMAC pads, U_i and the accumulator T
+ * between calls so a long derivation can be spread over several frames
+ */
+typedef struct {
+  union {
+    struct {
+      uint32_t istate[8];
+      uint32_t ostate[8];
+      uint32_t u[8];
+      uint32_t t[8];
+    } sha256;
+    struct {
+      uint64_t istate[8];
+      uint64_t ostate[8];
+      uint64_t u[8];
+      uint64_t t[8];
+    } sha512;
+  } s;
+  uint32_t hash;
+  uint32_t iterations;
+  uint32_t done;
+} crypt0_pbkdf2_ctx;
+
+/**
+ * Keys the context and runs the first iteration
+ * returns CRYPT0_OK on success, negative error code otherwise
+ */
+int crypt0_pbkdf2_init(crypt0_pbkdf2_ctx * ctx, crypt0_pbkdf2_hash_t hash,
+  uint32_t iterations, const uint8_t * pass, uint16_t pass_len,
+  const uint8_t * salt, uint16_t salt_len);
+
+/**
+ * Runs at most n iterations
+ * returns the number of iterations still left
+ */
+uint32_t crypt0_pbkdf2_step(crypt0_pbkdf2_ctx * ctx, uint32_t n);
+
+/**
+ * Writes the derived key (32 bytes for sha256, 64 for sha512) and wipes ctx
+ * returns CRYPT0_OK on success, CRYPT0_ERR if iterations are left
+ */
+int crypt0_pbkdf2_finish(crypt0_pbkdf2_ctx * ctx, uint8_t * key, uint16_t key_len);
+
+/** Aborts the derivation, wipes ctx */
+void crypt0_pbkdf2_wipe(crypt0_pbkdf2_ctx * ctx);
+
 int crypt0_pbkdf2_hmac_sha256(int i, const uint8_t * pass, uint16_t pass_len, 
   const uint8_t * salt, uint16_t salt_len, uint8_t * key, uint16_t key_len);
 
 int crypt0_pbkdf2_hmac_sha512(int i, const uint8_t * pass, uint16_t pass_len, 
   const uint8_t * salt, uint16_t salt_len, uint8_t * key, uint16_t key_len);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif//__crypt0_pbkdf2_h_included__
@@ -1,16 +1,28 @@
 #ifndef __crypt0_ripemd160_h_included__
 #define __crypt0_ripemd160_h_included__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define CRYPT0_RIPEMD_BYTES 20
+#define CRYPT0_RIPEMD160_BLOCK_BYTES 64
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void ripemd160(const uint8_t* msg, uint32_t msg_len, uint8_t* hash);
-#define crypt0_ripemd160 ripemd160
+extern const uint32_t crypt0_ripemd160_iv[5];
+
+void crypt0_ripemd160(const uint8_t * msg, uint32_t msg_len, uint8_t * hash);
+
+/** Compress one block given as 16 little-endian decoded words into state */
+void crypt0_ripemd160_compress(uint32_t state[5], const uint32_t block[16]);
+
+/**
+ * hash160 = ripemd160(sha256(msg)), the pubkey hash of P2PKH addresses and
+ * bip32 fingerprints. The sha256 digest goes to ripemd160 as words.
+ */
+void crypt0_hash160(const uint8_t * msg, size_t msg_len, uint8_t hash[20]);
 
 #ifdef __cplusplus
 }
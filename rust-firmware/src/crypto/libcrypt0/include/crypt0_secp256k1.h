@@ -7,16 +7,85 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "crypt0_sha2.h"
+#include "crypt0_hmac.h"
+
 #define CRYPT0_SECP256_PRIVKEY_BYTES 32
 #define CRYPT0_SECP256_PUBKEY_BYTES 65
 #define CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES 33
 #define CRYPT0_SECP256_SIG_RECOVERABLE_BYTES 65
 #define CRYPT0_SECP256_SIG_COMPACT_BYTES 64
 
+/** operations on the shared context between re-randomizations of its blinding */
+#ifndef CRYPT0_SECP256K1_RERANDOMIZE_EVERY
+#define CRYPT0_SECP256K1_RERANDOMIZE_EVERY 64
+#endif
+
+/** scratch crypt0_secp256k1_pubkeys_batch needs for n keys, any alignment */
+#define CRYPT0_SECP256K1_BATCH_SCRATCH_PER_KEY 256
+#define CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n) \
+  ((n) * CRYPT0_SECP256K1_BATCH_SCRATCH_PER_KEY + 16)
+
+/** signature formats of crypt0_secp256k1_sign_batch */
+#define CRYPT0_SECP256K1_SIG_COMPACT     0 // r | s, 64 bytes
+#define CRYPT0_SECP256K1_SIG_RECOVERABLE 1 // r | s | recid, 65 bytes
+#define CRYPT0_SECP256K1_SIG_DER         2 // DER, up to 72 bytes
+#define CRYPT0_SECP256_SIG_DER_MAX_BYTES 72
+
+/** scratch crypt0_secp256k1_sign_batch needs for n signatures, any alignment */
+#define CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_PER_SIG 384
+#define CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(n) \
+  ((n) * CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_PER_SIG + 16)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** 
+ * re-seed the blinding of the shared context from crypt0_rng now, e.g. after
+ * wake up, it is also done every CRYPT0_SECP256K1_RERANDOMIZE_EVERY calls.
+ * Each thread has its own context, this one is the calling thread's. A Zephyr
+ * build without CONFIG_THREAD_LOCAL_STORAGE has a single context, calls must
+ * come from one thread at a time there
+ */
+void crypt0_secp256k1_rerandomize(void);
+
+/**
+ * ECDH hash, same as libsecp256k1 secp256k1_ecdh_hash_function: gets the
+ * shared point, writes 32 bytes to out and returns 1, or 0 on failure
+ */
+typedef int (*crypt0_secp256k1_ecdh_hash_fn)(uint8_t * out, const uint8_t * x32,
+        const uint8_t * y32, void * data);
+
+/**
+ * shared secret of a private key and a 33 or 65 byte public key, one point
+ * multiplication on the shared context and one call of hash with data.
+ * hash NULL is the libsecp256k1 default, sha256 of the compressed point
+ */
+int crypt0_secp256k1_ecdh(const uint8_t * priv, const uint8_t * pub, size_t publen,
+        uint8_t * out, crypt0_secp256k1_ecdh_hash_fn hash, void * data);
+
+/** ECDH hash: the raw x coordinate, data unused */
+int crypt0_secp256k1_ecdh_hash_x(uint8_t * out, const uint8_t * x32,
+        const uint8_t * y32, void * data);
+
+/** 
+ * ECDH hash: tagged sha256(sha256(tag) | sha256(tag) | x) as in BIP340, data
+ * is a crypt0_sha256_ctx from crypt0_secp256k1_ecdh_tag_init, so the tag
+ * block is hashed once
+ */
+int crypt0_secp256k1_ecdh_hash_tagged(uint8_t * out, const uint8_t * x32,
+        const uint8_t * y32, void * data);
+
+void crypt0_secp256k1_ecdh_tag_init(crypt0_sha256_ctx * ctx, const char * tag);
+
+/** 
+ * ECDH hash: HKDF-SHA256 extract, hmac(salt, x), data is a
+ * crypt0_hmac_sha256_ctx keyed with the salt, it is not modified
+ */
+int crypt0_secp256k1_ecdh_hash_hkdf_extract(uint8_t * out, const uint8_t * x32,
+        const uint8_t * y32, void * data);
+
 /** generate a secret using pubkey and a private key
  * publen = 33
  * privlen = 32
@@ -32,10 +101,57 @@ int crypt0_secp256k1_public_key(const uint8_t * priv, size_t privlen,
 int crypt0_secp256k1_public_key_compressed(const uint8_t * priv, size_t privlen, 
         uint8_t * pub, size_t publen);
 
+/** 
+ * n compressed public keys from n private keys packed back to back, pub gets
+ * n * 33 bytes. The affine conversion of all points shares one field
+ * inversion. scratch is caller memory of CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n),
+ * nothing is allocated. If any key is invalid pub is zeroed and 
+ * CRYPT0_ERR_IMPORT_KEY returned
+ */
+int crypt0_secp256k1_pubkeys_batch(const uint8_t * priv, size_t n, uint8_t * pub,
+        void * scratch, size_t scratchlen);
+
+/** 
+ * n compressed public keys pub + tweak_i * G, tweaks are 32 bytes each back
+ * to back, out gets n * 33 bytes. pub is a 33 byte compressed key, tweaks are
+ * public values (BIP32 public derivation). The sums share one field inversion,
+ * scratch is CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n). A tweak of the order or
+ * above or a sum at infinity fails only its own entry, whose 33 bytes are
+ * zeroed, the others are still computed
+ * returns the number of failed entries (CRYPT0_OK if none) or an error
+ */
+int crypt0_secp256k1_pubkey_tweak_add_batch(const uint8_t * pub, const uint8_t * tweaks,
+        size_t n, uint8_t * out, void * scratch, size_t scratchlen);
+
+/** 
+ * sign n sha256 hashes packed back to back, hash i with the 32 byte key
+ * keys[i]. Signatures are the same as one by one (RFC6979, low s) and are
+ * written back to back to sigs in format CRYPT0_SECP256K1_SIG_*, sigslen must
+ * fit n of the largest size. siglens, if not NULL, gets the length of each.
+ * The nonce and the affine R inversions of all signatures are shared, a key
+ * repeated at consecutive entries (same pointer) is parsed once. scratch is
+ * caller memory of CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(n). Returns the
+ * bytes written to sigs; if any key is invalid sigs is zeroed and
+ * CRYPT0_ERR_IMPORT_KEY returned
+ */
+int crypt0_secp256k1_sign_batch(const uint8_t * hashes, const uint8_t * const * keys,
+        size_t n, int format, uint8_t * sigs, size_t sigslen, uint8_t * siglens,
+        void * scratch, size_t scratchlen);
+
 /** sign sha256 hash */
 int crypt0_secp256k1_sign(const uint8_t * hash, size_t hashlen, 
         const uint8_t * priv, size_t privlen, uint8_t * sig, uint8_t siglen);
 
+/** 
+ * verify a 64 byte compact signature (or 65 byte recoverable, recid unused)
+ * of a sha256 hash with a 33 or 65 byte public key. Low s only, as
+ * crypt0_secp256k1_sign makes them. CRYPT0_OK if it verifies, CRYPT0_ERR if
+ * not, CRYPT0_ERR_IMPORT_KEY or CRYPT0_ERR_FMT for an unparsable key or
+ * signature
+ */
+int crypt0_secp256k1_verify_signature(const uint8_t * sig, size_t siglen,
+        const uint8_t * hash, size_t hashlen, const uint8_t * pub, size_t publen);
+
 /** sign sha256 hash recoverable */
 int crypt0_secp256k1_sign_recoverable(const uint8_t * hash, size_t hashlen, 
         const uint8_t * priv, size_t privlen, uint8_t * sig, uint8_t siglen);
@@ -44,121 +160,6 @@ int crypt0_secp256k1_sign_recoverable(const uint8_t * hash, size_t hashlen,
 }
 #endif
 
-/* Limbs of the secp256k1 order. */
-#define SECP256K1_N_0 ((uint32_t)0xD0364141UL)
-#define SECP256K1_N_1 ((uint32_t)0xBFD25E8CUL)
-#define SECP256K1_N_2 ((uint32_t)0xAF48A03BUL)
-#define SECP256K1_N_3 ((uint32_t)0xBAAEDCE6UL)
-#define SECP256K1_N_4 ((uint32_t)0xFFFFFFFEUL)
-#define SECP256K1_N_5 ((uint32_t)0xFFFFFFFFUL)
-#define SECP256K1_N_6 ((uint32_t)0xFFFFFFFFUL)
-#define SECP256K1_N_7 ((uint32_t)0xFFFFFFFFUL)
-
-/* Limbs of 2^256 minus the secp256k1 order. */
-#define SECP256K1_N_C_0 (~SECP256K1_N_0 + 1)
-#define SECP256K1_N_C_1 (~SECP256K1_N_1)
-#define SECP256K1_N_C_2 (~SECP256K1_N_2)
-#define SECP256K1_N_C_3 (~SECP256K1_N_3)
-#define SECP256K1_N_C_4 (1)
-
-/* Limbs of half the secp256k1 order. */
-#define SECP256K1_N_H_0 ((uint32_t)0x681B20A0UL)
-#define SECP256K1_N_H_1 ((uint32_t)0xDFE92F46UL)
-#define SECP256K1_N_H_2 ((uint32_t)0x57A4501DUL)
-#define SECP256K1_N_H_3 ((uint32_t)0x5D576E73UL)
-#define SECP256K1_N_H_4 ((uint32_t)0xFFFFFFFFUL)
-#define SECP256K1_N_H_5 ((uint32_t)0xFFFFFFFFUL)
-#define SECP256K1_N_H_6 ((uint32_t)0xFFFFFFFFUL)
-#define SECP256K1_N_H_7 ((uint32_t)0x7FFFFFFFUL)
-
-// Bitcoin Core https://github.com/bitcoin-core/secp256k1
-inline static int secp256k1_scalar_check_overflow(const uint32_t *a) {
-    int yes = 0;
-    int no = 0;
-    no |= (a[7] < SECP256K1_N_7); /* No need for a > check. */
-    no |= (a[6] < SECP256K1_N_6); /* No need for a > check. */
-    no |= (a[5] < SECP256K1_N_5); /* No need for a > check. */
-    no |= (a[4] < SECP256K1_N_4);
-    yes |= (a[4] > SECP256K1_N_4) & ~no;
-    no |= (a[3] < SECP256K1_N_3) & ~yes;
-    yes |= (a[3] > SECP256K1_N_3) & ~no;
-    no |= (a[2] < SECP256K1_N_2) & ~yes;
-    yes |= (a[2] > SECP256K1_N_2) & ~no;
-    no |= (a[1] < SECP256K1_N_1) & ~yes;
-    yes |= (a[1] > SECP256K1_N_1) & ~no;
-    yes |= (a[0] >= SECP256K1_N_0) & ~no;
-    return yes;
-}
-
-inline static int secp256k1_scalar_reduce(uint32_t *r, uint32_t overflow) {
-    uint64_t t;
-    t = (uint64_t)r[0] + overflow * SECP256K1_N_C_0;
-    r[0] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[1] + overflow * SECP256K1_N_C_1;
-    r[1] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[2] + overflow * SECP256K1_N_C_2;
-    r[2] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[3] + overflow * SECP256K1_N_C_3;
-    r[3] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[4] + overflow * SECP256K1_N_C_4;
-    r[4] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[5];
-    r[5] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[6];
-    r[6] = t & 0xFFFFFFFFUL; t >>= 32;
-    t += (uint64_t)r[7];
-    r[7] = t & 0xFFFFFFFFUL;
-    return overflow;
-}
-
-inline static int secp256k1_scalar_add(uint32_t *r, const uint32_t *a, const uint32_t *b) {
-    int overflow = 0;
-    uint64_t t = (uint64_t)a[0] + b[0];
-    r[0] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[1] + b[1];
-    r[1] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[2] + b[2];
-    r[2] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[3] + b[3];
-    r[3] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[4] + b[4];
-    r[4] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[5] + b[5];
-    r[5] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[6] + b[6];
-    r[6] = t & 0xFFFFFFFFULL; t >>= 32;
-    t += (uint64_t)a[7] + b[7];
-    r[7] = t & 0xFFFFFFFFULL; t >>= 32;
-    overflow = t + secp256k1_scalar_check_overflow(r);
-
-    secp256k1_scalar_reduce(r, overflow);
-    return overflow;
-}
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-static void secp256k1_scalar_set_b32(uint32_t *r, const unsigned char *b32) {
-    //int over;
-    r[0] = (uint32_t)b32[31] | (uint32_t)b32[30] << 8 | (uint32_t)b32[29] << 16 | (uint32_t)b32[28] << 24;
-    r[1] = (uint32_t)b32[27] | (uint32_t)b32[26] << 8 | (uint32_t)b32[25] << 16 | (uint32_t)b32[24] << 24;
-    r[2] = (uint32_t)b32[23] | (uint32_t)b32[22] << 8 | (uint32_t)b32[21] << 16 | (uint32_t)b32[20] << 24;
-    r[3] = (uint32_t)b32[19] | (uint32_t)b32[18] << 8 | (uint32_t)b32[17] << 16 | (uint32_t)b32[16] << 24;
-    r[4] = (uint32_t)b32[15] | (uint32_t)b32[14] << 8 | (uint32_t)b32[13] << 16 | (uint32_t)b32[12] << 24;
-    r[5] = (uint32_t)b32[11] | (uint32_t)b32[10] << 8 | (uint32_t)b32[9] << 16 | (uint32_t)b32[8] << 24;
-    r[6] = (uint32_t)b32[7] | (uint32_t)b32[6] << 8 | (uint32_t)b32[5] << 16 | (uint32_t)b32[4] << 24;
-    r[7] = (uint32_t)b32[3] | (uint32_t)b32[2] << 8 | (uint32_t)b32[1] << 16 | (uint32_t)b32[0] << 24;
-}
-
-static void secp256k1_scalar_get_b32(unsigned char *bin, const uint32_t* a) {
-    bin[0] = a[7] >> 24; bin[1] = a[7] >> 16; bin[2] = a[7] >> 8; bin[3] = a[7];
-    bin[4] = a[6] >> 24; bin[5] = a[6] >> 16; bin[6] = a[6] >> 8; bin[7] = a[6];
-    bin[8] = a[5] >> 24; bin[9] = a[5] >> 16; bin[10] = a[5] >> 8; bin[11] = a[5];
-    bin[12] = a[4] >> 24; bin[13] = a[4] >> 16; bin[14] = a[4] >> 8; bin[15] = a[4];
-    bin[16] = a[3] >> 24; bin[17] = a[3] >> 16; bin[18] = a[3] >> 8; bin[19] = a[3];
-    bin[20] = a[2] >> 24; bin[21] = a[2] >> 16; bin[22] = a[2] >> 8; bin[23] = a[2];
-    bin[24] = a[1] >> 24; bin[25] = a[1] >> 16; bin[26] = a[1] >> 8; bin[27] = a[1];
-    bin[28] = a[0] >> 24; bin[29] = a[0] >> 16; bin[30] = a[0] >> 8; bin[31] = a[0];
-}
-#pragma GCC diagnostic pop
 #endif//__crypt0_secp256k1_h_included__
 
 
@@ -9,11 +9,31 @@
 extern "C" {
 #endif
 
+#define CRYPT0_KECCAK256_RATE 136
+
+/**
+ * Streaming keccak256 (Ethereum, original Keccak padding). The context is
+ * plain data: copy it, or use clone, to snapshot a shared prefix and finish
+ * several messages from it.
+ */
+typedef struct {
+  uint64_t state[25];
+  size_t used;      // bytes absorbed into the current block
+} crypt0_keccak_ctx;
+
+void crypt0_keccak_init(crypt0_keccak_ctx * ctx);
+void crypt0_keccak_update(crypt0_keccak_ctx * ctx, const void * data, size_t len);
+/** Writes the 32 bytes digest, ctx needs init before it is used again */
+void crypt0_keccak_final(crypt0_keccak_ctx * ctx, uint8_t out[32]);
+void crypt0_keccak_clone(crypt0_keccak_ctx * dst, const crypt0_keccak_ctx * src);
+
+/** keccak256 of data1 || data2, outlen up to 32 */
 bool crypt0_sha3_keccak2(
 		const uint8_t * data1, size_t data1len, 
 		const uint8_t * data2, size_t data2len, 
 		uint8_t * out, size_t outlen);
 
+/** keccak256, outlen up to 32 */
 bool crypt0_sha3_keccak(const uint8_t * buf, size_t buflen, 
 		uint8_t * out, size_t outlen);
 
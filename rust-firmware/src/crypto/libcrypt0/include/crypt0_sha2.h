@@ -0,0 +1,75 @@
+#ifndef __crypt0_sha2_h_included__
+#define __crypt0_sha2_h_included__
+
+/** SHA-256 / SHA-512 compression functions working on word-form state */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRYPT0_SHA256_BLOCK_BYTES 64
+#define CRYPT0_SHA512_BLOCK_BYTES 128
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const uint32_t crypt0_sha256_iv[8];
+extern const uint64_t crypt0_sha512_iv[8];
+
+/**
+ * Compress one block given as 16 big-endian decoded words into state,
+ * used when the message is already in word form (pbkdf2, hmac pads)
+ */
+void crypt0_sha256_compress(uint32_t state[8], const uint32_t block[16]);
+void crypt0_sha512_compress(uint64_t state[8], const uint64_t block[16]);
+
+/** Compress nblocks consecutive message blocks given as bytes */
+void crypt0_sha256_blocks(uint32_t state[8], const uint8_t * data, size_t nblocks);
+void crypt0_sha512_blocks(uint64_t state[8], const uint8_t * data, size_t nblocks);
+
+/**
+ * Compression kernels. Host builds on x86 pick the fastest one the cpu
+ * supports on first use, everything else always runs the scalar kernel.
+ * SHA-512 has no SHA-NI kernel and runs on avx2 (if present) under SHANI.
+ */
+typedef enum {
+  CRYPT0_SHA2_KERNEL_SCALAR = 0,
+  CRYPT0_SHA2_KERNEL_AVX2   = 1,
+  CRYPT0_SHA2_KERNEL_SHANI  = 2,
+} crypt0_sha2_kernel_t;
+
+bool crypt0_sha2_kernel_supported(crypt0_sha2_kernel_t kernel);
+
+/** Forces a kernel for every SHA-2 user (tests, benchmarks), false if unsupported */
+bool crypt0_sha2_kernel_select(crypt0_sha2_kernel_t kernel);
+
+crypt0_sha2_kernel_t crypt0_sha2_kernel(void);
+const char * crypt0_sha2_kernel_name(crypt0_sha2_kernel_t kernel);
+
+/** Streaming SHA-256 / SHA-512, state is plain data and can be copied */
+typedef struct {
+  uint32_t state[8];
+  uint64_t count;
+  uint8_t buf[CRYPT0_SHA256_BLOCK_BYTES];
+} crypt0_sha256_ctx;
+
+typedef struct {
+  uint64_t state[8];
+  uint64_t count;
+  uint8_t buf[CRYPT0_SHA512_BLOCK_BYTES];
+} crypt0_sha512_ctx;
+
+void crypt0_sha256_init(crypt0_sha256_ctx * ctx);
+void crypt0_sha256_update(crypt0_sha256_ctx * ctx, const uint8_t * data, size_t len);
+void crypt0_sha256_final(crypt0_sha256_ctx * ctx, uint8_t digest[32]);
+
+void crypt0_sha512_init(crypt0_sha512_ctx * ctx);
+void crypt0_sha512_update(crypt0_sha512_ctx * ctx, const uint8_t * data, size_t len);
+void crypt0_sha512_final(crypt0_sha512_ctx * ctx, uint8_t digest[64]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__crypt0_sha2_h_included__
@@ -8,6 +8,7 @@
 #endif//__ZEPHYR__
 
 #include "crypt0_log.h"
+#include "crypt0_openssl.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -55,6 +56,16 @@ int crypt0_sig_ber2raw(const uint8_t * ber, uint8_t * raw)
   return CRYPT0_OK;
 }
 
+//-----------------------------------------------------------------------------
+// Wipe secret material
+void crypt0_memzero(void * buf, size_t len)
+{
+  volatile uint8_t * p = (volatile uint8_t *)buf;
+  while (len--) {
+    *p++ = 0;
+  }
+}
+
 // init crypt0 library
 int crypt0_init()
 {
@@ -84,6 +95,14 @@ int crypt0_init()
   return CRYPT0_OK;
 }
 
+// free per thread contexts
+void crypt0_release_thread(void)
+{
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
+  crypt0_ossl_thread_release();
+#endif
+}
+
 #ifndef __ZEPHYR__
 bool crypt0_bin2hex(const uint8_t * bin, size_t binlen, char * hex, size_t hexlen)
 {
@@ -0,0 +1,143 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "crypt0.h"
+#include "crypt0_address.h"
+#include "crypt0_bip32.h"
+#include "crypt0_hash_batch.h"
+#include <crypt0_log.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+LOG_MODULE_REGISTER(crypt0_address, LOG_LEVEL_DBG);
+#pragma GCC diagnostic pop
+
+//-----------------------------------------------------------------------------
+// Address ranges
+//
+// A chunk of children at a time: public keys of the chunk from the chain node
+// (one shared inversion), hash160 of all keys in lanes, for base58 the double
+// sha256 checksums of all version | hash160 payloads in lanes too, then the
+// text encoding of each. The scratch is fixed by the chunk, not the count. A
+// child BIP32 skips is an empty string, the others keep their positions.
+
+typedef struct {
+  uint8_t p2pkh;        // base58check version byte
+  const char * hrp;     // bech32 human readable part, NULL without segwit
+} coin_params;
+
+static const coin_params m_coins[] = {
+  [CRYPT0_COIN_BTC]      = { 0x00, "bc" },
+  [CRYPT0_COIN_BTC_TEST] = { 0x6f, "tb" },
+  [CRYPT0_COIN_LTC]      = { 0x30, "ltc" },
+  [CRYPT0_COIN_DOGE]     = { 0x1e, NULL },
+};
+
+#define P2PKH_PAYLOAD_BYTES 21
+
+// one address to the end of the arena, its length with the zero or -1
+static int encode_one(const coin_params * coin, int format, const uint8_t * hash160,
+    const uint8_t * payload, const uint8_t * checksum, char * out, size_t outlen)
+{
+  char buf[96];
+  int len;
+
+  if (format == CRYPT0_ADDRESS_P2WPKH) {
+    len = crypt0_bech32_witness_v0_encode(hash160, 20, coin->hrp, buf, sizeof(buf));
+  } else {
+    uint8_t addr[P2PKH_PAYLOAD_BYTES + 4];
+    memcpy(addr, payload, P2PKH_PAYLOAD_BYTES);
+    memcpy(&addr[P2PKH_PAYLOAD_BYTES], checksum, 4);
+    len = crypt0_base58_encode(addr, sizeof(addr), buf, sizeof(buf));
+  }
+  if (len < 0 || (size_t)len + 1 > outlen) {
+    return -1;
+  }
+  memcpy(out, buf, len + 1);
+  return len + 1;
+}
+
+int crypt0_address_range(const uint8_t * xpub, uint32_t chain, uint32_t start,
+    size_t count, int coin, int format, char * out, size_t outlen,
+    void * scratch, size_t scratchlen)
+{
+  uint8_t account[CRYPT0_BIP32_PUBNODE_BYTES];
+  uint8_t node[CRYPT0_BIP32_PUBNODE_BYTES];
+
+  if (coin < 0 || coin >= (int)(sizeof(m_coins) / sizeof(m_coins[0])) ||
+      (format != CRYPT0_ADDRESS_P2PKH && format != CRYPT0_ADDRESS_P2WPKH) ||
+      (format == CRYPT0_ADDRESS_P2WPKH && m_coins[coin].hrp == NULL)) {
+    LOG_ERR("coin %d format %d", coin, format);
+    return CRYPT0_ERR_FMT;
+  }
+  if (count == 0) {
+    return 0;
+  }
+  if (((start + count - 1) & CRYPT0_BIP32_INDEX_HARDENED) || start + count - 1 < start) {
+    return CRYPT0_ERR_FMT;
+  }
+  if (scratch == NULL || scratchlen < CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES) {
+    LOG_ERR("address scratch %d bytes, need %d", (int)scratchlen,
+        (int)CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES);
+    return CRYPT0_ERR_OUTBUF_LEN;
+  }
+
+  const coin_params * params = &m_coins[coin];
+  uint8_t * pubs = scratch;
+  uint8_t * hashes = pubs + CRYPT0_ADDRESS_RANGE_CHUNK * 33;
+  uint8_t * payloads = hashes + CRYPT0_ADDRESS_RANGE_CHUNK * 20;
+  uint8_t * checksums = payloads + CRYPT0_ADDRESS_RANGE_CHUNK * P2PKH_PAYLOAD_BYTES;
+  uint8_t * batch = checksums + CRYPT0_ADDRESS_RANGE_CHUNK * 32;
+  size_t batchlen = CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(CRYPT0_ADDRESS_RANGE_CHUNK);
+
+  crypt0_bip32_pubnode_from_xpub(xpub, account);
+  int ret = crypt0_bip32_ckd_pub(account, chain, node);
+  if (ret != CRYPT0_OK) {
+    return ret;
+  }
+
+  size_t written = 0;
+  for (size_t done = 0; done < count; ) {
+    size_t n = count - done;
+    if (n > CRYPT0_ADDRESS_RANGE_CHUNK) {
+      n = CRYPT0_ADDRESS_RANGE_CHUNK;
+    }
+
+    ret = crypt0_bip32_ckd_pub_batch(node, start + done, n, pubs, batch, batchlen);
+    if (ret < 0) {
+      return ret;
+    }
+    crypt0_hash160_batch(pubs, 33, n, hashes);
+
+    if (format == CRYPT0_ADDRESS_P2PKH) {
+      for (size_t i = 0; i < n; i++) {
+        payloads[i * P2PKH_PAYLOAD_BYTES] = params->p2pkh;
+        memcpy(&payloads[i * P2PKH_PAYLOAD_BYTES + 1], &hashes[i * 20], 20);
+      }
+      crypt0_dsha256_batch(payloads, P2PKH_PAYLOAD_BYTES, n, checksums);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      int len = -1;
+      if (pubs[i * 33] != 0) {
+        len = encode_one(params, format, &hashes[i * 20],
+            &payloads[i * P2PKH_PAYLOAD_BYTES], &checksums[i * 32],
+            out + written, outlen - written);
+      } else if (written < outlen) {
+        // skipped child, zeroed by crypt0_bip32_ckd_pub_batch
+        out[written] = '\0';
+        len = 1;
+      }
+      if (len < 0) {
+        LOG_ERR("address arena %d bytes, full at %d", (int)outlen, (int)(done + i));
+        return CRYPT0_ERR_OUTBUF_LEN;
+      }
+      written += len;
+    }
+    done += n;
+  }
+  return (int)written;
+}
+
+// eof
@@ -1,10 +1,15 @@
 #include <crypt0_aes_ccm.h>
 
+#include "crypt0.h"
+
 #ifdef __ZEPHYR__
 #include <ocrypto_aes_ccm.h>
-#else
+#elif defined(CRYPT0_USE_OPENSSL)
+#include <stdio.h>
+#include <stdlib.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
+#include "crypt0_openssl.h"
 #endif
 
 #include <string.h>
@@ -24,7 +29,7 @@
 }
 #endif
 
-#ifndef __ZEPHYR__
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
 
 int crypt0_encrypt_aes_ccm_openssl(
   const uint8_t *plaintext, int plaintext_len, 
@@ -38,13 +43,13 @@ int crypt0_encrypt_aes_ccm_openssl(
     int len;
     int ciphertext_len;
 
-    // Create and initialize the context
-    if(!(ctx = EVP_CIPHER_CTX_new())) {
+    // The thread's cipher context, reinitialized below
+    if(!(ctx = crypt0_ossl_cipher_ctx())) {
         handleErrors();
     }
 
     // Initialize the encryption operation
-    if(1 != EVP_EncryptInit_ex(ctx, EVP_aes_256_ccm(), NULL, NULL, NULL))
+    if(1 != EVP_EncryptInit_ex(ctx, crypt0_ossl_aes_256_ccm(), NULL, NULL, NULL))
         handleErrors();
 
     // Set nonce len
@@ -86,8 +91,6 @@ int crypt0_encrypt_aes_ccm_openssl(
     if(1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_GET_TAG, tag_len, tag))
         handleErrors();
 
-    EVP_CIPHER_CTX_free(ctx);
-
     return ciphertext_len;
 }
 
@@ -104,12 +107,12 @@ int crypt0_decrypt_aes_ccm_openssl(const uint8_t * ciphertext, int ciphertext_le
     int plaintext_len;
     int ret;
 
-    /* Create and initialise the context */
-    if(!(ctx = EVP_CIPHER_CTX_new()))
+    /* The thread's cipher context, reinitialized below */
+    if(!(ctx = crypt0_ossl_cipher_ctx()))
         handleErrors();
 
     /* Initialise the decryption operation. */
-    if(1 != EVP_DecryptInit_ex(ctx, EVP_aes_256_ccm(), NULL, NULL, NULL))
+    if(1 != EVP_DecryptInit_ex(ctx, crypt0_ossl_aes_256_ccm(), NULL, NULL, NULL))
         handleErrors();
 
     /* Setting IV len to 7. Not strictly necessary as this is the default
@@ -142,9 +145,6 @@ int crypt0_decrypt_aes_ccm_openssl(const uint8_t * ciphertext, int ciphertext_le
 
     plaintext_len = len;
 
-    /* Clean up */
-    EVP_CIPHER_CTX_free(ctx);
-
     if(ret > 0) {
         /* Success */
         return plaintext_len;
@@ -154,6 +154,287 @@ int crypt0_decrypt_aes_ccm_openssl(const uint8_t * ciphertext, int ciphertext_le
     }
 
 }
+#elif !defined(__ZEPHYR__)
+
+//-----------------------------------------------------------------------------
+// Portable AES (encrypt direction only, CCM never runs the inverse cipher) and
+// CCM as in NIST SP 800-38C, everything on the stack
+
+#define AES_BLOCK 16
+
+typedef struct {
+  uint8_t rk[240];
+  int rounds;
+} aes_ctx;
+
+static const uint8_t aes_sbox[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static inline uint8_t aes_xtime(uint8_t x)
+{
+  return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+static int aes_setkey(aes_ctx * ctx, const uint8_t * key, int key_len)
+{
+  int nk = key_len / 4;
+  uint8_t rcon = 1;
+  uint8_t t[4];
+
+  if (key_len != 16 && key_len != 24 && key_len != 32) {
+    return -1;
+  }
+  ctx->rounds = nk + 6;
+  memcpy(ctx->rk, key, key_len);
+
+  for (int i = nk; i < 4 * (ctx->rounds + 1); i++) {
+    memcpy(t, &ctx->rk[4 * (i - 1)], 4);
+    if (i % nk == 0) {
+      uint8_t u = t[0];
+      t[0] = aes_sbox[t[1]] ^ rcon;
+      t[1] = aes_sbox[t[2]];
+      t[2] = aes_sbox[t[3]];
+      t[3] = aes_sbox[u];
+      rcon = aes_xtime(rcon);
+    } else if (nk > 6 && i % nk == 4) {
+      for (int j = 0; j < 4; j++) {
+        t[j] = aes_sbox[t[j]];
+      }
+    }
+    for (int j = 0; j < 4; j++) {
+      ctx->rk[4 * i + j] = ctx->rk[4 * (i - nk) + j] ^ t[j];
+    }
+  }
+  return 0;
+}
+
+static void aes_encrypt(const aes_ctx * ctx, const uint8_t in[AES_BLOCK],
+    uint8_t out[AES_BLOCK])
+{
+  uint8_t s[AES_BLOCK], t[AES_BLOCK];
+
+  for (int i = 0; i < AES_BLOCK; i++) {
+    s[i] = in[i] ^ ctx->rk[i];
+  }
+
+  for (int r = 1; r <= ctx->rounds; r++) {
+    // SubBytes + ShiftRows, state is column major
+    for (int c = 0; c < 4; c++) {
+      for (int row = 0; row < 4; row++) {
+        t[4 * c + row] = aes_sbox[s[4 * ((c + row) & 3) + row]];
+      }
+    }
+    if (r != ctx->rounds) {
+      for (int c = 0; c < 4; c++) {
+        uint8_t * a = &t[4 * c];
+        uint8_t x = a[0] ^ a[1] ^ a[2] ^ a[3];
+        uint8_t a0 = a[0];
+        a[0] ^= x ^ aes_xtime(a[0] ^ a[1]);
+        a[1] ^= x ^ aes_xtime(a[1] ^ a[2]);
+        a[2] ^= x ^ aes_xtime(a[2] ^ a[3]);
+        a[3] ^= x ^ aes_xtime(a[3] ^ a0);
+      }
+    }
+    for (int i = 0; i < AES_BLOCK; i++) {
+      s[i] = t[i] ^ ctx->rk[16 * r + i];
+    }
+  }
+
+  memcpy(out, s, AES_BLOCK);
+  crypt0_memzero(s, sizeof(s));
+  crypt0_memzero(t, sizeof(t));
+}
+
+// counter block A_i, flags carry q - 1, the counter takes the last q bytes
+static void ccm_counter(uint8_t ctr[AES_BLOCK], const uint8_t * nonce,
+    int nonce_len, uint32_t i)
+{
+  int q = 15 - nonce_len;
+
+  memset(ctr, 0, AES_BLOCK);
+  ctr[0] = q - 1;
+  memcpy(&ctr[1], nonce, nonce_len);
+  for (int j = 0; j < q && j < 4; j++) {
+    ctr[15 - j] = (uint8_t)(i >> (8 * j));
+  }
+}
+
+static void ccm_mac_update(const aes_ctx * ctx, uint8_t mac[AES_BLOCK],
+    int * used, const uint8_t * data, int len)
+{
+  while (len-- > 0) {
+    mac[(*used)++] ^= *data++;
+    if (*used == AES_BLOCK) {
+      aes_encrypt(ctx, mac, mac);
+      *used = 0;
+    }
+  }
+}
+
+static void ccm_mac_pad(const aes_ctx * ctx, uint8_t mac[AES_BLOCK], int * used)
+{
+  if (*used) {
+    aes_encrypt(ctx, mac, mac);
+    *used = 0;
+  }
+}
+
+// CBC-MAC over B_0, the encoded AAD and the plaintext, encrypted with S_0
+static void ccm_tag(const aes_ctx * ctx, const uint8_t * plaintext, int len,
+    const uint8_t * nonce, int nonce_len, const uint8_t * aad, int aad_len,
+    uint8_t * tag, int tag_len)
+{
+  uint8_t mac[AES_BLOCK];
+  uint8_t s0[AES_BLOCK];
+  uint8_t alen[6];
+  int q = 15 - nonce_len;
+  int used = 0;
+
+  memset(mac, 0, sizeof(mac));
+  mac[0] = (aad_len > 0 ? 0x40 : 0) | (((tag_len - 2) / 2) << 3) | (q - 1);
+  memcpy(&mac[1], nonce, nonce_len);
+  for (int j = 0; j < q && j < 4; j++) {
+    mac[15 - j] = (uint8_t)((uint32_t)len >> (8 * j));
+  }
+  aes_encrypt(ctx, mac, mac);
+
+  if (aad_len > 0) {
+    if (aad_len < 0xff00) {
+      alen[0] = aad_len >> 8;
+      alen[1] = aad_len;
+      ccm_mac_update(ctx, mac, &used, alen, 2);
+    } else {
+      alen[0] = 0xff;
+      alen[1] = 0xfe;
+      alen[2] = (uint32_t)aad_len >> 24;
+      alen[3] = aad_len >> 16;
+      alen[4] = aad_len >> 8;
+      alen[5] = aad_len;
+      ccm_mac_update(ctx, mac, &used, alen, 6);
+    }
+    ccm_mac_update(ctx, mac, &used, aad, aad_len);
+    ccm_mac_pad(ctx, mac, &used);
+  }
+
+  ccm_mac_update(ctx, mac, &used, plaintext, len);
+  ccm_mac_pad(ctx, mac, &used);
+
+  ccm_counter(s0, nonce, nonce_len, 0);
+  aes_encrypt(ctx, s0, s0);
+  for (int i = 0; i < tag_len; i++) {
+    tag[i] = mac[i] ^ s0[i];
+  }
+
+  crypt0_memzero(mac, sizeof(mac));
+  crypt0_memzero(s0, sizeof(s0));
+}
+
+static void ccm_ctr(const aes_ctx * ctx, const uint8_t * in, int len,
+    const uint8_t * nonce, int nonce_len, uint8_t * out)
+{
+  uint8_t ks[AES_BLOCK];
+
+  for (uint32_t i = 1; len > 0; i++) {
+    int n = len < AES_BLOCK ? len : AES_BLOCK;
+    ccm_counter(ks, nonce, nonce_len, i);
+    aes_encrypt(ctx, ks, ks);
+    for (int j = 0; j < n; j++) {
+      out[j] = in[j] ^ ks[j];
+    }
+    in += n;
+    out += n;
+    len -= n;
+  }
+  crypt0_memzero(ks, sizeof(ks));
+}
+
+static int ccm_check_params(int len, int nonce_len, int tag_len)
+{
+  if (nonce_len < 7 || nonce_len > 13) {
+    return -1;
+  }
+  if (tag_len < 4 || tag_len > 16 || (tag_len & 1)) {
+    return -1;
+  }
+  // message length has to fit into q = 15 - nonce_len bytes
+  if (len < 0 || (nonce_len > 11 && (len >> (8 * (15 - nonce_len))) != 0)) {
+    return -1;
+  }
+  return 0;
+}
+
+static int crypt0_encrypt_aes_ccm_portable(
+  const uint8_t *plaintext, int plaintext_len, 
+  const uint8_t *key, int key_len, 
+  const uint8_t *nonce, int nonce_len,
+  const uint8_t *aad, int aad_len,
+  uint8_t *ciphertext, uint8_t *tag, int tag_len)
+{
+  aes_ctx ctx;
+
+  if (ccm_check_params(plaintext_len, nonce_len, tag_len) != 0 ||
+      aes_setkey(&ctx, key, key_len) != 0) {
+    return -1;
+  }
+
+  ccm_tag(&ctx, plaintext, plaintext_len, nonce, nonce_len, aad, aad_len,
+      tag, tag_len);
+  ccm_ctr(&ctx, plaintext, plaintext_len, nonce, nonce_len, ciphertext);
+
+  crypt0_memzero(&ctx, sizeof(ctx));
+  return plaintext_len;
+}
+
+static int crypt0_decrypt_aes_ccm_portable(const uint8_t * ciphertext, int ciphertext_len, 
+                                           const uint8_t * key,   int key_len,
+                                           const uint8_t * nonce, int nonce_len,
+                                           const uint8_t * aad,   int aad_len,
+                                           const uint8_t * tag,   int tag_len,
+                                           uint8_t *plaintext)
+{
+  aes_ctx ctx;
+  uint8_t expected[AES_BLOCK];
+  uint8_t diff = 0;
+
+  if (ccm_check_params(ciphertext_len, nonce_len, tag_len) != 0 ||
+      aes_setkey(&ctx, key, key_len) != 0) {
+    return -1;
+  }
+
+  ccm_ctr(&ctx, ciphertext, ciphertext_len, nonce, nonce_len, plaintext);
+  ccm_tag(&ctx, plaintext, ciphertext_len, nonce, nonce_len, aad, aad_len,
+      expected, tag_len);
+
+  for (int i = 0; i < tag_len; i++) {
+    diff |= expected[i] ^ tag[i];
+  }
+
+  crypt0_memzero(&ctx, sizeof(ctx));
+  crypt0_memzero(expected, sizeof(expected));
+
+  if (diff != 0) {
+    crypt0_memzero(plaintext, ciphertext_len);
+    return -1;
+  }
+  return ciphertext_len;
+}
+
 #endif
 
 int crypt0_encrypt_aes_ccm(const uint8_t *plaintext, int plaintext_len, 
@@ -174,6 +455,9 @@ int crypt0_encrypt_aes_ccm(const uint8_t *plaintext, int plaintext_len,
     // TODO: verify tag
 
     return plaintext_len;
+  #elif !defined(CRYPT0_USE_OPENSSL)
+    return crypt0_encrypt_aes_ccm_portable(plaintext, plaintext_len, key, key_len, 
+           nonce, nonce_len, aad, aad_len, ciphertext, tag, tag_len);
   #else
     return crypt0_encrypt_aes_ccm_openssl(plaintext, plaintext_len, key, key_len, 
            nonce, nonce_len, aad, aad_len, ciphertext, tag, tag_len);
@@ -197,6 +481,9 @@ int crypt0_decrypt_aes_ccm(const uint8_t *ciphertext, int ciphertext_len,
             nonce, nonce_len,
             aad, aad_len);
     return res == 0 ? ciphertext_len : -1;
+  #elif !defined(CRYPT0_USE_OPENSSL)
+    return crypt0_decrypt_aes_ccm_portable(ciphertext, ciphertext_len, key, key_len, 
+           nonce, nonce_len, aad, aad_len, tag, tag_len, plaintext);
   #else
     return crypt0_decrypt_aes_ccm_openssl(ciphertext, ciphertext_len, key, key_len, 
            nonce, nonce_len, aad, aad_len, tag, tag_len, plaintext);
@@ -140,14 +140,9 @@ int crypt0_base58_checksum_hash(const uint8_t * hash, int hashlen, uint8_t prefi
 
 int crypt0_base58_checksum_address(const uint8_t * pub, int publen, uint8_t prefix, char * buf, int buflen)
 {
-	uint8_t sha[32];
 	uint8_t hash160[20];
-	memset(sha, 0, 32);
-	memset(hash160, 0, 20);
-
-	crypt0_sha256(pub, publen, sha, 32);
 
-	crypt0_ripemd160(sha, 32, hash160);
+	crypt0_hash160(pub, publen, hash160);
 
 	return crypt0_base58_checksum_hash(hash160, 20, prefix, buf, buflen);
 
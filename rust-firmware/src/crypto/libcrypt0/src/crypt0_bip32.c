@@ -2,6 +2,7 @@
 
 #include "crypt0_hmac.h"
 #include "crypt0_secp256k1.h"
+#include "crypt0_secp256k1_scalar_impl.h"
 #include "crypt0_bip32.h"
 #include "crypt0_sha.h"
 #include "crypt0_ripemd160.h"
@@ -25,7 +26,8 @@ LOG_MODULE_REGISTER(crypt0_bip32, LOG_LEVEL_DBG);
 #define COIN_ID_NEAR 397
 
 //-----------------------------------------------------------------------------
-int crypt0_bip32_seed_to_account_pubkey(const uint8_t * seed, uint8_t * pubkey, int bip_standard, int coin, int account)
+// extended public key version bytes of a purpose and coin
+static void account_pubkey_version(uint8_t * pubkey, int bip_standard, int coin)
 {
   if (bip_standard - CRYPT0_BIP32_INDEX_HARDENED == 84 || bip_standard == 84) {
     if (coin == COIN_ID_BTC_TEST || coin - CRYPT0_BIP32_INDEX_HARDENED == COIN_ID_BTC_TEST) {
@@ -69,6 +71,12 @@ int crypt0_bip32_seed_to_account_pubkey(const uint8_t * seed, uint8_t * pubkey,
       pubkey[3] = 0x1E;
     }
   }
+}
+
+//-----------------------------------------------------------------------------
+int crypt0_bip32_seed_to_account_pubkey(const uint8_t * seed, uint8_t * pubkey, int bip_standard, int coin, int account)
+{
+  account_pubkey_version(pubkey, bip_standard, coin);
 
   pubkey[4] = 0x03;
 
@@ -87,15 +95,14 @@ int crypt0_bip32_seed_to_account_pubkey(const uint8_t * seed, uint8_t * pubkey,
   crypt0_secp256k1_public_key_compressed(secret, 32, pub, 33);
 
   // get sha256 + ripemd160 of public key
-  uint8_t sha[32];
-  crypt0_sha256(pub, 33, sha, 32);
-  crypt0_ripemd160(sha, 32, pub);
+  uint8_t hash160[CRYPT0_RIPEMD_BYTES];
+  crypt0_hash160(pub, 33, hash160);
 
   // copy first four bytes of a ripemd160
-  pubkey[5] = pub[0];
-  pubkey[6] = pub[1];
-  pubkey[7] = pub[2];
-  pubkey[8] = pub[3];
+  pubkey[5] = hash160[0];
+  pubkey[6] = hash160[1];
+  pubkey[7] = hash160[2];
+  pubkey[8] = hash160[3];
 
   // LOG_HEXDUMP_DBG(pub, 4, "parent fingerprint");
 
@@ -143,16 +150,14 @@ int crypt0_bip32_seed_to_secret_custom(const uint8_t * seed, uint8_t * secret,
 }
 
 //-----------------------------------------------------------------------------
-/**
- * Derives chaincode and private key by index, modifies secret
- * returns CRYPT0_OK on success, negative error code otherwise
- * secret is privkey (32 bytes) and chaincode (32 bytes)
- */
-int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index)
+// child key derivation, pub is the compressed public key of secret when the
+// caller has it, NULL to compute it for a non-hardened index
+static int ckd_priv(uint8_t * secret, uint32_t index, const uint8_t * pub)
 {
   uint8_t payload[64];  
-  uint8_t hmac_src[37];
+  uint8_t parent_pub[CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES];
   uint32_t index_be;
+  crypt0_hmac_sha512_ctx hmac;
 #ifdef __ZEPHYR__
   ocrypto_cp_p256 r;
   ocrypto_cp_p256 n;
@@ -163,24 +168,26 @@ int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index)
   uint32_t p[8];
 #endif
 
+  index_be = crypt0_be32_to_cpu(index);
+  crypt0_hmac_sha512_init(&hmac, &secret[32], 32);
+
   if (index & CRYPT0_BIP32_INDEX_HARDENED) {
 
     // 0x00, private_key (32 bytes), index (4 bytes big endian)
-    hmac_src[0] = 0x00;
-    memcpy(&hmac_src[1], secret, 32);
-    index_be = crypt0_be32_to_cpu(index);
-    memcpy(&hmac_src[33], &index_be, 4);
-
-    // LOG_HEXDUMP_DBG(hmac_src, sizeof(hmac_src), "hmac_src");
-    crypt0_hmac_sha512(&secret[32], 32, hmac_src, 37, payload);
+    crypt0_hmac_sha512_update(&hmac, (const uint8_t *)"\0", 1);
+    crypt0_hmac_sha512_update(&hmac, secret, 32);
 
   } else {
-    index_be = crypt0_be32_to_cpu(index);
-    crypt0_secp256k1_public_key_compressed(secret, 32, hmac_src, CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
-    memcpy(&hmac_src[33], &index_be, 4);
-
-    crypt0_hmac_sha512(&secret[32], 32, hmac_src, 37, payload);
+    // compressed public key (33 bytes), index (4 bytes big endian)
+    if (pub == NULL) {
+      crypt0_secp256k1_public_key_compressed(secret, 32, parent_pub, 
+          CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+      pub = parent_pub;
+    }
+    crypt0_hmac_sha512_update(&hmac, pub, CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
   }
+  crypt0_hmac_sha512_update(&hmac, (const uint8_t *)&index_be, 4);
+  crypt0_hmac_sha512_final(&hmac, payload);
   
   // LOG_HEXDUMP_DBG(payload, 64, "payload");
 
@@ -199,13 +206,50 @@ int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index)
 #endif
 
   memcpy(&secret[32], &payload[32], 32);
+  crypt0_memzero(payload, sizeof(payload));
 
   // LOG_HEXDUMP_DBG(secret, 64, "secret");
   
   return CRYPT0_OK;
 }
 
+/**
+ * Derives chaincode and private key by index, modifies secret
+ * returns CRYPT0_OK on success, negative error code otherwise
+ * secret is privkey (32 bytes) and chaincode (32 bytes)
+ */
+int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index)
+{
+  return ckd_priv(secret, index, NULL);
+}
+
+int crypt0_bip32_derive_secret_index_pub(uint8_t * secret, uint32_t index,
+    const uint8_t * pub)
+{
+  return ckd_priv(secret, index, pub);
+}
+
 //-----------------------------------------------------------------------------
+// SLIP-10 ed25519 child: always the hardened form, the key is the left half
+// of the hmac as is. pub is unused, the signature matches ckd_priv
+static int ckd_ed25519(uint8_t * secret, uint32_t index, const uint8_t * pub)
+{
+  uint32_t index_be;
+  crypt0_hmac_sha512_ctx hmac;
+
+  (void)pub;
+
+  // 0x00, private_key (32 bytes), index (4 bytes big endian)
+  index_be = crypt0_be32_to_cpu(index);
+  crypt0_hmac_sha512_init(&hmac, &secret[32], 32);
+  crypt0_hmac_sha512_update(&hmac, (const uint8_t *)"\0", 1);
+  crypt0_hmac_sha512_update(&hmac, secret, 32);
+  crypt0_hmac_sha512_update(&hmac, (const uint8_t *)&index_be, 4);
+  crypt0_hmac_sha512_final(&hmac, secret);
+
+  return CRYPT0_OK;
+}
+
 /**
  * Derives chaincode and private key by index, modifies secret
  * returns CRYPT0_OK on success, negative error code otherwise
@@ -213,32 +257,320 @@ int crypt0_bip32_derive_secret_index(uint8_t * secret, uint32_t index)
  */
 int crypt0_bip32_derive_secret_index_near(uint8_t * secret, uint32_t index)
 {
-  uint8_t payload[64];  
-  uint8_t hmac_src[37];
-  uint32_t index_be;
+  return ckd_ed25519(secret, index, NULL);
+}
 
-    hmac_src[0] = 0x00;
-    memcpy(&hmac_src[1], secret, 32);
-    index_be = crypt0_be32_to_cpu(index);
-    memcpy(&hmac_src[33], &index_be, 4);
+//-----------------------------------------------------------------------------
+// SLIP-10 curves, one entry per CRYPT0_SLIP10_* with its master key hmac key
+// and child derivation. A curve without public derivation takes hardened
+// indexes only
+
+static const struct {
+  const char * seed_key;
+  int (*ckd)(uint8_t * secret, uint32_t index, const uint8_t * pub);
+  bool hardened_only;
+} m_slip10[] = {
+  [CRYPT0_SLIP10_SECP256K1] = { "Bitcoin seed", ckd_priv, false },
+  [CRYPT0_SLIP10_ED25519]   = { "ed25519 seed", ckd_ed25519, true },
+};
+
+static bool slip10_curve_valid(int curve)
+{
+  return curve >= 0 && curve < (int)(sizeof(m_slip10) / sizeof(m_slip10[0]));
+}
 
-    // LOG_HEXDUMP_DBG(hmac_src, sizeof(hmac_src), "hmac_src");
-    crypt0_hmac_sha512(&secret[32], 32, hmac_src, 37, payload);
+static int slip10_ckd(int curve, uint8_t * secret, uint32_t index, const uint8_t * pub)
+{
+  if (m_slip10[curve].hardened_only && !(index & CRYPT0_BIP32_INDEX_HARDENED)) {
+    LOG_ERR("curve %d: index %u not hardened", curve, (unsigned)index);
+    return CRYPT0_ERR_FMT;
+  }
+  return m_slip10[curve].ckd(secret, index, pub);
+}
 
-  memcpy(secret, payload, 64);
+int crypt0_slip10_seed_to_secret(int curve, const uint8_t * seed, uint8_t * secret)
+{
+  if (!slip10_curve_valid(curve)) {
+    return CRYPT0_ERR_FMT;
+  }
+  return crypt0_bip32_seed_to_secret_custom(seed, secret, m_slip10[curve].seed_key);
+}
 
-    // LOG_HEXDUMP_DBG(secret, 64, "secret");
-  
-  return CRYPT0_OK;
+int crypt0_slip10_derive_secret_index(int curve, uint8_t * secret, uint32_t index)
+{
+  if (!slip10_curve_valid(curve)) {
+    return CRYPT0_ERR_FMT;
+  }
+  return slip10_ckd(curve, secret, index, NULL);
 }
 
 //-----------------------------------------------------------------------------
+static uint32_t path_index(const uint8_t * path, int level)
+{
+  const uint8_t * p = path + 1 + 4 * level;
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
 /**
- * Derives chaincode and private key by index, modifies secret
- * returns secret length on success, negative error code otherwise
+ * Derives chaincode and private key of a binary path, modifies secret
+ * returns CRYPT0_OK on success, negative error code otherwise
  */
+int crypt0_slip10_derive_secret_path(int curve, uint8_t * secret, const uint8_t * path)
+{
+  if (!slip10_curve_valid(curve)) {
+    return CRYPT0_ERR_FMT;
+  }
+  if (path[0] > CRYPT0_BIP32_MAX_DEPTH) {
+    LOG_ERR("path depth %d, max %d", path[0], CRYPT0_BIP32_MAX_DEPTH);
+    return CRYPT0_ERR_FMT;
+  }
+  for (int level = 0; level < path[0]; level++) {
+    int ret = slip10_ckd(curve, secret, path_index(path, level), NULL);
+    if (ret != CRYPT0_OK) {
+      return ret;
+    }
+  }
+  return CRYPT0_OK;
+}
+
 int crypt0_bip32_derive_secret_path(uint8_t * secret, const uint8_t * path)
 {
-  return CRYPT0_ERR_NOT_IMPLEMENTED;
+  return crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_SECP256K1, secret, path);
 }
 
+//-----------------------------------------------------------------------------
+int crypt0_bip32_path_from_string(const char * str, uint8_t * path, size_t pathlen)
+{
+  int depth = 0;
+
+  if (*str == 'm') {
+    str++;
+  }
+  while (*str == '/') {
+    str++;
+    if (depth == CRYPT0_BIP32_MAX_DEPTH || pathlen < CRYPT0_BIP32_PATH_BYTES(depth + 1)) {
+      LOG_ERR("path deeper than %d or buffer", depth);
+      return CRYPT0_ERR_FMT;
+    }
+    if (*str < '0' || *str > '9') {
+      return CRYPT0_ERR_FMT;
+    }
+    uint32_t index = 0;
+    for (; *str >= '0' && *str <= '9'; str++) {
+      uint32_t digit = *str - '0';
+      // check before the multiply, a wrapped index would be another key
+      if (index > (CRYPT0_BIP32_INDEX_HARDENED - 1 - digit) / 10) {
+        return CRYPT0_ERR_FMT;
+      }
+      index = index * 10 + digit;
+    }
+    if (*str == '\'' || *str == 'h' || *str == 'H') {
+      index |= CRYPT0_BIP32_INDEX_HARDENED;
+      str++;
+    }
+    uint8_t * p = path + CRYPT0_BIP32_PATH_BYTES(depth);
+    p[0] = index >> 24; p[1] = index >> 16; p[2] = index >> 8; p[3] = index;
+    depth++;
+  }
+  if (*str != '\0' || pathlen < 1) {
+    return CRYPT0_ERR_FMT;
+  }
+  path[0] = depth;
+  return CRYPT0_BIP32_PATH_BYTES(depth);
+}
+
+//-----------------------------------------------------------------------------
+// Derivation cursor
+
+int crypt0_slip10_cursor_init(crypt0_bip32_cursor * cursor, int curve, const uint8_t * seed)
+{
+  crypt0_memzero(cursor, sizeof(*cursor));
+  if (!slip10_curve_valid(curve)) {
+    return CRYPT0_ERR_FMT;
+  }
+  cursor->curve = curve;
+  return crypt0_slip10_seed_to_secret(curve, seed, cursor->node[0]);
+}
+
+int crypt0_bip32_cursor_init(crypt0_bip32_cursor * cursor, const uint8_t * seed)
+{
+  return crypt0_slip10_cursor_init(cursor, CRYPT0_SLIP10_SECP256K1, seed);
+}
+
+void crypt0_bip32_cursor_wipe(crypt0_bip32_cursor * cursor)
+{
+  crypt0_memzero(cursor, sizeof(*cursor));
+}
+
+// compressed public key of a node, computed once
+static const uint8_t * cursor_pub(crypt0_bip32_cursor * cursor, int level)
+{
+  if (!(cursor->pub_ready & (1u << level))) {
+    crypt0_secp256k1_public_key_compressed(cursor->node[level], 32, cursor->pub[level],
+        CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+    cursor->pub_ready |= 1u << level;
+  }
+  return cursor->pub[level];
+}
+
+int crypt0_bip32_cursor_derive(crypt0_bip32_cursor * cursor, const uint8_t * path,
+    uint8_t * secret)
+{
+  int depth = path[0];
+  int level = 0;
+
+  if (depth > CRYPT0_BIP32_MAX_DEPTH) {
+    LOG_ERR("path depth %d, max %d", depth, CRYPT0_BIP32_MAX_DEPTH);
+    return CRYPT0_ERR_FMT;
+  }
+
+  // deepest node shared with the previous path, deeper ones stay until a
+  // different child replaces them
+  while (level < depth && level < cursor->depth && 
+      cursor->index[level] == path_index(path, level)) {
+    level++;
+  }
+  if (level < depth) {
+    cursor->depth = level;
+    cursor->pub_ready &= (1u << (level + 1)) - 1;
+  }
+
+  for (; level < depth; level++) {
+    uint32_t index = path_index(path, level);
+    const uint8_t * pub = NULL;
+
+    if (cursor->curve == CRYPT0_SLIP10_SECP256K1 && !(index & CRYPT0_BIP32_INDEX_HARDENED)) {
+      pub = cursor_pub(cursor, level);
+    }
+    memcpy(cursor->node[level + 1], cursor->node[level], 64);
+    int ret = slip10_ckd(cursor->curve, cursor->node[level + 1], index, pub);
+    if (ret != CRYPT0_OK) {
+      return ret;
+    }
+    cursor->index[level] = index;
+    cursor->depth = level + 1;
+  }
+
+  memcpy(secret, cursor->node[depth], 64);
+  return CRYPT0_OK;
+}
+
+int crypt0_bip32_cursor_account_pubkey(crypt0_bip32_cursor * cursor, uint8_t * pubkey,
+    int bip_standard, int coin, int account)
+{
+  uint8_t path[CRYPT0_BIP32_PATH_BYTES(3)] = { 3 };
+  uint8_t secret[CRYPT0_BIP32_SECRET_BYTES];
+  const uint32_t indexes[3] = { bip_standard, coin, account };
+
+  if (cursor->curve != CRYPT0_SLIP10_SECP256K1) {
+    return CRYPT0_ERR_FMT;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    uint8_t * p = path + CRYPT0_BIP32_PATH_BYTES(i);
+    p[0] = indexes[i] >> 24; p[1] = indexes[i] >> 16; p[2] = indexes[i] >> 8; p[3] = indexes[i];
+  }
+  int ret = crypt0_bip32_cursor_derive(cursor, path, secret);
+  crypt0_memzero(secret, sizeof(secret));
+  if (ret != CRYPT0_OK) {
+    return ret;
+  }
+
+  account_pubkey_version(pubkey, bip_standard, coin);
+  pubkey[4] = 0x03;
+
+  // parent fingerprint, the first four bytes of hash160 of the coin key
+  uint8_t hash160[CRYPT0_RIPEMD_BYTES];
+  crypt0_hash160(cursor_pub(cursor, 2), 33, hash160);
+  memcpy(&pubkey[5], hash160, 4);
+
+  pubkey[9] = (account >> 24) & 0xFF;
+  pubkey[10] = (account >> 16) & 0xFF;
+  pubkey[11] = (account >> 8) & 0xFF;
+  pubkey[12] = account & 0xFF;
+
+  memcpy(&pubkey[13], &cursor->node[3][32], 32);
+  memcpy(&pubkey[45], cursor_pub(cursor, 3), 33);
+
+  return 79;
+}
+
+//-----------------------------------------------------------------------------
+// public derivation, pubnode is the compressed public key then the chain code
+
+int crypt0_bip32_secret_to_pubnode(const uint8_t * secret, uint8_t * pubnode)
+{
+  memcpy(&pubnode[33], &secret[32], 32);
+  return crypt0_secp256k1_public_key_compressed(secret, 32, pubnode, 
+      CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+}
+
+void crypt0_bip32_pubnode_from_xpub(const uint8_t * xpub, uint8_t * pubnode)
+{
+  memcpy(pubnode, &xpub[45], 33);
+  memcpy(&pubnode[33], &xpub[13], 32);
+}
+
+// hmac(chain code, pub | index), hmac keyed with the parent chain code
+static void ckd_pub_payload(const crypt0_hmac_sha512_ctx * keyed, const uint8_t * pub,
+    uint32_t index, uint8_t * payload)
+{
+  crypt0_hmac_sha512_ctx hmac;
+  uint32_t index_be = crypt0_be32_to_cpu(index);
+
+  crypt0_hmac_sha512_clone(&hmac, keyed);
+  crypt0_hmac_sha512_update(&hmac, pub, CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+  crypt0_hmac_sha512_update(&hmac, (const uint8_t *)&index_be, 4);
+  crypt0_hmac_sha512_final(&hmac, payload);
+}
+
+int crypt0_bip32_ckd_pub(const uint8_t * parent, uint32_t index, uint8_t * child)
+{
+  uint8_t payload[64];
+  uint8_t scratch[CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(1)];
+  crypt0_hmac_sha512_ctx keyed;
+
+  if (index & CRYPT0_BIP32_INDEX_HARDENED) {
+    return CRYPT0_ERR_FMT;
+  }
+  crypt0_hmac_sha512_init(&keyed, &parent[33], 32);
+  ckd_pub_payload(&keyed, parent, index, payload);
+
+  int ret = crypt0_secp256k1_pubkey_tweak_add_batch(parent, payload, 1, child,
+      scratch, sizeof(scratch));
+  memcpy(&child[33], &payload[32], 32);
+  return ret > 0 ? CRYPT0_ERR_IMPORT_KEY : ret;
+}
+
+const size_t crypt0_bip32_ckd_pub_chunk_scratch_bytes =
+  CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(CRYPT0_BIP32_CKD_PUB_CHUNK);
+
+int crypt0_bip32_ckd_pub_batch(const uint8_t * parent, uint32_t first, size_t n,
+    uint8_t * pubs, void * scratch, size_t scratchlen)
+{
+  uint8_t payload[64];
+  crypt0_hmac_sha512_ctx keyed;
+
+  if (n == 0) {
+    return CRYPT0_OK;
+  }
+  if (((first + n - 1) & CRYPT0_BIP32_INDEX_HARDENED) || first + n - 1 < first) {
+    return CRYPT0_ERR_FMT;
+  }
+  if (scratch == NULL || scratchlen < CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(n)) {
+    LOG_ERR("ckd pub scratch %d bytes, need %d", (int)scratchlen,
+        (int)CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(n));
+    return CRYPT0_ERR_OUTBUF_LEN;
+  }
+
+  // the tweaks at the start of scratch, the point batch after them
+  uint8_t * tweaks = scratch;
+  crypt0_hmac_sha512_init(&keyed, &parent[33], 32);
+  for (size_t i = 0; i < n; i++) {
+    ckd_pub_payload(&keyed, parent, first + i, payload);
+    memcpy(&tweaks[32 * i], payload, 32);
+  }
+
+  return crypt0_secp256k1_pubkey_tweak_add_batch(parent, tweaks, n, pubs,
+      tweaks + 32 * n, scratchlen - 32 * n);
+}
@@ -18,6 +18,136 @@ LOG_MODULE_REGISTER(crypt0_bip39, LOG_LEVEL_DBG);
 
 #define CRYPT0_BIP39_MNEMONIC_WORDS 2048
 
+typedef struct {
+  uint32_t letters;     // next letters, bit i for 'a' + i, CRYPT0_BIP39_WORD_COMPLETE
+  uint16_t first;       // first word with the prefix
+  uint16_t child;       // node of the prefix and its lowest next letter
+} bip39_trie_node;
+
+#include "crypt0_bip39_lookup.h"
+
+//-----------------------------------------------------------------------------
+// Word lookup: words by their 4 letter key through the perfect hash, prefixes
+// of up to 3 letters through the trie, see crypt0_bip39_lookup.h
+
+static uint32_t bip39_fmix(uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+// index of the only word whose first 4 letters are those of word, len >= 4
+static int bip39_key_index(const char * word)
+{
+  uint32_t key = (uint32_t)(uint8_t)word[0] | (uint32_t)(uint8_t)word[1] << 8 |
+    (uint32_t)(uint8_t)word[2] << 16 | (uint32_t)(uint8_t)word[3] << 24;
+  uint32_t seed = m_mph_seeds[bip39_fmix(key) >> (32 - BIP39_MPH_BUCKET_BITS)];
+  int index = m_mph_slots[bip39_fmix(key ^ (seed * 0x9e3779b9)) >> 21];
+
+  // any key lands on some slot, only the word's own prefix is the word
+  if (strncmp(crypt0_bip39_english[index], word, 4) != 0) {
+    return CRYPT0_ERR_FMT;
+  }
+  return index;
+}
+
+int crypt0_bip39_word_index(const char * word, size_t len)
+{
+  if (word == NULL || len < 3 || len > 8) {
+    return CRYPT0_ERR_FMT;
+  }
+
+  char key[4] = { word[0], word[1], word[2], len > 3 ? word[3] : 0 };
+  int index = bip39_key_index(key);
+  if (index < 0 || strlen(crypt0_bip39_english[index]) != len ||
+      memcmp(crypt0_bip39_english[index], word, len) != 0) {
+    return CRYPT0_ERR_FMT;
+  }
+  return index;
+}
+
+uint32_t crypt0_bip39_next_letters(const char * prefix, size_t len,
+    uint16_t * first, uint16_t * count)
+{
+  uint32_t letters = 0;
+  uint16_t start = 0, n = 0;
+
+  if (prefix != NULL && len >= 4) {
+    int index = len <= 8 ? bip39_key_index(prefix) : CRYPT0_ERR_FMT;
+    const char * word = index >= 0 ? crypt0_bip39_english[index] : "";
+    size_t wordlen = strlen(word);
+    if (index >= 0 && len <= wordlen && memcmp(word, prefix, len) == 0) {
+      letters = len == wordlen ? CRYPT0_BIP39_WORD_COMPLETE : 1u << (word[len] - 'a');
+      start = index;
+      n = 1;
+    }
+  } else if (prefix != NULL || len == 0) {
+    int node = 0;
+    size_t depth = 0;
+    for (; depth < len; depth++) {
+      uint32_t c = (uint8_t)prefix[depth] - 'a';
+      if (c >= 26 || !(m_trie[node].letters & (1u << c))) {
+        break;
+      }
+      node = m_trie[node].child + __builtin_popcount(m_trie[node].letters & ((1u << c) - 1));
+    }
+    if (depth == len) {
+      // words are sorted, the range ends where the next prefix of this length starts
+      letters = m_trie[node].letters;
+      start = m_trie[node].first;
+      n = (node + 1 < m_trie_levels[depth + 1] ? m_trie[node + 1].first :
+          CRYPT0_BIP39_MNEMONIC_WORDS) - start;
+    }
+  }
+
+  if (first != NULL) {
+    *first = start;
+  }
+  if (count != NULL) {
+    *count = n;
+  }
+  return letters;
+}
+
+// ASCII whitespace, a pasted mnemonic may come with tabs and line breaks
+static bool bip39_is_space(uint8_t c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+int crypt0_bip39_mnemonic_to_indexes(const uint8_t * mnemonic, uint16_t mnemonic_len,
+    uint16_t * indexes, uint16_t max_words)
+{
+  int words = 0;
+
+  for (size_t i = 0; i < mnemonic_len; ) {
+    if (bip39_is_space(mnemonic[i])) {
+      i++;
+      continue;
+    }
+    size_t len = 0;
+    while (i + len < mnemonic_len && !bip39_is_space(mnemonic[i + len])) {
+      len++;
+    }
+    int index = crypt0_bip39_word_index((const char *)&mnemonic[i], len);
+    if (index < 0) {
+      LOG_ERR("word %d is not in the list", words + 1);
+      return CRYPT0_ERR_FMT;
+    }
+    if (words == max_words) {
+      LOG_ERR("more than %d words", (int)max_words);
+      return CRYPT0_ERR_OUTBUF_LEN;
+    }
+    indexes[words++] = (uint16_t)index;
+    i += len;
+  }
+  return words;
+}
+
 //-----------------------------------------------------------------------------
 /** 
  * Converts entropy to mnemonic english
@@ -94,6 +224,13 @@ int crypt0_bip39_mnemonic_to_seed(const uint8_t * mnemonic,
   return ret;
 }
 
+int crypt0_bip39_mnemonic_to_seed_init(crypt0_pbkdf2_ctx * ctx,
+    const uint8_t * mnemonic, uint16_t mnemonic_len)
+{
+  return crypt0_pbkdf2_init(ctx, CRYPT0_PBKDF2_HMAC_SHA512, 2048,
+      mnemonic, mnemonic_len, (unsigned char *)"mnemonic", strlen("mnemonic"));
+}
+
 bool crypt0_bip39_ton_mnemonic_to_entropy(const uint8_t *mnemonic, uint16_t mnemonic_len, uint8_t *entropy, uint16_t entropy_len) {
   if (!mnemonic || !entropy) {
     return false;
@@ -205,6 +342,14 @@ int crypt0_ton_entropy_to_seed(const uint8_t *entropy, uint16_t entropy_len, uin
   return ret;
 }
 
+int crypt0_ton_entropy_to_seed_init(crypt0_pbkdf2_ctx * ctx,
+    const uint8_t * entropy, uint16_t entropy_len)
+{
+  if (!entropy || entropy_len != 64) return CRYPT0_ERR_FMT;
+  return crypt0_pbkdf2_init(ctx, CRYPT0_PBKDF2_HMAC_SHA512, 100000, entropy,
+      entropy_len, (unsigned char *)"TON default seed", strlen("TON default seed"));
+}
+
 int crypt0_ton_mnemonic_to_seed(const uint8_t *mnemonic_str, uint16_t mnemonic_len, uint8_t *seed_out, uint32_t seed_len) {
     if (!mnemonic_str || !seed_out || seed_len != 64) {
         LOG_ERR("Invalid input parameters");
@@ -239,88 +384,23 @@ int crypt0_ton_mnemonic_to_seed(const uint8_t *mnemonic_str, uint16_t mnemonic_l
 //   return ret;
 // }
 
-// bool crypt0_bip39_mnemonic_to_entropy(const uint8_t *mnemonic, uint16_t mnemonic_len,
-//   uint8_t *entropy, uint16_t entropy_len) {
-//   if (!mnemonic || !entropy) {
-//     return false;
-//   }
-
-//   // Convert input buffer to null-terminated string for word parsing
-//   char mnemonic_str[256];
-//   if (mnemonic_len >= sizeof(mnemonic_str)) {
-//     LOG_ERR("mnemonic too long");
-//     return false;
-//   }
-//   memcpy(mnemonic_str, mnemonic, mnemonic_len);
-//   mnemonic_str[mnemonic_len] = '\0';
-
-//   // Split mnemonic string into words
-//   char *words[24] = {0};
-//   int word_count = 0;
-//   char *token = strtok(mnemonic_str, " ");
-//   while (token && word_count < 24) {
-//     words[word_count++] = token;
-//     token = strtok(NULL, " ");
-//   }
-
-//   if (word_count != 12 && word_count != 18 && word_count != 24) {
-//     LOG_ERR("unsupported word count: %d", word_count);
-//     return false;
-//   }
-//   LOG_DBG("word count: %d", word_count);
-
-//   // Check expected entropy length
-//   uint16_t expected_entropy_len = (word_count * 11) / 33 * 4;
-//   if (entropy_len != expected_entropy_len) {
-//     LOG_ERR("unexpected entropy len: %d, expected: %d", entropy_len, expected_entropy_len);
-//     return false;
-//   }
-
-//   // Convert words to indices
-//   uint16_t indices[24] = {0};
-//   for (int i = 0; i < word_count; i++) {
-//     int idx = bip39_get_word_index(words[i]);
-//     if (idx < 0) {
-//       LOG_ERR("invalid word: %s", words[i]);
-//       return false;
-//     }
-//     indices[i] = (uint16_t)idx;
-//   }
-
-//   // Pack indices into bitstream
-//   uint8_t bitstream[33] = {0};  // max 24*11=264 bits
-//   int bit_pos = 0;
-//   for (int i = 0; i < word_count; i++) {
-//     for (int j = 10; j >= 0; j--) {
-//       if ((indices[i] >> j) & 1) {
-//         bitstream[bit_pos / 8] |= 1 << (7 - (bit_pos % 8));
-//       }
-//       bit_pos++;
-//     }
-//   }
-
-//   // Extract entropy and checksum
-//   memcpy(entropy, bitstream, entropy_len);
-//   int checksum_bits = word_count * 11 - entropy_len * 8;
-
-//   // Calculate SHA-256 of entropy
-//   uint8_t hash[32];
-//   crypt0_sha256(entropy, entropy_len, hash, sizeof(hash));
-
-//   // Compare checksums
-//   uint8_t expected_checksum = hash[0] >> (8 - checksum_bits);
-//   uint8_t actual_checksum = bitstream[entropy_len] >> (8 - checksum_bits);
-
-//   if (expected_checksum != actual_checksum) {
-//     LOG_ERR("checksum mismatch: got %02x, expected %02x",
-//             actual_checksum, expected_checksum);
-//     return false;
-//   }
-
-//   return true;
-// }
+bool crypt0_bip39_mnemonic_en_to_entropy(const uint8_t * mnemonic, uint16_t mnemonic_len,
+    uint8_t * entropy, uint16_t entropy_len)
+{
+  uint16_t indexes[24];
 
+  if (mnemonic == NULL || entropy == NULL) {
+    return false;
+  }
+  int words = crypt0_bip39_mnemonic_to_indexes(mnemonic, mnemonic_len, indexes, 24);
+  if (words < 0) {
+    return false;
+  }
+  bool ret = crypt0_bip39_mnemonic_to_entropy(indexes, words, entropy, entropy_len);
 
+  crypt0_memzero(indexes, sizeof(indexes));
+  return ret;
+}
 
 // // convert mnemonic provided as array of words indexes to entropy
 // bool crypt0_bip39_mnemonic_to_entropy(
@@ -0,0 +1,1567 @@
+#ifndef __crypt0_bip39_lookup_h_included__
+#define __crypt0_bip39_lookup_h_included__
+
+//-----------------------------------------------------------------------------
+// Lookup tables of crypt0_bip39.c over crypt0_bip39_english, generated by
+// tools/gen_bip39_lookup.py, do not edit. The key of a word is its first 4
+// letters (unique in the list, shorter words padded with zeros) packed little
+// endian in a uint32_t.
+//
+// Minimal perfect hash: key -> bucket of BIP39_MPH_BUCKET_BITS bits, the
+// bucket seed -> one of 2048 slots, the slot -> word index. 5 KB.
+//
+// Prefix trie of every prefix up to 3 letters, level by level in list order:
+// letters bit i for 'a' + i (bit 26 if the prefix is a word itself), the
+// first word with the prefix, the first child node. 10 KB.
+
+#define BIP39_MPH_BUCKET_BITS 9
+
+static const uint16_t m_mph_seeds[1 << BIP39_MPH_BUCKET_BITS] = {
+     10,    71,    62,    21,     6,   114,    14,   278,     4,    29,    17,     2,
+      4,    53,     8,    60,     6,    14,    94,     3,    20,     8,    27,    19,
+      7,     0,    31,    31,    60,    52,     4,    22,    86,    68,    81,   114,
+    200,    56,     2,    11,    49,   215,    18,   431,   281,    14,     3,    66,
+     36,     7,     7,     8,   302,     7,    92,    41,    24,    55,    32,     1,
+      1,     1,    13,     7,    16,    17,    55,     1,    31,     3,     9,   168,
+     51,     3,    74,     2,     1,     1,    40,     4,    65,    39,    12,     1,
+    326,     8,    46,    85,    26,     3,    25,    10,     4,    35,   335,     0,
+      4,    19,     1,    57,    46,    17,   618,     5,     4,    31,     1,    32,
+      2,   289,    78,    50,    46,     2,    62,    18,    15,     5,    32,    73,
+      1,    31,     7,   187,    38,     9,    72,   323,    22,    20,     5,     1,
+     27,     3,     3,    12,     3,    85,     0,     5,     8,     7,     1,    89,
+      7,     3,   116,    32,    42,    36,    41,    17,    18,    18,     4,   102,
+    102,   235,     9,     2,   553,   169,     5,    74,     2,   248,    36,   188,
+    105,    63,    12,    97,     6,    26,     7,     9,   174,    40,     1,   294,
+      1,    88,    31,   111,     2,    11,   157,    66,     5,    18,    26,    81,
+    182,    12,     0,     2,    12,    99,     1,    23,   122,    19,     4,   219,
+     16,     2,    40,    40,    17,    29,   451,    67,   115,     1,   254,     8,
+    671,   224,   524,    96,    73,   149,   119,     8,    48,   142,     0,     7,
+      5,     8,   134,   339,   119,   110,   781,    24,     1,     0,    52,   304,
+     69,     9,     3,    89,     6,   444,    19,   117,     8,   218,     1,    42,
+      1,     2,    74,    42,    31,     1,   110,   728,    22,    80,    10,     3,
+     16,     2,   317,     1,     9,     6,   204,     5,   181,    20,   209,    33,
+     57,     1,   193,   179,    18,     5,   265,   287,     2,   445,   108,   307,
+    350,   434,   278,     3,   860,     2,     4,    94,   316,   146,   402,   711,
+    395,     0,     3,    10,    64,     4,   654,    26,   262,    11,    66,    88,
+    140,   110,   250,     1,   112,   184,   878,     8,    65,    79,   136,    39,
+    234,    74,    98,    13,    54,    75,     0,     1,   200,    33,   140,     0,
+    394,    10,     1,    15,    19,   214,   408,  1249,     4,  1278,     6,    75,
+     21,   113,    77,   475,   173,    64,   837,     2,   148,   152,     1,    27,
+      0,    10,   441,   608,    24,   432,  1281,    23,    10,   295,    93,    10,
+     28,     2,    32,   258,     1,   495,  1461,   358,     7,   725,    48,     2,
+     15,   388,     9,    16,     7,  1541,    21,   417,     8,    14,    69,   401,
+    126,    60,    17,     5,   420,   489,     8,    67,    86,     1,   416,    16,
+     18,    69,   324,    11,    54,    15,   360,   491,     1,     1,   209,   458,
+      8,    12,   147,    11,   148,     1,    42,     3,     0,   240,   253,    15,
+     41,   136,     1,   207,     8,    13,     9,    52,     0,   260,    22,   222,
+    473,     2,   167,   945,  1242,     1,   349,   775,   106,   405,  4383,   203,
+      2,     1,   976,    36,    19,  1773,  1388,   861,    50,    43,   168,   812,
+   2137,     2,   309,    54,     6,     6,   105,   528,   209,     6,  1208,   246,
+    845,     5,   673,   107,   408,  2119,     4,   420,    37,   110,     0,    21,
+      1,   112,  1669,   115,   271,  3247,     6,  1278,   929,   181,     9,    66,
+     35,    11,   542,   249,   581,    55,   456,     1,
+};
+
+static const uint16_t m_mph_slots[2048] = {
+  1684, 1731,  800, 1032,  178,   79, 1652, 1902,  618, 1303, 1280,  574,
+  1715,   13,  931,  318,  376,    4, 1376, 1810,  811, 1586,  534, 1357,
+  1288, 1366,  520, 1060,   64,  768, 1428, 1844, 1055, 1988, 1379, 1007,
+  1263, 1991,  131,  853,  882, 1903, 1283,  682,  267, 1506,  702,  832,
+  1897,  117,  208,  714, 1317, 1608, 1242,  498,  591,  371,  468,  628,
+  1773, 1721, 1122,  721,  876,  828,  820, 1365, 1885,  306,  918,  236,
+  1683, 1214,  246,  715,  111,   62,  424,   84, 1287, 1966,  818,   97,
+   767, 1298, 1345, 1235, 1801, 1679, 1210, 1008, 1021,  583,  545, 1005,
+  1177, 1437, 1026,  315, 1887, 1782, 1420, 1067,  115,  473, 1609, 1713,
+   971, 1853, 1898, 1396,  884, 1565, 1982, 1716, 1848,  124, 1682, 2037,
+   879, 1975, 1685,  109, 1559, 1606, 1277, 1547,  410,  863,  262,  872,
+   699, 1785, 1967, 2001, 1023,  757,  957,  553,  868,  996,  310,  580,
+   329, 1398, 1000, 2000, 1162,  543, 1271, 1075, 2036, 1697, 1958, 1752,
+  1459, 1980,  336, 1378,  578, 1292, 1849, 1758, 1323,  132, 1363,  251,
+   167, 1674,  288,  782,  608, 1628,   90,  307,  654,  904, 1295,  442,
+    57,   45, 1203,   94,  599, 1699,  529,   88,  558,  825, 1519, 1240,
+  2045,  293,  297,  305, 1281,  759,  206,  781, 1503,  110,   89,  581,
+  2038,  989,  712, 1855, 1553,  995, 1290, 1012, 1728, 1383, 1719,  496,
+  1069, 1424,  475,  334, 1528,   67, 1521, 1673, 1276,   92, 1927,  500,
+   285, 2016, 1960,  420,   33, 1526, 1843,  127, 1094,  984,  619, 1409,
+  1675,  656, 1222, 1680,  798, 1180,    6, 1754,  950, 1913,  755,  784,
+   927,   51,  515, 1212, 1489, 1399,  338,  386, 1657,  570,  507,  175,
+  1076,   75,  162,  992, 1494,  461, 1469, 1751,    2,  766,  148,  105,
+   511,  947,   59,  195,  569, 1866,  821,  270, 1527, 1343, 1706, 1542,
+  1102, 1003,  661, 1090, 1722,  398,  504,  447, 1650, 1143, 1013,  660,
+  1524, 1587,  209, 1678, 1475,  356,  810, 1247,  808,  347,  953, 1596,
+   138,  538,  841, 1933,  629,  867,  830, 1671,   27, 1963, 1134,  335,
+  1056, 1703, 1355,   72, 1837,  430,  223,  769, 1818,  723,  916,  269,
+   911, 1808, 1744, 1585, 1924, 1560, 1756, 1867, 1805,  353,  753, 1875,
+   550, 1354, 1140,   46, 1776,  994, 1949,  177, 1799, 1034, 1829,  488,
+   717,  118,  963, 1951,  277, 1889, 1995, 1145, 1236, 1858, 1962,  802,
+   623,  551,  324, 1880, 1440,  590, 2030,  674,  150,  316, 1786, 2018,
+   404,  388,  303,  774,  158, 1149, 2008, 1798,  906, 1828,  790,  411,
+  1111, 1215, 1311, 1822, 1813,  824, 1442, 1540, 1759, 1169, 1098,   18,
+   284, 1040, 1300,  990,  280, 1467, 1052, 1064,  390,   73, 1466, 1636,
+   200,  683,  357, 1806, 1445, 1088, 1696, 1857,  156,  454, 1655, 1950,
+  1299,  720, 1601,   40, 1668, 1859, 1575, 1274,   26,  972, 1654,   10,
+  1275,  154,   63,  345,  254, 1202, 1181, 1484,  734,  155, 1422, 2023,
+  1666,  752, 1191, 1388, 1241, 1783,  481, 1635, 1256, 2035,  880, 1395,
+   144,  556, 1482, 1983,  955,  403,   53,  644,  311, 1820,  856, 1640,
+   340,  460, 1807, 2004, 1780, 1599,   96, 1382, 1726,  560, 1272, 1460,
+  1170,  685, 1634,  459, 1130, 1081, 1904, 1142, 1330,  426, 1809, 1485,
+   615, 1293,  793, 1107,  969, 2005,  233,  968,  220,  613, 1767,  946,
+   983, 1286, 1876,    0, 1997,  625,  328,  589,  205, 1057,  705, 1688,
+  1253,  837,  875, 1116,  387,  241, 1154,  917,  414, 1421,  804, 1906,
+   883,  194,  326,  981,  806, 1690,  857, 2028,  827,   41,   58, 1380,
+   740,  171,   43,  762, 1160,  341, 1662, 1568,  552, 1905, 1491, 1830,
+  1937,  677,  651, 1496,  603, 1979, 1790, 1901, 2011, 1955,  632, 1507,
+  1580,    8,  479,  477, 1520, 2015, 1110,  149,   25,  368,  745,  408,
+   998,  777,  239, 1549,  486,  854, 1126,  225, 1112, 1551,  153,  756,
+  1745,  364, 1394, 1788,  547, 1431, 1734, 1304, 1198,  770,  598,  394,
+  1463, 1243,  462, 1042, 2002,  322,   22,  566, 1375, 1800,  710, 1676,
+  1916, 1563, 1846, 1103, 1312, 1471, 1653, 1024,  869, 1244,  235, 1765,
+  1265,  692, 1318,  791, 1619,  275, 1131, 1766, 1079, 1479,  490, 1614,
+  1778, 1341,  489,  549, 1538, 1689,  183, 1163, 1099,    5, 1497, 1119,
+   125,  362, 1502,  182, 1425, 1986,  813,  210, 1161, 1124,   69,  469,
+    32,  889, 1095, 1361, 1865,  999,  283, 1186,  133,  763,  843,  170,
+   639, 1724,  609, 1306,  815,  240, 1536,  122,  878,  417, 1220, 1135,
+  1185, 1831, 1006,  610,  601,  100,  567,  836,  627, 1146, 1511, 1385,
+  1443, 1749,   34, 1307, 1188,  640,   77,  258,  213, 1358,  129, 1739,
+   397,  330,   87, 1531, 1404,  261, 1232, 1725, 1984,  126, 1727,  743,
+   238, 1523, 2024,  532, 1393, 1327,  866,  226,  814,  234, 1630,  436,
+   159, 2032, 1498,  218, 1761,  915, 1672,  772,  130,  145,  365, 1969,
+  1908, 1566,  686, 1998,  152,  901,  179,  624,  180, 1620,  975, 1468,
+   633,  431, 1555, 1548, 1746, 1258,  514, 1326,  892, 1622,  266, 1917,
+   350, 1625, 1842, 1797,  582,  202, 1087, 1711,  959,  327,  695, 1670,
+  1803, 1351,  384,  655, 1063,  286, 1011, 1850, 1735, 1871, 1691, 1171,
+   513,  174, 1384, 1935,   15,  681,  317,  921,  747,   36,  713,  593,
+   186, 1651,  926, 1101, 1750,  928, 1010, 1248,  301, 1994, 1753, 2009,
+  1254,   12,  313,  764, 1301, 1250, 1492, 1464,   23, 1237, 1050, 1372,
+  1589,  332, 1259,  224,  351, 1221, 1930, 1432,  112,  634,  531, 1804,
+    66,  716, 1787, 1544,  196, 1709, 1200, 1066, 1611,  678,  687,  564,
+  1061,  688, 1147,  744, 1763,  405,  665,  423,   17,  844,  803, 1642,
+   858, 1535, 1037,  265,  237, 1710, 1921,  309,  709,  165,  670,  142,
+   874,  456,   74,  419, 1707, 1661, 1562,  204, 1592, 1836,  339, 1058,
+  1436, 1137,  510, 1218,  850, 1434,  212,  941, 1329,  616,  897, 1584,
+  1176,  642, 1847, 1082,  185,  557,  899,  700, 1132,  817, 1238,   71,
+   785,  219, 1537,  847,  643,  505, 1433, 1072, 1618, 1415,  736,  652,
+   166,  982,  690,  703,  506, 1647,   61,   37, 1825,  891,  933,  427,
+   263,  586, 1481, 1321,  748, 1091,  203,  274,  993, 1452, 1408,  727,
+   272,  761, 1285,  730,  696, 2027,  881, 1811,  106, 1617, 1794,  287,
+  1025, 1249, 1035, 1781,  949, 1992,  977, 1309, 1593, 1941, 1971,   24,
+  1607,    1, 1932, 1233, 1764, 1297, 1448,   11,  924, 1631,    9, 1030,
+   786, 1127,  587,  650, 1884,  898,  450, 1925,   21, 1266,  400, 1129,
+  1539, 1217,  302, 1120,  698, 2017,  101,  673,  914, 1477, 1364,  184,
+  1370, 1028,  216,  965, 1114, 1826,  885, 1743, 1138,  415, 2046, 1403,
+   173,   20,  114,  120, 1175, 1269, 1694, 1970, 1771, 1159, 1701,  671,
+  1532,  851, 1546, 1578,   48, 1487, 1458, 1961,  242,  215,  794, 1623,
+   539,  706,  375, 1626, 1513,  503,  516, 1074,  672, 1342,  278, 1796,
+  1965,  606,  855, 1187,  887,  958,    7, 1051, 1954,  409,   35, 1918,
+   925, 1923, 1123, 1556, 1838, 1430, 1255,  537, 1178, 1478, 1392, 1097,
+  1262, 1643, 1033, 1581, 2039, 1450, 1268,  169, 1861,   56, 1337,  401,
+   970, 2021, 1260, 1314,  296,  249,  392,  907, 1500,  396, 1183,  812,
+   349, 1860,  344,  222, 1197,  102,  746, 1205,  873,  487, 1331, 1977,
+   343,  711, 1835,  779, 1557,  576, 1868,  718,  492, 1895, 1505,  458,
+    60,  446, 1039,  412,  250, 1027, 1943, 1158,  912,  738,  380, 1772,
+   659, 1172, 1883, 1851,  367, 1646,   91, 1041, 1952, 1043,  735,  951,
+  1083,  252,  852,  402, 1449, 1802,  724,  605,  548,  641,  860,  559,
+   568,  980,  829,  822,   50, 1230,  259,  859, 1359, 1779, 1125, 1319,
+   792, 1423, 1334, 1273, 1762,  939,  870,  563,  797, 1912, 1914,  636,
+  1839, 1228, 1667, 1571,  819, 1572,  530, 1136, 1638, 1096, 1418, 1712,
+  1570,  522, 1981, 1369, 1336, 1381, 1204,  524,  988,  630, 2010, 1956,
+   232, 1104, 1720,  750,   31, 1009, 1514,  689, 1931, 1148, 1387,  584,
+  1852,  382, 1757, 1278, 1873,  894, 1121, 1001, 1579, 1166,  775, 1582,
+   314,  865,  157, 1926,   99, 1515, 1004, 1048, 1845, 2041,  579,  113,
+  1441,   49,  135,  467,  905, 1942, 1627,  536,   55,  773, 1613,  299,
+   512, 1864,  737, 1368, 1816, 1014, 1649,  571,  448,  795, 1015, 1427,
+   742,  731, 1597,  840, 1741, 1435, 1944,  585, 1328, 1302, 1564, 1569,
+   363,  658, 1190, 1377, 1552, 1070,  877,  913, 1105, 2020,  719,  541,
+  1402,  485,   44,   16,  434, 1543,  595, 1717, 1602, 1036,  325, 1823,
+  1985, 1959,  662,   98, 1665,  944, 1768, 1493, 1412, 1223, 1473,  535,
+   494,  355,  562,  331, 1907, 1893, 2044, 1910,  495,  366, 1648, 1257,
+   666,  861,  230,  391,  464,  943, 1915, 2014,  528,  268, 1019,  527,
+  1194, 1660,  577, 1401,  319,  940,  964, 1353, 1461,   70,  509,   95,
+   521,  457, 1017, 1740, 1957, 1389,  256,  228, 1879,  244,  935, 1718,
+  1305,  176,  991,  645, 1891,  638, 1356,  137,  198, 1106, 1216, 1501,
+   197, 1139, 1226, 1929, 1414, 1577,  575,  809,  960, 2022, 2006, 1270,
+   160,  732, 1495,  799,  432, 1692,  201, 1196,   81, 1267, 1574, 1686,
+  1390,  903,  834,   29, 1419, 1558,  227, 2013,  701,  385,  839, 1157,
+   544, 1687,   86,  348,  607, 1062,  116, 1938, 1890, 1698, 1600,   68,
+  1109,  693, 1533,  962,   38, 1224,  890,  979, 1791, 1182,  937,  499,
+  1663, 1530, 1705, 1604,  932,  491,  592, 1325,   93, 1841,  663, 1073,
+  1737,  526,  664,  621, 1702,  653,  728, 1583,  189, 1637,  474,  361,
+  1410, 1071, 1229, 1819, 1934, 1386,  783, 1038,  668, 1022,  787, 1714,
+    42,  207,   78, 1046,  378,  967,  945,  243,  221,  842, 1545, 1621,
+   938, 1681,  604, 1279,  217,  722, 1629,  778, 1936,  919,   30, 1486,
+  1208,  377, 2012, 1206, 1047, 1246,   47, 1953,  470,  697,  956,  193,
+   379,  518, 1978, 1451, 1338, 1150, 1349, 1470, 1201,  358, 1141, 1020,
+  1747,  805, 1976, 1065, 1504, 1769, 2031,  896,  437, 1053,  121, 1439,
+  1031, 1049, 1211, 1854, 1632,  438,  399,  484,  119,  452, 1872, 1144,
+   554, 1827, 2040, 1308,  801,  140,  320,  359, 2042, 1151,  525, 1335,
+   594,  888,  134,   83,  838,   85,  308,  631,  502,   65, 1456,  136,
+  1374, 1576,  555,  300,  986,  765, 1207,  729, 1118, 1989, 1940, 1616,
+  1362,  649, 1996,  749,  771, 1899, 1296,  895, 1817, 1633,  517,  760,
+   273,   14, 1777, 1639,  501,  187, 1462, 1195,  323,  936, 1824, 1928,
+   276,  406, 1261,  449, 1465,  974, 1605,  508,  523,  107,  381,  451,
+  1152, 1193,  987,  667, 1472, 1603, 1573,  289,  741, 1723, 1733, 1284,
+  2025, 1518,  428,   19, 1795, 1192, 2003, 1946, 1133,  370,  751, 1156,
+   418, 1367, 1184, 1656,  966,  708, 1878, 1113,  846, 1999,  168, 1447,
+  1881, 1264,  546, 1541,  465, 1892, 1490,  161, 1108,  248,  104, 1407,
+   542,  413, 1610,  445, 1645, 1117, 1332,  128,   28,  271, 1044,  954,
+   147, 1529,  669, 1219,  245,  816, 1078, 1400, 1406,  930, 2019,  934,
+   978, 1093,  143,  321, 1760, 2026, 1509, 1888, 1922, 1347,  561,  694,
+  1832,  369, 1453, 1658,  676, 1561, 1213,  796,  151, 1863,  373,  264,
+   637,  422,  758, 1870, 1729, 1821,  190, 1086, 1736,  920,  922, 1165,
+   354, 1488,  997, 1155, 1209,  519, 1554, 1522,  823, 1054, 1840, 1068,
+   684, 1225, 1029, 1708,  181, 1919, 1784,  279,  739,  929,  680, 1324,
+   360,  942,  985, 1320, 1730, 1426,  733, 1174,  788, 1894, 2033, 1199,
+   255, 1239,  292, 1322, 1128,  478, 1920,  163, 1429, 1590, 1693,  776,
+  1624, 1615,  483,  346,  849,  453, 1588,  433,    3,  389, 1909, 1483,
+   253,  648, 1350, 1480,  443,  900,  910,  572, 1413, 1397, 1291, 1774,
+  1251,  281,  304,   76,  231,  472, 1534, 1100,  455, 1738,  923, 1085,
+   588, 1939,  617, 1089,  429, 1856,  565,  614,  976,  103, 1045, 1189,
+   416, 1153, 1339, 1510,  192, 1227,  342,  291,  646, 1525,  294,  675,
+  1815,  164, 1644,  612, 1373,  596, 1315,  372, 1333, 1755,  260,  172,
+  2029, 1945,  679, 1310,  886,  600, 1252, 1968, 1360, 1775,   82,  191,
+   835, 1173,  444, 1391,  826,  726,  707, 1231,  333, 1704,  611, 1834,
+   211, 1313,  435,  620,  948,  780,  439, 1567, 1695, 1664, 1059, 1512,
+   493,  312, 1793,  657, 1993, 1948, 1245,  139, 1348, 1168,  626,  961,
+  1869,  704, 1454, 1900,   54,  973, 1179,  831,  199,  108, 1016,  647,
+  2043, 1792, 1417,   80,  635,  807, 1371, 1964, 1457,  476, 2047, 1002,
+  1164, 1862, 1077, 1474,  440,  540,  282, 1659,  622, 1499, 1092,  871,
+  1591, 1770,  290,  482,  597, 1669,  480,  862,  395, 2007, 1340,  146,
+  1444, 1748,  229, 1289,  421, 1595, 1700, 1294, 1732, 1886, 1990, 1789,
+   573, 1080,  789, 1018, 1167,  602,  298,  845,  141, 1344,  725, 1352,
+   497,  754, 1282, 1405,  833,  848,  952, 1234, 1612, 1598, 1476, 1877,
+  1833,   39,  374, 1814,  471, 1346, 1742,  463, 1911, 1987,  864,  466,
+  1896, 1947, 1550, 1115,  441,  123, 1411,  337, 2034, 1974,  393,  247,
+  1972,  257,  533,  893, 1973, 1446,  902, 1517, 1594, 1416,  691,  425,
+   352,   52, 1316,  383, 1641,  909,  188, 1084, 1455, 1874, 1516, 1508,
+   908, 1812,  407, 1882, 1677,  214,  295, 1438,
+};
+
+// first node of each prefix length 0..3, then the node count
+static const uint16_t m_trie_levels[5] = { 0, 1, 26, 226, 1322 };
+
+static const bip39_trie_node m_trie[1322] = {
+  { 0x37fffff,    0,    1 },
+  { 0x0feb9fe,    0,   26 },
+  { 0x0124911,  136,   45 },
+  { 0x1124991,  253,   52 },
+  { 0x1524111,  439,   61 },
+  { 0x1afb96d,  551,   69 },
+  { 0x0124911,  651,   86 },
+  { 0x1124991,  757,   93 },
+  { 0x1104111,  833,  102 },
+  { 0x02e384c,  897,  108 },
+  { 0x0104011,  952,  118 },
+  { 0x0002111,  972,  122 },
+  { 0x1104111,  992,  126 },
+  { 0x1104111, 1068,  132 },
+  { 0x0104111, 1173,  138 },
+  { 0x3febd2f, 1214,  143 },
+  { 0x1124991, 1269,  163 },
+  { 0x0100000, 1401,  172 },
+  { 0x0104191, 1409,  173 },
+  { 0x159fd95, 1517,  179 },
+  { 0x1524191, 1767,  195 },
+  { 0x00eb040, 1888,  204 },
+  { 0x0004111, 1923,  211 },
+  { 0x0024191, 1969,  215 },
+  { 0x0004011, 2038,  221 },
+  { 0x0004010, 2044,  224 },
+  { 0x0144901,    0,  226 },
+  { 0x00b4184,   10,  232 },
+  { 0x0301209,   24,  239 },
+  { 0x0020000,   33,  245 },
+  { 0x0020020,   34,  246 },
+  { 0x0020011,   37,  248 },
+  { 0x0000010,   41,  251 },
+  { 0x0061000,   42,  252 },
+  { 0x04ed917,   46,  255 },
+  { 0x0104001,   61,  268 },
+  { 0x18c6545,   66,  271 },
+  { 0x002c001,   82,  282 },
+  { 0x00a5054,   88,  286 },
+  { 0x00c8400,  106,  293 },
+  { 0x0084080,  113,  297 },
+  { 0x008204c,  119,  300 },
+  { 0x0004010,  126,  305 },
+  { 0x0000431,  129,  307 },
+  { 0x0000100,  135,  311 },
+  { 0x00e384e,  136,  312 },
+  { 0x10c28f5,  155,  322 },
+  { 0x00a640c,  175,  333 },
+  { 0x0104111,  183,  340 },
+  { 0x19e7109,  197,  345 },
+  { 0x0104111,  214,  357 },
+  { 0x30e292a,  234,  362 },
+  { 0x03ebc46,  253,  373 },
+  { 0x0023900,  295,  386 },
+  { 0x0124111,  302,  391 },
+  { 0x02a2040,  327,  397 },
+  { 0x0104111,  333,  402 },
+  { 0x13ef92d,  357,  407 },
+  { 0x1104111,  398,  423 },
+  { 0x00e8802,  427,  429 },
+  { 0x0000004,  438,  435 },
+  { 0x1563008,  439,  436 },
+  { 0x02eb877,  449,  444 },
+  { 0x2262875,  487,  458 },
+  { 0x0347844,  514,  469 },
+  { 0x1104111,  527,  478 },
+  { 0x00e3004,  542,  484 },
+  { 0x0000001,  549,  490 },
+  { 0x0002000,  550,  491 },
+  { 0x0060040,  551,  492 },
+  { 0x0004080,  559,  495 },
+  { 0x0100140,  562,  497 },
+  { 0x0000020,  565,  500 },
+  { 0x0000040,  566,  501 },
+  { 0x0080040,  567,  502 },
+  { 0x004011a,  569,  504 },
+  { 0x000c012,  578,  509 },
+  { 0x02e4af9,  586,  513 },
+  { 0x0000100,  607,  526 },
+  { 0x0100000,  608,  527 },
+  { 0x0124001,  610,  528 },
+  { 0x00c0004,  616,  532 },
+  { 0x0000090,  620,  535 },
+  { 0x0004100,  622,  537 },
+  { 0x008c195,  626,  539 },
+  { 0x0000010,  649,  547 },
+  { 0x03e390e,  651,  548 },
+  { 0x06c301b,  673,  560 },
+  { 0x08e2856,  685,  570 },
+  { 0x1104111,  705,  580 },
+  { 0x0964945,  720,  586 },
+  { 0x0104111,  739,  596 },
+  { 0x00a2010,  751,  601 },
+  { 0x21e9908,  757,  605 },
+  { 0x0042000,  774,  615 },
+  { 0x0004000,  780,  617 },
+  { 0x0222061,  781,  618 },
+  { 0x0104101,  788,  624 },
+  { 0x0664809,  800,  628 },
+  { 0x0104111,  810,  636 },
+  { 0x0002111,  826,  641 },
+  { 0x0001000,  832,  645 },
+  { 0x26ab902,  833,  646 },
+  { 0x0022909,  848,  657 },
+  { 0x006a848,  859,  663 },
+  { 0x03ef806,  866,  670 },
+  { 0x0063042,  884,  682 },
+  { 0x0000002,  896,  688 },
+  { 0x0004010,  897,  689 },
+  { 0x0000810,  899,  691 },
+  { 0x0002000,  902,  693 },
+  { 0x0000800,  903,  694 },
+  { 0x0009101,  906,  695 },
+  { 0x02db3ac,  914,  699 },
+  { 0x0004000,  946,  712 },
+  { 0x0044800,  947,  713 },
+  { 0x0000010,  950,  716 },
+  { 0x0004000,  951,  717 },
+  { 0x2020044,  952,  718 },
+  { 0x0400801,  956,  722 },
+  { 0x1100502,  960,  725 },
+  { 0x0043108,  965,  730 },
+  { 0x0002000,  972,  735 },
+  { 0x1080010,  973,  736 },
+  { 0x04c200c,  977,  739 },
+  { 0x0004110,  988,  745 },
+  { 0x37ab40a,  992,  748 },
+  { 0x02c7165, 1012,  761 },
+  { 0x22d7467, 1030,  772 },
+  { 0x1386047, 1047,  786 },
+  { 0x0803044, 1061,  796 },
+  { 0x0020000, 1067,  801 },
+  { 0x28eb74c, 1068,  802 },
+  { 0x00e380d, 1101,  816 },
+  { 0x0863808, 1122,  825 },
+  { 0x03e700a, 1139,  832 },
+  { 0x00c0824, 1160,  842 },
+  { 0x00c0000, 1170,  847 },
+  { 0x00e9100, 1173,  849 },
+  { 0x0fe8155, 1180,  855 },
+  { 0x0000044, 1195,  868 },
+  { 0x06e5102, 1197,  870 },
+  { 0x00a1004, 1210,  879 },
+  { 0x0000400, 1214,  883 },
+  { 0x02c0a10, 1215,  884 },
+  { 0x0080014, 1222,  890 },
+  { 0x0004000, 1225,  893 },
+  { 0x0080020, 1226,  894 },
+  { 0x0000800, 1230,  896 },
+  { 0x0000001, 1231,  897 },
+  { 0x1000108, 1232,  898 },
+  { 0x0000100, 1235,  901 },
+  { 0x0000914, 1236,  902 },
+  { 0x0088110, 1241,  906 },
+  { 0x000814f, 1246,  910 },
+  { 0x0080000, 1255,  917 },
+  { 0x0000080, 1256,  918 },
+  { 0x0080000, 1257,  919 },
+  { 0x0000011, 1261,  920 },
+  { 0x0002000, 1264,  922 },
+  { 0x1000000, 1266,  923 },
+  { 0x0040000, 1267,  924 },
+  { 0x0004000, 1268,  925 },
+  { 0x13ea94c, 1269,  926 },
+  { 0x00ae801, 1294,  939 },
+  { 0x1024000, 1308,  946 },
+  { 0x20ce855, 1312,  949 },
+  { 0x0100011, 1326,  960 },
+  { 0x06ee910, 1336,  963 },
+  { 0x0004111, 1355,  974 },
+  { 0x20eb80a, 1384,  978 },
+  { 0x0020000, 1400,  988 },
+  { 0x0004111, 1401,  989 },
+  { 0x26ab90e, 1409,  993 },
+  { 0x07dfa6f, 1430, 1006 },
+  { 0x1000000, 1478, 1024 },
+  { 0x02ce06e, 1479, 1025 },
+  { 0x11c5007, 1495, 1036 },
+  { 0x002284a, 1510, 1045 },
+  { 0x1383928, 1517, 1051 },
+  { 0x0024191, 1536, 1061 },
+  { 0x02e3855, 1551, 1067 },
+  { 0x1124111, 1574, 1078 },
+  { 0x28e385e, 1597, 1085 },
+  { 0x0100111, 1616, 1098 },
+  { 0x0104111, 1623, 1102 },
+  { 0x0004101, 1635, 1107 },
+  { 0x0004101, 1640, 1110 },
+  { 0x012782d, 1645, 1113 },
+  { 0x1024991, 1666, 1123 },
+  { 0x0100000, 1691, 1131 },
+  { 0x1124111, 1694, 1132 },
+  { 0x006b16e, 1727, 1139 },
+  { 0x0004111, 1752, 1150 },
+  { 0x0061000, 1763, 1154 },
+  { 0x08ea946, 1767, 1157 },
+  { 0x0862801, 1780, 1168 },
+  { 0x0124111, 1790, 1174 },
+  { 0x00eb84c, 1805, 1180 },
+  { 0x15ef55b, 1816, 1190 },
+  { 0x1104111, 1844, 1207 },
+  { 0x0023102, 1872, 1213 },
+  { 0x0004110, 1880, 1218 },
+  { 0x0008000, 1886, 1221 },
+  { 0x0000800, 1888, 1222 },
+  { 0x0000002, 1889, 1223 },
+  { 0x0380dad, 1890, 1224 },
+  { 0x004c0c8, 1908, 1235 },
+  { 0x0000042, 1914, 1241 },
+  { 0x0100011, 1916, 1243 },
+  { 0x0000100, 1922, 1246 },
+  { 0x016a844, 1923, 1247 },
+  { 0x00e2880, 1935, 1255 },
+  { 0x02e681f, 1946, 1261 },
+  { 0x1080904, 1962, 1273 },
+  { 0x12e2940, 1969, 1278 },
+  { 0x00c091b, 1985, 1287 },
+  { 0x0000111, 1997, 1295 },
+  { 0x00e2828, 2005, 1298 },
+  { 0x0027800, 2022, 1305 },
+  { 0x0004111, 2032, 1310 },
+  { 0x0020000, 2038, 1314 },
+  { 0x0000801, 2039, 1315 },
+  { 0x0100000, 2041, 1317 },
+  { 0x0020002, 2044, 1318 },
+  { 0x0006000, 2046, 1320 },
+  { 0x0002000,    0,    0 },
+  { 0x0000800,    1,    0 },
+  { 0x0000010,    2,    0 },
+  { 0x0300000,    3,    0 },
+  { 0x0184010,    5,    0 },
+  { 0x0040000,    9,    0 },
+  { 0x0104110,   10,    0 },
+  { 0x0000100,   14,    0 },
+  { 0x0000008,   15,    0 },
+  { 0x0100000,   16,    0 },
+  { 0x0100000,   17,    0 },
+  { 0x0004000,   18,    0 },
+  { 0x4124100,   19,    0 },
+  { 0x0008000,   24,    0 },
+  { 0x4020100,   25,    0 },
+  { 0x0100000,   28,    0 },
+  { 0x0000100,   29,    0 },
+  { 0x0000800,   30,    0 },
+  { 0x0000101,   31,    0 },
+  { 0x0004000,   33,    0 },
+  { 0x0004001,   34,    0 },
+  { 0x0000001,   36,    0 },
+  { 0x0000100,   37,    0 },
+  { 0x4002000,   38,    0 },
+  { 0x0000010,   40,    0 },
+  { 0x0000001,   41,    0 },
+  { 0x4000000,   42,    0 },
+  { 0x4008000,   43,    0 },
+  { 0x0000800,   45,    0 },
+  { 0x0020000,   46,    0 },
+  { 0x0100000,   47,    0 },
+  { 0x0004000,   48,    0 },
+  { 0x0020000,   49,    0 },
+  { 0x0000010,   50,    0 },
+  { 0x4004010,   51,    0 },
+  { 0x0004000,   54,    0 },
+  { 0x0002000,   55,    0 },
+  { 0x0000080,   56,    0 },
+  { 0x0000010,   57,    0 },
+  { 0x0004000,   58,    0 },
+  { 0x0000010,   59,    0 },
+  { 0x0000001,   60,    0 },
+  { 0x2080000,   61,    0 },
+  { 0x0102000,   63,    0 },
+  { 0x0040000,   65,    0 },
+  { 0x0000800,   66,    0 },
+  { 0x0000180,   67,    0 },
+  { 0x0020810,   69,    0 },
+  { 0x0001000,   72,    0 },
+  { 0x0000800,   73,    0 },
+  { 0x0104000,   74,    0 },
+  { 0x0080000,   76,    0 },
+  { 0x0400000,   77,    0 },
+  { 0x0000110,   78,    0 },
+  { 0x0000100,   80,    0 },
+  { 0x4000000,   81,    0 },
+  { 0x0020000,   82,    0 },
+  { 0x0000800,   83,    0 },
+  { 0x0020810,   84,    0 },
+  { 0x0000100,   87,    0 },
+  { 0x0080080,   88,    0 },
+  { 0x0002001,   90,    0 },
+  { 0x0100000,   92,    0 },
+  { 0x5004010,   93,    0 },
+  { 0x0100000,   97,    0 },
+  { 0x0004111,   98,    0 },
+  { 0x4400110,  102,    0 },
+  { 0x4000000,  106,    0 },
+  { 0x0000010,  107,    0 },
+  { 0x0100111,  108,    0 },
+  { 0x0000080,  112,    0 },
+  { 0x0000800,  113,    0 },
+  { 0x0001000,  114,    0 },
+  { 0x0020111,  115,    0 },
+  { 0x0080000,  119,    0 },
+  { 0x0000100,  120,    0 },
+  { 0x0100000,  121,    0 },
+  { 0x0080000,  122,    0 },
+  { 0x0104080,  123,    0 },
+  { 0x0020000,  126,    0 },
+  { 0x0000104,  127,    0 },
+  { 0x1020400,  129,    0 },
+  { 0x0040000,  132,    0 },
+  { 0x0100000,  133,    0 },
+  { 0x0400000,  134,    0 },
+  { 0x0040000,  135,    0 },
+  { 0x1000000,  136,    0 },
+  { 0x0004080,  137,    0 },
+  { 0x0000040,  139,    0 },
+  { 0x4000000,  140,    0 },
+  { 0x0000805,  141,    0 },
+  { 0x0000002,  144,    0 },
+  { 0x0002001,  145,    0 },
+  { 0x4020050,  147,    0 },
+  { 0x0000510,  151,    0 },
+  { 0x0080000,  154,    0 },
+  { 0x0102004,  155,    0 },
+  { 0x0004001,  158,    0 },
+  { 0x0000020,  160,    0 },
+  { 0x0004000,  161,    0 },
+  { 0x0000100,  162,    0 },
+  { 0x0000101,  163,    0 },
+  { 0x0084100,  165,    0 },
+  { 0x0000014,  168,    0 },
+  { 0x0080000,  170,    0 },
+  { 0x04a0000,  171,    0 },
+  { 0x0004000,  174,    0 },
+  { 0x1000000,  175,    0 },
+  { 0x4000000,  176,    0 },
+  { 0x0000010,  177,    0 },
+  { 0x0000008,  178,    0 },
+  { 0x0000800,  179,    0 },
+  { 0x0080008,  180,    0 },
+  { 0x0080000,  182,    0 },
+  { 0x004300c,  183,    0 },
+  { 0x0040001,  188,    0 },
+  { 0x0002000,  190,    0 },
+  { 0x0144000,  191,    0 },
+  { 0x0060010,  194,    0 },
+  { 0x00a0000,  197,    0 },
+  { 0x1000000,  199,    0 },
+  { 0x0000800,  200,    0 },
+  { 0x0000002,  201,    0 },
+  { 0x0100010,  202,    0 },
+  { 0x0040400,  204,    0 },
+  { 0x0020108,  206,    0 },
+  { 0x0040000,  209,    0 },
+  { 0x0080000,  210,    0 },
+  { 0x0002000,  211,    0 },
+  { 0x4000000,  212,    0 },
+  { 0x4000000,  213,    0 },
+  { 0x0242104,  214,    0 },
+  { 0x0000011,  219,    0 },
+  { 0x004205c,  221,    0 },
+  { 0x0486404,  227,    0 },
+  { 0x0040000,  233,    0 },
+  { 0x0000002,  234,    0 },
+  { 0x0000048,  235,    0 },
+  { 0x0000020,  237,    0 },
+  { 0x0000800,  238,    0 },
+  { 0x0000c02,  239,    0 },
+  { 0x0000408,  242,    0 },
+  { 0x0040048,  244,    0 },
+  { 0x5000100,  247,    0 },
+  { 0x0080000,  250,    0 },
+  { 0x0000010,  251,    0 },
+  { 0x2000000,  252,    0 },
+  { 0x0000902,  253,    0 },
+  { 0x0080000,  256,    0 },
+  { 0x0000010,  257,    0 },
+  { 0x0000010,  258,    0 },
+  { 0x0001800,  259,    0 },
+  { 0x0008010,  261,    0 },
+  { 0x520600d,  263,    0 },
+  { 0x0080101,  271,    0 },
+  { 0x40a804a,  274,    0 },
+  { 0x0180190,  281,    0 },
+  { 0x4080015,  286,    0 },
+  { 0x00c0040,  291,    0 },
+  { 0x0000010,  294,    0 },
+  { 0x0000800,  295,    0 },
+  { 0x0000010,  296,    0 },
+  { 0x0000010,  297,    0 },
+  { 0x00c0000,  298,    0 },
+  { 0x0080010,  300,    0 },
+  { 0x00ef900,  302,    0 },
+  { 0x0060035,  311,    0 },
+  { 0x0001814,  317,    0 },
+  { 0x0004100,  321,    0 },
+  { 0x0004000,  323,    0 },
+  { 0x0022004,  324,    0 },
+  { 0x0000001,  327,    0 },
+  { 0x0002000,  328,    0 },
+  { 0x0000004,  329,    0 },
+  { 0x1000100,  330,    0 },
+  { 0x0000100,  332,    0 },
+  { 0x1428100,  333,    0 },
+  { 0x0220001,  338,    0 },
+  { 0x000b034,  341,    0 },
+  { 0x05c0044,  347,    0 },
+  { 0x00c1002,  353,    0 },
+  { 0x0040004,  357,    0 },
+  { 0x0004000,  359,    0 },
+  { 0x0000010,  360,    0 },
+  { 0x0000020,  361,    0 },
+  { 0x0002800,  362,    0 },
+  { 0x0104800,  364,    0 },
+  { 0x0009132,  367,    0 },
+  { 0x02c206c,  373,    0 },
+  { 0x0000c00,  381,    0 },
+  { 0x1008000,  383,    0 },
+  { 0x0022011,  385,    0 },
+  { 0x0080000,  389,    0 },
+  { 0x0080000,  390,    0 },
+  { 0x006a004,  391,    0 },
+  { 0x0000010,  396,    0 },
+  { 0x0004000,  397,    0 },
+  { 0x24c302c,  398,    0 },
+  { 0x0400019,  407,    0 },
+  { 0x00c1004,  411,    0 },
+  { 0x0548000,  415,    0 },
+  { 0x0043114,  419,    0 },
+  { 0x4040000,  425,    0 },
+  { 0x0000010,  427,    0 },
+  { 0x0080000,  428,    0 },
+  { 0x4000002,  429,    0 },
+  { 0x02a0100,  431,    0 },
+  { 0x0080080,  435,    0 },
+  { 0x0000010,  437,    0 },
+  { 0x0000800,  438,    0 },
+  { 0x4000000,  439,    0 },
+  { 0x0008001,  440,    0 },
+  { 0x0000044,  442,    0 },
+  { 0x0000100,  444,    0 },
+  { 0x0000080,  445,    0 },
+  { 0x0000040,  446,    0 },
+  { 0x0002000,  447,    0 },
+  { 0x4000000,  448,    0 },
+  { 0x0000800,  449,    0 },
+  { 0x0020001,  450,    0 },
+  { 0x0024911,  452,    0 },
+  { 0x0020000,  458,    0 },
+  { 0x1000110,  459,    0 },
+  { 0x0020000,  462,    0 },
+  { 0x0000101,  463,    0 },
+  { 0x0000101,  465,    0 },
+  { 0x1080100,  467,    0 },
+  { 0x0184011,  470,    0 },
+  { 0x0000100,  475,    0 },
+  { 0x0088514,  476,    0 },
+  { 0x0000011,  482,    0 },
+  { 0x0004110,  484,    0 },
+  { 0x0021840,  487,    0 },
+  { 0x0000010,  491,    0 },
+  { 0x00c0000,  492,    0 },
+  { 0x0000020,  494,    0 },
+  { 0x0002100,  495,    0 },
+  { 0x0000010,  497,    0 },
+  { 0x0006000,  498,    0 },
+  { 0x0080010,  500,    0 },
+  { 0x008d095,  502,    0 },
+  { 0x0004110,  510,    0 },
+  { 0x2000000,  513,    0 },
+  { 0x0180000,  514,    0 },
+  { 0x4000000,  516,    0 },
+  { 0x0008800,  517,    0 },
+  { 0x0000001,  519,    0 },
+  { 0x0004401,  520,    0 },
+  { 0x0020000,  523,    0 },
+  { 0x0000010,  524,    0 },
+  { 0x0000002,  525,    0 },
+  { 0x0000010,  526,    0 },
+  { 0x0441060,  527,    0 },
+  { 0x0040001,  532,    0 },
+  { 0x020a820,  534,    0 },
+  { 0x0008000,  539,    0 },
+  { 0x0001000,  540,    0 },
+  { 0x4000000,  541,    0 },
+  { 0x0000400,  542,    0 },
+  { 0x0000002,  543,    0 },
+  { 0x0000010,  544,    0 },
+  { 0x0000100,  545,    0 },
+  { 0x0080000,  546,    0 },
+  { 0x1000004,  547,    0 },
+  { 0x0020000,  549,    0 },
+  { 0x0000001,  550,    0 },
+  { 0x0000810,  551,    0 },
+  { 0x0082800,  553,    0 },
+  { 0x1080100,  556,    0 },
+  { 0x0004000,  559,    0 },
+  { 0x0002800,  560,    0 },
+  { 0x0000010,  562,    0 },
+  { 0x0080000,  563,    0 },
+  { 0x0000004,  564,    0 },
+  { 0x0004000,  565,    0 },
+  { 0x4000000,  566,    0 },
+  { 0x0000080,  567,    0 },
+  { 0x0000080,  568,    0 },
+  { 0x0004000,  569,    0 },
+  { 0x0000010,  570,    0 },
+  { 0x0209044,  571,    0 },
+  { 0x0080000,  576,    0 },
+  { 0x0000010,  577,    0 },
+  { 0x0024001,  578,    0 },
+  { 0x0020000,  581,    0 },
+  { 0x0080000,  582,    0 },
+  { 0x0084800,  583,    0 },
+  { 0x0000006,  586,    0 },
+  { 0x4004800,  588,    0 },
+  { 0x0021000,  591,    0 },
+  { 0x0004000,  593,    0 },
+  { 0x0000101,  594,    0 },
+  { 0x0000001,  596,    0 },
+  { 0x0004000,  597,    0 },
+  { 0x0000100,  598,    0 },
+  { 0x0100000,  599,    0 },
+  { 0x0004100,  600,    0 },
+  { 0x0100000,  602,    0 },
+  { 0x0020110,  603,    0 },
+  { 0x0000010,  606,    0 },
+  { 0x0040000,  607,    0 },
+  { 0x0000101,  608,    0 },
+  { 0x4040000,  610,    0 },
+  { 0x0040008,  612,    0 },
+  { 0x0004000,  614,    0 },
+  { 0x0008000,  615,    0 },
+  { 0x0000001,  616,    0 },
+  { 0x0000011,  617,    0 },
+  { 0x0000001,  619,    0 },
+  { 0x0020000,  620,    0 },
+  { 0x0000100,  621,    0 },
+  { 0x0000808,  622,    0 },
+  { 0x0000c00,  624,    0 },
+  { 0x0001004,  626,    0 },
+  { 0x0100990,  628,    0 },
+  { 0x0020004,  633,    0 },
+  { 0x0000101,  635,    0 },
+  { 0x00c0800,  637,    0 },
+  { 0x0080000,  640,    0 },
+  { 0x0024911,  641,    0 },
+  { 0x0020010,  647,    0 },
+  { 0x4000002,  649,    0 },
+  { 0x0020000,  651,    0 },
+  { 0x0100010,  652,    0 },
+  { 0x0000010,  654,    0 },
+  { 0x0082000,  655,    0 },
+  { 0x0040800,  657,    0 },
+  { 0x0004110,  659,    0 },
+  { 0x4080004,  662,    0 },
+  { 0x0001000,  665,    0 },
+  { 0x0000080,  666,    0 },
+  { 0x4000181,  667,    0 },
+  { 0x0000800,  671,    0 },
+  { 0x0004000,  672,    0 },
+  { 0x0080000,  673,    0 },
+  { 0x0020000,  674,    0 },
+  { 0x0000010,  675,    0 },
+  { 0x4000808,  676,    0 },
+  { 0x0000001,  679,    0 },
+  { 0x0000004,  680,    0 },
+  { 0x0080000,  681,    0 },
+  { 0x0000004,  682,    0 },
+  { 0x0000010,  683,    0 },
+  { 0x4000000,  684,    0 },
+  { 0x0000010,  685,    0 },
+  { 0x0080000,  686,    0 },
+  { 0x0000800,  687,    0 },
+  { 0x0100000,  688,    0 },
+  { 0x0081010,  689,    0 },
+  { 0x0000159,  692,    0 },
+  { 0x0041010,  697,    0 },
+  { 0x0000084,  700,    0 },
+  { 0x4002000,  702,    0 },
+  { 0x4000000,  704,    0 },
+  { 0x02c1040,  705,    0 },
+  { 0x0000010,  710,    0 },
+  { 0x0008040,  711,    0 },
+  { 0x0404005,  713,    0 },
+  { 0x0040100,  717,    0 },
+  { 0x4000000,  719,    0 },
+  { 0x0001000,  720,    0 },
+  { 0x0100000,  721,    0 },
+  { 0x4000000,  722,    0 },
+  { 0x0000800,  723,    0 },
+  { 0x0000808,  724,    0 },
+  { 0x0080008,  726,    0 },
+  { 0x0580454,  728,    0 },
+  { 0x00c0000,  735,    0 },
+  { 0x0002000,  737,    0 },
+  { 0x4000000,  738,    0 },
+  { 0x0001040,  739,    0 },
+  { 0x0050000,  741,    0 },
+  { 0x0002010,  743,    0 },
+  { 0x2442040,  745,    0 },
+  { 0x0000100,  750,    0 },
+  { 0x0000800,  751,    0 },
+  { 0x4002000,  752,    0 },
+  { 0x1002000,  754,    0 },
+  { 0x0100000,  756,    0 },
+  { 0x0000040,  757,    0 },
+  { 0x0002000,  758,    0 },
+  { 0x0000801,  759,    0 },
+  { 0x0000010,  761,    0 },
+  { 0x4000000,  762,    0 },
+  { 0x000180b,  763,    0 },
+  { 0x4008000,  768,    0 },
+  { 0x0000090,  770,    0 },
+  { 0x0000040,  772,    0 },
+  { 0x0000010,  773,    0 },
+  { 0x01a0110,  774,    0 },
+  { 0x0080000,  779,    0 },
+  { 0x0040000,  780,    0 },
+  { 0x0002000,  781,    0 },
+  { 0x0080000,  782,    0 },
+  { 0x0000040,  783,    0 },
+  { 0x0000040,  784,    0 },
+  { 0x0000801,  785,    0 },
+  { 0x0000010,  787,    0 },
+  { 0x0062008,  788,    0 },
+  { 0x0001008,  792,    0 },
+  { 0x0624002,  794,    0 },
+  { 0x0000010,  799,    0 },
+  { 0x0080000,  800,    0 },
+  { 0x0000008,  801,    0 },
+  { 0x0000008,  802,    0 },
+  { 0x0040008,  803,    0 },
+  { 0x0000100,  805,    0 },
+  { 0x0048000,  806,    0 },
+  { 0x0000010,  808,    0 },
+  { 0x0002000,  809,    0 },
+  { 0x024a106,  810,    0 },
+  { 0x0000011,  817,    0 },
+  { 0x0080018,  819,    0 },
+  { 0x0500004,  822,    0 },
+  { 0x0002000,  825,    0 },
+  { 0x0020000,  826,    0 },
+  { 0x0040000,  827,    0 },
+  { 0x0080808,  828,    0 },
+  { 0x4000000,  831,    0 },
+  { 0x4000000,  832,    0 },
+  { 0x0000100,  833,    0 },
+  { 0x0020000,  834,    0 },
+  { 0x0000020,  835,    0 },
+  { 0x0041000,  836,    0 },
+  { 0x0000008,  838,    0 },
+  { 0x0008000,  839,    0 },
+  { 0x024000a,  840,    0 },
+  { 0x4000000,  844,    0 },
+  { 0x0000010,  845,    0 },
+  { 0x0000400,  846,    0 },
+  { 0x0000001,  847,    0 },
+  { 0x0220808,  848,    0 },
+  { 0x0000040,  852,    0 },
+  { 0x0000040,  853,    0 },
+  { 0x0009800,  854,    0 },
+  { 0x4000000,  857,    0 },
+  { 0x0004000,  858,    0 },
+  { 0x0000008,  859,    0 },
+  { 0x0000080,  860,    0 },
+  { 0x0000800,  861,    0 },
+  { 0x0080000,  862,    0 },
+  { 0x4000000,  863,    0 },
+  { 0x0000010,  864,    0 },
+  { 0x0080000,  865,    0 },
+  { 0x0000002,  866,    0 },
+  { 0x0000400,  867,    0 },
+  { 0x0000918,  868,    0 },
+  { 0x0000010,  872,    0 },
+  { 0x0000010,  873,    0 },
+  { 0x0000008,  874,    0 },
+  { 0x0000010,  875,    0 },
+  { 0x0062000,  876,    0 },
+  { 0x0088000,  879,    0 },
+  { 0x0000010,  881,    0 },
+  { 0x0020000,  882,    0 },
+  { 0x0000010,  883,    0 },
+  { 0x4000000,  884,    0 },
+  { 0x0000010,  885,    0 },
+  { 0x0004003,  886,    0 },
+  { 0x0080048,  889,    0 },
+  { 0x00a0008,  892,    0 },
+  { 0x0000002,  895,    0 },
+  { 0x0020000,  896,    0 },
+  { 0x4000000,  897,    0 },
+  { 0x0002000,  898,    0 },
+  { 0x0002001,  899,    0 },
+  { 0x0000010,  901,    0 },
+  { 0x0004000,  902,    0 },
+  { 0x4002010,  903,    0 },
+  { 0x0000040,  906,    0 },
+  { 0x0080000,  907,    0 },
+  { 0x0100010,  908,    0 },
+  { 0x0124001,  910,    0 },
+  { 0x0024880,  914,    0 },
+  { 0x0104110,  918,    0 },
+  { 0x0004801,  922,    0 },
+  { 0x0000011,  925,    0 },
+  { 0x0080000,  927,    0 },
+  { 0x0100010,  928,    0 },
+  { 0x0000001,  930,    0 },
+  { 0x0004010,  931,    0 },
+  { 0x0100000,  933,    0 },
+  { 0x0100000,  934,    0 },
+  { 0x0088111,  935,    0 },
+  { 0x0004011,  940,    0 },
+  { 0x0004110,  943,    0 },
+  { 0x0002000,  946,    0 },
+  { 0x0000001,  947,    0 },
+  { 0x0000800,  948,    0 },
+  { 0x0100000,  949,    0 },
+  { 0x0001000,  950,    0 },
+  { 0x0020000,  951,    0 },
+  { 0x0000400,  952,    0 },
+  { 0x0100000,  953,    0 },
+  { 0x4000000,  954,    0 },
+  { 0x2000000,  955,    0 },
+  { 0x0002800,  956,    0 },
+  { 0x0000800,  958,    0 },
+  { 0x0000010,  959,    0 },
+  { 0x4000000,  960,    0 },
+  { 0x0002000,  961,    0 },
+  { 0x0000010,  962,    0 },
+  { 0x0020000,  963,    0 },
+  { 0x4000000,  964,    0 },
+  { 0x0000040,  965,    0 },
+  { 0x0000004,  966,    0 },
+  { 0x0008000,  967,    0 },
+  { 0x0000540,  968,    0 },
+  { 0x0080000,  971,    0 },
+  { 0x0000040,  972,    0 },
+  { 0x000a000,  973,    0 },
+  { 0x0000004,  975,    0 },
+  { 0x4000000,  976,    0 },
+  { 0x0000400,  977,    0 },
+  { 0x4002000,  978,    0 },
+  { 0x0000048,  980,    0 },
+  { 0x0040000,  982,    0 },
+  { 0x4080014,  983,    0 },
+  { 0x0000100,  987,    0 },
+  { 0x0000010,  988,    0 },
+  { 0x0000020,  989,    0 },
+  { 0x0400004,  990,    0 },
+  { 0x4004010,  992,    0 },
+  { 0x1000008,  995,    0 },
+  { 0x0000010,  997,    0 },
+  { 0x0008000,  998,    0 },
+  { 0x0000040,  999,    0 },
+  { 0x0080000, 1000,    0 },
+  { 0x0000040, 1001,    0 },
+  { 0x0000110, 1002,    0 },
+  { 0x0002040, 1004,    0 },
+  { 0x0000001, 1006,    0 },
+  { 0x4042000, 1007,    0 },
+  { 0x0000010, 1010,    0 },
+  { 0x1000000, 1011,    0 },
+  { 0x0220028, 1012,    0 },
+  { 0x0080000, 1016,    0 },
+  { 0x0080000, 1017,    0 },
+  { 0x4000011, 1018,    0 },
+  { 0x0040000, 1021,    0 },
+  { 0x0004000, 1022,    0 },
+  { 0x0040048, 1023,    0 },
+  { 0x0008000, 1026,    0 },
+  { 0x0040000, 1027,    0 },
+  { 0x0080000, 1028,    0 },
+  { 0x0000010, 1029,    0 },
+  { 0x0020000, 1030,    0 },
+  { 0x0020010, 1031,    0 },
+  { 0x0000010, 1033,    0 },
+  { 0x0080010, 1034,    0 },
+  { 0x0000080, 1036,    0 },
+  { 0x0000010, 1037,    0 },
+  { 0x0000102, 1038,    0 },
+  { 0x0000400, 1040,    0 },
+  { 0x0002000, 1041,    0 },
+  { 0x0100000, 1042,    0 },
+  { 0x0080000, 1043,    0 },
+  { 0x0080000, 1044,    0 },
+  { 0x0000010, 1045,    0 },
+  { 0x0000001, 1046,    0 },
+  { 0x0002008, 1047,    0 },
+  { 0x0040000, 1049,    0 },
+  { 0x0000401, 1050,    0 },
+  { 0x0000100, 1052,    0 },
+  { 0x0000050, 1053,    0 },
+  { 0x0008000, 1055,    0 },
+  { 0x0080000, 1056,    0 },
+  { 0x0002008, 1057,    0 },
+  { 0x0000010, 1059,    0 },
+  { 0x0000001, 1060,    0 },
+  { 0x0000400, 1061,    0 },
+  { 0x0000040, 1062,    0 },
+  { 0x0000002, 1063,    0 },
+  { 0x0000005, 1064,    0 },
+  { 0x0100000, 1066,    0 },
+  { 0x0000100, 1067,    0 },
+  { 0x0000080, 1068,    0 },
+  { 0x4000000, 1069,    0 },
+  { 0x0002100, 1070,    0 },
+  { 0x0002808, 1072,    0 },
+  { 0x0004000, 1075,    0 },
+  { 0x0000010, 1076,    0 },
+  { 0x0001000, 1077,    0 },
+  { 0x4140049, 1078,    0 },
+  { 0x0000800, 1084,    0 },
+  { 0x0020546, 1085,    0 },
+  { 0x00c0400, 1091,    0 },
+  { 0x00a0094, 1094,    0 },
+  { 0x0000100, 1099,    0 },
+  { 0x0000010, 1100,    0 },
+  { 0x00c2008, 1101,    0 },
+  { 0x0000080, 1105,    0 },
+  { 0x0000101, 1106,    0 },
+  { 0x0084000, 1108,    0 },
+  { 0x0004002, 1110,    0 },
+  { 0x0180000, 1112,    0 },
+  { 0x0020144, 1114,    0 },
+  { 0x0040080, 1118,    0 },
+  { 0x0000081, 1120,    0 },
+  { 0x0002008, 1122,    0 },
+  { 0x0000c00, 1124,    0 },
+  { 0x0000100, 1126,    0 },
+  { 0x0104108, 1127,    0 },
+  { 0x0020001, 1131,    0 },
+  { 0x00c0010, 1133,    0 },
+  { 0x4080010, 1136,    0 },
+  { 0x0000100, 1139,    0 },
+  { 0x0000110, 1140,    0 },
+  { 0x4000010, 1142,    0 },
+  { 0x00c0500, 1144,    0 },
+  { 0x0002000, 1148,    0 },
+  { 0x0002011, 1149,    0 },
+  { 0x0010000, 1152,    0 },
+  { 0x0004180, 1153,    0 },
+  { 0x0042000, 1156,    0 },
+  { 0x0000110, 1158,    0 },
+  { 0x0000080, 1160,    0 },
+  { 0x0000020, 1161,    0 },
+  { 0x0080010, 1162,    0 },
+  { 0x0080194, 1164,    0 },
+  { 0x0100000, 1169,    0 },
+  { 0x0080010, 1170,    0 },
+  { 0x0000080, 1172,    0 },
+  { 0x0200000, 1173,    0 },
+  { 0x0000010, 1174,    0 },
+  { 0x0000400, 1175,    0 },
+  { 0x0020000, 1176,    0 },
+  { 0x0080000, 1177,    0 },
+  { 0x0100100, 1178,    0 },
+  { 0x0020000, 1180,    0 },
+  { 0x0000400, 1181,    0 },
+  { 0x0000008, 1182,    0 },
+  { 0x0000801, 1183,    0 },
+  { 0x0080000, 1185,    0 },
+  { 0x0000080, 1186,    0 },
+  { 0x0200000, 1187,    0 },
+  { 0x0080000, 1188,    0 },
+  { 0x4400000, 1189,    0 },
+  { 0x0080000, 1191,    0 },
+  { 0x0000010, 1192,    0 },
+  { 0x0040000, 1193,    0 },
+  { 0x0080000, 1194,    0 },
+  { 0x0000010, 1195,    0 },
+  { 0x0000080, 1196,    0 },
+  { 0x0000800, 1197,    0 },
+  { 0x0040000, 1198,    0 },
+  { 0x0000100, 1199,    0 },
+  { 0x0000008, 1200,    0 },
+  { 0x0081000, 1201,    0 },
+  { 0x0000010, 1203,    0 },
+  { 0x0000191, 1204,    0 },
+  { 0x0000010, 1208,    0 },
+  { 0x4000000, 1209,    0 },
+  { 0x0000800, 1210,    0 },
+  { 0x0000002, 1211,    0 },
+  { 0x0040000, 1212,    0 },
+  { 0x4000000, 1213,    0 },
+  { 0x4000000, 1214,    0 },
+  { 0x1000000, 1215,    0 },
+  { 0x0000010, 1216,    0 },
+  { 0x0000100, 1217,    0 },
+  { 0x0000014, 1218,    0 },
+  { 0x0000001, 1220,    0 },
+  { 0x0000100, 1221,    0 },
+  { 0x0100000, 1222,    0 },
+  { 0x0000001, 1223,    0 },
+  { 0x0004000, 1224,    0 },
+  { 0x0020000, 1225,    0 },
+  { 0x4000110, 1226,    0 },
+  { 0x0000010, 1229,    0 },
+  { 0x4000000, 1230,    0 },
+  { 0x1000000, 1231,    0 },
+  { 0x4000000, 1232,    0 },
+  { 0x0200000, 1233,    0 },
+  { 0x0001000, 1234,    0 },
+  { 0x0080000, 1235,    0 },
+  { 0x0000010, 1236,    0 },
+  { 0x4000000, 1237,    0 },
+  { 0x0004000, 1238,    0 },
+  { 0x1000100, 1239,    0 },
+  { 0x0022000, 1241,    0 },
+  { 0x0002000, 1243,    0 },
+  { 0x0004000, 1244,    0 },
+  { 0x0000100, 1245,    0 },
+  { 0x0002000, 1246,    0 },
+  { 0x0000100, 1247,    0 },
+  { 0x0000080, 1248,    0 },
+  { 0x0000110, 1249,    0 },
+  { 0x0000001, 1251,    0 },
+  { 0x0000050, 1252,    0 },
+  { 0x0000080, 1254,    0 },
+  { 0x0020000, 1255,    0 },
+  { 0x0000010, 1256,    0 },
+  { 0x0048018, 1257,    0 },
+  { 0x0000800, 1261,    0 },
+  { 0x0022000, 1262,    0 },
+  { 0x4000010, 1264,    0 },
+  { 0x0000040, 1266,    0 },
+  { 0x0080000, 1267,    0 },
+  { 0x0002000, 1268,    0 },
+  { 0x0080000, 1269,    0 },
+  { 0x0000008, 1270,    0 },
+  { 0x0000010, 1271,    0 },
+  { 0x0020000, 1272,    0 },
+  { 0x0001001, 1273,    0 },
+  { 0x0080118, 1275,    0 },
+  { 0x0000010, 1279,    0 },
+  { 0x00a0411, 1280,    0 },
+  { 0x0040000, 1285,    0 },
+  { 0x00a0184, 1286,    0 },
+  { 0x0040000, 1291,    0 },
+  { 0x0000010, 1292,    0 },
+  { 0x0001000, 1293,    0 },
+  { 0x0062004, 1294,    0 },
+  { 0x0000100, 1298,    0 },
+  { 0x4000005, 1299,    0 },
+  { 0x0008000, 1302,    0 },
+  { 0x0008000, 1303,    0 },
+  { 0x0041020, 1304,    0 },
+  { 0x4000000, 1307,    0 },
+  { 0x0082000, 1308,    0 },
+  { 0x0000001, 1310,    0 },
+  { 0x0040000, 1311,    0 },
+  { 0x0002000, 1312,    0 },
+  { 0x0082000, 1313,    0 },
+  { 0x0000004, 1315,    0 },
+  { 0x4000010, 1316,    0 },
+  { 0x0004800, 1318,    0 },
+  { 0x0000400, 1320,    0 },
+  { 0x0002000, 1321,    0 },
+  { 0x0000010, 1322,    0 },
+  { 0x0080000, 1323,    0 },
+  { 0x0000004, 1324,    0 },
+  { 0x2000000, 1325,    0 },
+  { 0x10c2004, 1326,    0 },
+  { 0x0000009, 1331,    0 },
+  { 0x0002044, 1333,    0 },
+  { 0x0081000, 1336,    0 },
+  { 0x0002000, 1338,    0 },
+  { 0x0000111, 1339,    0 },
+  { 0x1000008, 1342,    0 },
+  { 0x0000800, 1344,    0 },
+  { 0x0100000, 1345,    0 },
+  { 0x0080000, 1346,    0 },
+  { 0x00c0100, 1347,    0 },
+  { 0x0080001, 1350,    0 },
+  { 0x0000010, 1352,    0 },
+  { 0x0000018, 1353,    0 },
+  { 0x0000104, 1355,    0 },
+  { 0x02c8028, 1357,    0 },
+  { 0x224700c, 1363,    0 },
+  { 0x03cd26e, 1371,    0 },
+  { 0x0000800, 1384,    0 },
+  { 0x0000008, 1385,    0 },
+  { 0x0048800, 1386,    0 },
+  { 0x0008000, 1389,    0 },
+  { 0x0000004, 1390,    0 },
+  { 0x0008100, 1391,    0 },
+  { 0x0048104, 1393,    0 },
+  { 0x0000080, 1397,    0 },
+  { 0x4000000, 1398,    0 },
+  { 0x2000000, 1399,    0 },
+  { 0x0000001, 1400,    0 },
+  { 0x0022800, 1401,    0 },
+  { 0x0040000, 1404,    0 },
+  { 0x2080004, 1405,    0 },
+  { 0x0080000, 1408,    0 },
+  { 0x0000002, 1409,    0 },
+  { 0x0000414, 1410,    0 },
+  { 0x0000101, 1413,    0 },
+  { 0x0042800, 1415,    0 },
+  { 0x0000800, 1418,    0 },
+  { 0x0008000, 1419,    0 },
+  { 0x000004c, 1420,    0 },
+  { 0x0000100, 1423,    0 },
+  { 0x0000010, 1424,    0 },
+  { 0x0000090, 1425,    0 },
+  { 0x0000010, 1427,    0 },
+  { 0x4000000, 1428,    0 },
+  { 0x0004000, 1429,    0 },
+  { 0x0040808, 1430,    0 },
+  { 0x0100010, 1433,    0 },
+  { 0x1004111, 1435,    0 },
+  { 0x0100000, 1440,    0 },
+  { 0x0104800, 1441,    0 },
+  { 0x0120100, 1444,    0 },
+  { 0x0000010, 1447,    0 },
+  { 0x1000111, 1448,    0 },
+  { 0x0004111, 1452,    0 },
+  { 0x0080018, 1456,    0 },
+  { 0x0008000, 1459,    0 },
+  { 0x0004811, 1460,    0 },
+  { 0x0100000, 1464,    0 },
+  { 0x010c114, 1465,    0 },
+  { 0x0120100, 1471,    0 },
+  { 0x0002000, 1474,    0 },
+  { 0x0000110, 1475,    0 },
+  { 0x0000001, 1477,    0 },
+  { 0x0080000, 1478,    0 },
+  { 0x4000002, 1479,    0 },
+  { 0x0000090, 1481,    0 },
+  { 0x0000050, 1483,    0 },
+  { 0x0000800, 1485,    0 },
+  { 0x0000180, 1486,    0 },
+  { 0x0000040, 1488,    0 },
+  { 0x0080000, 1489,    0 },
+  { 0x0008000, 1490,    0 },
+  { 0x0000400, 1491,    0 },
+  { 0x0100000, 1492,    0 },
+  { 0x0000011, 1493,    0 },
+  { 0x0040008, 1495,    0 },
+  { 0x0104000, 1497,    0 },
+  { 0x0000400, 1499,    0 },
+  { 0x0000001, 1500,    0 },
+  { 0x0001420, 1501,    0 },
+  { 0x0000010, 1504,    0 },
+  { 0x0000001, 1505,    0 },
+  { 0x0082040, 1506,    0 },
+  { 0x0000001, 1509,    0 },
+  { 0x0000002, 1510,    0 },
+  { 0x0000010, 1511,    0 },
+  { 0x4000000, 1512,    0 },
+  { 0x0000010, 1513,    0 },
+  { 0x4400000, 1514,    0 },
+  { 0x0000001, 1516,    0 },
+  { 0x4002008, 1517,    0 },
+  { 0x0000010, 1520,    0 },
+  { 0x0000800, 1521,    0 },
+  { 0x0185001, 1522,    0 },
+  { 0x0008010, 1527,    0 },
+  { 0x0000008, 1529,    0 },
+  { 0x0004100, 1530,    0 },
+  { 0x0040004, 1532,    0 },
+  { 0x0000010, 1534,    0 },
+  { 0x4000000, 1535,    0 },
+  { 0x00a2800, 1536,    0 },
+  { 0x0002000, 1540,    0 },
+  { 0x0004010, 1541,    0 },
+  { 0x0040010, 1543,    0 },
+  { 0x0120000, 1545,    0 },
+  { 0x0100111, 1547,    0 },
+  { 0x40e0000, 1551,    0 },
+  { 0x01a4000, 1555,    0 },
+  { 0x0000408, 1559,    0 },
+  { 0x0001000, 1561,    0 },
+  { 0x0000810, 1562,    0 },
+  { 0x0000100, 1564,    0 },
+  { 0x00c0100, 1565,    0 },
+  { 0x0200100, 1568,    0 },
+  { 0x0040000, 1570,    0 },
+  { 0x0180000, 1571,    0 },
+  { 0x0000010, 1573,    0 },
+  { 0x0020828, 1574,    0 },
+  { 0x0020808, 1578,    0 },
+  { 0x020a030, 1581,    0 },
+  { 0x032c014, 1586,    0 },
+  { 0x0100100, 1593,    0 },
+  { 0x0000020, 1595,    0 },
+  { 0x4000000, 1596,    0 },
+  { 0x0000800, 1597,    0 },
+  { 0x0000400, 1598,    0 },
+  { 0x0000010, 1599,    0 },
+  { 0x0000040, 1600,    0 },
+  { 0x0002080, 1601,    0 },
+  { 0x0200c10, 1603,    0 },
+  { 0x0008100, 1607,    0 },
+  { 0x0000044, 1609,    0 },
+  { 0x0000010, 1611,    0 },
+  { 0x0080000, 1612,    0 },
+  { 0x0100000, 1613,    0 },
+  { 0x4000000, 1614,    0 },
+  { 0x0000010, 1615,    0 },
+  { 0x0080000, 1616,    0 },
+  { 0x0080000, 1617,    0 },
+  { 0x4022800, 1618,    0 },
+  { 0x0000800, 1622,    0 },
+  { 0x0001002, 1623,    0 },
+  { 0x0002010, 1625,    0 },
+  { 0x000104c, 1627,    0 },
+  { 0x0480040, 1631,    0 },
+  { 0x0040000, 1634,    0 },
+  { 0x0020800, 1635,    0 },
+  { 0x0000800, 1637,    0 },
+  { 0x0004400, 1638,    0 },
+  { 0x0008404, 1640,    0 },
+  { 0x0000020, 1643,    0 },
+  { 0x0400000, 1644,    0 },
+  { 0x0008000, 1645,    0 },
+  { 0x0000504, 1646,    0 },
+  { 0x0000001, 1649,    0 },
+  { 0x0080000, 1650,    0 },
+  { 0x0300109, 1651,    0 },
+  { 0x0000010, 1656,    0 },
+  { 0x0000040, 1657,    0 },
+  { 0x0002000, 1658,    0 },
+  { 0x00a0000, 1659,    0 },
+  { 0x00aa800, 1661,    0 },
+  { 0x04a0004, 1666,    0 },
+  { 0x0002815, 1670,    0 },
+  { 0x0000010, 1675,    0 },
+  { 0x002240c, 1676,    0 },
+  { 0x0000100, 1681,    0 },
+  { 0x00a6100, 1682,    0 },
+  { 0x0000111, 1687,    0 },
+  { 0x4000000, 1690,    0 },
+  { 0x0000111, 1691,    0 },
+  { 0x10a316a, 1694,    0 },
+  { 0x0029011, 1704,    0 },
+  { 0x0002804, 1709,    0 },
+  { 0x0227004, 1712,    0 },
+  { 0x0104111, 1718,    0 },
+  { 0x0001028, 1723,    0 },
+  { 0x0000800, 1726,    0 },
+  { 0x0401200, 1727,    0 },
+  { 0x0000084, 1730,    0 },
+  { 0x0000008, 1732,    0 },
+  { 0x0000020, 1733,    0 },
+  { 0x0000041, 1734,    0 },
+  { 0x0080000, 1736,    0 },
+  { 0x0001000, 1737,    0 },
+  { 0x4042000, 1738,    0 },
+  { 0x0028010, 1741,    0 },
+  { 0x0228070, 1744,    0 },
+  { 0x0088000, 1750,    0 },
+  { 0x0029800, 1752,    0 },
+  { 0x0000011, 1756,    0 },
+  { 0x0083020, 1758,    0 },
+  { 0x0020000, 1762,    0 },
+  { 0x0008002, 1763,    0 },
+  { 0x0100000, 1765,    0 },
+  { 0x0080000, 1766,    0 },
+  { 0x0000800, 1767,    0 },
+  { 0x0000400, 1768,    0 },
+  { 0x4000000, 1769,    0 },
+  { 0x0000800, 1770,    0 },
+  { 0x0000410, 1771,    0 },
+  { 0x0000400, 1773,    0 },
+  { 0x0000010, 1774,    0 },
+  { 0x0000040, 1775,    0 },
+  { 0x0080400, 1776,    0 },
+  { 0x0080000, 1778,    0 },
+  { 0x0000100, 1779,    0 },
+  { 0x0001004, 1780,    0 },
+  { 0x0000800, 1782,    0 },
+  { 0x4082001, 1783,    0 },
+  { 0x0001000, 1787,    0 },
+  { 0x0080000, 1788,    0 },
+  { 0x0080000, 1789,    0 },
+  { 0x0082000, 1790,    0 },
+  { 0x1027000, 1792,    0 },
+  { 0x0042000, 1797,    0 },
+  { 0x0100000, 1799,    0 },
+  { 0x0004110, 1800,    0 },
+  { 0x0003000, 1803,    0 },
+  { 0x0000400, 1805,    0 },
+  { 0x0000010, 1806,    0 },
+  { 0x0000010, 1807,    0 },
+  { 0x0080000, 1808,    0 },
+  { 0x0000012, 1809,    0 },
+  { 0x1000000, 1811,    0 },
+  { 0x4000000, 1812,    0 },
+  { 0x0000010, 1813,    0 },
+  { 0x0040000, 1814,    0 },
+  { 0x0000800, 1815,    0 },
+  { 0x0040000, 1816,    0 },
+  { 0x0000001, 1817,    0 },
+  { 0x0000009, 1818,    0 },
+  { 0x4000000, 1820,    0 },
+  { 0x0000010, 1821,    0 },
+  { 0x0000800, 1822,    0 },
+  { 0x0000010, 1823,    0 },
+  { 0x0004001, 1824,    0 },
+  { 0x0000150, 1826,    0 },
+  { 0x0080800, 1829,    0 },
+  { 0x4008100, 1831,    0 },
+  { 0x0082004, 1834,    0 },
+  { 0x0040000, 1837,    0 },
+  { 0x0000001, 1838,    0 },
+  { 0x0020000, 1839,    0 },
+  { 0x0002011, 1840,    0 },
+  { 0x4000000, 1843,    0 },
+  { 0x124a16c, 1844,    0 },
+  { 0x0002011, 1854,    0 },
+  { 0x0009047, 1857,    0 },
+  { 0x0108000, 1863,    0 },
+  { 0x00c1814, 1865,    0 },
+  { 0x4000000, 1871,    0 },
+  { 0x0000010, 1872,    0 },
+  { 0x0080000, 1873,    0 },
+  { 0x0000002, 1874,    0 },
+  { 0x0002001, 1875,    0 },
+  { 0x0082400, 1877,    0 },
+  { 0x0002800, 1880,    0 },
+  { 0x0042004, 1882,    0 },
+  { 0x4000000, 1885,    0 },
+  { 0x0000110, 1886,    0 },
+  { 0x1000000, 1888,    0 },
+  { 0x0020000, 1889,    0 },
+  { 0x0400002, 1890,    0 },
+  { 0x0004800, 1892,    0 },
+  { 0x0004010, 1894,    0 },
+  { 0x0004001, 1896,    0 },
+  { 0x0000001, 1898,    0 },
+  { 0x0290020, 1899,    0 },
+  { 0x0002000, 1903,    0 },
+  { 0x0004000, 1904,    0 },
+  { 0x0000100, 1905,    0 },
+  { 0x0040000, 1906,    0 },
+  { 0x0000010, 1907,    0 },
+  { 0x0000001, 1908,    0 },
+  { 0x0020000, 1909,    0 },
+  { 0x0004000, 1910,    0 },
+  { 0x0002000, 1911,    0 },
+  { 0x0000010, 1912,    0 },
+  { 0x0000010, 1913,    0 },
+  { 0x0000001, 1914,    0 },
+  { 0x0000010, 1915,    0 },
+  { 0x0000040, 1916,    0 },
+  { 0x4000828, 1917,    0 },
+  { 0x0000001, 1921,    0 },
+  { 0x0000800, 1922,    0 },
+  { 0x0100001, 1923,    0 },
+  { 0x0100000, 1925,    0 },
+  { 0x0200900, 1926,    0 },
+  { 0x4000100, 1929,    0 },
+  { 0x0004000, 1931,    0 },
+  { 0x0000100, 1932,    0 },
+  { 0x0080000, 1933,    0 },
+  { 0x0000800, 1934,    0 },
+  { 0x0000100, 1935,    0 },
+  { 0x0200000, 1936,    0 },
+  { 0x0180008, 1937,    0 },
+  { 0x1040102, 1940,    0 },
+  { 0x0040000, 1944,    0 },
+  { 0x0000010, 1945,    0 },
+  { 0x0000002, 1946,    0 },
+  { 0x0020000, 1947,    0 },
+  { 0x0080100, 1948,    0 },
+  { 0x0000010, 1950,    0 },
+  { 0x0400000, 1951,    0 },
+  { 0x0000800, 1952,    0 },
+  { 0x0080000, 1953,    0 },
+  { 0x0000800, 1954,    0 },
+  { 0x0180000, 1955,    0 },
+  { 0x0100101, 1957,    0 },
+  { 0x0000001, 1960,    0 },
+  { 0x0000100, 1961,    0 },
+  { 0x0000001, 1962,    0 },
+  { 0x000000c, 1963,    0 },
+  { 0x0100004, 1965,    0 },
+  { 0x0000010, 1967,    0 },
+  { 0x0000001, 1968,    0 },
+  { 0x0004010, 1969,    0 },
+  { 0x0080000, 1971,    0 },
+  { 0x0002c00, 1972,    0 },
+  { 0x0080000, 1975,    0 },
+  { 0x0021020, 1976,    0 },
+  { 0x0088080, 1979,    0 },
+  { 0x0000010, 1982,    0 },
+  { 0x0000010, 1983,    0 },
+  { 0x4000000, 1984,    0 },
+  { 0x00e8800, 1985,    0 },
+  { 0x4000000, 1990,    0 },
+  { 0x0000008, 1991,    0 },
+  { 0x0000400, 1992,    0 },
+  { 0x0020000, 1993,    0 },
+  { 0x0000004, 1994,    0 },
+  { 0x0080000, 1995,    0 },
+  { 0x4000000, 1996,    0 },
+  { 0x0080800, 1997,    0 },
+  { 0x0022011, 1999,    0 },
+  { 0x0048000, 2003,    0 },
+  { 0x0080010, 2005,    0 },
+  { 0x0000010, 2007,    0 },
+  { 0x0000808, 2008,    0 },
+  { 0x4082458, 2010,    0 },
+  { 0x0000010, 2017,    0 },
+  { 0x0000098, 2018,    0 },
+  { 0x0002000, 2021,    0 },
+  { 0x0000020, 2022,    0 },
+  { 0x0000001, 2023,    0 },
+  { 0x0000008, 2024,    0 },
+  { 0x0000808, 2025,    0 },
+  { 0x00a0c08, 2027,    0 },
+  { 0x0008000, 2032,    0 },
+  { 0x0040004, 2033,    0 },
+  { 0x00c0000, 2035,    0 },
+  { 0x0002000, 2037,    0 },
+  { 0x0000008, 2038,    0 },
+  { 0x0020000, 2039,    0 },
+  { 0x0000800, 2040,    0 },
+  { 0x4082000, 2041,    0 },
+  { 0x0020000, 2044,    0 },
+  { 0x0004000, 2045,    0 },
+  { 0x0000010, 2046,    0 },
+  { 0x4000000, 2047,    0 },
+};
+
+#endif//__crypt0_bip39_lookup_h_included__
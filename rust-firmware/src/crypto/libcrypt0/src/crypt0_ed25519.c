@@ -1,22 +1,11 @@
-
+#include <crypt0.h>
 #include <crypt0_ed25519.h>
-#include <crypt0_hmac.h>
+#include <crypt0_bip32.h>
 
 #include <stdint.h>
 #include <string.h>
 
-#ifdef __ZEPHYR__
-#include <ocrypto_ed25519.h>
-#else
-#include <openssl/evp.h>
-#include <openssl/ec.h>
-#include <openssl/core_names.h>
-#include <openssl/err.h>
-#endif
-
-#define ED25519_CHAIN_CODE_SIZE 32
-#define ED25519_PRIVATE_KEY_SIZE 32
-#define ED25519_DERIVE_DATA_SIZE (1 + ED25519_PRIVATE_KEY_SIZE + 4) // 0x00 + private_key + index
+// one implementation on every backend, see crypt0_ed25519_portable.c
 
 /** convert secret key to public */
 int crypt0_ed25519_public_key(const uint8_t * priv, size_t privlen, 
@@ -29,46 +18,20 @@ int crypt0_ed25519_public_key(const uint8_t * priv, size_t privlen,
     return -1;
   }
 
-  #ifdef __ZEPHYR__
-    ocrypto_ed25519_public_key(pub, priv);
-
-    return 0;
-  
-  #else
-
-    EVP_PKEY *pkey = NULL;
-    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
-
-    if (ctx == NULL) {
-      fprintf(stderr, "Failed to create EVP_PKEY_CTX\n");
-      return -1;
-    }
+  crypt0_ed25519_portable_public_key(pub, priv);
 
-    if (EVP_PKEY_keygen_init(ctx) <= 0) {
-      EVP_PKEY_CTX_free(ctx);
-      return -1;
-    }
-
-    pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, priv, 32);
-    if (pkey == NULL) {
-      EVP_PKEY_CTX_free(ctx);
-      return -1; 
-    }
-
-    size_t publen_ret = publen;
-    if (EVP_PKEY_get_raw_public_key(pkey, pub, &publen_ret) <= 0) {
-      EVP_PKEY_free(pkey);
-      EVP_PKEY_CTX_free(ctx);
-      return -1;
-    }
+  return 0;
+}
 
-    EVP_PKEY_free(pkey);
-    EVP_PKEY_CTX_free(ctx);
+int crypt0_ed25519_public_keys(const uint8_t * priv, size_t n, uint8_t * pub)
+{
+  if (n > 0 && (priv == NULL || pub == NULL)) {
+    return -1;
+  }
 
-    return 0;
-  
-  #endif
+  crypt0_ed25519_portable_public_keys(pub, priv, n);
 
+  return 0;
 }
 
 /** sign sha256 hash */
@@ -86,37 +49,9 @@ int crypt0_ed25519_sign(const uint8_t * message, size_t messagelen,
   if (siglen != CRYPT0_ED25519_SIG_BYTES) {
     return -1;
   }
-  #ifdef __ZEPHYR__
-    ocrypto_ed25519_sign(sig, message, messagelen, priv, pub);
-  #else
-    EVP_PKEY *pkey = NULL;
-    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
-
-    if (EVP_PKEY_keygen_init(ctx) <= 0) {
-      return -1;
-    }
-
-    if ((pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, priv, 32)) == NULL) {
-      return -1; 
-    }
-
-    EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
-    if (mdctx == NULL) {
-        return -1;
-    }
-
-    if (EVP_DigestSignInit(mdctx, NULL, NULL, NULL, pkey) <= 0) {
-        return -1;
-    }
-
-    size_t siglen_ret = siglen;
-    if (EVP_DigestSign(mdctx, sig, &siglen_ret, message, messagelen) <= 0) {
-      return -1;
-    }
-
-    EVP_MD_CTX_free(mdctx);
-    EVP_PKEY_CTX_free(ctx);
-  #endif
+
+  crypt0_ed25519_portable_sign(sig, message, messagelen, priv, pub);
+
   return 0;
 }
 
@@ -125,20 +60,36 @@ int crypt0_ed25519_derive_secret_index(uint8_t * secret, uint32_t index)
   if (index < 0x80000000) {
     return -1;
   }
+  // SLIP-10, see crypt0_bip32.c
+  return crypt0_slip10_derive_secret_index(CRYPT0_SLIP10_ED25519, secret, index);
+}
 
-  uint8_t data[ED25519_DERIVE_DATA_SIZE];
-  uint8_t hash[64];
+int crypt0_ed25519_keypair_init(crypt0_ed25519_keypair * keypair,
+        const uint8_t * priv, size_t privlen)
+{
+  if (privlen != CRYPT0_ED25519_PRIVKEY_BYTES) {
+    return -1;
+  }
+
+  crypt0_ed25519_portable_expand(keypair->secret, keypair->pub, priv);
+
+  return 0;
+}
+
+int crypt0_ed25519_keypair_sign(const crypt0_ed25519_keypair * keypair,
+        const uint8_t * message, size_t messagelen, uint8_t * sig, size_t siglen)
+{
+  if (siglen != CRYPT0_ED25519_SIG_BYTES) {
+    return -1;
+  }
 
-  // Prepare data: 0x00 || private_key || index (big-endian)
-  data[0] = 0x00;
-  memcpy(data + 1, secret, ED25519_PRIVATE_KEY_SIZE);
-  data[ED25519_PRIVATE_KEY_SIZE + 1] = (index >> 24) & 0xFF;
-  data[ED25519_PRIVATE_KEY_SIZE + 2] = (index >> 16) & 0xFF;
-  data[ED25519_PRIVATE_KEY_SIZE + 3] = (index >> 8) & 0xFF;
-  data[ED25519_PRIVATE_KEY_SIZE + 4] = index & 0xFF;
+  crypt0_ed25519_portable_sign_expanded(sig, message, messagelen,
+      keypair->secret, keypair->pub);
 
-  // HMAC-SHA512(chain_code, data)
-  crypt0_hmac_sha512(&secret[32], ED25519_CHAIN_CODE_SIZE, data, sizeof(data), hash);
-  memcpy(secret, hash, ED25519_PRIVATE_KEY_SIZE + ED25519_CHAIN_CODE_SIZE);
   return 0;
-}
\ No newline at end of file
+}
+
+void crypt0_ed25519_keypair_wipe(crypt0_ed25519_keypair * keypair)
+{
+  crypt0_memzero(keypair, sizeof(*keypair));
+}
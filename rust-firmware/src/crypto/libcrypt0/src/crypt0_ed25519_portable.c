@@ -0,0 +1,543 @@
+#include "crypt0.h"
+#include "crypt0_ed25519.h"
+#include "crypt0_sha2.h"
+
+#include <stdint.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Portable Ed25519 (RFC 8032), the implementation behind crypt0_ed25519.h on
+// every backend, so signing costs the same in the simulator and on the
+// device. Field elements are kept in radix 2^25.5 (ten signed limbs, the
+// same layout as ref10) so the code runs on 32 bit cores, points are in
+// extended coordinates. The base point multiplication is ref10's: signed
+// radix 16 digits, each added from a fixed table in flash with a constant
+// time lookup, four doublings in all. Nothing is allocated.
+
+typedef int32_t fe[10];
+
+typedef struct {
+  fe X, Y, Z, T;
+} ge;
+
+// affine point as (y + x, y - x, 2 * d * x * y), for mixed additions
+typedef struct {
+  fe yplusx, yminusx, xy2d;
+} ge_precomp;
+
+#include "crypt0_ed25519_table.h"
+
+static inline int fe_bits(int i)
+{
+  return (i & 1) ? 25 : 26;
+}
+
+// brings every limb back to 26 / 25 bits (plus a small excess in limb 1)
+static void fe_carry(int32_t h[10], int64_t t[10])
+{
+  int64_t c;
+
+  for (int i = 0; i < 9; i++) {
+    c = (t[i] + ((int64_t)1 << (fe_bits(i) - 1))) >> fe_bits(i);
+    t[i + 1] += c;
+    t[i] -= c * ((int64_t)1 << fe_bits(i));
+  }
+  c = (t[9] + ((int64_t)1 << 24)) >> 25;
+  t[0] += c * 19;
+  t[9] -= c * ((int64_t)1 << 25);
+  c = (t[0] + ((int64_t)1 << 25)) >> 26;
+  t[1] += c;
+  t[0] -= c * ((int64_t)1 << 26);
+
+  for (int i = 0; i < 10; i++) {
+    h[i] = (int32_t)t[i];
+  }
+}
+
+static void fe_0(fe h)
+{
+  memset(h, 0, sizeof(fe));
+}
+
+static void fe_1(fe h)
+{
+  fe_0(h);
+  h[0] = 1;
+}
+
+static void fe_add(fe h, const fe f, const fe g)
+{
+  int64_t t[10];
+
+  for (int i = 0; i < 10; i++) {
+    t[i] = (int64_t)f[i] + g[i];
+  }
+  fe_carry(h, t);
+}
+
+static void fe_sub(fe h, const fe f, const fe g)
+{
+  int64_t t[10];
+
+  for (int i = 0; i < 10; i++) {
+    t[i] = (int64_t)f[i] - g[i];
+  }
+  fe_carry(h, t);
+}
+
+// schoolbook product, limbs that wrap past 2^255 are folded back times 19 and
+// odd x odd limb products carry the extra factor 2 of the half bit radix. g is
+// spread by factor first, so the inner loops are plain multiply-accumulates
+static void fe_mul(fe h, const fe f, const fe g)
+{
+  int64_t t[10] = { 0 };
+  int64_t gs[2][20];
+
+  for (int j = 0; j < 10; j++) {
+    gs[0][j] = g[j];
+    gs[1][j] = (j & 1) ? 2 * (int64_t)g[j] : g[j];
+    gs[0][j + 10] = 19 * gs[0][j];
+    gs[1][j + 10] = 19 * gs[1][j];
+  }
+
+  // limb i + j of the product is t[i + j], past 9 it wraps times 19
+  for (int i = 0; i < 10; i++) {
+    const int64_t * gi = gs[i & 1];
+    int64_t fi = f[i];
+    for (int j = 0; j < 10 - i; j++) {
+      t[i + j] += fi * gi[j];
+    }
+    for (int j = 10 - i; j < 10; j++) {
+      t[i + j - 10] += fi * gi[j + 10];
+    }
+  }
+  fe_carry(h, t);
+}
+
+static void fe_sq(fe h, const fe f)
+{
+  fe_mul(h, f, f);
+}
+
+static void fe_sqn(fe h, const fe f, int n)
+{
+  fe_sq(h, f);
+  while (--n > 0) {
+    fe_sq(h, h);
+  }
+}
+
+// z^(p - 2), same addition chain as ref10
+static void fe_invert(fe out, const fe z)
+{
+  fe t0, t1, t2, t3;
+
+  fe_sq(t0, z);
+  fe_sqn(t1, t0, 2);
+  fe_mul(t1, z, t1);
+  fe_mul(t0, t0, t1);
+  fe_sq(t2, t0);
+  fe_mul(t1, t1, t2);
+  fe_sqn(t2, t1, 5);
+  fe_mul(t1, t2, t1);
+  fe_sqn(t2, t1, 10);
+  fe_mul(t2, t2, t1);
+  fe_sqn(t3, t2, 20);
+  fe_mul(t2, t3, t2);
+  fe_sqn(t2, t2, 10);
+  fe_mul(t1, t2, t1);
+  fe_sqn(t2, t1, 50);
+  fe_mul(t2, t2, t1);
+  fe_sqn(t3, t2, 100);
+  fe_mul(t2, t3, t2);
+  fe_sqn(t2, t2, 50);
+  fe_mul(t1, t2, t1);
+  fe_sqn(t1, t1, 5);
+  fe_mul(out, t1, t0);
+}
+
+// canonical little endian encoding, fully reduced mod p
+static void fe_tobytes(uint8_t s[32], const fe f)
+{
+  int32_t h[10];
+  int32_t q;
+  uint64_t acc = 0;
+  int bits = 0;
+  int k = 0;
+
+  memcpy(h, f, sizeof(h));
+
+  q = (19 * h[9] + ((int32_t)1 << 24)) >> 25;
+  for (int i = 0; i < 10; i++) {
+    q = (h[i] + q) >> fe_bits(i);
+  }
+  h[0] += 19 * q;
+
+  for (int i = 0; i < 9; i++) {
+    int32_t c = h[i] >> fe_bits(i);
+    h[i + 1] += c;
+    h[i] -= c * ((int32_t)1 << fe_bits(i));
+  }
+  h[9] &= (1 << 25) - 1;
+
+  for (int i = 0; i < 10; i++) {
+    acc |= (uint64_t)(uint32_t)h[i] << bits;
+    bits += fe_bits(i);
+    while (bits >= 8) {
+      s[k++] = (uint8_t)acc;
+      acc >>= 8;
+      bits -= 8;
+    }
+  }
+  s[k] = (uint8_t)acc;
+}
+
+static void fe_cmov(fe f, const fe g, uint32_t b)
+{
+  int32_t mask = -(int32_t)b;
+
+  for (int i = 0; i < 10; i++) {
+    f[i] ^= (f[i] ^ g[i]) & mask;
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void ge_0(ge * r)
+{
+  fe_0(r->X);
+  fe_1(r->Y);
+  fe_1(r->Z);
+  fe_0(r->T);
+}
+
+// madd-2008-hwcd-3, p plus an affine q, complete for a = -1, so p may be
+// the neutral element or q itself
+static void ge_madd(ge * r, const ge * p, const ge_precomp * q)
+{
+  fe a, b, c, d, t;
+
+  fe_sub(a, p->Y, p->X);
+  fe_mul(a, a, q->yminusx);
+  fe_add(b, p->Y, p->X);
+  fe_mul(b, b, q->yplusx);
+  fe_mul(c, p->T, q->xy2d);
+  fe_add(d, p->Z, p->Z);
+
+  fe_sub(t, b, a);      // E
+  fe_add(b, b, a);      // H
+  fe_sub(a, d, c);      // F
+  fe_add(d, d, c);      // G
+
+  fe_mul(r->X, t, a);
+  fe_mul(r->Y, d, b);
+  fe_mul(r->T, t, b);
+  fe_mul(r->Z, a, d);
+}
+
+// dbl-2008-hwcd
+static void ge_dbl(ge * r, const ge * p)
+{
+  fe a, b, c, e, g, h;
+
+  fe_sq(a, p->X);
+  fe_sq(b, p->Y);
+  fe_sq(c, p->Z);
+  fe_add(c, c, c);
+  fe_add(h, a, b);
+  fe_add(e, p->X, p->Y);
+  fe_sq(e, e);
+  fe_sub(e, h, e);
+  fe_sub(g, a, b);
+  fe_add(c, c, g);      // F
+
+  fe_mul(r->X, e, c);
+  fe_mul(r->Y, g, h);
+  fe_mul(r->T, e, h);
+  fe_mul(r->Z, c, g);
+}
+
+static void ge_precomp_cmov(ge_precomp * t, const ge_precomp * u, uint32_t b)
+{
+  fe_cmov(t->yplusx, u->yplusx, b);
+  fe_cmov(t->yminusx, u->yminusx, b);
+  fe_cmov(t->xy2d, u->xy2d, b);
+}
+
+// t = b * 256^pos * B for a digit -8 <= b <= 8, touching every entry of the
+// row whatever b is
+static void ge_select(ge_precomp * t, int pos, int8_t b)
+{
+  ge_precomp minus;
+  uint32_t negative = (uint8_t)b >> 7;
+  uint32_t babs = (uint32_t)(b - ((-(int32_t)negative & b) * 2));
+
+  fe_1(t->yplusx);
+  fe_1(t->yminusx);
+  fe_0(t->xy2d);
+  for (uint32_t j = 1; j <= 8; j++) {
+    ge_precomp_cmov(t, &ge_base_table[pos][j - 1], ((j ^ babs) - 1) >> 31);
+  }
+
+  // -(x, y) = (-x, y) swaps y + x and y - x and negates x * y
+  memcpy(minus.yplusx, t->yminusx, sizeof(fe));
+  memcpy(minus.yminusx, t->yplusx, sizeof(fe));
+  fe_0(minus.xy2d);
+  fe_sub(minus.xy2d, minus.xy2d, t->xy2d);
+  ge_precomp_cmov(t, &minus, negative);
+}
+
+// s = encoding of p, zi the inverse of p->Z
+static void ge_tobytes_zi(uint8_t s[32], const ge * p, const fe zi)
+{
+  fe x, y;
+  uint8_t xs[32];
+
+  fe_mul(x, p->X, zi);
+  fe_mul(y, p->Y, zi);
+  fe_tobytes(s, y);
+  fe_tobytes(xs, x);
+  s[31] ^= (xs[0] & 1) << 7;
+}
+
+static void ge_tobytes(uint8_t s[32], const ge * p)
+{
+  fe zi;
+
+  fe_invert(zi, p->Z);
+  ge_tobytes_zi(s, p, zi);
+}
+
+// r = a * B, a is 32 bytes little endian with a[31] <= 127. With signed
+// digits e[i] of a in radix 16, r = sum e[i] * 16^i * B: the odd digits from
+// the table rows, times 16, then the even digits
+static void ge_scalarmult_base(ge * r, const uint8_t a[32])
+{
+  int8_t e[64];
+  int8_t carry = 0;
+  ge_precomp t;
+
+  for (int i = 0; i < 32; i++) {
+    e[2 * i] = a[i] & 15;
+    e[2 * i + 1] = (a[i] >> 4) & 15;
+  }
+  for (int i = 0; i < 63; i++) {
+    e[i] += carry;
+    carry = (e[i] + 8) >> 4;
+    e[i] -= carry * 16;
+  }
+  e[63] += carry;
+
+  ge_0(r);
+  for (int i = 1; i < 64; i += 2) {
+    ge_select(&t, i / 2, e[i]);
+    ge_madd(r, r, &t);
+  }
+
+  ge_dbl(r, r);
+  ge_dbl(r, r);
+  ge_dbl(r, r);
+  ge_dbl(r, r);
+
+  for (int i = 0; i < 64; i += 2) {
+    ge_select(&t, i / 2, e[i]);
+    ge_madd(r, r, &t);
+  }
+
+  crypt0_memzero(e, sizeof(e));
+  crypt0_memzero(&t, sizeof(t));
+}
+
+//-----------------------------------------------------------------------------
+// Scalars mod L = 2^252 + 27742317777372353535851937790883648493, byte wise
+// reduction as in TweetNaCl
+
+static const int64_t sc_L[32] = {
+  0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+  0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10
+};
+
+static void sc_modl(uint8_t r[32], int64_t x[64])
+{
+  int64_t carry;
+  int i, j;
+
+  for (i = 63; i >= 32; i--) {
+    carry = 0;
+    for (j = i - 32; j < i - 12; j++) {
+      x[j] += carry - 16 * x[i] * sc_L[j - (i - 32)];
+      carry = (x[j] + 128) >> 8;
+      x[j] -= carry * 256;
+    }
+    x[j] += carry;
+    x[i] = 0;
+  }
+
+  carry = 0;
+  for (j = 0; j < 32; j++) {
+    x[j] += carry - (x[31] >> 4) * sc_L[j];
+    carry = x[j] >> 8;
+    x[j] &= 255;
+  }
+  for (j = 0; j < 32; j++) {
+    x[j] -= carry * sc_L[j];
+  }
+  for (i = 0; i < 32; i++) {
+    x[i + 1] += x[i] >> 8;
+    r[i] = x[i] & 255;
+  }
+}
+
+static void sc_reduce(uint8_t r[32], const uint8_t s[64])
+{
+  int64_t x[64];
+
+  for (int i = 0; i < 64; i++) {
+    x[i] = s[i];
+  }
+  sc_modl(r, x);
+}
+
+// r = (a * b + c) mod L
+static void sc_muladd(uint8_t r[32], const uint8_t a[32], const uint8_t b[32],
+    const uint8_t c[32])
+{
+  int64_t x[64] = { 0 };
+
+  for (int i = 0; i < 32; i++) {
+    x[i] = c[i];
+  }
+  for (int i = 0; i < 32; i++) {
+    for (int j = 0; j < 32; j++) {
+      x[i + j] += (int64_t)a[i] * b[j];
+    }
+  }
+  sc_modl(r, x);
+}
+
+//-----------------------------------------------------------------------------
+static void ed25519_expand(const uint8_t * priv, uint8_t az[64])
+{
+  crypt0_sha512_ctx sha;
+
+  crypt0_sha512_init(&sha);
+  crypt0_sha512_update(&sha, priv, 32);
+  crypt0_sha512_final(&sha, az);
+  az[0] &= 248;
+  az[31] &= 127;
+  az[31] |= 64;
+}
+
+void crypt0_ed25519_portable_public_key(uint8_t * pub, const uint8_t * priv)
+{
+  uint8_t az[64];
+
+  crypt0_ed25519_portable_expand(az, pub, priv);
+
+  crypt0_memzero(az, sizeof(az));
+}
+
+void crypt0_ed25519_portable_expand(uint8_t * az, uint8_t * pub, const uint8_t * priv)
+{
+  ge a;
+
+  ed25519_expand(priv, az);
+  ge_scalarmult_base(&a, az);
+  ge_tobytes(pub, &a);
+
+  crypt0_memzero(&a, sizeof(a));
+}
+
+// keys multiplied together on the stack, 1.5 KB of points and products
+#define PUBKEYS_CHUNK 8
+
+// the affine conversion of a chunk shares one inversion: the running
+// products of the Z coordinates are inverted once and walked back
+void crypt0_ed25519_portable_public_keys(uint8_t * pub, const uint8_t * priv, size_t n)
+{
+  uint8_t az[64];
+  ge a[PUBKEYS_CHUNK];
+  fe acc[PUBKEYS_CHUNK];
+  fe inv, zi;
+
+  for (size_t done = 0; done < n; ) {
+    size_t m = n - done;
+    if (m > PUBKEYS_CHUNK) {
+      m = PUBKEYS_CHUNK;
+    }
+
+    for (size_t i = 0; i < m; i++) {
+      ed25519_expand(&priv[32 * (done + i)], az);
+      ge_scalarmult_base(&a[i], az);
+      if (i == 0) {
+        memcpy(acc[0], a[0].Z, sizeof(fe));
+      } else {
+        fe_mul(acc[i], acc[i - 1], a[i].Z);
+      }
+    }
+
+    fe_invert(inv, acc[m - 1]);
+    for (size_t i = m - 1; i > 0; i--) {
+      fe_mul(zi, inv, acc[i - 1]);
+      fe_mul(inv, inv, a[i].Z);
+      ge_tobytes_zi(&pub[32 * (done + i)], &a[i], zi);
+    }
+    ge_tobytes_zi(&pub[32 * done], &a[0], inv);
+    done += m;
+  }
+
+  crypt0_memzero(az, sizeof(az));
+  crypt0_memzero(a, sizeof(a));
+  crypt0_memzero(acc, sizeof(acc));
+  crypt0_memzero(inv, sizeof(inv));
+  crypt0_memzero(zi, sizeof(zi));
+}
+
+void crypt0_ed25519_portable_sign(uint8_t * sig, const uint8_t * message,
+    size_t messagelen, const uint8_t * priv, const uint8_t * pub)
+{
+  uint8_t az[64];
+
+  ed25519_expand(priv, az);
+  crypt0_ed25519_portable_sign_expanded(sig, message, messagelen, az, pub);
+
+  crypt0_memzero(az, sizeof(az));
+}
+
+void crypt0_ed25519_portable_sign_expanded(uint8_t * sig, const uint8_t * message,
+    size_t messagelen, const uint8_t * az, const uint8_t * pub)
+{
+  crypt0_sha512_ctx sha;
+  uint8_t nonce[64];
+  uint8_t r[32];
+  uint8_t hram[64];
+  uint8_t k[32];
+  ge R;
+
+  // r = H(prefix || M) mod L, R = r * B
+  crypt0_sha512_init(&sha);
+  crypt0_sha512_update(&sha, &az[32], 32);
+  crypt0_sha512_update(&sha, message, messagelen);
+  crypt0_sha512_final(&sha, nonce);
+  sc_reduce(r, nonce);
+  ge_scalarmult_base(&R, r);
+  ge_tobytes(sig, &R);
+
+  // S = (r + H(R || A || M) * a) mod L
+  crypt0_sha512_init(&sha);
+  crypt0_sha512_update(&sha, sig, 32);
+  crypt0_sha512_update(&sha, pub, 32);
+  crypt0_sha512_update(&sha, message, messagelen);
+  crypt0_sha512_final(&sha, hram);
+  sc_reduce(k, hram);
+  sc_muladd(&sig[32], k, az, r);
+
+  crypt0_memzero(nonce, sizeof(nonce));
+  crypt0_memzero(r, sizeof(r));
+  crypt0_memzero(hram, sizeof(hram));
+  crypt0_memzero(k, sizeof(k));
+  crypt0_memzero(&R, sizeof(R));
+  crypt0_memzero(&sha, sizeof(sha));
+}
+
+// eof
@@ -0,0 +1,11 @@
+@ libsecp256k1 field_10x26 multiply and square kernels (UMULL/UMLAL, two
+@ interleaved accumulator passes) assembled as Thumb-2 for the Cortex-M33.
+@ Built with CRYPT0_SECP256K1_ARM_ASM, which also defines USE_EXTERNAL_ASM
+@ so field_10x26_impl.h calls these instead of its C inner loops.
+@ The kernels sit in lib/secp256k1/src/asm, found through -Wa,-I
+
+	.syntax unified
+	.thumb
+	.include "field_10x26_arm.s"
+
+@ eof
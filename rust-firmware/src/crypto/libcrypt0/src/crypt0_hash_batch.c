@@ -0,0 +1,610 @@
+#include "crypt0_hash_batch.h"
+#include "crypt0_sha2.h"
+#include "crypt0_sha2_impl.h"
+#include "crypt0_ripemd160.h"
+#include "crypt0_ripemd160_impl.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef CRYPT0_SHA2_X86
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2,bmi2")))
+#endif
+
+//-----------------------------------------------------------------------------
+// Multi-buffer hash160 / double sha256
+//
+// All inputs have the same length, so every lane has the same padding layout
+// and block count and the lanes run the exact same instruction stream. The
+// sha256 digest is handed to the second stage as words, the intermediate
+// bytes are never formed. The portable kernels interleave BATCH_LANES chains,
+// the avx2 kernels run eight.
+
+#define BATCH_LANES 2
+
+static inline uint32_t load_be32(const uint8_t * p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void store_be32(uint8_t * p, uint32_t v)
+{
+  p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static inline void store_le32(uint8_t * p, uint32_t v)
+{
+  p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static inline uint32_t bswap32(uint32_t v)
+{
+  return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+static inline size_t sha256_nblocks(size_t len)
+{
+  return (len + 9 + CRYPT0_SHA256_BLOCK_BYTES - 1) / CRYPT0_SHA256_BLOCK_BYTES;
+}
+
+// words of block blk of the padded message
+static void sha256_block_words(const uint8_t * msg, size_t len, size_t blk, uint32_t w[16])
+{
+  uint8_t buf[CRYPT0_SHA256_BLOCK_BYTES];
+  size_t off = blk * CRYPT0_SHA256_BLOCK_BYTES;
+  const uint8_t * p = msg + off;
+
+  if (off + CRYPT0_SHA256_BLOCK_BYTES > len) {
+    memset(buf, 0, sizeof(buf));
+    if (off <= len) {
+      memcpy(buf, msg + off, len - off);
+      buf[len - off] = 0x80;
+    }
+    if (blk + 1 == sha256_nblocks(len)) {
+      store_be32(&buf[56], (uint32_t)((uint64_t)len >> 29));
+      store_be32(&buf[60], (uint32_t)len << 3);
+    }
+    p = buf;
+  }
+
+  for (int i = 0; i < 16; i++) {
+    w[i] = load_be32(p + 4 * i);
+  }
+}
+
+// lanes past the last input hash a copy of it, their output is dropped
+static inline const uint8_t * lane_input(const uint8_t * in, size_t len, size_t k, size_t l)
+{
+  return in + (l < k ? l : k - 1) * len;
+}
+
+#ifdef CRYPT0_SHA2_X86
+// A single sha-ni stream already outruns eight avx2 lanes, so while sha-ni is
+// the active kernel the sha256 stage runs lane by lane through it and only
+// ripemd160 is done in lanes. st is indexed [lane][word].
+static inline bool batch_shani(void)
+{
+  return crypt0_sha2_kernel() == CRYPT0_SHA2_KERNEL_SHANI;
+}
+
+static void sha256_shani_lanes(const uint8_t * in, size_t len, size_t k, size_t lanes,
+    uint32_t st[][8])
+{
+  uint8_t tail[2 * CRYPT0_SHA256_BLOCK_BYTES];
+  size_t full = len / CRYPT0_SHA256_BLOCK_BYTES;
+  size_t rest = len % CRYPT0_SHA256_BLOCK_BYTES;
+  size_t tail_len = (sha256_nblocks(len) - full) * CRYPT0_SHA256_BLOCK_BYTES;
+
+  memset(tail, 0, sizeof(tail));
+  tail[rest] = 0x80;
+  store_be32(&tail[tail_len - 8], (uint32_t)((uint64_t)len >> 29));
+  store_be32(&tail[tail_len - 4], (uint32_t)len << 3);
+
+  for (size_t l = 0; l < lanes && l < k; l++) {
+    const uint8_t * msg = in + l * len;
+    memcpy(st[l], crypt0_sha256_iv, sizeof(st[l]));
+    crypt0_sha256_blocks(st[l], msg, full);
+    memcpy(tail, msg + full * CRYPT0_SHA256_BLOCK_BYTES, rest);
+    crypt0_sha256_blocks(st[l], tail, tail_len / CRYPT0_SHA256_BLOCK_BYTES);
+  }
+  for (size_t l = k; l < lanes; l++) {
+    memcpy(st[l], st[k - 1], sizeof(st[l]));
+  }
+}
+
+static void dsha256_shani(const uint8_t * in, size_t len, size_t k, uint8_t * out)
+{
+  uint32_t st[1][8];
+  uint32_t w[16] = { 0 };
+
+  sha256_shani_lanes(in, len, k, 1, st);
+  memcpy(w, st[0], sizeof(st[0]));
+  w[8] = 0x80000000;
+  w[15] = 32 * 8;
+  memcpy(st[0], crypt0_sha256_iv, sizeof(st[0]));
+  crypt0_sha256_compress(st[0], w);
+
+  for (int i = 0; i < 8; i++) {
+    store_be32(out + 4 * i, st[0][i]);
+  }
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Portable lanes, the scalar round macros applied to every lane in turn. The
+// bodies are unrolled by 8 (sha256) and 5 (ripemd160) so the working
+// variables are renamed instead of shuffled, as in crypt0_sha2.c.
+
+#define EXPAND256_LANES(i) \
+  for (int l = 0; l < BATCH_LANES; l++) { \
+    w[(i) & 15][l] += SSIG1_256(w[((i) - 2) & 15][l]) + w[((i) - 7) & 15][l] + \
+                      SSIG0_256(w[((i) - 15) & 15][l]); \
+  }
+
+#define ROUND256_LANES(a, b, c, d, e, f, g, h, i) \
+  for (int l = 0; l < BATCH_LANES; l++) { \
+    ROUND256(a[l], b[l], c[l], d[l], e[l], f[l], g[l], h[l], \
+        crypt0_sha256_k[i] + w[(i) & 15][l]); \
+  }
+
+static void sha256_lanes(uint32_t s[8][BATCH_LANES], uint32_t w[16][BATCH_LANES])
+{
+  uint32_t a[BATCH_LANES], b[BATCH_LANES], c[BATCH_LANES], d[BATCH_LANES];
+  uint32_t e[BATCH_LANES], f[BATCH_LANES], g[BATCH_LANES], h[BATCH_LANES];
+
+  for (int l = 0; l < BATCH_LANES; l++) {
+    a[l] = s[0][l]; b[l] = s[1][l]; c[l] = s[2][l]; d[l] = s[3][l];
+    e[l] = s[4][l]; f[l] = s[5][l]; g[l] = s[6][l]; h[l] = s[7][l];
+  }
+
+  for (int i = 0; i < 64; i += 8) {
+    if (i >= 16) {
+      EXPAND256_LANES(i + 0); EXPAND256_LANES(i + 1);
+      EXPAND256_LANES(i + 2); EXPAND256_LANES(i + 3);
+      EXPAND256_LANES(i + 4); EXPAND256_LANES(i + 5);
+      EXPAND256_LANES(i + 6); EXPAND256_LANES(i + 7);
+    }
+    ROUND256_LANES(a, b, c, d, e, f, g, h, i + 0);
+    ROUND256_LANES(h, a, b, c, d, e, f, g, i + 1);
+    ROUND256_LANES(g, h, a, b, c, d, e, f, i + 2);
+    ROUND256_LANES(f, g, h, a, b, c, d, e, i + 3);
+    ROUND256_LANES(e, f, g, h, a, b, c, d, i + 4);
+    ROUND256_LANES(d, e, f, g, h, a, b, c, i + 5);
+    ROUND256_LANES(c, d, e, f, g, h, a, b, i + 6);
+    ROUND256_LANES(b, c, d, e, f, g, h, a, i + 7);
+  }
+
+  for (int l = 0; l < BATCH_LANES; l++) {
+    s[0][l] += a[l]; s[1][l] += b[l]; s[2][l] += c[l]; s[3][l] += d[l];
+    s[4][l] += e[l]; s[5][l] += f[l]; s[6][l] += g[l]; s[7][l] += h[l];
+  }
+}
+
+// one step of both lines, the next step is called with (e, a, b, c, d)
+#define STEP160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee, i) \
+  for (int l = 0; l < BATCH_LANES; l++) { \
+    a[l] = ROL32(a[l] + rmd_f(j, b[l], c[l], d[l]) + x[rmd_r[i]][l] + rmd_k[j], \
+        rmd_s[i]) + e[l]; \
+    c[l] = ROL32(c[l], 10); \
+    aa[l] = ROL32(aa[l] + rmd_f(4 - (j), bb[l], cc[l], dd[l]) + x[rmd_rr[i]][l] + rmd_kk[j], \
+        rmd_ss[i]) + ee[l]; \
+    cc[l] = ROL32(cc[l], 10); \
+  }
+
+// sixteen steps with f and K fixed, a round leaves the roles rotated by one
+#define ROUND160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee) { \
+  STEP160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 0); \
+  STEP160_LANES(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 1); \
+  STEP160_LANES(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 2); \
+  STEP160_LANES(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 3); \
+  STEP160_LANES(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 4); \
+  STEP160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 5); \
+  STEP160_LANES(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 6); \
+  STEP160_LANES(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 7); \
+  STEP160_LANES(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 8); \
+  STEP160_LANES(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 9); \
+  STEP160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 10); \
+  STEP160_LANES(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 11); \
+  STEP160_LANES(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 12); \
+  STEP160_LANES(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 13); \
+  STEP160_LANES(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 14); \
+  STEP160_LANES(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 15); \
+}
+
+static void ripemd160_lanes(uint32_t h[5][BATCH_LANES], const uint32_t x[16][BATCH_LANES])
+{
+  uint32_t a[BATCH_LANES], b[BATCH_LANES], c[BATCH_LANES], d[BATCH_LANES], e[BATCH_LANES];
+  uint32_t aa[BATCH_LANES], bb[BATCH_LANES], cc[BATCH_LANES], dd[BATCH_LANES], ee[BATCH_LANES];
+
+  for (int l = 0; l < BATCH_LANES; l++) {
+    a[l] = aa[l] = h[0][l]; b[l] = bb[l] = h[1][l]; c[l] = cc[l] = h[2][l];
+    d[l] = dd[l] = h[3][l]; e[l] = ee[l] = h[4][l];
+  }
+
+  ROUND160_LANES(0, a, b, c, d, e, aa, bb, cc, dd, ee);
+  ROUND160_LANES(1, e, a, b, c, d, ee, aa, bb, cc, dd);
+  ROUND160_LANES(2, d, e, a, b, c, dd, ee, aa, bb, cc);
+  ROUND160_LANES(3, c, d, e, a, b, cc, dd, ee, aa, bb);
+  ROUND160_LANES(4, b, c, d, e, a, bb, cc, dd, ee, aa);
+
+  for (int l = 0; l < BATCH_LANES; l++) {
+    uint32_t t = h[1][l] + c[l] + dd[l];
+    h[1][l] = h[2][l] + d[l] + ee[l];
+    h[2][l] = h[3][l] + e[l] + aa[l];
+    h[3][l] = h[4][l] + a[l] + bb[l];
+    h[4][l] = h[0][l] + b[l] + cc[l];
+    h[0][l] = t;
+  }
+}
+
+static void sha256_lanes_msg(const uint8_t * in, size_t len, size_t k,
+    uint32_t s[8][BATCH_LANES])
+{
+  uint32_t w[16][BATCH_LANES];
+  uint32_t tmp[16];
+  size_t nblocks = sha256_nblocks(len);
+
+#ifdef CRYPT0_SHA2_X86
+  if (batch_shani()) {
+    uint32_t st[BATCH_LANES][8];
+    sha256_shani_lanes(in, len, k, BATCH_LANES, st);
+    for (int l = 0; l < BATCH_LANES; l++) {
+      for (int i = 0; i < 8; i++) {
+        s[i][l] = st[l][i];
+      }
+    }
+    return;
+  }
+#endif
+
+  for (int i = 0; i < 8; i++) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+      s[i][l] = crypt0_sha256_iv[i];
+    }
+  }
+
+  for (size_t blk = 0; blk < nblocks; blk++) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+      sha256_block_words(lane_input(in, len, k, l), len, blk, tmp);
+      for (int i = 0; i < 16; i++) {
+        w[i][l] = tmp[i];
+      }
+    }
+    sha256_lanes(s, w);
+  }
+}
+
+static void hash160_lanes(const uint8_t * in, size_t len, size_t k, uint8_t * out)
+{
+  uint32_t s[8][BATCH_LANES];
+  uint32_t x[16][BATCH_LANES];
+  uint32_t h[5][BATCH_LANES];
+
+  sha256_lanes_msg(in, len, k, s);
+
+  // the 32 byte digest is the whole ripemd160 message, its little endian
+  // words are the byte swapped sha256 state
+  memset(x, 0, sizeof(x));
+  for (int l = 0; l < BATCH_LANES; l++) {
+    for (int i = 0; i < 8; i++) {
+      x[i][l] = bswap32(s[i][l]);
+    }
+    x[8][l] = 0x80;
+    x[14][l] = 32 * 8;
+    for (int i = 0; i < 5; i++) {
+      h[i][l] = crypt0_ripemd160_iv[i];
+    }
+  }
+  ripemd160_lanes(h, x);
+
+  for (size_t l = 0; l < k; l++) {
+    for (int i = 0; i < 5; i++) {
+      store_le32(out + 20 * l + 4 * i, h[i][l]);
+    }
+  }
+}
+
+static void dsha256_lanes(const uint8_t * in, size_t len, size_t k, uint8_t * out)
+{
+  uint32_t s[8][BATCH_LANES];
+  uint32_t w[16][BATCH_LANES];
+
+  sha256_lanes_msg(in, len, k, s);
+
+  memset(w, 0, sizeof(w));
+  for (int l = 0; l < BATCH_LANES; l++) {
+    for (int i = 0; i < 8; i++) {
+      w[i][l] = s[i][l];
+      s[i][l] = crypt0_sha256_iv[i];
+    }
+    w[8][l] = 0x80000000;
+    w[15][l] = 32 * 8;
+  }
+  sha256_lanes(s, w);
+
+  for (size_t l = 0; l < k; l++) {
+    for (int i = 0; i < 8; i++) {
+      store_be32(out + 32 * l + 4 * i, s[i][l]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// AVX2, eight lanes, same structure as the portable lanes
+
+#ifdef CRYPT0_SHA2_X86
+
+#define X8_LANES 8
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i rol_x8(__m256i x, int n)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i ror_x8(__m256i x, int n)
+{
+  return rol_x8(x, 32 - n);
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i add3_x8(__m256i x, __m256i y, __m256i z)
+{
+  return _mm256_add_epi32(_mm256_add_epi32(x, y), z);
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i xor3_x8(__m256i x, __m256i y, __m256i z)
+{
+  return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i rmd_f_x8(int j, __m256i x, __m256i y, __m256i z)
+{
+  const __m256i ones = _mm256_set1_epi32(-1);
+
+  switch (j) {
+    case 0:  return xor3_x8(x, y, z);
+    case 1:  return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z));
+    case 2:  return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+    case 3:  return _mm256_or_si256(_mm256_and_si256(x, z), _mm256_andnot_si256(z, y));
+    default: return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+  }
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+void sha256_x8(__m256i s[8], __m256i w[16])
+{
+  __m256i v[8];
+
+  for (int i = 0; i < 8; i++) {
+    v[i] = s[i];
+  }
+
+#pragma GCC unroll 64
+  for (int i = 0; i < 64; i++) {
+    __m256i * a = &v[(0 - i) & 7], * b = &v[(1 - i) & 7];
+    __m256i * c = &v[(2 - i) & 7], * d = &v[(3 - i) & 7];
+    __m256i * e = &v[(4 - i) & 7], * f = &v[(5 - i) & 7];
+    __m256i * g = &v[(6 - i) & 7], * h = &v[(7 - i) & 7];
+
+    if (i >= 16) {
+      __m256i w2 = w[(i - 2) & 15], w15 = w[(i - 15) & 15];
+      __m256i s1 = xor3_x8(ror_x8(w2, 17), ror_x8(w2, 19), _mm256_srli_epi32(w2, 10));
+      __m256i s0 = xor3_x8(ror_x8(w15, 7), ror_x8(w15, 18), _mm256_srli_epi32(w15, 3));
+      w[i & 15] = _mm256_add_epi32(add3_x8(w[i & 15], s1, s0), w[(i - 7) & 15]);
+    }
+
+    __m256i ch = _mm256_xor_si256(_mm256_and_si256(*e, *f), _mm256_andnot_si256(*e, *g));
+    __m256i maj = _mm256_xor_si256(_mm256_and_si256(*a, *b),
+        _mm256_and_si256(*c, _mm256_xor_si256(*a, *b)));
+    __m256i bs1 = xor3_x8(ror_x8(*e, 6), ror_x8(*e, 11), ror_x8(*e, 25));
+    __m256i bs0 = xor3_x8(ror_x8(*a, 2), ror_x8(*a, 13), ror_x8(*a, 22));
+    __m256i t1 = add3_x8(*h, bs1, ch);
+    t1 = add3_x8(t1, _mm256_set1_epi32((int)crypt0_sha256_k[i]), w[i & 15]);
+    *d = _mm256_add_epi32(*d, t1);
+    *h = add3_x8(t1, bs0, maj);
+  }
+
+  for (int i = 0; i < 8; i++) {
+    s[i] = _mm256_add_epi32(s[i], v[i]);
+  }
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+void ripemd160_x8(__m256i h[5], const __m256i x[16])
+{
+  __m256i v[5], vv[5];
+
+  for (int i = 0; i < 5; i++) {
+    v[i] = h[i];
+    vv[i] = h[i];
+  }
+
+#pragma GCC unroll 80
+  for (int i = 0; i < 80; i++) {
+    int j = i >> 4;
+    __m256i * a = &v[4 * i % 5], * b = &v[(4 * i + 1) % 5], * c = &v[(4 * i + 2) % 5];
+    __m256i * d = &v[(4 * i + 3) % 5], * e = &v[(4 * i + 4) % 5];
+    __m256i * aa = &vv[4 * i % 5], * bb = &vv[(4 * i + 1) % 5], * cc = &vv[(4 * i + 2) % 5];
+    __m256i * dd = &vv[(4 * i + 3) % 5], * ee = &vv[(4 * i + 4) % 5];
+
+    __m256i t = add3_x8(*a, rmd_f_x8(j, *b, *c, *d), x[rmd_r[i]]);
+    t = _mm256_add_epi32(t, _mm256_set1_epi32((int)rmd_k[j]));
+    *a = _mm256_add_epi32(rol_x8(t, rmd_s[i]), *e);
+    *c = rol_x8(*c, 10);
+
+    t = add3_x8(*aa, rmd_f_x8(4 - j, *bb, *cc, *dd), x[rmd_rr[i]]);
+    t = _mm256_add_epi32(t, _mm256_set1_epi32((int)rmd_kk[j]));
+    *aa = _mm256_add_epi32(rol_x8(t, rmd_ss[i]), *ee);
+    *cc = rol_x8(*cc, 10);
+  }
+
+  __m256i t = add3_x8(h[1], v[2], vv[3]);
+  h[1] = add3_x8(h[2], v[3], vv[4]);
+  h[2] = add3_x8(h[3], v[4], vv[0]);
+  h[3] = add3_x8(h[4], v[0], vv[1]);
+  h[4] = add3_x8(h[0], v[1], vv[2]);
+  h[0] = t;
+}
+
+AVX2_TARGET
+static void sha256_x8_msg(const uint8_t * in, size_t len, size_t k, __m256i s[8])
+{
+  uint32_t wt[16][X8_LANES] __attribute__((aligned(32)));
+  uint32_t tmp[16];
+  __m256i w[16];
+  size_t nblocks = sha256_nblocks(len);
+
+  if (batch_shani()) {
+    uint32_t st[X8_LANES][8];
+    sha256_shani_lanes(in, len, k, X8_LANES, st);
+    for (int l = 0; l < X8_LANES; l++) {
+      for (int i = 0; i < 8; i++) {
+        wt[i][l] = st[l][i];
+      }
+    }
+    for (int i = 0; i < 8; i++) {
+      s[i] = _mm256_load_si256((const __m256i *)wt[i]);
+    }
+    return;
+  }
+
+  for (int i = 0; i < 8; i++) {
+    s[i] = _mm256_set1_epi32((int)crypt0_sha256_iv[i]);
+  }
+
+  for (size_t blk = 0; blk < nblocks; blk++) {
+    for (int l = 0; l < X8_LANES; l++) {
+      sha256_block_words(lane_input(in, len, k, l), len, blk, tmp);
+      for (int i = 0; i < 16; i++) {
+        wt[i][l] = tmp[i];
+      }
+    }
+    for (int i = 0; i < 16; i++) {
+      w[i] = _mm256_load_si256((const __m256i *)wt[i]);
+    }
+    sha256_x8(s, w);
+  }
+}
+
+AVX2_TARGET
+static void hash160_x8(const uint8_t * in, size_t len, size_t k, uint8_t * out)
+{
+  const __m256i bswap = _mm256_set_epi64x(
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  uint32_t ht[5][X8_LANES] __attribute__((aligned(32)));
+  __m256i s[8], x[16], h[5];
+
+  sha256_x8_msg(in, len, k, s);
+
+  for (int i = 0; i < 8; i++) {
+    x[i] = _mm256_shuffle_epi8(s[i], bswap);
+  }
+  for (int i = 8; i < 16; i++) {
+    x[i] = _mm256_setzero_si256();
+  }
+  x[8] = _mm256_set1_epi32(0x80);
+  x[14] = _mm256_set1_epi32(32 * 8);
+  for (int i = 0; i < 5; i++) {
+    h[i] = _mm256_set1_epi32((int)crypt0_ripemd160_iv[i]);
+  }
+  ripemd160_x8(h, x);
+
+  for (int i = 0; i < 5; i++) {
+    _mm256_store_si256((__m256i *)ht[i], h[i]);
+  }
+  for (size_t l = 0; l < k; l++) {
+    for (int i = 0; i < 5; i++) {
+      store_le32(out + 20 * l + 4 * i, ht[i][l]);
+    }
+  }
+}
+
+AVX2_TARGET
+static void dsha256_x8(const uint8_t * in, size_t len, size_t k, uint8_t * out)
+{
+  uint32_t st[8][X8_LANES] __attribute__((aligned(32)));
+  __m256i s[8], w[16];
+
+  sha256_x8_msg(in, len, k, s);
+
+  for (int i = 0; i < 8; i++) {
+    w[i] = s[i];
+    s[i] = _mm256_set1_epi32((int)crypt0_sha256_iv[i]);
+  }
+  for (int i = 8; i < 16; i++) {
+    w[i] = _mm256_setzero_si256();
+  }
+  w[8] = _mm256_set1_epi32((int)0x80000000);
+  w[15] = _mm256_set1_epi32(32 * 8);
+  sha256_x8(s, w);
+
+  for (int i = 0; i < 8; i++) {
+    _mm256_store_si256((__m256i *)st[i], s[i]);
+  }
+  for (size_t l = 0; l < k; l++) {
+    for (int i = 0; i < 8; i++) {
+      store_be32(out + 32 * l + 4 * i, st[i][l]);
+    }
+  }
+}
+
+// follows crypt0_sha2_kernel_select, forcing the scalar kernel also forces
+// the portable lanes
+static bool batch_x8(void)
+{
+  return crypt0_sha2_kernel() != CRYPT0_SHA2_KERNEL_SCALAR &&
+    (crypt0_sha2_x86_features() & CRYPT0_SHA2_X86_AVX2) != 0;
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+typedef void (*batch_fn)(const uint8_t * in, size_t len, size_t k, uint8_t * out);
+
+static void batch_run(batch_fn fn, size_t lanes, size_t digest_len,
+    const uint8_t * in, size_t len, size_t n, uint8_t * out)
+{
+  while (n) {
+    size_t k = n < lanes ? n : lanes;
+    fn(in, len, k, out);
+    in += k * len;
+    out += k * digest_len;
+    n -= k;
+  }
+}
+
+void crypt0_hash160_batch(const uint8_t * in, size_t len, size_t n, uint8_t * out)
+{
+#ifdef CRYPT0_SHA2_X86
+  if (batch_x8()) {
+    batch_run(hash160_x8, X8_LANES, 20, in, len, n, out);
+    return;
+  }
+#endif
+  batch_run(hash160_lanes, BATCH_LANES, 20, in, len, n, out);
+}
+
+void crypt0_dsha256_batch(const uint8_t * in, size_t len, size_t n, uint8_t * out)
+{
+#ifdef CRYPT0_SHA2_X86
+  if (batch_shani()) {
+    batch_run(dsha256_shani, 1, 32, in, len, n, out);
+    return;
+  }
+  if (batch_x8()) {
+    batch_run(dsha256_x8, X8_LANES, 32, in, len, n, out);
+    return;
+  }
+#endif
+  batch_run(dsha256_lanes, BATCH_LANES, 32, in, len, n, out);
+}
+
+// eof
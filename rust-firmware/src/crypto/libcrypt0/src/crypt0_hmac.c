@@ -1,13 +1,29 @@
 #include "crypt0.h"
+#include "crypt0_hmac.h"
+
+#include <string.h>
 
 #ifdef __ZEPHYR__
 #include <ocrypto_hmac_sha512.h>
 #include <ocrypto_hmac_sha256.h>
-#else 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <openssl/hmac.h>
+#elif defined(CRYPT0_USE_OPENSSL)
+#include "crypt0_openssl.h"
+
+// one shot hmac on the thread's reusable mac context, a NULL key would keep
+// the previous call's key so it is passed as an empty one
+static int ossl_hmac(EVP_MAC_CTX * ctx, const uint8_t * key, uint16_t key_len,
+  const uint8_t * msg, uint16_t msg_len, uint8_t * digest, size_t digest_len)
+{
+  size_t len;
+
+  if (ctx == NULL ||
+      !EVP_MAC_init(ctx, key ? key : (const uint8_t *)"", key_len, NULL) ||
+      !EVP_MAC_update(ctx, msg, msg_len) ||
+      !EVP_MAC_final(ctx, digest, &len, digest_len)) {
+    return CRYPT0_ERR_HMAC_DIGEST;
+  }
+  return CRYPT0_OK;
+}
 #endif
 
 /**
@@ -20,9 +36,13 @@ int crypt0_hmac_sha512(const uint8_t * key, uint16_t key_len,
 #ifdef __ZEPHYR__
   ocrypto_hmac_sha512(digest, key, key_len, msg, msg_len);    
   return CRYPT0_OK;
+#elif defined(CRYPT0_USE_OPENSSL)
+  return ossl_hmac(crypt0_ossl_hmac_sha512_ctx(), key, key_len, msg, msg_len, digest, 64);
 #else
-  unsigned int digest_len;
-  HMAC(EVP_sha512(), key, key_len, msg, msg_len, digest, &digest_len);
+  crypt0_hmac_sha512_ctx ctx;
+  crypt0_hmac_sha512_init(&ctx, key, key_len);
+  crypt0_hmac_sha512_update(&ctx, msg, msg_len);
+  crypt0_hmac_sha512_final(&ctx, digest);
   return CRYPT0_OK;
 #endif
 }
@@ -33,9 +53,142 @@ int crypt0_hmac_sha256(const uint8_t * key, uint16_t key_len,
 #ifdef __ZEPHYR__
   ocrypto_hmac_sha256(digest, key, key_len, msg, msg_len);    
   return CRYPT0_OK;
+#elif defined(CRYPT0_USE_OPENSSL)
+  return ossl_hmac(crypt0_ossl_hmac_sha256_ctx(), key, key_len, msg, msg_len, digest, 32);
 #else
-  unsigned int digest_len;
-  HMAC(EVP_sha256(), key, key_len, msg, msg_len, digest, &digest_len);
+  crypt0_hmac_sha256_ctx ctx;
+  crypt0_hmac_sha256_init(&ctx, key, key_len);
+  crypt0_hmac_sha256_update(&ctx, msg, msg_len);
+  crypt0_hmac_sha256_final(&ctx, digest);
   return CRYPT0_OK;
 #endif
 }
+
+//-----------------------------------------------------------------------------
+// Streaming HMAC on top of the crypt0_sha2 compression functions, the same
+// code runs on both targets. Both pads are compressed in init, the outer hash
+// in final is a single compression of the inner state words.
+
+void crypt0_hmac_sha256_init(crypt0_hmac_sha256_ctx * ctx,
+  const uint8_t * key, size_t key_len)
+{
+  uint8_t pad[CRYPT0_SHA256_BLOCK_BYTES];
+
+  memset(pad, 0, sizeof(pad));
+  if (key_len > CRYPT0_SHA256_BLOCK_BYTES) {
+    crypt0_sha256_init(&ctx->inner);
+    crypt0_sha256_update(&ctx->inner, key, key_len);
+    crypt0_sha256_final(&ctx->inner, pad);
+  } else {
+    memcpy(pad, key, key_len);
+  }
+
+  for (int i = 0; i < CRYPT0_SHA256_BLOCK_BYTES; i++) {
+    pad[i] ^= 0x5c;
+  }
+  memcpy(ctx->ostate, crypt0_sha256_iv, sizeof(ctx->ostate));
+  crypt0_sha256_blocks(ctx->ostate, pad, 1);
+
+  for (int i = 0; i < CRYPT0_SHA256_BLOCK_BYTES; i++) {
+    pad[i] ^= 0x5c ^ 0x36;
+  }
+  crypt0_sha256_init(&ctx->inner);
+  crypt0_sha256_update(&ctx->inner, pad, sizeof(pad));
+
+  crypt0_memzero(pad, sizeof(pad));
+}
+
+void crypt0_hmac_sha256_update(crypt0_hmac_sha256_ctx * ctx,
+  const uint8_t * msg, size_t msg_len)
+{
+  crypt0_sha256_update(&ctx->inner, msg, msg_len);
+}
+
+void crypt0_hmac_sha256_final(crypt0_hmac_sha256_ctx * ctx, uint8_t * digest)
+{
+  uint32_t block[16] = { 0 };
+
+  crypt0_sha256_final(&ctx->inner, digest);
+  memcpy(block, ctx->inner.state, sizeof(ctx->inner.state));
+  block[8] = 0x80000000;
+  block[15] = (CRYPT0_SHA256_BLOCK_BYTES + 32) * 8;
+  crypt0_sha256_compress(ctx->ostate, block);
+
+  for (int i = 0; i < 8; i++) {
+    uint32_t v = ctx->ostate[i];
+    digest[4 * i + 0] = v >> 24; digest[4 * i + 1] = v >> 16;
+    digest[4 * i + 2] = v >> 8;  digest[4 * i + 3] = v;
+  }
+
+  crypt0_memzero(block, sizeof(block));
+  crypt0_memzero(ctx, sizeof(*ctx));
+}
+
+void crypt0_hmac_sha256_clone(crypt0_hmac_sha256_ctx * dst,
+  const crypt0_hmac_sha256_ctx * src)
+{
+  memcpy(dst, src, sizeof(*dst));
+}
+
+//-----------------------------------------------------------------------------
+void crypt0_hmac_sha512_init(crypt0_hmac_sha512_ctx * ctx,
+  const uint8_t * key, size_t key_len)
+{
+  uint8_t pad[CRYPT0_SHA512_BLOCK_BYTES];
+
+  memset(pad, 0, sizeof(pad));
+  if (key_len > CRYPT0_SHA512_BLOCK_BYTES) {
+    crypt0_sha512_init(&ctx->inner);
+    crypt0_sha512_update(&ctx->inner, key, key_len);
+    crypt0_sha512_final(&ctx->inner, pad);
+  } else {
+    memcpy(pad, key, key_len);
+  }
+
+  for (int i = 0; i < CRYPT0_SHA512_BLOCK_BYTES; i++) {
+    pad[i] ^= 0x5c;
+  }
+  memcpy(ctx->ostate, crypt0_sha512_iv, sizeof(ctx->ostate));
+  crypt0_sha512_blocks(ctx->ostate, pad, 1);
+
+  for (int i = 0; i < CRYPT0_SHA512_BLOCK_BYTES; i++) {
+    pad[i] ^= 0x5c ^ 0x36;
+  }
+  crypt0_sha512_init(&ctx->inner);
+  crypt0_sha512_update(&ctx->inner, pad, sizeof(pad));
+
+  crypt0_memzero(pad, sizeof(pad));
+}
+
+void crypt0_hmac_sha512_update(crypt0_hmac_sha512_ctx * ctx,
+  const uint8_t * msg, size_t msg_len)
+{
+  crypt0_sha512_update(&ctx->inner, msg, msg_len);
+}
+
+void crypt0_hmac_sha512_final(crypt0_hmac_sha512_ctx * ctx, uint8_t * digest)
+{
+  uint64_t block[16] = { 0 };
+
+  crypt0_sha512_final(&ctx->inner, digest);
+  memcpy(block, ctx->inner.state, sizeof(ctx->inner.state));
+  block[8] = 0x8000000000000000ULL;
+  block[15] = (CRYPT0_SHA512_BLOCK_BYTES + 64) * 8;
+  crypt0_sha512_compress(ctx->ostate, block);
+
+  for (int i = 0; i < 8; i++) {
+    uint64_t v = ctx->ostate[i];
+    for (int j = 0; j < 8; j++) {
+      digest[8 * i + j] = v >> (56 - 8 * j);
+    }
+  }
+
+  crypt0_memzero(block, sizeof(block));
+  crypt0_memzero(ctx, sizeof(*ctx));
+}
+
+void crypt0_hmac_sha512_clone(crypt0_hmac_sha512_ctx * dst,
+  const crypt0_hmac_sha512_ctx * src)
+{
+  memcpy(dst, src, sizeof(*dst));
+}
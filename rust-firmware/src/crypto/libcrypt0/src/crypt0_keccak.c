@@ -0,0 +1,327 @@
+#include "crypt0_keccak.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+// The permutation comes in three flavours, all working on the same 25 lane
+// state so the SHA3IUF sponge can call any of them:
+//   ref  the loop based code SHA3IUF shipped with, kept to test against
+//   lc   fully unrolled 64-bit rounds with lane complementing (Keccak team
+//        implementation overview, section 2.2), six lanes are stored
+//        inverted so chi needs one NOT per row instead of five
+//   bi   bit-interleaved 32-bit lanes: even and odd bits of every lane in
+//        two words so each 64-bit rotate is two 32-bit rotates, which are
+//        free on Cortex-M as part of the next instruction
+
+#ifndef CRYPT0_KECCAK_IMPL
+#if UINTPTR_MAX > 0xffffffffu
+#define CRYPT0_KECCAK_IMPL CRYPT0_KECCAK_IMPL_LC
+#else
+#define CRYPT0_KECCAK_IMPL CRYPT0_KECCAK_IMPL_BI
+#endif
+#endif
+
+#define KECCAK_ROUNDS 24
+
+#define ROL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+static inline uint32_t rol32(uint32_t x, unsigned n)
+{
+  return (x << n) | (x >> ((32 - n) & 31));
+}
+
+static const uint64_t keccakf_rndc[KECCAK_ROUNDS] = {
+  0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+  0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+  0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+  0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+  0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+  0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+//-----------------------------------------------------------------------------
+// Reference
+
+static const unsigned keccakf_rotc[24] = {
+  1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62,
+  18, 39, 61, 20, 44
+};
+
+static const unsigned keccakf_piln[24] = {
+  10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20,
+  14, 22, 9, 6, 1
+};
+
+void crypt0_keccakf1600_ref(uint64_t s[25])
+{
+  int i, j, round;
+  uint64_t t, bc[5];
+
+  for (round = 0; round < KECCAK_ROUNDS; round++) {
+    // theta
+    for (i = 0; i < 5; i++) {
+      bc[i] = s[i] ^ s[i + 5] ^ s[i + 10] ^ s[i + 15] ^ s[i + 20];
+    }
+    for (i = 0; i < 5; i++) {
+      t = bc[(i + 4) % 5] ^ ROL64(bc[(i + 1) % 5], 1);
+      for (j = 0; j < 25; j += 5) {
+        s[j + i] ^= t;
+      }
+    }
+
+    // rho pi
+    t = s[1];
+    for (i = 0; i < 24; i++) {
+      j = keccakf_piln[i];
+      bc[0] = s[j];
+      s[j] = ROL64(t, keccakf_rotc[i]);
+      t = bc[0];
+    }
+
+    // chi
+    for (j = 0; j < 25; j += 5) {
+      for (i = 0; i < 5; i++) {
+        bc[i] = s[j + i];
+      }
+      for (i = 0; i < 5; i++) {
+        s[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+      }
+    }
+
+    // iota
+    s[0] ^= keccakf_rndc[round];
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Lane complementing, 64-bit
+//
+// Lanes are named by row (b g k m s = y 0..4) and column (a e i o u = x 0..4).
+// be bi go ki mi sa are kept inverted between rounds.
+
+#define LC_ROUND(A, E, rc) { \
+  uint64_t Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du; \
+  uint64_t B0, B1, B2, B3, B4; \
+  Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+  Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+  Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+  Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+  Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+  Da = Cu ^ ROL64(Ce, 1); \
+  De = Ca ^ ROL64(Ci, 1); \
+  Di = Ce ^ ROL64(Co, 1); \
+  Do = Ci ^ ROL64(Cu, 1); \
+  Du = Co ^ ROL64(Ca, 1); \
+  \
+  B0 = A##ba ^ Da; \
+  B1 = ROL64(A##ge ^ De, 44); \
+  B2 = ROL64(A##ki ^ Di, 43); \
+  B3 = ROL64(A##mo ^ Do, 21); \
+  B4 = ROL64(A##su ^ Du, 14); \
+  E##ba = B0 ^ (B1 | B2) ^ (rc); \
+  E##be = B1 ^ (~B2 | B3); \
+  E##bi = B2 ^ (B3 & B4); \
+  E##bo = B3 ^ (B4 | B0); \
+  E##bu = B4 ^ (B0 & B1); \
+  \
+  B0 = ROL64(A##bo ^ Do, 28); \
+  B1 = ROL64(A##gu ^ Du, 20); \
+  B2 = ROL64(A##ka ^ Da, 3); \
+  B3 = ROL64(A##me ^ De, 45); \
+  B4 = ROL64(A##si ^ Di, 61); \
+  E##ga = B0 ^ (B1 | B2); \
+  E##ge = B1 ^ (B2 & B3); \
+  E##gi = B2 ^ (B3 | ~B4); \
+  E##go = B3 ^ (B4 | B0); \
+  E##gu = B4 ^ (B0 & B1); \
+  \
+  B0 = ROL64(A##be ^ De, 1); \
+  B1 = ROL64(A##gi ^ Di, 6); \
+  B2 = ROL64(A##ko ^ Do, 25); \
+  B3 = ROL64(A##mu ^ Du, 8); \
+  B4 = ROL64(A##sa ^ Da, 18); \
+  E##ka = B0 ^ (B1 | B2); \
+  E##ke = B1 ^ (B2 & B3); \
+  E##ki = B2 ^ (~B3 & B4); \
+  E##ko = ~B3 ^ (B4 | B0); \
+  E##ku = B4 ^ (B0 & B1); \
+  \
+  B0 = ROL64(A##bu ^ Du, 27); \
+  B1 = ROL64(A##ga ^ Da, 36); \
+  B2 = ROL64(A##ke ^ De, 10); \
+  B3 = ROL64(A##mi ^ Di, 15); \
+  B4 = ROL64(A##so ^ Do, 56); \
+  E##ma = B0 ^ (B1 & B2); \
+  E##me = B1 ^ (B2 | B3); \
+  E##mi = B2 ^ (~B3 | B4); \
+  E##mo = ~B3 ^ (B4 & B0); \
+  E##mu = B4 ^ (B0 | B1); \
+  \
+  B0 = ROL64(A##bi ^ Di, 62); \
+  B1 = ROL64(A##go ^ Do, 55); \
+  B2 = ROL64(A##ku ^ Du, 39); \
+  B3 = ROL64(A##ma ^ Da, 41); \
+  B4 = ROL64(A##se ^ De, 2); \
+  E##sa = B0 ^ (~B1 & B2); \
+  E##se = ~B1 ^ (B2 | B3); \
+  E##si = B2 ^ (B3 & B4); \
+  E##so = B3 ^ (B4 | B0); \
+  E##su = B4 ^ (B0 & B1); \
+}
+
+void crypt0_keccakf1600_lc(uint64_t s[25])
+{
+  uint64_t Aba = s[0],  Abe = ~s[1],  Abi = ~s[2],  Abo = s[3],   Abu = s[4];
+  uint64_t Aga = s[5],  Age = s[6],   Agi = s[7],   Ago = ~s[8],  Agu = s[9];
+  uint64_t Aka = s[10], Ake = s[11],  Aki = ~s[12], Ako = s[13],  Aku = s[14];
+  uint64_t Ama = s[15], Ame = s[16],  Ami = ~s[17], Amo = s[18],  Amu = s[19];
+  uint64_t Asa = ~s[20], Ase = s[21], Asi = s[22],  Aso = s[23],  Asu = s[24];
+  uint64_t Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;
+  uint64_t Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+
+  for (int round = 0; round < KECCAK_ROUNDS; round += 2) {
+    LC_ROUND(A, E, keccakf_rndc[round]);
+    LC_ROUND(E, A, keccakf_rndc[round + 1]);
+  }
+
+  s[0] = Aba;   s[1] = ~Abe;  s[2] = ~Abi;  s[3] = Abo;   s[4] = Abu;
+  s[5] = Aga;   s[6] = Age;   s[7] = Agi;   s[8] = ~Ago;  s[9] = Agu;
+  s[10] = Aka;  s[11] = Ake;  s[12] = ~Aki; s[13] = Ako;  s[14] = Aku;
+  s[15] = Ama;  s[16] = Ame;  s[17] = ~Ami; s[18] = Amo;  s[19] = Amu;
+  s[20] = ~Asa; s[21] = Ase;  s[22] = Asi;  s[23] = Aso;  s[24] = Asu;
+}
+
+//-----------------------------------------------------------------------------
+// Bit-interleaved, 32-bit
+//
+// A 64-bit rotate by 2n is a rotate of both halves by n, by 2n + 1 it also
+// swaps them. Lanes are converted on the way in and out of every
+// permutation, which costs a few percent of one permutation and keeps the
+// sponge state in the plain layout.
+
+// interleaved round constants, { even bits, odd bits }
+static const uint32_t keccakf_rndc_bi[KECCAK_ROUNDS][2] = {
+  { 0x00000001, 0x00000000 }, { 0x00000000, 0x00000089 }, { 0x00000000, 0x8000008b }, { 0x00000000, 0x80008080 },
+  { 0x00000001, 0x0000008b }, { 0x00000001, 0x00008000 }, { 0x00000001, 0x80008088 }, { 0x00000001, 0x80000082 },
+  { 0x00000000, 0x0000000b }, { 0x00000000, 0x0000000a }, { 0x00000001, 0x00008082 }, { 0x00000000, 0x00008003 },
+  { 0x00000001, 0x0000808b }, { 0x00000001, 0x8000000b }, { 0x00000001, 0x8000008a }, { 0x00000001, 0x80000081 },
+  { 0x00000000, 0x80000081 }, { 0x00000000, 0x80000008 }, { 0x00000000, 0x00000083 }, { 0x00000000, 0x80008003 },
+  { 0x00000001, 0x80008088 }, { 0x00000000, 0x80000088 }, { 0x00000001, 0x00008000 }, { 0x00000000, 0x80008082 },
+};
+
+// gathers the even bits of x into the low half and the odd bits into the high half
+static inline uint32_t unzip32(uint32_t x)
+{
+  uint32_t t;
+  t = (x ^ (x >> 1)) & 0x22222222; x ^= t ^ (t << 1);
+  t = (x ^ (x >> 2)) & 0x0c0c0c0c; x ^= t ^ (t << 2);
+  t = (x ^ (x >> 4)) & 0x00f000f0; x ^= t ^ (t << 4);
+  t = (x ^ (x >> 8)) & 0x0000ff00; x ^= t ^ (t << 8);
+  return x;
+}
+
+static inline uint32_t zip32(uint32_t x)
+{
+  uint32_t t;
+  t = (x ^ (x >> 8)) & 0x0000ff00; x ^= t ^ (t << 8);
+  t = (x ^ (x >> 4)) & 0x00f000f0; x ^= t ^ (t << 4);
+  t = (x ^ (x >> 2)) & 0x0c0c0c0c; x ^= t ^ (t << 2);
+  t = (x ^ (x >> 1)) & 0x22222222; x ^= t ^ (t << 1);
+  return x;
+}
+
+// lane i ^ d, rotated left by r, into b[j]
+#define RHO_PI(i, j, x, r) { \
+  uint32_t le = a[i][0] ^ d[x][0]; \
+  uint32_t lo = a[i][1] ^ d[x][1]; \
+  if ((r) & 1) { \
+    b[j][0] = rol32(lo, ((r) + 1) / 2); \
+    b[j][1] = rol32(le, (r) / 2); \
+  } else { \
+    b[j][0] = rol32(le, (r) / 2); \
+    b[j][1] = rol32(lo, (r) / 2); \
+  } \
+}
+
+void crypt0_keccakf1600_bi(uint64_t s[25])
+{
+  uint32_t a[25][2];
+  uint32_t b[25][2];
+  uint32_t c[5][2];
+  uint32_t d[5][2];
+
+  for (int i = 0; i < 25; i++) {
+    uint32_t lo = unzip32((uint32_t)s[i]);
+    uint32_t hi = unzip32((uint32_t)(s[i] >> 32));
+    a[i][0] = (lo & 0x0000ffff) | (hi << 16);
+    a[i][1] = (lo >> 16) | (hi & 0xffff0000);
+  }
+
+  for (int round = 0; round < KECCAK_ROUNDS; round++) {
+    // theta
+    for (int x = 0; x < 5; x++) {
+      c[x][0] = a[x][0] ^ a[x + 5][0] ^ a[x + 10][0] ^ a[x + 15][0] ^ a[x + 20][0];
+      c[x][1] = a[x][1] ^ a[x + 5][1] ^ a[x + 10][1] ^ a[x + 15][1] ^ a[x + 20][1];
+    }
+    for (int x = 0; x < 5; x++) {
+      d[x][0] = c[(x + 4) % 5][0] ^ rol32(c[(x + 1) % 5][1], 1);
+      d[x][1] = c[(x + 4) % 5][1] ^ c[(x + 1) % 5][0];
+    }
+
+    // rho pi, source lane, destination lane, column, rotation
+    RHO_PI( 0,  0, 0,  0); RHO_PI( 1, 10, 1,  1); RHO_PI( 2, 20, 2, 62); RHO_PI( 3,  5, 3, 28); RHO_PI( 4, 15, 4, 27);
+    RHO_PI( 5, 16, 0, 36); RHO_PI( 6,  1, 1, 44); RHO_PI( 7, 11, 2,  6); RHO_PI( 8, 21, 3, 55); RHO_PI( 9,  6, 4, 20);
+    RHO_PI(10,  7, 0,  3); RHO_PI(11, 17, 1, 10); RHO_PI(12,  2, 2, 43); RHO_PI(13, 12, 3, 25); RHO_PI(14, 22, 4, 39);
+    RHO_PI(15, 23, 0, 41); RHO_PI(16,  8, 1, 45); RHO_PI(17, 18, 2, 15); RHO_PI(18,  3, 3, 21); RHO_PI(19, 13, 4,  8);
+    RHO_PI(20, 14, 0, 18); RHO_PI(21, 24, 1,  2); RHO_PI(22,  9, 2, 61); RHO_PI(23, 19, 3, 56); RHO_PI(24,  4, 4, 14);
+
+    // chi
+    for (int y = 0; y < 25; y += 5) {
+      for (int h = 0; h < 2; h++) {
+        uint32_t b0 = b[y][h], b1 = b[y + 1][h], b2 = b[y + 2][h];
+        uint32_t b3 = b[y + 3][h], b4 = b[y + 4][h];
+        a[y][h]     = b0 ^ (~b1 & b2);
+        a[y + 1][h] = b1 ^ (~b2 & b3);
+        a[y + 2][h] = b2 ^ (~b3 & b4);
+        a[y + 3][h] = b3 ^ (~b4 & b0);
+        a[y + 4][h] = b4 ^ (~b0 & b1);
+      }
+    }
+
+    // iota
+    a[0][0] ^= keccakf_rndc_bi[round][0];
+    a[0][1] ^= keccakf_rndc_bi[round][1];
+  }
+
+  for (int i = 0; i < 25; i++) {
+    uint32_t lo = zip32((a[i][0] & 0x0000ffff) | (a[i][1] << 16));
+    uint32_t hi = zip32((a[i][0] >> 16) | (a[i][1] & 0xffff0000));
+    s[i] = ((uint64_t)hi << 32) | lo;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void crypt0_keccakf1600(uint64_t state[25])
+{
+#if CRYPT0_KECCAK_IMPL == CRYPT0_KECCAK_IMPL_REF
+  crypt0_keccakf1600_ref(state);
+#elif CRYPT0_KECCAK_IMPL == CRYPT0_KECCAK_IMPL_LC
+  crypt0_keccakf1600_lc(state);
+#else
+  crypt0_keccakf1600_bi(state);
+#endif
+}
+
+const char * crypt0_keccakf1600_impl(void)
+{
+#if CRYPT0_KECCAK_IMPL == CRYPT0_KECCAK_IMPL_REF
+  return "ref";
+#elif CRYPT0_KECCAK_IMPL == CRYPT0_KECCAK_IMPL_LC
+  return "lc";
+#else
+  return "bi";
+#endif
+}
+
+// eof
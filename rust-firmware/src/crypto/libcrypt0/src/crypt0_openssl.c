@@ -0,0 +1,185 @@
+#include "crypt0.h"
+#include "crypt0_openssl.h"
+
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
+
+// EC_KEY is deprecated in OpenSSL 3 but ECDSA_do_sign still takes one
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/obj_mac.h>
+
+//-----------------------------------------------------------------------------
+// Process wide handles
+
+static CRYPTO_ONCE m_handles_once = CRYPTO_ONCE_STATIC_INIT;
+
+static EVP_MD * m_sha256;
+static EVP_MD * m_sha512;
+static EVP_CIPHER * m_aes_256_ccm;
+static EVP_MAC * m_hmac;
+static EC_GROUP * m_secp256k1;
+static BIGNUM * m_order;
+static BIGNUM * m_half_order;
+
+static void handles_init(void)
+{
+  m_sha256 = EVP_MD_fetch(NULL, "SHA256", NULL);
+  m_sha512 = EVP_MD_fetch(NULL, "SHA512", NULL);
+  m_aes_256_ccm = EVP_CIPHER_fetch(NULL, "AES-256-CCM", NULL);
+  m_hmac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+
+  m_secp256k1 = EC_GROUP_new_by_curve_name(NID_secp256k1);
+  m_order = BN_new();
+  m_half_order = BN_new();
+  if (m_secp256k1 && m_order && m_half_order &&
+      EC_GROUP_get_order(m_secp256k1, m_order, NULL)) {
+    BN_rshift1(m_half_order, m_order);
+  }
+}
+
+static void handles(void)
+{
+  CRYPTO_THREAD_run_once(&m_handles_once, handles_init);
+}
+
+const EVP_MD * crypt0_ossl_sha256(void)
+{
+  handles();
+  return m_sha256;
+}
+
+const EVP_MD * crypt0_ossl_sha512(void)
+{
+  handles();
+  return m_sha512;
+}
+
+const EVP_CIPHER * crypt0_ossl_aes_256_ccm(void)
+{
+  handles();
+  return m_aes_256_ccm;
+}
+
+const EC_GROUP * crypt0_ossl_secp256k1(void)
+{
+  handles();
+  return m_secp256k1;
+}
+
+const BIGNUM * crypt0_ossl_secp256k1_order(void)
+{
+  handles();
+  return m_order;
+}
+
+const BIGNUM * crypt0_ossl_secp256k1_half_order(void)
+{
+  handles();
+  return m_half_order;
+}
+
+//-----------------------------------------------------------------------------
+// Per thread contexts, created on first use
+
+static _Thread_local EVP_MD_CTX * t_md_ctx;
+static _Thread_local EVP_CIPHER_CTX * t_cipher_ctx;
+static _Thread_local EVP_MAC_CTX * t_hmac_sha256_ctx;
+static _Thread_local EVP_MAC_CTX * t_hmac_sha512_ctx;
+static _Thread_local BIGNUM * t_bn;
+static _Thread_local EC_KEY * t_key;
+
+EVP_MD_CTX * crypt0_ossl_md_ctx(void)
+{
+  if (t_md_ctx == NULL) {
+    t_md_ctx = EVP_MD_CTX_new();
+  }
+  return t_md_ctx;
+}
+
+EVP_CIPHER_CTX * crypt0_ossl_cipher_ctx(void)
+{
+  if (t_cipher_ctx == NULL) {
+    t_cipher_ctx = EVP_CIPHER_CTX_new();
+  }
+  return t_cipher_ctx;
+}
+
+static EVP_MAC_CTX * hmac_ctx_new(const char * digest)
+{
+  OSSL_PARAM params[2];
+  EVP_MAC_CTX * ctx;
+
+  handles();
+  if (m_hmac == NULL || (ctx = EVP_MAC_CTX_new(m_hmac)) == NULL) {
+    return NULL;
+  }
+  params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *)digest, 0);
+  params[1] = OSSL_PARAM_construct_end();
+  if (!EVP_MAC_CTX_set_params(ctx, params)) {
+    EVP_MAC_CTX_free(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+EVP_MAC_CTX * crypt0_ossl_hmac_sha256_ctx(void)
+{
+  if (t_hmac_sha256_ctx == NULL) {
+    t_hmac_sha256_ctx = hmac_ctx_new("SHA256");
+  }
+  return t_hmac_sha256_ctx;
+}
+
+EVP_MAC_CTX * crypt0_ossl_hmac_sha512_ctx(void)
+{
+  if (t_hmac_sha512_ctx == NULL) {
+    t_hmac_sha512_ctx = hmac_ctx_new("SHA512");
+  }
+  return t_hmac_sha512_ctx;
+}
+
+BIGNUM * crypt0_ossl_bn(void)
+{
+  if (t_bn == NULL) {
+    t_bn = BN_secure_new();
+  }
+  return t_bn;
+}
+
+EC_KEY * crypt0_ossl_secp256k1_key(void)
+{
+  if (t_key == NULL && crypt0_ossl_secp256k1() != NULL) {
+    t_key = EC_KEY_new();
+    if (t_key && !EC_KEY_set_group(t_key, crypt0_ossl_secp256k1())) {
+      EC_KEY_free(t_key);
+      t_key = NULL;
+    }
+  }
+  return t_key;
+}
+
+void crypt0_ossl_thread_release(void)
+{
+  EVP_MD_CTX_free(t_md_ctx);
+  EVP_CIPHER_CTX_free(t_cipher_ctx);
+  EVP_MAC_CTX_free(t_hmac_sha256_ctx);
+  EVP_MAC_CTX_free(t_hmac_sha512_ctx);
+  BN_clear_free(t_bn);
+  EC_KEY_free(t_key);
+
+  t_md_ctx = NULL;
+  t_cipher_ctx = NULL;
+  t_hmac_sha256_ctx = NULL;
+  t_hmac_sha512_ctx = NULL;
+  t_bn = NULL;
+  t_key = NULL;
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+// eof
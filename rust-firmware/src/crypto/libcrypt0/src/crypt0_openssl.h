@@ -0,0 +1,43 @@
+#ifndef __crypt0_openssl_h_included__
+#define __crypt0_openssl_h_included__
+
+/**
+ * Internal to the OpenSSL backend: algorithm handles fetched once per process
+ * and working contexts kept per thread, so a call does not fetch algorithms
+ * or build curve groups and contexts from scratch.
+ */
+
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+
+/** Shared, read only handles */
+const EVP_MD * crypt0_ossl_sha256(void);
+const EVP_MD * crypt0_ossl_sha512(void);
+const EVP_CIPHER * crypt0_ossl_aes_256_ccm(void);
+const EC_GROUP * crypt0_ossl_secp256k1(void);
+const BIGNUM * crypt0_ossl_secp256k1_order(void);
+const BIGNUM * crypt0_ossl_secp256k1_half_order(void);
+
+/**
+ * Contexts owned by the calling thread. They are reinitialized by the next
+ * init call and must not be freed or kept across calls.
+ */
+EVP_MD_CTX * crypt0_ossl_md_ctx(void);
+EVP_CIPHER_CTX * crypt0_ossl_cipher_ctx(void);
+EVP_MAC_CTX * crypt0_ossl_hmac_sha256_ctx(void);
+EVP_MAC_CTX * crypt0_ossl_hmac_sha512_ctx(void);
+
+/** Scratch number, cleared by the callers after use */
+BIGNUM * crypt0_ossl_bn(void);
+/** Key on secp256k1, the caller sets and clears the private key */
+EC_KEY * crypt0_ossl_secp256k1_key(void);
+
+/** Frees the calling thread's contexts */
+void crypt0_ossl_thread_release(void);
+
+#endif
+
+#endif//__crypt0_openssl_h_included__
@@ -1,20 +1,270 @@
 #include "crypt0_pbkdf2.h"
 
 #include "crypt0.h"
-#include "crypt0_byteorder.h"
 #include "crypt0_hmac.h"
+#include "crypt0_sha2.h"
 
 #include <string.h>
 
-int crypt0_pbkdf2_hmac_sha256(int i, const uint8_t * pass, uint16_t pass_len, 
-  const uint8_t * salt, uint16_t salt_len, uint8_t * key, uint16_t key_len)
+//-----------------------------------------------------------------------------
+// PBKDF2 engine
+//
+// HMAC(P, m) = H(P ^ opad || H(P ^ ipad || m)), the ipad and opad blocks only
+// depend on the password, so they are compressed once and the resulting
+// midstates are reused by every iteration. From the second iteration on the
+// message U_i is exactly one digest long, so both the inner and the outer hash
+// are a single compression of a block built directly from words - U_i and the
+// accumulator T never leave word form until the key is written out.
+
+static inline void store_be32(uint8_t * p, uint32_t v)
+{
+  p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static inline void store_be64(uint8_t * p, uint64_t v)
+{
+  store_be32(p, v >> 32);
+  store_be32(p + 4, (uint32_t)v);
+}
+
+//-----------------------------------------------------------------------------
+static void pbkdf2_sha256_pads(const uint8_t * pass, uint16_t pass_len,
+    uint32_t istate[8], uint32_t ostate[8])
+{
+  crypt0_hmac_sha256_ctx hmac;
+
+  crypt0_hmac_sha256_init(&hmac, pass, pass_len);
+  memcpy(istate, hmac.inner.state, sizeof(hmac.inner.state));
+  memcpy(ostate, hmac.ostate, sizeof(hmac.ostate));
+  crypt0_memzero(&hmac, sizeof(hmac));
+}
+
+// U_1 = HMAC(P, S || INT(1)), the only iteration with a variable length message
+static void pbkdf2_sha256_first(const uint32_t istate[8], const uint32_t ostate[8],
+    const uint8_t * salt, uint16_t salt_len, uint32_t u[8])
+{
+  uint8_t buf[2 * CRYPT0_SHA256_BLOCK_BYTES];
+  uint32_t block[16];
+  uint32_t h[8];
+  size_t len = salt_len + 4;
+  size_t nblocks = (len + 9 + CRYPT0_SHA256_BLOCK_BYTES - 1) / CRYPT0_SHA256_BLOCK_BYTES;
+
+  memset(buf, 0, sizeof(buf));
+  memcpy(buf, salt, salt_len);
+  store_be32(&buf[salt_len], 1);
+  buf[len] = 0x80;
+  store_be64(&buf[nblocks * CRYPT0_SHA256_BLOCK_BYTES - 8],
+      (uint64_t)(CRYPT0_SHA256_BLOCK_BYTES + len) * 8);
+
+  memcpy(h, istate, sizeof(h));
+  crypt0_sha256_blocks(h, buf, nblocks);
+
+  memset(block, 0, sizeof(block));
+  memcpy(block, h, sizeof(h));
+  block[8] = 0x80000000;
+  block[15] = (CRYPT0_SHA256_BLOCK_BYTES + 32) * 8;
+  memcpy(u, ostate, sizeof(h));
+  crypt0_sha256_compress(u, block);
+}
+
+// U_i = HMAC(P, U_i-1), both compressions take a block assembled from words
+static void pbkdf2_sha256_next(const uint32_t istate[8], const uint32_t ostate[8],
+    uint32_t u[8])
+{
+  uint32_t block[16] = { 0 };
+
+  memcpy(block, u, 8 * sizeof(uint32_t));
+  block[8] = 0x80000000;
+  block[15] = (CRYPT0_SHA256_BLOCK_BYTES + 32) * 8;
+  memcpy(u, istate, 8 * sizeof(uint32_t));
+  crypt0_sha256_compress(u, block);
+
+  memcpy(block, u, 8 * sizeof(uint32_t));
+  memcpy(u, ostate, 8 * sizeof(uint32_t));
+  crypt0_sha256_compress(u, block);
+}
+
+//-----------------------------------------------------------------------------
+static void pbkdf2_sha512_pads(const uint8_t * pass, uint16_t pass_len,
+    uint64_t istate[8], uint64_t ostate[8])
+{
+  crypt0_hmac_sha512_ctx hmac;
+
+  crypt0_hmac_sha512_init(&hmac, pass, pass_len);
+  memcpy(istate, hmac.inner.state, sizeof(hmac.inner.state));
+  memcpy(ostate, hmac.ostate, sizeof(hmac.ostate));
+  crypt0_memzero(&hmac, sizeof(hmac));
+}
+
+static void pbkdf2_sha512_first(const uint64_t istate[8], const uint64_t ostate[8],
+    const uint8_t * salt, uint16_t salt_len, uint64_t u[8])
+{
+  uint8_t buf[2 * CRYPT0_SHA512_BLOCK_BYTES];
+  uint64_t block[16];
+  uint64_t h[8];
+  size_t len = salt_len + 4;
+  size_t nblocks = (len + 17 + CRYPT0_SHA512_BLOCK_BYTES - 1) / CRYPT0_SHA512_BLOCK_BYTES;
+
+  memset(buf, 0, sizeof(buf));
+  memcpy(buf, salt, salt_len);
+  store_be32(&buf[salt_len], 1);
+  buf[len] = 0x80;
+  store_be64(&buf[nblocks * CRYPT0_SHA512_BLOCK_BYTES - 8],
+      (uint64_t)(CRYPT0_SHA512_BLOCK_BYTES + len) * 8);
+
+  memcpy(h, istate, sizeof(h));
+  crypt0_sha512_blocks(h, buf, nblocks);
+
+  memset(block, 0, sizeof(block));
+  memcpy(block, h, sizeof(h));
+  block[8] = 0x8000000000000000ULL;
+  block[15] = (CRYPT0_SHA512_BLOCK_BYTES + 64) * 8;
+  memcpy(u, ostate, sizeof(h));
+  crypt0_sha512_compress(u, block);
+}
+
+static void pbkdf2_sha512_next(const uint64_t istate[8], const uint64_t ostate[8],
+    uint64_t u[8])
+{
+  uint64_t block[16] = { 0 };
+
+  memcpy(block, u, 8 * sizeof(uint64_t));
+  block[8] = 0x8000000000000000ULL;
+  block[15] = (CRYPT0_SHA512_BLOCK_BYTES + 64) * 8;
+  memcpy(u, istate, 8 * sizeof(uint64_t));
+  crypt0_sha512_compress(u, block);
+
+  memcpy(block, u, 8 * sizeof(uint64_t));
+  memcpy(u, ostate, 8 * sizeof(uint64_t));
+  crypt0_sha512_compress(u, block);
+}
+
+//-----------------------------------------------------------------------------
+// Resumable state
+//
+// init keys the pads and computes U_1, step runs the remaining iterations in
+// caller sized slices, so a 100k iteration seed can be spread over frames
+// without paying the setup again.
+
+int crypt0_pbkdf2_init(crypt0_pbkdf2_ctx * ctx, crypt0_pbkdf2_hash_t hash,
+  uint32_t iterations, const uint8_t * pass, uint16_t pass_len,
+  const uint8_t * salt, uint16_t salt_len)
 {
 	crypt0_init();
 
-  uint8_t salt_tmp[68];
-  uint8_t digest[32];
+  memset(ctx, 0, sizeof(*ctx));
 
-  if (salt_len > 64) {
+  if (salt_len > CRYPT0_PBKDF2_SALT_MAXBYTES) {
+    return CRYPT0_ERR_SALTLEN;
+  }
+
+  if (iterations < 1) {
+    return CRYPT0_ERR_FMT;
+  }
+
+  if (hash == CRYPT0_PBKDF2_HMAC_SHA256) {
+    pbkdf2_sha256_pads(pass, pass_len, ctx->s.sha256.istate, ctx->s.sha256.ostate);
+    pbkdf2_sha256_first(ctx->s.sha256.istate, ctx->s.sha256.ostate,
+        salt, salt_len, ctx->s.sha256.u);
+    memcpy(ctx->s.sha256.t, ctx->s.sha256.u, sizeof(ctx->s.sha256.t));
+  } else if (hash == CRYPT0_PBKDF2_HMAC_SHA512) {
+    pbkdf2_sha512_pads(pass, pass_len, ctx->s.sha512.istate, ctx->s.sha512.ostate);
+    pbkdf2_sha512_first(ctx->s.sha512.istate, ctx->s.sha512.ostate,
+        salt, salt_len, ctx->s.sha512.u);
+    memcpy(ctx->s.sha512.t, ctx->s.sha512.u, sizeof(ctx->s.sha512.t));
+  } else {
+    return CRYPT0_ERR_FMT;
+  }
+
+  ctx->hash = hash;
+  ctx->iterations = iterations;
+  ctx->done = 1;
+  return CRYPT0_OK;
+}
+
+uint32_t crypt0_pbkdf2_step(crypt0_pbkdf2_ctx * ctx, uint32_t n)
+{
+  uint32_t left = ctx->iterations - ctx->done;
+
+  if (n > left) {
+    n = left;
+  }
+
+  if (ctx->hash == CRYPT0_PBKDF2_HMAC_SHA256) {
+    for (uint32_t k = 0; k < n; k++) {
+      pbkdf2_sha256_next(ctx->s.sha256.istate, ctx->s.sha256.ostate, ctx->s.sha256.u);
+      for (int j = 0; j < 8; j++) {
+        ctx->s.sha256.t[j] ^= ctx->s.sha256.u[j];
+      }
+    }
+  } else {
+    for (uint32_t k = 0; k < n; k++) {
+      pbkdf2_sha512_next(ctx->s.sha512.istate, ctx->s.sha512.ostate, ctx->s.sha512.u);
+      for (int j = 0; j < 8; j++) {
+        ctx->s.sha512.t[j] ^= ctx->s.sha512.u[j];
+      }
+    }
+  }
+
+  ctx->done += n;
+  return left - n;
+}
+
+int crypt0_pbkdf2_finish(crypt0_pbkdf2_ctx * ctx, uint8_t * key, uint16_t key_len)
+{
+  if (ctx->done == 0 || ctx->done != ctx->iterations) {
+    return CRYPT0_ERR;
+  }
+
+  if (ctx->hash == CRYPT0_PBKDF2_HMAC_SHA256) {
+    if (key_len != 32) {
+      return CRYPT0_ERR_PRIVKEY_LEN;
+    }
+    for (int j = 0; j < 8; j++) {
+      store_be32(&key[4 * j], ctx->s.sha256.t[j]);
+    }
+  } else {
+    if (key_len != 64) {
+      return CRYPT0_ERR_PRIVKEY_LEN;
+    }
+    for (int j = 0; j < 8; j++) {
+      store_be64(&key[8 * j], ctx->s.sha512.t[j]);
+    }
+  }
+
+  crypt0_pbkdf2_wipe(ctx);
+  return CRYPT0_OK;
+}
+
+void crypt0_pbkdf2_wipe(crypt0_pbkdf2_ctx * ctx)
+{
+  crypt0_memzero(ctx, sizeof(*ctx));
+}
+
+//-----------------------------------------------------------------------------
+static int pbkdf2_oneshot(crypt0_pbkdf2_hash_t hash, int i,
+  const uint8_t * pass, uint16_t pass_len, const uint8_t * salt,
+  uint16_t salt_len, uint8_t * key, uint16_t key_len)
+{
+  crypt0_pbkdf2_ctx ctx;
+
+  if (i < 1) {
+    return CRYPT0_ERR_FMT;
+  }
+
+  int ret = crypt0_pbkdf2_init(&ctx, hash, i, pass, pass_len, salt, salt_len);
+  if (ret == CRYPT0_OK) {
+    crypt0_pbkdf2_step(&ctx, ctx.iterations);
+    ret = crypt0_pbkdf2_finish(&ctx, key, key_len);
+  }
+  crypt0_pbkdf2_wipe(&ctx);
+  return ret;
+}
+
+int crypt0_pbkdf2_hmac_sha256(int i, const uint8_t * pass, uint16_t pass_len,
+  const uint8_t * salt, uint16_t salt_len, uint8_t * key, uint16_t key_len)
+{
+  if (salt_len > CRYPT0_PBKDF2_SALT_MAXBYTES) {
     return CRYPT0_ERR_SALTLEN;
   }
 
@@ -22,37 +272,14 @@ int crypt0_pbkdf2_hmac_sha256(int i, const uint8_t * pass, uint16_t pass_len,
 		return CRYPT0_ERR_PRIVKEY_LEN;
 	}
 
-	memcpy(salt_tmp, salt, salt_len);
-	uint32_t index_le = 1;
-	index_le = crypt0_cpu_to_be32(index_le);
-	memcpy(&salt_tmp[salt_len], &index_le, 4);
-	salt_len += 4;
-
-	for(int n = 0; n < i; n++) {
-		crypt0_hmac_sha256(pass, pass_len, salt_tmp, salt_len, digest);
-
-		salt_len = 32;
-		if (n == 0) {
-		  memcpy(key, digest, 32);
-		  memcpy(salt_tmp, digest, 32);
-		} else {
-			for(int j = 0; j < 32; j++) {
-				salt_tmp[j] = digest[j];
-				key[j] = key[j] ^ digest[j];
-			}
-		}
-	}
-  return CRYPT0_OK;
+  return pbkdf2_oneshot(CRYPT0_PBKDF2_HMAC_SHA256, i, pass, pass_len,
+      salt, salt_len, key, key_len);
 }
 
-int crypt0_pbkdf2_hmac_sha512(int i, const uint8_t * pass, uint16_t pass_len, 
+int crypt0_pbkdf2_hmac_sha512(int i, const uint8_t * pass, uint16_t pass_len,
   const uint8_t * salt, uint16_t salt_len, uint8_t * key, uint16_t key_len)
 {
-	crypt0_init();
-  uint8_t salt_tmp[68];
-  uint8_t digest[64];
-
-  if (salt_len > 64) {
+  if (salt_len > CRYPT0_PBKDF2_SALT_MAXBYTES) {
     return CRYPT0_ERR_SALTLEN;
   }
 
@@ -60,29 +287,7 @@ int crypt0_pbkdf2_hmac_sha512(int i, const uint8_t * pass, uint16_t pass_len,
 		return CRYPT0_ERR_PRIVKEY_LEN;
 	}
 
-	memcpy(salt_tmp, salt, salt_len);
-	uint32_t index_le = 1;
-	index_le = crypt0_cpu_to_be32(index_le);
-	memcpy(&salt_tmp[salt_len], &index_le, 4);
-	salt_len += 4;
-
-	for(int n = 0; n < i; n++) {
-		int res = crypt0_hmac_sha512(pass, pass_len, salt_tmp, salt_len, digest);
-		if (res != CRYPT0_OK) {
-			return res;
-		}
-
-		salt_len = 64;
-		if (n == 0) {
-		  memcpy(key, digest, 64);
-		  memcpy(salt_tmp, digest, 64);
-		} else {
-			for(int j = 0; j < 64; j++) {
-				salt_tmp[j] = digest[j];
-				key[j] = key[j] ^ digest[j];
-			}
-		}
-	}
-  return CRYPT0_OK;
+  return pbkdf2_oneshot(CRYPT0_PBKDF2_HMAC_SHA512, i, pass, pass_len,
+      salt, salt_len, key, key_len);
 }
 
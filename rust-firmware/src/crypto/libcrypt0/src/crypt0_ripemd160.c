@@ -1,3 +1,169 @@
 #include "crypt0.h"
+#include "crypt0_ripemd160.h"
+#include "crypt0_ripemd160_impl.h"
+#include "crypt0_sha2.h"
 
-#include "ripemd160_.c"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Word oriented RIPEMD-160, replaces the byte oriented libbtc code in
+// lib/ripemd160. Both lines run side by side in one unrolled body and the
+// working variables are renamed between steps instead of shuffled.
+
+const uint32_t crypt0_ripemd160_iv[5] = {
+  0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0,
+};
+
+static inline uint32_t load_le32(const uint8_t * p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store_le32(uint8_t * p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void store_be32(uint8_t * p, uint32_t v)
+{
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+static inline uint32_t bswap32(uint32_t v)
+{
+  return (v >> 24) | ((v >> 8) & 0x0000ff00) | ((v << 8) & 0x00ff0000) | (v << 24);
+}
+
+// one step of both lines, the next step is called with (e, a, b, c, d)
+#define STEP160(j, a, b, c, d, e, aa, bb, cc, dd, ee, i) { \
+  a = ROL32(a + rmd_f(j, b, c, d) + x[rmd_r[i]] + rmd_k[j], rmd_s[i]) + e; \
+  c = ROL32(c, 10); \
+  aa = ROL32(aa + rmd_f(4 - (j), bb, cc, dd) + x[rmd_rr[i]] + rmd_kk[j], rmd_ss[i]) + ee; \
+  cc = ROL32(cc, 10); \
+}
+
+// sixteen steps with f and K fixed, a round leaves the roles rotated by one
+#define ROUND160(j, a, b, c, d, e, aa, bb, cc, dd, ee) { \
+  STEP160(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 0); \
+  STEP160(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 1); \
+  STEP160(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 2); \
+  STEP160(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 3); \
+  STEP160(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 4); \
+  STEP160(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 5); \
+  STEP160(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 6); \
+  STEP160(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 7); \
+  STEP160(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 8); \
+  STEP160(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 9); \
+  STEP160(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 10); \
+  STEP160(j, e, a, b, c, d, ee, aa, bb, cc, dd, 16 * (j) + 11); \
+  STEP160(j, d, e, a, b, c, dd, ee, aa, bb, cc, 16 * (j) + 12); \
+  STEP160(j, c, d, e, a, b, cc, dd, ee, aa, bb, 16 * (j) + 13); \
+  STEP160(j, b, c, d, e, a, bb, cc, dd, ee, aa, 16 * (j) + 14); \
+  STEP160(j, a, b, c, d, e, aa, bb, cc, dd, ee, 16 * (j) + 15); \
+}
+
+void crypt0_ripemd160_compress(uint32_t state[5], const uint32_t x[16])
+{
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+  uint32_t aa = a, bb = b, cc = c, dd = d, ee = e;
+
+  ROUND160(0, a, b, c, d, e, aa, bb, cc, dd, ee);
+  ROUND160(1, e, a, b, c, d, ee, aa, bb, cc, dd);
+  ROUND160(2, d, e, a, b, c, dd, ee, aa, bb, cc);
+  ROUND160(3, c, d, e, a, b, cc, dd, ee, aa, bb);
+  ROUND160(4, b, c, d, e, a, bb, cc, dd, ee, aa);
+
+  uint32_t t = state[1] + c + dd;
+  state[1] = state[2] + d + ee;
+  state[2] = state[3] + e + aa;
+  state[3] = state[4] + a + bb;
+  state[4] = state[0] + b + cc;
+  state[0] = t;
+}
+
+void crypt0_ripemd160(const uint8_t * msg, uint32_t msg_len, uint8_t * hash)
+{
+  uint32_t state[5];
+  uint32_t x[16];
+  uint32_t left = msg_len;
+
+  memcpy(state, crypt0_ripemd160_iv, sizeof(state));
+
+  for (; left >= CRYPT0_RIPEMD160_BLOCK_BYTES; left -= CRYPT0_RIPEMD160_BLOCK_BYTES) {
+    for (int i = 0; i < 16; i++) {
+      x[i] = load_le32(msg + 4 * i);
+    }
+    crypt0_ripemd160_compress(state, x);
+    msg += CRYPT0_RIPEMD160_BLOCK_BYTES;
+  }
+
+  // last block, whole words first then the 0x80 terminated partial word
+  memset(x, 0, sizeof(x));
+  uint32_t words = left / 4;
+  for (uint32_t i = 0; i < words; i++) {
+    x[i] = load_le32(msg + 4 * i);
+  }
+  uint32_t tail = 0;
+  for (uint32_t i = 0; i < (left & 3); i++) {
+    tail |= (uint32_t)msg[4 * words + i] << (8 * i);
+  }
+  x[words] = tail | ((uint32_t)0x80 << (8 * (left & 3)));
+
+  if (left > 55) {
+    crypt0_ripemd160_compress(state, x);
+    memset(x, 0, sizeof(x));
+  }
+  x[14] = msg_len << 3;
+  x[15] = msg_len >> 29;
+  crypt0_ripemd160_compress(state, x);
+
+  for (int i = 0; i < 5; i++) {
+    store_le32(hash + 4 * i, state[i]);
+  }
+}
+
+void crypt0_hash160(const uint8_t * msg, size_t msg_len, uint8_t hash[20])
+{
+  uint32_t sha[8];
+  uint8_t tail[2 * CRYPT0_SHA256_BLOCK_BYTES];
+  size_t full = msg_len / CRYPT0_SHA256_BLOCK_BYTES;
+  size_t rest = msg_len % CRYPT0_SHA256_BLOCK_BYTES;
+  size_t tail_len = rest < 56 ? CRYPT0_SHA256_BLOCK_BYTES : 2 * CRYPT0_SHA256_BLOCK_BYTES;
+
+  // sha256 with the padding done here, the digest stays in state words
+  memcpy(sha, crypt0_sha256_iv, sizeof(sha));
+  crypt0_sha256_blocks(sha, msg, full);
+  memcpy(tail, msg + full * CRYPT0_SHA256_BLOCK_BYTES, rest);
+  tail[rest] = 0x80;
+  memset(tail + rest + 1, 0, tail_len - rest - 1 - 8);
+  store_be32(tail + tail_len - 8, (uint32_t)((uint64_t)msg_len >> 29));
+  store_be32(tail + tail_len - 4, (uint32_t)msg_len << 3);
+  crypt0_sha256_blocks(sha, tail, tail_len / CRYPT0_SHA256_BLOCK_BYTES);
+
+  // the 32 digest bytes are big endian sha words read back little endian,
+  // followed by ripemd160 padding for a 256 bit message
+  uint32_t x[16] = { 0 };
+  for (int i = 0; i < 8; i++) {
+    x[i] = bswap32(sha[i]);
+  }
+  x[8] = 0x80;
+  x[14] = 256;
+
+  uint32_t state[5];
+  memcpy(state, crypt0_ripemd160_iv, sizeof(state));
+  crypt0_ripemd160_compress(state, x);
+
+  for (int i = 0; i < 5; i++) {
+    store_le32(hash + 4 * i, state[i]);
+  }
+}
+
+// eof
@@ -0,0 +1,62 @@
+#ifndef __crypt0_ripemd160_impl_h_included__
+#define __crypt0_ripemd160_impl_h_included__
+
+/**
+ * Internal to crypt0_ripemd160.c / crypt0_hash_batch.c: step tables and
+ * boolean functions. The tables are static so unrolled code indexing them
+ * with constants folds them away.
+ */
+
+#include <stdint.h>
+
+#define ROL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+// RIPEMD-160 message word order and rotations, left line then right line
+static const uint8_t rmd_r[80] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+  3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+  1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+  4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13,
+};
+
+static const uint8_t rmd_rr[80] = {
+  5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+  6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+  15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+  8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+  12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11,
+};
+
+static const uint8_t rmd_s[80] = {
+  11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+  7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+  11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+  11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+  9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6,
+};
+
+static const uint8_t rmd_ss[80] = {
+  8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+  9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+  9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+  15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+  8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11,
+};
+
+static const uint32_t rmd_k[5]  = { 0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e };
+static const uint32_t rmd_kk[5] = { 0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000 };
+
+// f for round j of the left line, the right line uses 4 - j
+static inline uint32_t rmd_f(int j, uint32_t x, uint32_t y, uint32_t z)
+{
+  switch (j) {
+    case 0:  return x ^ y ^ z;
+    case 1:  return (x & y) | (~x & z);
+    case 2:  return (x | ~y) ^ z;
+    case 3:  return (x & z) | (y & ~z);
+    default: return x ^ (y | ~z);
+  }
+}
+
+#endif//__crypt0_ripemd160_impl_h_included__
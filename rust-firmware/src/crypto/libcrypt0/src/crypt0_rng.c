@@ -15,7 +15,7 @@ bool crypt0_rng(uint8_t * data, int dataLen)
   }
 }
 
-#else
+#elif defined(CRYPT0_USE_OPENSSL)
 
 #include <openssl/rand.h>
 
@@ -25,4 +25,32 @@ bool crypt0_rng(uint8_t * data, int dataLen)
   return ret == 1;
 }
 
+#elif defined(_WIN32)
+
+#include <windows.h>
+#include <bcrypt.h>
+
+bool crypt0_rng(uint8_t * data, int dataLen) 
+{
+  NTSTATUS status = BCryptGenRandom(NULL, data, dataLen, 
+      BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+  return status == 0;
+}
+
+#else
+
+#include <stdio.h>
+
+// desktop builds without OpenSSL read the kernel pool
+bool crypt0_rng(uint8_t * data, int dataLen) 
+{
+  FILE * f = fopen("/dev/urandom", "rb");
+  if (f == NULL) {
+    return false;
+  }
+  size_t len = fread(data, 1, dataLen, f);
+  fclose(f);
+  return len == (size_t)dataLen;
+}
+
 #endif
@@ -14,100 +14,125 @@ LOG_MODULE_REGISTER(crypt0_secp256k1, LOG_LEVEL_DBG);
 #include <string.h>
 
 #include <secp256k1.h>
+#include <secp256k1_preallocated.h>
 #include <secp256k1_recovery.h>
 #include <secp256k1_ecdh.h>
 
-#ifdef __ZEPHYR__
-#include <psa/crypto.h>
-#else
+#include "crypt0_rng.h"
+#include "crypt0_sha.h"
+#include "crypt0_secp256k1_impl.h"
+
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
 #include <openssl/evp.h>
 #include <openssl/ec.h>
 #include <openssl/core_names.h>
 #include <openssl/err.h>
+#include "crypt0_openssl.h"
 #endif
 
 //-----------------------------------------------------------------------------
-int crypt0_secp256k1_public_key(const uint8_t * priv, size_t privlen, 
-		uint8_t * pub, size_t publen)
-{
-	if (privlen != CRYPT0_SECP256_PRIVKEY_BYTES) {
-		LOG_ERR("wrong private key len: %d, expected: %d", (int)privlen, CRYPT0_SECP256_PRIVKEY_BYTES);
-		return CRYPT0_ERR_PRIVKEY_LEN;
-	}
-	if (publen != CRYPT0_SECP256_PUBKEY_BYTES) {
-		LOG_ERR("wrong public key len: %d, expected: %d", (int)publen, CRYPT0_SECP256_PUBKEY_BYTES);
-		return CRYPT0_ERR_PUBKEY_LEN;
-	}
-  crypt0_init();
-
-#ifdef __ZEPHYR__
-	static psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
-	static psa_key_handle_t priv_key_handle;
-	static psa_status_t status;
-	size_t len;
+// Shared context, created once in a static buffer and blinded with a fresh
+// seed every CRYPT0_SECP256K1_RERANDOMIZE_EVERY uses. One per thread where
+// the target has thread local storage, as the OpenSSL contexts of
+// crypt0_openssl.c: the desktop tests and the simulator sign from several
+// threads, and the context and its use count change on every call. The
+// Zephyr firmware calls libcrypt0 from its main thread only and keeps one
+// unless CONFIG_THREAD_LOCAL_STORAGE is set
+
+#if defined(__ZEPHYR__) && !defined(CONFIG_THREAD_LOCAL_STORAGE)
+#define SECP256K1_CTX_LOCAL
+#else
+#define SECP256K1_CTX_LOCAL _Thread_local
+#endif
 
-  psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_VERIFY_HASH | PSA_KEY_USAGE_SIGN_HASH);
-  psa_set_key_algorithm(&key_attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
-  psa_set_key_type(&key_attributes, 
-			PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_K1));  
-	psa_set_key_bits(&key_attributes, 256);
+#define SECP256K1_CTX_BYTES 256
 
+static SECP256K1_CTX_LOCAL uint8_t m_ctx_mem[SECP256K1_CTX_BYTES] __attribute__((aligned(16)));
+static SECP256K1_CTX_LOCAL secp256k1_context * m_ctx = NULL;
+static SECP256K1_CTX_LOCAL unsigned m_ctx_uses = 0;
 
-	status = psa_import_key(&key_attributes, priv,
-			CRYPT0_SECP256_PRIVKEY_BYTES , &priv_key_handle);
+static void secp256k1_ctx_randomize(void)
+{
+	uint8_t seed[32];
 
-	if (status != PSA_SUCCESS) {
-		LOG_ERR("psa_import_key: %d", status);
-		return CRYPT0_ERR_IMPORT_KEY;
+	if (crypt0_rng(seed, sizeof(seed))) {
+		if (!secp256k1_context_randomize(m_ctx, seed)) {
+			LOG_ERR("err randomize secp256k1 context");
+		}
+	} else {
+		LOG_ERR("err rng, secp256k1 context not randomized");
 	}
+	crypt0_memzero(seed, sizeof(seed));
+	m_ctx_uses = 0;
+}
 
-	memset(pub, 0xff, CRYPT0_SECP256_PUBKEY_BYTES);
-	
-	status = psa_export_public_key(priv_key_handle, pub, CRYPT0_SECP256_PUBKEY_BYTES, &len);
-	if (status != PSA_SUCCESS) {
-		LOG_ERR("psa_export_public_key: %d", status);
-		return CRYPT0_ERR_EXPORT_KEY;
+secp256k1_context * crypt0_secp256k1_context(unsigned uses)
+{
+	if (m_ctx == NULL) {
+		if (secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE) > sizeof(m_ctx_mem)) {
+			LOG_ERR("secp256k1 context does not fit %d bytes", SECP256K1_CTX_BYTES);
+			return NULL;
+		}
+		m_ctx = secp256k1_context_preallocated_create(m_ctx_mem, SECP256K1_CONTEXT_NONE);
+		secp256k1_ctx_randomize();
+	} else if ((m_ctx_uses += uses) >= CRYPT0_SECP256K1_RERANDOMIZE_EVERY) {
+		secp256k1_ctx_randomize();
 	}
-	
-  psa_destroy_key(priv_key_handle);
-
-#else
-
-	EC_KEY   *key      = NULL;
-	BIGNUM   *priv_key = NULL;
-	EC_POINT *pub_key  = NULL;
-	
-	//int ret;
-
-	EC_GROUP *secp256k1_group = NULL;
-
-	secp256k1_group = EC_GROUP_new_by_curve_name(NID_secp256k1);
-
-	key = EC_KEY_new_by_curve_name(NID_secp256k1);
-	//ret = EC_KEY_generate_key(key);
-
-	EC_KEY_oct2priv(key, priv, privlen);
-
-	priv_key = (BIGNUM *)EC_KEY_get0_private_key(key);
-
-	pub_key = EC_POINT_new(secp256k1_group);
-	EC_POINT_mul(secp256k1_group, pub_key, priv_key, NULL, NULL, NULL);
-	EC_KEY_set_public_key(key, pub_key);
+	return m_ctx;
+}
 
-	EC_POINT_free(pub_key);
+static secp256k1_context * secp256k1_ctx(void)
+{
+	return crypt0_secp256k1_context(1);
+}
 
-	pub_key            = (EC_POINT *)EC_KEY_get0_public_key(key);
-	EC_POINT_point2oct(secp256k1_group, 
-			pub_key, POINT_CONVERSION_UNCOMPRESSED, pub, publen, NULL);
+void crypt0_secp256k1_rerandomize(void)
+{
+	// a new context is randomized as it is created
+	if (m_ctx == NULL) {
+		crypt0_secp256k1_context(0);
+	} else {
+		secp256k1_ctx_randomize();
+	}
+}
 
-	EC_KEY_free(key);
-	EC_GROUP_free(secp256k1_group);
+//-----------------------------------------------------------------------------
+// Public key from the bundled libsecp256k1 generator table on every target,
+// serialized straight to the requested form
+static int secp256k1_public_key_serialize(const uint8_t * priv, size_t privlen, 
+		uint8_t * pub, size_t publen, unsigned int flags)
+{
+	if (privlen != CRYPT0_SECP256_PRIVKEY_BYTES) {
+		LOG_ERR("wrong private key len: %d, expected: %d", (int)privlen, CRYPT0_SECP256_PRIVKEY_BYTES);
+		return CRYPT0_ERR_PRIVKEY_LEN;
+	}
 
-#endif
+	secp256k1_pubkey pubkey;
+	size_t len = publen;
+  secp256k1_context * ctx = secp256k1_ctx();
+	if (ctx == NULL) {
+		return CRYPT0_ERR_INIT_SECP256K1;
+	}
+	if (!secp256k1_ec_pubkey_create(ctx, &pubkey, priv)) {
+		return CRYPT0_ERR_IMPORT_KEY;
+	}
+	secp256k1_ec_pubkey_serialize(ctx, pub, &len, &pubkey, flags);
 
   return CRYPT0_OK;
 }
 
+//-----------------------------------------------------------------------------
+int crypt0_secp256k1_public_key(const uint8_t * priv, size_t privlen, 
+		uint8_t * pub, size_t publen)
+{
+	if (publen != CRYPT0_SECP256_PUBKEY_BYTES) {
+		LOG_ERR("wrong public key len: %d, expected: %d", (int)publen, CRYPT0_SECP256_PUBKEY_BYTES);
+		return CRYPT0_ERR_PUBKEY_LEN;
+	}
+	return secp256k1_public_key_serialize(priv, privlen, pub, publen, 
+			SECP256K1_EC_UNCOMPRESSED);
+}
+
 //-----------------------------------------------------------------------------
 int crypt0_secp256k1_public_key_compressed(const uint8_t * priv, size_t privlen, 
 		uint8_t * pub, size_t publen)
@@ -117,17 +142,8 @@ int crypt0_secp256k1_public_key_compressed(const uint8_t * priv, size_t privlen,
 				CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
 		return CRYPT0_ERR_PUBKEY_LEN;
 	}
-	uint8_t pub_uncompressed[CRYPT0_SECP256_PUBKEY_BYTES];
-
-	int ret = crypt0_secp256k1_public_key(priv, privlen, pub_uncompressed, sizeof(pub_uncompressed));
-	if (ret != CRYPT0_OK) {
-		return ret;
-	}
-
-	memcpy(pub, pub_uncompressed, CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
-	pub[0] = 0x02 + (pub_uncompressed[CRYPT0_SECP256_PUBKEY_BYTES - 1] & 0x01);
-
-  return CRYPT0_OK;
+	return secp256k1_public_key_serialize(priv, privlen, pub, publen, 
+			SECP256K1_EC_COMPRESSED);
 }
 
 //-----------------------------------------------------------------------------
@@ -145,10 +161,8 @@ int crypt0_secp256k1_sign_recoverable(const uint8_t * hash, size_t hashlen,
 		return CRYPT0_ERR_SIG_LEN;
 	}
   secp256k1_ecdsa_recoverable_signature sigr;
-  secp256k1_context * ctx = 
-		secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+  secp256k1_context * ctx = secp256k1_ctx();
 	if (ctx == NULL) {
-		LOG_ERR("err create secp256k1 context");
 		return CRYPT0_ERR_INIT_SECP256K1;
 	}
   secp256k1_ecdsa_sign_recoverable(ctx, &sigr, hash, priv, NULL, NULL);
@@ -156,27 +170,45 @@ int crypt0_secp256k1_sign_recoverable(const uint8_t * hash, size_t hashlen,
   int recid;
   secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, sig, &recid, &sigr);
 	LOG_DBG("recid %d", recid);
-	secp256k1_context_destroy(ctx);
 	sig[siglen - 1] = sigr.data[64];
 
 	return CRYPT0_OK;
 }
 
-int crypt0_secp256k1_verify_signature(const secp256k1_ecdsa_signature *sig, const uint8_t * hash, size_t hashlen)
+//-----------------------------------------------------------------------------
+int crypt0_secp256k1_verify_signature(const uint8_t * sig, size_t siglen,
+        const uint8_t * hash, size_t hashlen, const uint8_t * pub, size_t publen)
 {
-  secp256k1_context * ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
-  
-  //secp256k1_ecdsa_signature_parse_compact(ctx, secp256k1_ecdsa_signature* sig, const unsigned char *input64);
-
-  const secp256k1_pubkey pubkey;
-  if (!secp256k1_ecdsa_verify(ctx, sig, hash, &pubkey))
-  {
-    LOG_DBG("Signature not verified");
-    return -1;
-  }
+	if (hashlen != CRYPT0_SHA256_BYTES) {
+		return CRYPT0_ERR_HASH_LEN;
+	}
+	if (siglen != CRYPT0_SECP256_SIG_COMPACT_BYTES &&
+			siglen != CRYPT0_SECP256_SIG_RECOVERABLE_BYTES) {
+		return CRYPT0_ERR_SIG_LEN;
+	}
+	if (publen != CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES &&
+			publen != CRYPT0_SECP256_PUBKEY_BYTES) {
+		return CRYPT0_ERR_PUBKEY_LEN;
+	}
+  secp256k1_context * ctx = secp256k1_ctx();
+	if (ctx == NULL) {
+		return CRYPT0_ERR_INIT_SECP256K1;
+	}
 
-  return 1;
-} //TODO Complete function
+  secp256k1_pubkey pubkey;
+  secp256k1_ecdsa_signature ecdsa_sig;
+	if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pub, publen)) {
+		return CRYPT0_ERR_IMPORT_KEY;
+	}
+	if (!secp256k1_ecdsa_signature_parse_compact(ctx, &ecdsa_sig, sig)) {
+		return CRYPT0_ERR_FMT;
+	}
+	if (!secp256k1_ecdsa_verify(ctx, &ecdsa_sig, hash, &pubkey)) {
+		LOG_DBG("signature not verified");
+		return CRYPT0_ERR;
+	}
+	return CRYPT0_OK;
+}
 
 int crypt0_secp256k1_ecdh_secret(uint8_t * priv, int privlen, uint8_t * pub, int publen, uint8_t *secret, int secretlen)
 {
@@ -193,27 +225,75 @@ int crypt0_secp256k1_ecdh_secret(uint8_t * priv, int privlen, uint8_t * pub, int
 		return CRYPT0_ERR_SIG_LEN;
 	}
 
-  secp256k1_context * ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-  if (ctx == NULL) 
-  {
-		LOG_ERR("err create secp256k1 context");
+  return crypt0_secp256k1_ecdh(priv, pub, publen, secret, NULL, NULL);
+}
+
+//-----------------------------------------------------------------------------
+// ECDH with the protocol's hash in place of the default sha256, so a KDF over
+// the shared point doesn't hash an already hashed secret again
+int crypt0_secp256k1_ecdh(const uint8_t * priv, const uint8_t * pub, size_t publen,
+		uint8_t * out, crypt0_secp256k1_ecdh_hash_fn hash, void * data)
+{
+	if (publen != CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES && 
+			publen != CRYPT0_SECP256_PUBKEY_BYTES) {
+		LOG_ERR("wrong public key len: %d", (int)publen);
+		return CRYPT0_ERR_PUBKEY_LEN;
+	}
+
+	secp256k1_context * ctx = secp256k1_ctx();
+	if (ctx == NULL) {
 		return CRYPT0_ERR_INIT_SECP256K1;
 	}
-  
-  secp256k1_pubkey pubkey;
-  if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pub, publen))
-  {
+
+	secp256k1_pubkey pubkey;
+	if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pub, publen)) {
 		LOG_ERR("err parsing secp256k1 pubkey");
 		return CRYPT0_ERR_IMPORT_KEY;
 	}
-  if (!secp256k1_ecdh(ctx, secret, &pubkey, priv, NULL, NULL))
-  {
-    LOG_ERR("secp256k1_ecdh failed");
-    return -1;
-  }
-  secp256k1_context_destroy(ctx);
-  
-  return CRYPT0_OK;
+	if (!secp256k1_ecdh(ctx, out, &pubkey, priv, hash, data)) {
+		LOG_ERR("secp256k1_ecdh failed");
+		return CRYPT0_ERR_IMPORT_KEY;
+	}
+	return CRYPT0_OK;
+}
+
+int crypt0_secp256k1_ecdh_hash_x(uint8_t * out, const uint8_t * x32,
+		const uint8_t * y32, void * data)
+{
+	memcpy(out, x32, 32);
+	return 1;
+}
+
+void crypt0_secp256k1_ecdh_tag_init(crypt0_sha256_ctx * ctx, const char * tag)
+{
+	uint8_t tag_hash[32];
+
+	crypt0_sha256(tag, strlen(tag), tag_hash, sizeof(tag_hash));
+	crypt0_sha256_init(ctx);
+	crypt0_sha256_update(ctx, tag_hash, sizeof(tag_hash));
+	crypt0_sha256_update(ctx, tag_hash, sizeof(tag_hash));
+}
+
+int crypt0_secp256k1_ecdh_hash_tagged(uint8_t * out, const uint8_t * x32,
+		const uint8_t * y32, void * data)
+{
+	crypt0_sha256_ctx sha = *(const crypt0_sha256_ctx *)data;
+
+	crypt0_sha256_update(&sha, x32, 32);
+	crypt0_sha256_final(&sha, out);
+	crypt0_memzero(&sha, sizeof(sha));
+	return 1;
+}
+
+int crypt0_secp256k1_ecdh_hash_hkdf_extract(uint8_t * out, const uint8_t * x32,
+		const uint8_t * y32, void * data)
+{
+	crypt0_hmac_sha256_ctx hmac;
+
+	crypt0_hmac_sha256_clone(&hmac, (const crypt0_hmac_sha256_ctx *)data);
+	crypt0_hmac_sha256_update(&hmac, x32, 32);
+	crypt0_hmac_sha256_final(&hmac, out);
+	return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -221,7 +301,7 @@ int crypt0_secp256k1_ecdh_secret(uint8_t * priv, int privlen, uint8_t * pub, int
 int crypt0_secp256k1_sign(const uint8_t * hash, size_t hashlen, 
         const uint8_t * priv, size_t privlen, uint8_t * sig, uint8_t siglen)
 {
-#ifdef __ZEPHYR__
+#if defined(__ZEPHYR__) || !defined(CRYPT0_USE_OPENSSL)
 
 	if (hashlen != CRYPT0_SHA256_BYTES) {
 		return CRYPT0_ERR_HASH_LEN;
@@ -233,10 +313,8 @@ int crypt0_secp256k1_sign(const uint8_t * hash, size_t hashlen,
 		return CRYPT0_ERR_SIG_LEN;
 	}
   secp256k1_ecdsa_signature ecdsa_sig;
-  secp256k1_context * ctx = 
-		secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+  secp256k1_context * ctx = secp256k1_ctx();
 	if (ctx == NULL) {
-		LOG_ERR("err create secp256k1 context");
 		return CRYPT0_ERR_INIT_SECP256K1;
 	}
   secp256k1_ecdsa_sign(ctx, &ecdsa_sig, hash, priv, NULL, NULL);
@@ -252,50 +330,42 @@ int crypt0_secp256k1_sign(const uint8_t * hash, size_t hashlen,
 			siglen = len;
 		}
 	}
-	secp256k1_context_destroy(ctx);
 
 #else
 
 	//---------------------------------------------------------------------
 	// OpenSSL implementation
 	
-	EC_GROUP * ec_group = EC_GROUP_new_by_curve_name(NID_secp256k1);
-	EC_KEY   * key = EC_KEY_new_by_curve_name(NID_secp256k1);
-
-	EC_KEY_generate_key(key);
-	EC_KEY_oct2priv(key, priv, privlen);
-
-	BIGNUM * priv_key = (BIGNUM *)EC_KEY_get0_private_key(key);
-	EC_POINT * pub_key = EC_POINT_new(ec_group);
-	EC_POINT_mul(ec_group, pub_key, priv_key, NULL, NULL, NULL);
-	EC_KEY_set_public_key(key, pub_key);
-
-	ECDSA_SIG *ec_sig = ECDSA_do_sign(hash, hashlen, key);
-
-	// normalize signature to use with bitcoin
-	BIGNUM *order = BN_new();
-  	BIGNUM *half_order = BN_new();
-	BN_CTX *ctx = BN_CTX_new();
-
-  EC_GROUP_get_order(ec_group, order, ctx);
-  BN_rshift1(half_order, order); // half_order = order / 2
+	EC_KEY * key = crypt0_ossl_secp256k1_key();
+	BIGNUM * priv_key = crypt0_ossl_bn();
+	if (key == NULL || priv_key == NULL) {
+		LOG_ERR("err init openssl secp256k1");
+		return CRYPT0_ERR_INIT_SECP256K1;
+	}
 
-	// Check if S > N/2 and normalize if necessary
-	BIGNUM *r = (BIGNUM*)ECDSA_SIG_get0_r(ec_sig);
-	BIGNUM *s = (BIGNUM*)ECDSA_SIG_get0_s(ec_sig);
-	if (BN_cmp(s, half_order) > 0) {
-		LOG_DBG("--------------- normalize");
-		BN_sub(s, order, s); // s = order - s
+	ECDSA_SIG * ec_sig = NULL;
+	if (BN_bin2bn(priv, privlen, priv_key) != NULL && 
+			EC_KEY_set_private_key(key, priv_key)) {
+		ec_sig = ECDSA_do_sign(hash, hashlen, key);
+	}
+	BN_clear(priv_key);
+	EC_KEY_set_private_key(key, NULL);
+	if (ec_sig == NULL) {
+		return CRYPT0_ERR_IMPORT_KEY;
+	}
 
-		// Reassemble the signature
-		ec_sig = ECDSA_SIG_new();
-		ECDSA_SIG_set0(ec_sig, r, s);
+	// normalize signature to use with bitcoin: s = order - s if s > order / 2,
+	// r and s are owned by ec_sig and updated in place
+	BIGNUM * r = (BIGNUM *)ECDSA_SIG_get0_r(ec_sig);
+	BIGNUM * s = (BIGNUM *)ECDSA_SIG_get0_s(ec_sig);
+	if (BN_cmp(s, crypt0_ossl_secp256k1_half_order()) > 0) {
+		BN_sub(s, crypt0_ossl_secp256k1_order(), s);
 	}
 
 	if (siglen == 64) {
 
-		BN_bn2bin(r, sig);
-		BN_bn2bin(s, &sig[32]);
+		BN_bn2binpad(r, sig, 32);
+		BN_bn2binpad(s, &sig[32], 32);
 
 	} else {
 		if (siglen < 0x48) {
@@ -305,12 +375,6 @@ int crypt0_secp256k1_sign(const uint8_t * hash, size_t hashlen,
 		}
 	}
 
-	BN_free(order);
-	BN_free(half_order);
-	BN_CTX_free(ctx);
-	EC_KEY_free(key);
-	EC_GROUP_free(ec_group);
-	EC_POINT_free(pub_key);
 	ECDSA_SIG_free(ec_sig);
 
 #endif
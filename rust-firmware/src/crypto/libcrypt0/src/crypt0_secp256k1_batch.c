@@ -0,0 +1,410 @@
+#include <string.h>
+
+// The batch routines need the libsecp256k1 internals, so this file is the
+// libsecp256k1 translation unit: secp256k1.c is compiled here and not on its
+// own, one copy of the code in flash. They multiply through the generator
+// context of the shared context in crypt0_secp256k1.c, one comb table and
+// one blinding.
+#include "secp256k1.c"
+
+#include "crypt0.h"
+#include "crypt0_secp256k1.h"
+#include "crypt0_secp256k1_impl.h"
+#include <crypt0_log.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+LOG_MODULE_REGISTER(crypt0_secp256k1_batch, LOG_LEVEL_DBG);
+#pragma GCC diagnostic pop
+
+//-----------------------------------------------------------------------------
+// Batch public keys
+//
+// Every key is multiplied with the blinded generator table into a Jacobian
+// point. The n points are then brought to affine coordinates together with
+// one field inversion (Montgomery's trick), instead of one inversion per key
+// as secp256k1_ec_pubkey_create does. The z coordinates depend on the keys,
+// so the inversion is the constant time secp256k1_fe_inv, as in
+// secp256k1_ge_set_gej, and never secp256k1_ge_set_all_gej_var.
+
+_Static_assert(sizeof(secp256k1_gej) + sizeof(secp256k1_ge) <=
+    CRYPT0_SECP256K1_BATCH_SCRATCH_PER_KEY, "batch scratch per key too small");
+_Static_assert(_Alignof(secp256k1_gej) <= 16, "batch scratch alignment slack too small");
+
+static const secp256k1_ecmult_gen_context * gen_ctx(size_t n)
+{
+  const secp256k1_context * ctx = crypt0_secp256k1_context((unsigned)n);
+  return ctx != NULL ? &ctx->ecmult_gen_ctx : NULL;
+}
+
+// scratch is caller memory with no alignment promise, the arrays are carved
+// at 16 bytes, NULL if len bytes don't fit after that
+static void * scratch_carve(void * scratch, size_t scratchlen, size_t len)
+{
+  uintptr_t base = ((uintptr_t)scratch + 15) & ~(uintptr_t)15;
+
+  if (scratch == NULL || base + len > (uintptr_t)scratch + scratchlen) {
+    return NULL;
+  }
+  return (void *)base;
+}
+
+// n Jacobian points, none at infinity, to affine in constant time with one
+// inversion. The x of p holds the running products of z until the walk back
+// replaces it
+static void ge_set_all_gej(secp256k1_ge * p, const secp256k1_gej * pj, size_t n)
+{
+  secp256k1_fe z_inv, zi;
+
+  p[0].x = pj[0].z;
+  for (size_t i = 1; i < n; i++) {
+    secp256k1_fe_mul(&p[i].x, &p[i - 1].x, &pj[i].z);
+  }
+  secp256k1_fe_inv(&z_inv, &p[n - 1].x);
+
+  for (size_t i = n; i-- > 0; ) {
+    if (i > 0) {
+      secp256k1_fe_mul(&zi, &z_inv, &p[i - 1].x);
+      secp256k1_fe_mul(&z_inv, &z_inv, &pj[i].z);
+    } else {
+      zi = z_inv;
+    }
+    secp256k1_ge_set_gej_zinv(&p[i], &pj[i], &zi);
+  }
+  crypt0_memzero(&z_inv, sizeof(z_inv));
+  crypt0_memzero(&zi, sizeof(zi));
+}
+
+// n affine points to compressed keys back to back, 33 zero bytes for a point
+// at infinity
+static void ge_serialize_compressed(secp256k1_ge * p, size_t n, uint8_t * pub)
+{
+  for (size_t i = 0; i < n; i++) {
+    uint8_t * out = pub + i * CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES;
+    if (secp256k1_ge_is_infinity(&p[i])) {
+      memset(out, 0, CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+      continue;
+    }
+    secp256k1_fe_normalize_var(&p[i].x);
+    secp256k1_fe_normalize_var(&p[i].y);
+    out[0] = secp256k1_fe_is_odd(&p[i].y) ? 0x03 : 0x02;
+    secp256k1_fe_get_b32(out + 1, &p[i].x);
+  }
+}
+
+int crypt0_secp256k1_pubkeys_batch(const uint8_t * priv, size_t n, uint8_t * pub,
+    void * scratch, size_t scratchlen)
+{
+  if (n == 0) {
+    return CRYPT0_OK;
+  }
+
+  secp256k1_gej * pj = scratch_carve(scratch, scratchlen,
+      n * (sizeof(secp256k1_gej) + sizeof(secp256k1_ge)));
+  if (pj == NULL) {
+    LOG_ERR("batch scratch %d bytes, need %d", (int)scratchlen,
+        (int)CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n));
+    return CRYPT0_ERR_OUTBUF_LEN;
+  }
+  secp256k1_ge * p = (secp256k1_ge *)(pj + n);
+
+  const secp256k1_ecmult_gen_context * gen = gen_ctx(n);
+  secp256k1_scalar k;
+  int valid = 1;
+
+  if (gen == NULL) {
+    return CRYPT0_ERR;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    // an invalid key is replaced by one so timing doesn't depend on it
+    int ok = secp256k1_scalar_set_b32_seckey(&k, priv + i * CRYPT0_SECP256_PRIVKEY_BYTES);
+    secp256k1_scalar_cmov(&k, &secp256k1_scalar_one, !ok);
+    valid &= ok;
+    secp256k1_ecmult_gen(gen, &pj[i], &k);
+  }
+  secp256k1_scalar_clear(&k);
+
+  ge_set_all_gej(p, pj, n);
+  ge_serialize_compressed(p, n, pub);
+
+  // the Jacobian z coordinates carry the blinding
+  crypt0_memzero(pj, n * sizeof(secp256k1_gej));
+
+  if (!valid) {
+    memset(pub, 0, n * CRYPT0_SECP256_PUBKEY_COMPRESSED_BYTES);
+    return CRYPT0_ERR_IMPORT_KEY;
+  }
+  return CRYPT0_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Batch tweaked public keys
+//
+// pub + tweak*G for n public tweaks, the BIP32 public child derivation. The
+// tweak multiplications go through the generator table like the batch public
+// keys, the additions of pub stay Jacobian and the n sums share the one
+// inversion to affine. An invalid tweak or sum becomes the point at infinity,
+// which the inversion passes over, so it costs only its own entry.
+
+int crypt0_secp256k1_pubkey_tweak_add_batch(const uint8_t * pub, const uint8_t * tweaks,
+    size_t n, uint8_t * out, void * scratch, size_t scratchlen)
+{
+  if (n == 0) {
+    return CRYPT0_OK;
+  }
+
+  secp256k1_gej * pj = scratch_carve(scratch, scratchlen,
+      n * (sizeof(secp256k1_gej) + sizeof(secp256k1_ge)));
+  if (pj == NULL) {
+    LOG_ERR("batch scratch %d bytes, need %d", (int)scratchlen,
+        (int)CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n));
+    return CRYPT0_ERR_OUTBUF_LEN;
+  }
+  secp256k1_ge * p = (secp256k1_ge *)(pj + n);
+
+  // compressed key as secp256k1_eckey_pubkey_parse, whose header would pull
+  // in the ecmult declarations
+  secp256k1_ge base;
+  secp256k1_fe x;
+  if ((pub[0] != SECP256K1_TAG_PUBKEY_EVEN && pub[0] != SECP256K1_TAG_PUBKEY_ODD) ||
+      !secp256k1_fe_set_b32(&x, pub + 1) ||
+      !secp256k1_ge_set_xo_var(&base, &x, pub[0] == SECP256K1_TAG_PUBKEY_ODD)) {
+    return CRYPT0_ERR_IMPORT_KEY;
+  }
+
+  const secp256k1_ecmult_gen_context * gen = gen_ctx(n);
+  secp256k1_scalar t;
+  int skipped = 0;
+
+  if (gen == NULL) {
+    return CRYPT0_ERR;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    int overflow;
+    secp256k1_scalar_set_b32(&t, tweaks + i * 32, &overflow);
+    secp256k1_ecmult_gen(gen, &pj[i], &t);
+    secp256k1_gej_add_ge_var(&pj[i], &pj[i], &base, NULL);
+    if (overflow) {
+      secp256k1_gej_set_infinity(&pj[i]);
+    }
+    skipped += secp256k1_gej_is_infinity(&pj[i]);
+  }
+
+  secp256k1_ge_set_all_gej_var(p, pj, n);
+  ge_serialize_compressed(p, n, out);
+  return skipped;
+}
+
+//-----------------------------------------------------------------------------
+// Batch signing
+//
+// Each signature needs k*G in affine coordinates and 1/k. Both inversions are
+// shared over the batch with Montgomery's trick: one constant time field
+// inversion for all the z of k*G and one scalar inversion for all nonces, the
+// rest is multiplications. Nonces come from the same RFC6979 function as
+// secp256k1_ecdsa_sign, so the signatures match the one by one ones.
+
+typedef struct {
+  secp256k1_gej r;       // k*G, then its affine x and y
+  secp256k1_fe z_acc;    // product of the z of k*G up to this entry
+  secp256k1_scalar k;    // nonce, then its inverse
+  secp256k1_scalar k_acc;// product of the nonces up to this entry
+  secp256k1_scalar sec;
+  secp256k1_scalar msg;
+} sign_entry;
+
+_Static_assert(sizeof(sign_entry) <= CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_PER_SIG,
+    "sign batch scratch per signature too small");
+_Static_assert(_Alignof(sign_entry) <= 16, "sign batch scratch alignment slack too small");
+
+static size_t sig_max_bytes(int format)
+{
+  switch (format) {
+  case CRYPT0_SECP256K1_SIG_COMPACT:
+    return CRYPT0_SECP256_SIG_COMPACT_BYTES;
+  case CRYPT0_SECP256K1_SIG_RECOVERABLE:
+    return CRYPT0_SECP256_SIG_RECOVERABLE_BYTES;
+  case CRYPT0_SECP256K1_SIG_DER:
+    return CRYPT0_SECP256_SIG_DER_MAX_BYTES;
+  }
+  return 0;
+}
+
+// r, s and recid into the output format, bytes written
+static size_t sig_serialize(int format, const secp256k1_scalar * r,
+    const secp256k1_scalar * s, int recid, uint8_t * out)
+{
+  uint8_t compact[CRYPT0_SECP256_SIG_COMPACT_BYTES];
+  secp256k1_ecdsa_signature sig;
+  size_t len = CRYPT0_SECP256_SIG_DER_MAX_BYTES;
+
+  if (format != CRYPT0_SECP256K1_SIG_DER) {
+    secp256k1_scalar_get_b32(out, r);
+    secp256k1_scalar_get_b32(out + 32, s);
+    if (format == CRYPT0_SECP256K1_SIG_COMPACT) {
+      return CRYPT0_SECP256_SIG_COMPACT_BYTES;
+    }
+    out[64] = (uint8_t)recid;
+    return CRYPT0_SECP256_SIG_RECOVERABLE_BYTES;
+  }
+
+  // DER through the public serializer, r and s are no longer secret
+  secp256k1_scalar_get_b32(compact, r);
+  secp256k1_scalar_get_b32(compact + 32, s);
+  secp256k1_ecdsa_signature_parse_compact(secp256k1_context_no_precomp, &sig, compact);
+  secp256k1_ecdsa_signature_serialize_der(secp256k1_context_no_precomp, out, &len, &sig);
+  return len;
+}
+
+// one signature through the shared context, for the 1 in 2^256 r or s of
+// zero where secp256k1_ecdsa_sign moves on to the next nonce
+static size_t sign_one(int format, const uint8_t * hash, const uint8_t * key, 
+    uint8_t * out)
+{
+  uint8_t sig[CRYPT0_SECP256_SIG_RECOVERABLE_BYTES];
+  secp256k1_scalar r, s;
+
+  crypt0_secp256k1_sign_recoverable(hash, CRYPT0_SHA256_BYTES, key,
+      CRYPT0_SECP256_PRIVKEY_BYTES, sig, sizeof(sig));
+  secp256k1_scalar_set_b32(&r, sig, NULL);
+  secp256k1_scalar_set_b32(&s, sig + 32, NULL);
+  return sig_serialize(format, &r, &s, sig[64], out);
+}
+
+int crypt0_secp256k1_sign_batch(const uint8_t * hashes, const uint8_t * const * keys,
+    size_t n, int format, uint8_t * sigs, size_t sigslen, uint8_t * siglens,
+    void * scratch, size_t scratchlen)
+{
+  size_t max = sig_max_bytes(format);
+  if (max == 0) {
+    LOG_ERR("unknown signature format %d", format);
+    return CRYPT0_ERR_FMT;
+  }
+  if (n == 0) {
+    return 0;
+  }
+  if (sigslen < n * max) {
+    LOG_ERR("sigs %d bytes, need %d", (int)sigslen, (int)(n * max));
+    return CRYPT0_ERR_SIG_LEN;
+  }
+  sign_entry * e = scratch_carve(scratch, scratchlen, n * sizeof(sign_entry));
+  if (e == NULL) {
+    LOG_ERR("batch scratch %d bytes, need %d", (int)scratchlen,
+        (int)CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(n));
+    return CRYPT0_ERR_OUTBUF_LEN;
+  }
+
+  const secp256k1_ecmult_gen_context * gen = gen_ctx(n);
+  uint8_t nonce[32];
+  int valid = 1;
+
+  if (gen == NULL) {
+    return CRYPT0_ERR;
+  }
+
+  // nonces, k*G and the running products of z and k
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t * hash = hashes + i * CRYPT0_SHA256_BYTES;
+
+    if (i > 0 && keys[i] == keys[i - 1]) {
+      e[i].sec = e[i - 1].sec;
+    } else {
+      // an invalid key is replaced by one so timing doesn't depend on it
+      int ok = secp256k1_scalar_set_b32_seckey(&e[i].sec, keys[i]);
+      secp256k1_scalar_cmov(&e[i].sec, &secp256k1_scalar_one, !ok);
+      valid &= ok;
+    }
+    secp256k1_scalar_set_b32(&e[i].msg, hash, NULL);
+
+    // an out of range nonce is less likely than 1 in 2^127
+    for (unsigned count = 0; ; count++) {
+      secp256k1_nonce_function_rfc6979(nonce, hash, keys[i], NULL, NULL, count);
+      if (secp256k1_scalar_set_b32_seckey(&e[i].k, nonce)) {
+        break;
+      }
+    }
+    secp256k1_ecmult_gen(gen, &e[i].r, &e[i].k);
+
+    if (i == 0) {
+      e[i].z_acc = e[i].r.z;
+      e[i].k_acc = e[i].k;
+    } else {
+      secp256k1_fe_mul(&e[i].z_acc, &e[i - 1].z_acc, &e[i].r.z);
+      secp256k1_scalar_mul(&e[i].k_acc, &e[i - 1].k_acc, &e[i].k);
+    }
+  }
+  crypt0_memzero(nonce, sizeof(nonce));
+
+  // one inversion each, walked back to every entry
+  secp256k1_fe z_inv, zi, zi2;
+  secp256k1_scalar k_inv, ki;
+  secp256k1_fe_inv(&z_inv, &e[n - 1].z_acc);
+  secp256k1_scalar_inverse(&k_inv, &e[n - 1].k_acc);
+
+  for (size_t i = n; i-- > 0; ) {
+    if (i > 0) {
+      secp256k1_fe_mul(&zi, &z_inv, &e[i - 1].z_acc);
+      secp256k1_fe_mul(&z_inv, &z_inv, &e[i].r.z);
+      secp256k1_scalar_mul(&ki, &k_inv, &e[i - 1].k_acc);
+      secp256k1_scalar_mul(&k_inv, &k_inv, &e[i].k);
+    } else {
+      zi = z_inv;
+      ki = k_inv;
+    }
+    e[i].k = ki;
+
+    secp256k1_fe_sqr(&zi2, &zi);
+    secp256k1_fe_mul(&e[i].r.x, &e[i].r.x, &zi2);
+    secp256k1_fe_mul(&zi2, &zi2, &zi);
+    secp256k1_fe_mul(&e[i].r.y, &e[i].r.y, &zi2);
+    secp256k1_fe_normalize(&e[i].r.x);
+    secp256k1_fe_normalize(&e[i].r.y);
+  }
+
+  // s = (msg + r * sec) / k, low s, serialized in order
+  uint8_t * out = sigs;
+  for (size_t i = 0; i < n; i++) {
+    secp256k1_scalar r, s;
+    uint8_t b[32];
+    int overflow = 0;
+    size_t len;
+
+    secp256k1_fe_get_b32(b, &e[i].r.x);
+    secp256k1_scalar_set_b32(&r, b, &overflow);
+    int recid = (overflow << 1) | secp256k1_fe_is_odd(&e[i].r.y);
+
+    secp256k1_scalar_mul(&s, &r, &e[i].sec);
+    secp256k1_scalar_add(&s, &s, &e[i].msg);
+    secp256k1_scalar_mul(&s, &s, &e[i].k);
+    int high = secp256k1_scalar_is_high(&s);
+    secp256k1_scalar_cond_negate(&s, high);
+    recid ^= high;
+
+    if (secp256k1_scalar_is_zero(&r) || secp256k1_scalar_is_zero(&s)) {
+      len = sign_one(format, hashes + i * CRYPT0_SHA256_BYTES, keys[i], out);
+    } else {
+      len = sig_serialize(format, &r, &s, recid, out);
+    }
+    secp256k1_scalar_clear(&s);
+    if (siglens != NULL) {
+      siglens[i] = (uint8_t)len;
+    }
+    out += len;
+  }
+
+  crypt0_memzero(e, n * sizeof(sign_entry));
+  crypt0_memzero(&k_inv, sizeof(k_inv));
+  crypt0_memzero(&ki, sizeof(ki));
+  crypt0_memzero(&zi, sizeof(zi));
+  crypt0_memzero(&z_inv, sizeof(z_inv));
+
+  if (!valid) {
+    memset(sigs, 0, out - sigs);
+    return CRYPT0_ERR_IMPORT_KEY;
+  }
+  return out - sigs;
+}
+
+// eof
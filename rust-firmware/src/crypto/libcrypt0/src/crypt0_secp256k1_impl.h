@@ -0,0 +1,13 @@
+#ifndef __crypt0_secp256k1_impl_h_included__
+#define __crypt0_secp256k1_impl_h_included__
+
+#include <secp256k1.h>
+
+/**
+ * Internal to crypt0_secp256k1.c / crypt0_secp256k1_batch.c: the calling
+ * thread's shared context, uses key operations counted towards its next
+ * re-blinding. The batch code multiplies through its generator context.
+ */
+secp256k1_context * crypt0_secp256k1_context(unsigned uses);
+
+#endif//__crypt0_secp256k1_impl_h_included__
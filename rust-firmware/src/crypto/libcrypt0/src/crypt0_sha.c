@@ -1,53 +1,136 @@
 #include "crypt0_sha.h"
 #include "crypt0.h"
+#include "crypt0_keccak.h"
 
-#include <sha3.h>
 #include <string.h>
 
 #ifdef __ZEPHYR__
 #include <ocrypto_sha256.h>
 #include <ocrypto_sha512.h>
-#else 
-#include <openssl/sha.h>
+#elif defined(CRYPT0_USE_OPENSSL)
+#include "crypt0_openssl.h"
+#else
+#include "crypt0_sha2.h"
 #endif//__ZEPHYR__
 
+//-----------------------------------------------------------------------------
+// keccak256 sponge, lanes are little endian
+
+void crypt0_keccak_init(crypt0_keccak_ctx * ctx)
+{
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+void crypt0_keccak_update(crypt0_keccak_ctx * ctx, const void * data, size_t len)
+{
+  const uint8_t * p = data;
+  size_t used = ctx->used;
+
+  // bytes up to the next lane boundary
+  while (len && (used & 7)) {
+    ctx->state[used / 8] ^= (uint64_t)*p++ << (8 * (used & 7));
+    len--;
+    if (++used == CRYPT0_KECCAK256_RATE) {
+      crypt0_keccakf1600(ctx->state);
+      used = 0;
+    }
+  }
+
+  // whole lanes
+  while (len >= 8) {
+    uint64_t w = 0;
+    for (int i = 7; i >= 0; i--) {
+      w = (w << 8) | p[i];
+    }
+    ctx->state[used / 8] ^= w;
+    p += 8;
+    len -= 8;
+    used += 8;
+    if (used == CRYPT0_KECCAK256_RATE) {
+      crypt0_keccakf1600(ctx->state);
+      used = 0;
+    }
+  }
+
+  while (len--) {
+    ctx->state[used / 8] ^= (uint64_t)*p++ << (8 * (used & 7));
+    used++;
+  }
+
+  ctx->used = used;
+}
+
+void crypt0_keccak_final(crypt0_keccak_ctx * ctx, uint8_t out[32])
+{
+  ctx->state[ctx->used / 8] ^= (uint64_t)0x01 << (8 * (ctx->used & 7));
+  ctx->state[CRYPT0_KECCAK256_RATE / 8 - 1] ^= 0x8000000000000000ULL;
+  crypt0_keccakf1600(ctx->state);
+
+  for (int i = 0; i < 32; i++) {
+    out[i] = (uint8_t)(ctx->state[i / 8] >> (8 * (i & 7)));
+  }
+}
+
+void crypt0_keccak_clone(crypt0_keccak_ctx * dst, const crypt0_keccak_ctx * src)
+{
+  memcpy(dst, src, sizeof(*dst));
+}
+
 bool crypt0_sha3_keccak2(
 		const uint8_t * data1, size_t data1len, 
 		const uint8_t * data2, size_t data2len, 
 		uint8_t * out, size_t outlen)
 {
-  sha3_return_t err;
-  sha3_context c;
-
-  err = sha3_Init(&c, 256);
-  if( err != SHA3_RETURN_OK )
-      return false;
-  if( sha3_SetFlags(&c, SHA3_FLAGS_KECCAK) != SHA3_FLAGS_KECCAK ) {
-      return false;
+  crypt0_keccak_ctx ctx;
+  uint8_t digest[32];
+
+  if (outlen > sizeof(digest)) {
+    outlen = sizeof(digest);
   }
-  sha3_Update(&c, data1, data1len);
-  sha3_Update(&c, data2, data2len);
-  const void *h = sha3_Finalize(&c);
+  crypt0_keccak_init(&ctx);
+  crypt0_keccak_update(&ctx, data1, data1len);
+  crypt0_keccak_update(&ctx, data2, data2len);
+  crypt0_keccak_final(&ctx, digest);
 
-  memcpy(out, h, outlen);
+  memcpy(out, digest, outlen);
 	return true;
 }
 
 bool crypt0_sha3_keccak(const uint8_t * data, size_t datalen, 
 		uint8_t * out, size_t outlen)
 {
-	sha3_HashBuffer(256, SHA3_FLAGS_KECCAK, data, datalen, out, outlen);
-	return true;
+	return crypt0_sha3_keccak2(data, datalen, NULL, 0, out, outlen);
 }
 
+//-----------------------------------------------------------------------------
+
+#if defined(CRYPT0_USE_OPENSSL) && !defined(__ZEPHYR__)
+// one shot digest on the thread's reusable context
+static bool ossl_digest(const EVP_MD * md, const void * data, size_t datalen,
+		uint8_t * out)
+{
+  EVP_MD_CTX * ctx = crypt0_ossl_md_ctx();
+
+  return md != NULL && ctx != NULL &&
+    EVP_DigestInit_ex(ctx, md, NULL) &&
+    EVP_DigestUpdate(ctx, data, datalen) &&
+    EVP_DigestFinal_ex(ctx, out, NULL);
+}
+#endif
+
 bool crypt0_sha256(const void * data, size_t datalen,
 		uint8_t * out, size_t outlen)
 {
 #ifdef __ZEPHYR__  
 	ocrypto_sha256(out, data, datalen);
   return true;
+#elif defined(CRYPT0_USE_OPENSSL)
+  return ossl_digest(crypt0_ossl_sha256(), data, datalen, out);
 #else
-	SHA256(data, datalen, out);
+  crypt0_sha256_ctx ctx;
+  crypt0_sha256_init(&ctx);
+  crypt0_sha256_update(&ctx, data, datalen);
+  crypt0_sha256_final(&ctx, out);
   return true;
 #endif
   return true;
@@ -62,8 +145,13 @@ bool crypt0_sha512(const void * data, uint32_t datalen,
 #ifdef __ZEPHYR__  
 	ocrypto_sha512(out, data, datalen);
   return true;
+#elif defined(CRYPT0_USE_OPENSSL)
+  return ossl_digest(crypt0_ossl_sha512(), data, datalen, out);
 #else
-	SHA512(data, datalen, out);
+  crypt0_sha512_ctx ctx;
+  crypt0_sha512_init(&ctx);
+  crypt0_sha512_update(&ctx, data, datalen);
+  crypt0_sha512_final(&ctx, out);
   return true;
 #endif
   return true;
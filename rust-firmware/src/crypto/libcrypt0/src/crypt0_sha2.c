@@ -0,0 +1,474 @@
+#include "crypt0_sha2.h"
+#include "crypt0_sha2_impl.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+const uint32_t crypt0_sha256_iv[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+const uint64_t crypt0_sha512_iv[8] = {
+  0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+  0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+  0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+  0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+const uint32_t crypt0_sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+const uint64_t crypt0_sha512_k[80] = {
+  0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+  0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+  0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+  0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+  0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+  0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+  0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+  0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+  0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+  0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+  0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+  0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+  0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+  0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+  0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+  0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+  0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+  0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+  0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+  0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static inline uint32_t load_be32(const uint8_t * p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline uint64_t load_be64(const uint8_t * p)
+{
+  return ((uint64_t)load_be32(p) << 32) | load_be32(p + 4);
+}
+//-----------------------------------------------------------------------------
+// Scalar kernels, the only ones on the device. The schedule is kept in a
+// rolling 16 word window, rounds are unrolled by 8 so the working variables
+// never have to be shuffled
+#define EXPAND256(i) \
+  w[(i) & 15] += SSIG1_256(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + \
+                 SSIG0_256(w[((i) - 15) & 15])
+
+#define KW256(i) (crypt0_sha256_k[i] + w[(i) & 15])
+
+static void sha256_compress_scalar(uint32_t state[8], const uint32_t block[16])
+{
+  uint32_t w[16];
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 16; i++) {
+    w[i] = block[i];
+  }
+
+  for (int i = 0; i < 64; i += 8) {
+    if (i >= 16) {
+      EXPAND256(i + 0); EXPAND256(i + 1); EXPAND256(i + 2); EXPAND256(i + 3);
+      EXPAND256(i + 4); EXPAND256(i + 5); EXPAND256(i + 6); EXPAND256(i + 7);
+    }
+    ROUND256(a, b, c, d, e, f, g, h, KW256(i + 0));
+    ROUND256(h, a, b, c, d, e, f, g, KW256(i + 1));
+    ROUND256(g, h, a, b, c, d, e, f, KW256(i + 2));
+    ROUND256(f, g, h, a, b, c, d, e, KW256(i + 3));
+    ROUND256(e, f, g, h, a, b, c, d, KW256(i + 4));
+    ROUND256(d, e, f, g, h, a, b, c, KW256(i + 5));
+    ROUND256(c, d, e, f, g, h, a, b, KW256(i + 6));
+    ROUND256(b, c, d, e, f, g, h, a, KW256(i + 7));
+  }
+
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+static void sha256_blocks_scalar(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  uint32_t block[16];
+
+  while (nblocks--) {
+    for (int i = 0; i < 16; i++) {
+      block[i] = load_be32(data + 4 * i);
+    }
+    sha256_compress_scalar(state, block);
+    data += CRYPT0_SHA256_BLOCK_BYTES;
+  }
+}
+
+#define EXPAND512(i) \
+  w[(i) & 15] += SSIG1_512(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + \
+                 SSIG0_512(w[((i) - 15) & 15])
+
+#define KW512(i) (crypt0_sha512_k[i] + w[(i) & 15])
+
+static void sha512_compress_scalar(uint64_t state[8], const uint64_t block[16])
+{
+  uint64_t w[16];
+  uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 16; i++) {
+    w[i] = block[i];
+  }
+
+  for (int i = 0; i < 80; i += 8) {
+    if (i >= 16) {
+      EXPAND512(i + 0); EXPAND512(i + 1); EXPAND512(i + 2); EXPAND512(i + 3);
+      EXPAND512(i + 4); EXPAND512(i + 5); EXPAND512(i + 6); EXPAND512(i + 7);
+    }
+    ROUND512(a, b, c, d, e, f, g, h, KW512(i + 0));
+    ROUND512(h, a, b, c, d, e, f, g, KW512(i + 1));
+    ROUND512(g, h, a, b, c, d, e, f, KW512(i + 2));
+    ROUND512(f, g, h, a, b, c, d, e, KW512(i + 3));
+    ROUND512(e, f, g, h, a, b, c, d, KW512(i + 4));
+    ROUND512(d, e, f, g, h, a, b, c, KW512(i + 5));
+    ROUND512(c, d, e, f, g, h, a, b, KW512(i + 6));
+    ROUND512(b, c, d, e, f, g, h, a, KW512(i + 7));
+  }
+
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+static void sha512_blocks_scalar(uint64_t state[8], const uint8_t * data, size_t nblocks)
+{
+  uint64_t block[16];
+
+  while (nblocks--) {
+    for (int i = 0; i < 16; i++) {
+      block[i] = load_be64(data + 8 * i);
+    }
+    sha512_compress_scalar(state, block);
+    data += CRYPT0_SHA512_BLOCK_BYTES;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Kernel dispatch
+//
+// On x86 hosts the kernels are picked from cpuid on the first call, every
+// crypt0_sha* / hmac / pbkdf2 user goes through the same four pointers.
+// Elsewhere the scalar kernels are called directly.
+
+static const char * const sha2_kernel_names[] = { "scalar", "avx2", "sha-ni" };
+
+#ifdef CRYPT0_SHA2_X86
+
+typedef struct {
+  crypt0_sha2_kernel_t kernel;
+  void (*sha256_compress)(uint32_t state[8], const uint32_t block[16]);
+  void (*sha256_blocks)(uint32_t state[8], const uint8_t * data, size_t nblocks);
+  void (*sha512_compress)(uint64_t state[8], const uint64_t block[16]);
+  void (*sha512_blocks)(uint64_t state[8], const uint8_t * data, size_t nblocks);
+} sha2_kernels_t;
+
+static void sha2_detect(void);
+
+static void sha256_compress_detect(uint32_t state[8], const uint32_t block[16]);
+static void sha256_blocks_detect(uint32_t state[8], const uint8_t * data, size_t nblocks);
+static void sha512_compress_detect(uint64_t state[8], const uint64_t block[16]);
+static void sha512_blocks_detect(uint64_t state[8], const uint8_t * data, size_t nblocks);
+
+static sha2_kernels_t sha2 = {
+  CRYPT0_SHA2_KERNEL_SCALAR,
+  sha256_compress_detect, sha256_blocks_detect,
+  sha512_compress_detect, sha512_blocks_detect,
+};
+
+static void sha256_compress_detect(uint32_t state[8], const uint32_t block[16])
+{
+  sha2_detect();
+  sha2.sha256_compress(state, block);
+}
+
+static void sha256_blocks_detect(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  sha2_detect();
+  sha2.sha256_blocks(state, data, nblocks);
+}
+
+static void sha512_compress_detect(uint64_t state[8], const uint64_t block[16])
+{
+  sha2_detect();
+  sha2.sha512_compress(state, block);
+}
+
+static void sha512_blocks_detect(uint64_t state[8], const uint8_t * data, size_t nblocks)
+{
+  sha2_detect();
+  sha2.sha512_blocks(state, data, nblocks);
+}
+
+// SHA-512 has no SHA-NI counterpart here, the sha-ni kernel set pairs it with
+// avx2 when the cpu has it
+static void sha2_set(crypt0_sha2_kernel_t kernel, unsigned features)
+{
+  sha2_kernels_t k = {
+    kernel,
+    sha256_compress_scalar, sha256_blocks_scalar,
+    sha512_compress_scalar, sha512_blocks_scalar,
+  };
+
+  if (features & CRYPT0_SHA2_X86_AVX2) {
+    k.sha512_compress = crypt0_sha512_compress_avx2;
+    k.sha512_blocks = crypt0_sha512_blocks_avx2;
+  }
+  if (kernel == CRYPT0_SHA2_KERNEL_AVX2) {
+    k.sha256_compress = crypt0_sha256_compress_avx2;
+    k.sha256_blocks = crypt0_sha256_blocks_avx2;
+  } else if (kernel == CRYPT0_SHA2_KERNEL_SHANI) {
+    k.sha256_compress = crypt0_sha256_compress_shani;
+    k.sha256_blocks = crypt0_sha256_blocks_shani;
+  } else {
+    k.sha512_compress = sha512_compress_scalar;
+    k.sha512_blocks = sha512_blocks_scalar;
+  }
+  sha2 = k;
+}
+
+// racing first calls all store the same pointers
+static void sha2_detect(void)
+{
+  unsigned features = crypt0_sha2_x86_features();
+
+  if (features & CRYPT0_SHA2_X86_SHANI) {
+    sha2_set(CRYPT0_SHA2_KERNEL_SHANI, features);
+  } else if (features & CRYPT0_SHA2_X86_AVX2) {
+    sha2_set(CRYPT0_SHA2_KERNEL_AVX2, features);
+  } else {
+    sha2_set(CRYPT0_SHA2_KERNEL_SCALAR, features);
+  }
+}
+
+bool crypt0_sha2_kernel_supported(crypt0_sha2_kernel_t kernel)
+{
+  unsigned features = crypt0_sha2_x86_features();
+
+  switch (kernel) {
+    case CRYPT0_SHA2_KERNEL_SCALAR: return true;
+    case CRYPT0_SHA2_KERNEL_AVX2:   return (features & CRYPT0_SHA2_X86_AVX2) != 0;
+    case CRYPT0_SHA2_KERNEL_SHANI:  return (features & CRYPT0_SHA2_X86_SHANI) != 0;
+  }
+  return false;
+}
+
+bool crypt0_sha2_kernel_select(crypt0_sha2_kernel_t kernel)
+{
+  if (!crypt0_sha2_kernel_supported(kernel)) {
+    return false;
+  }
+  sha2_set(kernel, crypt0_sha2_x86_features());
+  return true;
+}
+
+crypt0_sha2_kernel_t crypt0_sha2_kernel(void)
+{
+  if (sha2.sha256_blocks == sha256_blocks_detect) {
+    sha2_detect();
+  }
+  return sha2.kernel;
+}
+
+void crypt0_sha256_compress(uint32_t state[8], const uint32_t block[16])
+{
+  sha2.sha256_compress(state, block);
+}
+
+void crypt0_sha256_blocks(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  if (nblocks) {
+    sha2.sha256_blocks(state, data, nblocks);
+  }
+}
+
+void crypt0_sha512_compress(uint64_t state[8], const uint64_t block[16])
+{
+  sha2.sha512_compress(state, block);
+}
+
+void crypt0_sha512_blocks(uint64_t state[8], const uint8_t * data, size_t nblocks)
+{
+  if (nblocks) {
+    sha2.sha512_blocks(state, data, nblocks);
+  }
+}
+
+#else
+
+bool crypt0_sha2_kernel_supported(crypt0_sha2_kernel_t kernel)
+{
+  return kernel == CRYPT0_SHA2_KERNEL_SCALAR;
+}
+
+bool crypt0_sha2_kernel_select(crypt0_sha2_kernel_t kernel)
+{
+  return kernel == CRYPT0_SHA2_KERNEL_SCALAR;
+}
+
+crypt0_sha2_kernel_t crypt0_sha2_kernel(void)
+{
+  return CRYPT0_SHA2_KERNEL_SCALAR;
+}
+
+void crypt0_sha256_compress(uint32_t state[8], const uint32_t block[16])
+{
+  sha256_compress_scalar(state, block);
+}
+
+void crypt0_sha256_blocks(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  sha256_blocks_scalar(state, data, nblocks);
+}
+
+void crypt0_sha512_compress(uint64_t state[8], const uint64_t block[16])
+{
+  sha512_compress_scalar(state, block);
+}
+
+void crypt0_sha512_blocks(uint64_t state[8], const uint8_t * data, size_t nblocks)
+{
+  sha512_blocks_scalar(state, data, nblocks);
+}
+
+#endif
+
+const char * crypt0_sha2_kernel_name(crypt0_sha2_kernel_t kernel)
+{
+  if ((unsigned)kernel >= sizeof(sha2_kernel_names) / sizeof(sha2_kernel_names[0])) {
+    return "unknown";
+  }
+  return sha2_kernel_names[kernel];
+}
+
+//-----------------------------------------------------------------------------
+static inline void store_be32(uint8_t * p, uint32_t v)
+{
+  p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static inline void store_be64(uint8_t * p, uint64_t v)
+{
+  store_be32(p, v >> 32);
+  store_be32(p + 4, (uint32_t)v);
+}
+
+void crypt0_sha256_init(crypt0_sha256_ctx * ctx)
+{
+  memcpy(ctx->state, crypt0_sha256_iv, sizeof(ctx->state));
+  ctx->count = 0;
+}
+
+void crypt0_sha256_update(crypt0_sha256_ctx * ctx, const uint8_t * data, size_t len)
+{
+  size_t used = ctx->count % CRYPT0_SHA256_BLOCK_BYTES;
+
+  if (len == 0) {
+    return;
+  }
+  ctx->count += len;
+  if (used) {
+    size_t fill = CRYPT0_SHA256_BLOCK_BYTES - used;
+    if (len < fill) {
+      memcpy(&ctx->buf[used], data, len);
+      return;
+    }
+    memcpy(&ctx->buf[used], data, fill);
+    crypt0_sha256_blocks(ctx->state, ctx->buf, 1);
+    data += fill;
+    len -= fill;
+  }
+
+  crypt0_sha256_blocks(ctx->state, data, len / CRYPT0_SHA256_BLOCK_BYTES);
+  data += len & ~(size_t)(CRYPT0_SHA256_BLOCK_BYTES - 1);
+  memcpy(ctx->buf, data, len % CRYPT0_SHA256_BLOCK_BYTES);
+}
+
+void crypt0_sha256_final(crypt0_sha256_ctx * ctx, uint8_t digest[32])
+{
+  size_t used = ctx->count % CRYPT0_SHA256_BLOCK_BYTES;
+
+  ctx->buf[used++] = 0x80;
+  if (used > CRYPT0_SHA256_BLOCK_BYTES - 8) {
+    memset(&ctx->buf[used], 0, CRYPT0_SHA256_BLOCK_BYTES - used);
+    crypt0_sha256_blocks(ctx->state, ctx->buf, 1);
+    used = 0;
+  }
+  memset(&ctx->buf[used], 0, CRYPT0_SHA256_BLOCK_BYTES - 8 - used);
+  store_be64(&ctx->buf[CRYPT0_SHA256_BLOCK_BYTES - 8], ctx->count * 8);
+  crypt0_sha256_blocks(ctx->state, ctx->buf, 1);
+
+  for (int i = 0; i < 8; i++) {
+    store_be32(&digest[4 * i], ctx->state[i]);
+  }
+}
+
+void crypt0_sha512_init(crypt0_sha512_ctx * ctx)
+{
+  memcpy(ctx->state, crypt0_sha512_iv, sizeof(ctx->state));
+  ctx->count = 0;
+}
+
+void crypt0_sha512_update(crypt0_sha512_ctx * ctx, const uint8_t * data, size_t len)
+{
+  size_t used = ctx->count % CRYPT0_SHA512_BLOCK_BYTES;
+
+  if (len == 0) {
+    return;
+  }
+  ctx->count += len;
+  if (used) {
+    size_t fill = CRYPT0_SHA512_BLOCK_BYTES - used;
+    if (len < fill) {
+      memcpy(&ctx->buf[used], data, len);
+      return;
+    }
+    memcpy(&ctx->buf[used], data, fill);
+    crypt0_sha512_blocks(ctx->state, ctx->buf, 1);
+    data += fill;
+    len -= fill;
+  }
+
+  crypt0_sha512_blocks(ctx->state, data, len / CRYPT0_SHA512_BLOCK_BYTES);
+  data += len & ~(size_t)(CRYPT0_SHA512_BLOCK_BYTES - 1);
+  memcpy(ctx->buf, data, len % CRYPT0_SHA512_BLOCK_BYTES);
+}
+
+// the 128 bit length field never needs its high half here
+void crypt0_sha512_final(crypt0_sha512_ctx * ctx, uint8_t digest[64])
+{
+  size_t used = ctx->count % CRYPT0_SHA512_BLOCK_BYTES;
+
+  ctx->buf[used++] = 0x80;
+  if (used > CRYPT0_SHA512_BLOCK_BYTES - 16) {
+    memset(&ctx->buf[used], 0, CRYPT0_SHA512_BLOCK_BYTES - used);
+    crypt0_sha512_blocks(ctx->state, ctx->buf, 1);
+    used = 0;
+  }
+  memset(&ctx->buf[used], 0, CRYPT0_SHA512_BLOCK_BYTES - 8 - used);
+  store_be64(&ctx->buf[CRYPT0_SHA512_BLOCK_BYTES - 8], ctx->count * 8);
+  crypt0_sha512_blocks(ctx->state, ctx->buf, 1);
+
+  for (int i = 0; i < 8; i++) {
+    store_be64(&digest[8 * i], ctx->state[i]);
+  }
+}
+
+// eof
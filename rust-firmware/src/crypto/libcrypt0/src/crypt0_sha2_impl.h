@@ -0,0 +1,65 @@
+#ifndef __crypt0_sha2_impl_h_included__
+#define __crypt0_sha2_impl_h_included__
+
+/** Internal to crypt0_sha2*.c: round macros, constants and host kernels */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(__ZEPHYR__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CRYPT0_SHA2_X86 1
+#endif
+
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define CH(x, y, z)  (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+#define BSIG0_256(x) (ROR32(x, 2) ^ ROR32(x, 13) ^ ROR32(x, 22))
+#define BSIG1_256(x) (ROR32(x, 6) ^ ROR32(x, 11) ^ ROR32(x, 25))
+#define SSIG0_256(x) (ROR32(x, 7) ^ ROR32(x, 18) ^ ((x) >> 3))
+#define SSIG1_256(x) (ROR32(x, 17) ^ ROR32(x, 19) ^ ((x) >> 10))
+
+#define BSIG0_512(x) (ROR64(x, 28) ^ ROR64(x, 34) ^ ROR64(x, 39))
+#define BSIG1_512(x) (ROR64(x, 14) ^ ROR64(x, 18) ^ ROR64(x, 41))
+#define SSIG0_512(x) (ROR64(x, 1) ^ ROR64(x, 8) ^ ((x) >> 7))
+#define SSIG1_512(x) (ROR64(x, 19) ^ ROR64(x, 61) ^ ((x) >> 6))
+
+// One round, kw is K[i] + W[i]; callers rotate the variable names instead of
+// shuffling the working state
+#define ROUND256(a, b, c, d, e, f, g, h, kw) { \
+  uint32_t t1 = h + BSIG1_256(e) + CH(e, f, g) + (kw); \
+  d += t1; \
+  h = t1 + BSIG0_256(a) + MAJ(a, b, c); \
+}
+
+#define ROUND512(a, b, c, d, e, f, g, h, kw) { \
+  uint64_t t1 = h + BSIG1_512(e) + CH(e, f, g) + (kw); \
+  d += t1; \
+  h = t1 + BSIG0_512(a) + MAJ(a, b, c); \
+}
+
+extern const uint32_t crypt0_sha256_k[64];
+extern const uint64_t crypt0_sha512_k[80];
+
+#ifdef CRYPT0_SHA2_X86
+
+#define CRYPT0_SHA2_X86_AVX2  (1u << 0)
+#define CRYPT0_SHA2_X86_SHANI (1u << 1)
+
+/** CRYPT0_SHA2_X86_* kernels this cpu and os can run */
+unsigned crypt0_sha2_x86_features(void);
+
+void crypt0_sha256_compress_shani(uint32_t state[8], const uint32_t block[16]);
+void crypt0_sha256_blocks_shani(uint32_t state[8], const uint8_t * data, size_t nblocks);
+
+void crypt0_sha256_compress_avx2(uint32_t state[8], const uint32_t block[16]);
+void crypt0_sha256_blocks_avx2(uint32_t state[8], const uint8_t * data, size_t nblocks);
+void crypt0_sha512_compress_avx2(uint64_t state[8], const uint64_t block[16]);
+void crypt0_sha512_blocks_avx2(uint64_t state[8], const uint8_t * data, size_t nblocks);
+
+#endif
+
+#endif//__crypt0_sha2_impl_h_included__
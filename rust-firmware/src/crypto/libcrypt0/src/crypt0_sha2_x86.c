@@ -0,0 +1,355 @@
+#include "crypt0_sha2.h"
+#include "crypt0_sha2_impl.h"
+
+//-----------------------------------------------------------------------------
+// x86 host kernels for crypt0_sha2.c, built with per-function target
+// attributes so the rest of the library keeps the baseline instruction set.
+// Nothing here is compiled for the device.
+
+#ifdef CRYPT0_SHA2_X86
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define SHANI_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+#define AVX2_TARGET  __attribute__((target("avx2,bmi2")))
+
+//-----------------------------------------------------------------------------
+// cpuid probe, sha-ni also needs ssse3 / sse4.1 for the shuffles, avx2 is only
+// usable when the os saves the ymm state (xcr0 bits 1 and 2)
+
+static unsigned sha2_x86_xcr0(void)
+{
+  unsigned lo, hi;
+
+  __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return lo;
+}
+
+static unsigned sha2_x86_probe(void)
+{
+  unsigned eax, ebx, ecx, edx;
+  unsigned features = 0;
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return 0;
+  }
+  unsigned ecx1 = ecx;
+
+  if (__get_cpuid_max(0, NULL) < 7) {
+    return 0;
+  }
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+  if ((ecx1 & bit_OSXSAVE) && (ecx1 & bit_AVX) && (sha2_x86_xcr0() & 6) == 6 &&
+      (ebx & bit_AVX2) && (ebx & bit_BMI2)) {
+    features |= CRYPT0_SHA2_X86_AVX2;
+  }
+  if ((ecx1 & bit_SSSE3) && (ecx1 & bit_SSE4_1) && (ebx & bit_SHA)) {
+    features |= CRYPT0_SHA2_X86_SHANI;
+  }
+  return features;
+}
+
+unsigned crypt0_sha2_x86_features(void)
+{
+  static int features = -1;
+
+  if (features < 0) {
+    features = (int)sha2_x86_probe();
+  }
+  return (unsigned)features;
+}
+
+//-----------------------------------------------------------------------------
+// SHA-NI, SHA-256 only. The state is kept as ABEF / CDGH as sha256rnds2 wants
+// it, each loop pass does four rounds and advances the schedule with
+// sha256msg1 / msg2 while the rounds run.
+
+static inline __attribute__((always_inline)) SHANI_TARGET
+void sha256_shani(uint32_t state[8], const uint8_t * data, size_t nblocks, int bswap)
+{
+  const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i state0, state1, abef, cdgh, msg, tmp;
+  __m128i m[4];
+
+  tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+  state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+  tmp = _mm_shuffle_epi32(tmp, 0xb1);
+  state1 = _mm_shuffle_epi32(state1, 0x1b);
+  state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+  while (nblocks--) {
+    abef = state0;
+    cdgh = state1;
+
+    for (int g = 0; g < 4; g++) {
+      m[g] = _mm_loadu_si128((const __m128i *)(data + 16 * g));
+      if (bswap) {
+        m[g] = _mm_shuffle_epi8(m[g], mask);
+      }
+    }
+
+#pragma GCC unroll 16
+    for (int g = 0; g < 16; g++) {
+      msg = _mm_add_epi32(m[g & 3], _mm_loadu_si128((const __m128i *)&crypt0_sha256_k[4 * g]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0e);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      if (g >= 3 && g <= 14) {
+        tmp = _mm_alignr_epi8(m[g & 3], m[(g - 1) & 3], 4);
+        m[(g + 1) & 3] = _mm_add_epi32(m[(g + 1) & 3], tmp);
+        m[(g + 1) & 3] = _mm_sha256msg2_epu32(m[(g + 1) & 3], m[g & 3]);
+      }
+      if (g >= 1 && g <= 12) {
+        m[(g - 1) & 3] = _mm_sha256msg1_epu32(m[(g - 1) & 3], m[g & 3]);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+    data += CRYPT0_SHA256_BLOCK_BYTES;
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1b);
+  state1 = _mm_shuffle_epi32(state1, 0xb1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128((__m128i *)&state[0], state0);
+  _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+SHANI_TARGET
+void crypt0_sha256_compress_shani(uint32_t state[8], const uint32_t block[16])
+{
+  sha256_shani(state, (const uint8_t *)block, 1, 0);
+}
+
+SHANI_TARGET
+void crypt0_sha256_blocks_shani(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  sha256_shani(state, data, nblocks, 1);
+}
+
+//-----------------------------------------------------------------------------
+// AVX2 SHA-256. The message schedule is expanded four words per step with the
+// K constants already added, each 128 bit lane carrying its own block, so two
+// blocks are scheduled for the price of one. The rounds stay scalar, compiled
+// with bmi2 for the non destructive rorx / andn.
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i ssig0_256x8(__m256i x)
+{
+  __m256i r = _mm256_xor_si256(_mm256_srli_epi32(x, 7), _mm256_slli_epi32(x, 25));
+  r = _mm256_xor_si256(r, _mm256_srli_epi32(x, 18));
+  r = _mm256_xor_si256(r, _mm256_slli_epi32(x, 14));
+  return _mm256_xor_si256(r, _mm256_srli_epi32(x, 3));
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i ssig1_256x8(__m256i x)
+{
+  __m256i r = _mm256_xor_si256(_mm256_srli_epi32(x, 17), _mm256_slli_epi32(x, 15));
+  r = _mm256_xor_si256(r, _mm256_srli_epi32(x, 19));
+  r = _mm256_xor_si256(r, _mm256_slli_epi32(x, 13));
+  return _mm256_xor_si256(r, _mm256_srli_epi32(x, 10));
+}
+
+// x0..x3 hold W0..W15 of two blocks, row i of kw gets K[4i..4i+3] + W[4i..4i+3]
+// of the first block followed by the same for the second
+static inline __attribute__((always_inline)) AVX2_TARGET
+void sha256_schedule_avx2(__m256i x0, __m256i x1, __m256i x2, __m256i x3, uint32_t kw[128])
+{
+#pragma GCC unroll 16
+  for (int i = 0; i < 16; i++) {
+    __m256i kv = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)&crypt0_sha256_k[4 * i]));
+    _mm256_store_si256((__m256i *)&kw[8 * i], _mm256_add_epi32(x0, kv));
+    if (i < 12) {
+      // W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16], W[t+2] and W[t+3]
+      // depend on W[t] and W[t+1] so s1 is applied in two halves
+      __m256i w = _mm256_add_epi32(x0, ssig0_256x8(_mm256_alignr_epi8(x1, x0, 4)));
+      w = _mm256_add_epi32(w, _mm256_alignr_epi8(x3, x2, 4));
+      w = _mm256_add_epi32(w, ssig1_256x8(_mm256_srli_si256(x3, 8)));
+      w = _mm256_add_epi32(w, _mm256_slli_si256(ssig1_256x8(w), 8));
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+      x3 = w;
+    } else {
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+    }
+  }
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+void sha256_rounds_avx2(uint32_t state[8], const uint32_t * kw, int lane)
+{
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+  // kw is laid out as 16 rows of 8 words, block lane in words 0..3 or 4..7
+#define KWL(i) kw[8 * ((i) >> 2) + 4 * lane + ((i) & 3)]
+  for (int i = 0; i < 64; i += 8) {
+    ROUND256(a, b, c, d, e, f, g, h, KWL(i + 0));
+    ROUND256(h, a, b, c, d, e, f, g, KWL(i + 1));
+    ROUND256(g, h, a, b, c, d, e, f, KWL(i + 2));
+    ROUND256(f, g, h, a, b, c, d, e, KWL(i + 3));
+    ROUND256(e, f, g, h, a, b, c, d, KWL(i + 4));
+    ROUND256(d, e, f, g, h, a, b, c, KWL(i + 5));
+    ROUND256(c, d, e, f, g, h, a, b, KWL(i + 6));
+    ROUND256(b, c, d, e, f, g, h, a, KWL(i + 7));
+  }
+#undef KWL
+
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+AVX2_TARGET
+void crypt0_sha256_compress_avx2(uint32_t state[8], const uint32_t block[16])
+{
+  uint32_t kw[128] __attribute__((aligned(32)));
+  __m256i x[4];
+
+  for (int i = 0; i < 4; i++) {
+    x[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&block[4 * i]));
+  }
+  sha256_schedule_avx2(x[0], x[1], x[2], x[3], kw);
+  sha256_rounds_avx2(state, kw, 0);
+}
+
+AVX2_TARGET
+void crypt0_sha256_blocks_avx2(uint32_t state[8], const uint8_t * data, size_t nblocks)
+{
+  const __m256i mask = _mm256_set_epi64x(
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  uint32_t kw[128] __attribute__((aligned(32)));
+  __m256i x[4];
+
+  while (nblocks) {
+    // a lone last block is scheduled in both lanes, the upper one is ignored
+    const uint8_t * next = nblocks > 1 ? data + CRYPT0_SHA256_BLOCK_BYTES : data;
+
+    for (int i = 0; i < 4; i++) {
+      x[i] = _mm256_loadu2_m128i((const __m128i *)(next + 16 * i),
+          (const __m128i *)(data + 16 * i));
+      x[i] = _mm256_shuffle_epi8(x[i], mask);
+    }
+    sha256_schedule_avx2(x[0], x[1], x[2], x[3], kw);
+    sha256_rounds_avx2(state, kw, 0);
+    if (nblocks == 1) {
+      break;
+    }
+    sha256_rounds_avx2(state, kw, 1);
+    data += 2 * CRYPT0_SHA256_BLOCK_BYTES;
+    nblocks -= 2;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// AVX2 SHA-512, one block per schedule with four 64 bit words per vector.
+// There is no 64 bit rotate before avx-512, rotates are shift pairs.
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i ssig0_512x4(__m256i x)
+{
+  __m256i r = _mm256_xor_si256(_mm256_srli_epi64(x, 1), _mm256_slli_epi64(x, 63));
+  r = _mm256_xor_si256(r, _mm256_srli_epi64(x, 8));
+  r = _mm256_xor_si256(r, _mm256_slli_epi64(x, 56));
+  return _mm256_xor_si256(r, _mm256_srli_epi64(x, 7));
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i ssig1_512x4(__m256i x)
+{
+  __m256i r = _mm256_xor_si256(_mm256_srli_epi64(x, 19), _mm256_slli_epi64(x, 45));
+  r = _mm256_xor_si256(r, _mm256_srli_epi64(x, 61));
+  r = _mm256_xor_si256(r, _mm256_slli_epi64(x, 3));
+  return _mm256_xor_si256(r, _mm256_srli_epi64(x, 6));
+}
+
+// words 1..4 of the 8 word window lo:hi
+static inline __attribute__((always_inline)) AVX2_TARGET
+__m256i shift1_512x4(__m256i lo, __m256i hi)
+{
+  return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21), lo, 8);
+}
+
+static inline __attribute__((always_inline)) AVX2_TARGET
+void sha512_avx2(uint64_t state[8], __m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+  uint64_t kw[80] __attribute__((aligned(32)));
+
+#pragma GCC unroll 20
+  for (int i = 0; i < 20; i++) {
+    __m256i kv = _mm256_loadu_si256((const __m256i *)&crypt0_sha512_k[4 * i]);
+    _mm256_store_si256((__m256i *)&kw[4 * i], _mm256_add_epi64(x0, kv));
+    if (i < 16) {
+      __m256i w = _mm256_add_epi64(x0, ssig0_512x4(shift1_512x4(x0, x1)));
+      w = _mm256_add_epi64(w, shift1_512x4(x2, x3));
+      w = _mm256_add_epi64(w, ssig1_512x4(_mm256_permute2x128_si256(x3, x3, 0x81)));
+      w = _mm256_add_epi64(w, _mm256_permute2x128_si256(ssig1_512x4(w), w, 0x08));
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+      x3 = w;
+    } else {
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+    }
+  }
+
+  uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 80; i += 8) {
+    ROUND512(a, b, c, d, e, f, g, h, kw[i + 0]);
+    ROUND512(h, a, b, c, d, e, f, g, kw[i + 1]);
+    ROUND512(g, h, a, b, c, d, e, f, kw[i + 2]);
+    ROUND512(f, g, h, a, b, c, d, e, kw[i + 3]);
+    ROUND512(e, f, g, h, a, b, c, d, kw[i + 4]);
+    ROUND512(d, e, f, g, h, a, b, c, kw[i + 5]);
+    ROUND512(c, d, e, f, g, h, a, b, kw[i + 6]);
+    ROUND512(b, c, d, e, f, g, h, a, kw[i + 7]);
+  }
+
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+AVX2_TARGET
+void crypt0_sha512_compress_avx2(uint64_t state[8], const uint64_t block[16])
+{
+  const __m256i * x = (const __m256i *)block;
+
+  sha512_avx2(state, _mm256_loadu_si256(x + 0), _mm256_loadu_si256(x + 1),
+      _mm256_loadu_si256(x + 2), _mm256_loadu_si256(x + 3));
+}
+
+AVX2_TARGET
+void crypt0_sha512_blocks_avx2(uint64_t state[8], const uint8_t * data, size_t nblocks)
+{
+  const __m256i mask = _mm256_set_epi64x(
+      0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+      0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+  const __m256i * x = (const __m256i *)data;
+
+  while (nblocks--) {
+    sha512_avx2(state,
+        _mm256_shuffle_epi8(_mm256_loadu_si256(x + 0), mask),
+        _mm256_shuffle_epi8(_mm256_loadu_si256(x + 1), mask),
+        _mm256_shuffle_epi8(_mm256_loadu_si256(x + 2), mask),
+        _mm256_shuffle_epi8(_mm256_loadu_si256(x + 3), mask));
+    x += 4;
+  }
+}
+
+#endif
+
+// eof
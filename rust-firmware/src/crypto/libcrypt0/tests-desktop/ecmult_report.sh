@@ -0,0 +1,101 @@
+#!/bin/sh
+# Flash bytes of the libsecp256k1 precomputed tables and secp256k1 latency
+# for each ECMULT_WINDOW_SIZE / ECMULT_GEN_PREC_BITS setting, as markdown.
+#
+#   ./ecmult_report.sh > ECMULT_REPORT.md
+#
+# The tables are arrays of 64 byte points, their size is the same on every
+# target. Latency is measured on the build host with -O2: every setting is
+# built first, then the benchmark runs REPS rounds over all of them in turn
+# so drift of the host hits every setting alike, and the median and the
+# range of the rounds are reported.
+
+cd "$(dirname "$0")" || exit 1
+
+BUILD=${BUILD:-/tmp/crypt0-ecmult-report}
+WINDOWS=${WINDOWS:-"2 4 6 8 10 12 15"}
+GEN_BITS=${GEN_BITS:-"2 4 8"}
+REPS=${REPS:-9}
+
+# .rodata bytes of an object file
+rodata() {
+  size -A "$1" | awk '$1 ~ /^\.rodata/ { n += $2 } END { print n + 0 }'
+}
+
+# latencies in us of a bench-secp256k1 line over the rounds of a setting,
+# as "median (min-max)"
+latency() {
+  for f in "$2"/bench.*.txt; do
+    grep "^$1 " "$f" | awk '{ r = $(NF); sub("/s", "", r); if (r > 0) print 1e6 / r }'
+  done | sort -n | awk '
+    { v[NR] = $1 }
+    END {
+      if (NR == 0) { print "-"; exit }
+      m = NR % 2 ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2
+      printf "%.1f (%.1f-%.1f)", m, v[1], v[NR]
+    }'
+}
+
+build() {
+  dir=$BUILD/w$1-g$2
+  cmake -S . -B "$dir" \
+    -DCMAKE_C_FLAGS=-O2 -DCMAKE_CXX_FLAGS=-O2 \
+    -DCRYPT0_ECMULT_WINDOW_SIZE="$1" -DCRYPT0_ECMULT_GEN_PREC_BITS="$2" \
+    >/dev/null || exit 1
+  cmake --build "$dir" --target bench-secp256k1 -j"$(nproc)" >/dev/null 2>&1 || exit 1
+  rm -f "$dir"/bench.*.txt
+}
+
+SETTINGS=
+for g in $GEN_BITS; do
+  SETTINGS="$SETTINGS w15-g$g"
+  build 15 "$g"
+done
+for w in $WINDOWS; do
+  SETTINGS="$SETTINGS w$w-g4"
+  [ -d "$BUILD/w$w-g4/build" ] || build "$w" 4
+done
+SETTINGS=$(echo $SETTINGS | tr ' ' '\n' | sort -u)
+
+rep=1
+while [ "$rep" -le "$REPS" ]; do
+  for s in $SETTINGS; do
+    "$BUILD/$s/build/bench-secp256k1" >"$BUILD/$s/bench.$rep.txt" 2>/dev/null
+  done
+  rep=$((rep + 1))
+done
+
+echo "# libsecp256k1 table sizes"
+echo
+echo "Generated by \`tests-desktop/ecmult_report.sh\` on $(uname -m), $(date -u +%Y-%m-%d)."
+echo "Table bytes are exact and the same on every target. Latencies are the median"
+echo "and the range of $REPS rounds of \`bench-secp256k1\` on this host only, there are no"
+echo "device numbers: they show the spread of the host, not the trade-off on the"
+echo "nRF5340. Settings whose ranges overlap are not told apart by these numbers."
+echo
+echo "Only the table bytes carry over to the Cortex-M33. The firmware default, window"
+echo "8 and 4 gen bits, is picked on them against the flash budget; its latency on the"
+echo "device has not been measured, neither on hardware nor in qemu, which models no"
+echo "cycle timing."
+echo
+echo "## ECMULT_GEN_PREC_BITS, k*G: signing and public keys"
+echo
+echo "| bits | table bytes | sign us | public key us |"
+echo "|-----:|------------:|--------:|--------------:|"
+for g in $GEN_BITS; do
+  dir=$BUILD/w15-g$g
+  obj=$(find "$dir" -name precomputed_ecmult_gen.c.o)
+  echo "| $g | $(rodata "$obj") |" \
+    "$(latency "sign, shared context" "$dir") |" \
+    "$(latency "public key compressed" "$dir") |"
+done
+echo
+echo "## ECMULT_WINDOW_SIZE, a*P + b*G: verification and key recovery"
+echo
+echo "| window | table bytes | verify us |"
+echo "|-------:|------------:|----------:|"
+for w in $WINDOWS; do
+  dir=$BUILD/w$w-g4
+  obj=$(find "$dir" -name precomputed_ecmult.c.o)
+  echo "| $w | $(rodata "$obj") |" "$(latency "verify" "$dir") |"
+done
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+"""
+Differential test of the Thumb-2 field kernels of crypt0_field_10x26_thumb.s
+against the 10x26 C kernels, without an ARM machine.
+
+  field_thumb_check.py [--report] VECTORS_EXE
+
+The kernels are assembled with llvm-mc for cortex-m33 and disassembled with
+llvm-objdump. The machine code is then run instruction by instruction by the
+small Thumb-2 interpreter below on every input VECTORS_EXE
+(test-secp256k1-field-vectors) prints, and every result limb must equal the
+C one. Inputs cover r aliasing a, as fe_mul and fe_sqr call them.
+
+--report also prints the executed instruction counts and the llvm-mca
+cycle estimate of the Cortex-M33 scheduling model per kernel, as markdown.
+These are an interpreter and a static model, not qemu-arm or the device.
+
+LLVM_MC, LLVM_OBJDUMP and LLVM_MCA in the environment override the tools.
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+here = os.path.dirname(os.path.abspath(__file__))
+ASM = os.path.join(here, '..', 'src', 'crypt0_field_10x26_thumb.s')
+ASM_INCLUDE = os.path.join(here, '..', 'lib', 'secp256k1', 'src', 'asm')
+TRIPLE = 'thumbv8m.main-none-eabi'
+CPU = 'cortex-m33'
+
+M32 = 0xffffffff
+RETURN = 0xfffffffe     # lr on entry, pc reaching it ends the call
+
+MEM_SIZE = 0x10000
+STACK_TOP = 0xff00
+A, B, R = 0x1000, 0x1100, 0x1200
+
+
+def tool(name):
+    return os.environ.get(name.upper().replace('-', '_'), name)
+
+
+def run(cmd, **kw):
+    return subprocess.run(cmd, check=True, capture_output=True, text=True, **kw).stdout
+
+
+def assemble(obj):
+    run([tool('llvm-mc'), '-triple=' + TRIPLE, '-mcpu=' + CPU, '-filetype=obj',
+         '-I', ASM_INCLUDE, ASM, '-o', obj])
+
+
+# {symbol: [(address, size, mnemonic, operands)]} of the object
+def disassemble(obj):
+    text = run([tool('llvm-objdump'), '-d', '--triple=' + TRIPLE, '--mcpu=' + CPU, obj])
+    funcs, current = {}, None
+    for line in text.splitlines():
+        m = re.match(r'^[0-9a-f]+ <(\w+)>:$', line)
+        if m:
+            current = funcs.setdefault(m.group(1), [])
+            continue
+        m = re.match(r'^\s*([0-9a-f]+):\s+((?:[0-9a-f]{2} )+)\s*\t(\S+)\s*(.*)$', line)
+        if m and current is not None:
+            size = len(m.group(2).split())
+            current.append((int(m.group(1), 16), size, m.group(3), m.group(4).strip()))
+    return funcs
+
+
+REGS = {'r%d' % i: i for i in range(13)}
+REGS.update({'sp': 13, 'lr': 14, 'pc': 15})
+
+
+class Unsupported(Exception):
+    pass
+
+
+class Cpu:
+    def __init__(self):
+        self.r = [0] * 16
+        self.c = 0
+        self.mem = bytearray(MEM_SIZE)
+
+    def load(self, addr):
+        if addr & 3 or not 0 <= addr < MEM_SIZE - 3:
+            raise Unsupported('load at %#x' % addr)
+        return int.from_bytes(self.mem[addr:addr + 4], 'little')
+
+    def store(self, addr, v):
+        if addr & 3 or not 0 <= addr < MEM_SIZE - 3:
+            raise Unsupported('store at %#x' % addr)
+        self.mem[addr:addr + 4] = (v & M32).to_bytes(4, 'little')
+
+    def reg(self, s):
+        if s not in REGS:
+            raise Unsupported('register %s' % s)
+        return REGS[s]
+
+    def imm(self, s):
+        if not s.startswith('#'):
+            raise Unsupported('immediate %s' % s)
+        return int(s[1:], 0) & M32
+
+    def operand(self, s):
+        return self.imm(s) if s.startswith('#') else self.r[self.reg(s)]
+
+    # operands of one instruction: registers, immediates, [base, #off] and {list}
+    @staticmethod
+    def split(ops):
+        out, depth, cur = [], 0, ''
+        for ch in ops:
+            if ch in '[{':
+                depth += 1
+            elif ch in ']}':
+                depth -= 1
+            if ch == ',' and depth == 0:
+                out.append(cur.strip())
+                cur = ''
+            else:
+                cur += ch
+        if cur.strip():
+            out.append(cur.strip())
+        return out
+
+    def address(self, s):
+        m = re.match(r'^\[(\w+)(?:,\s*#(-?\w+))?\]$', s)
+        if not m:
+            raise Unsupported('address %s' % s)
+        return (self.r[self.reg(m.group(1))] + int(m.group(2) or '0', 0)) & M32
+
+    def reglist(self, s):
+        if not (s.startswith('{') and s.endswith('}')):
+            raise Unsupported('register list %s' % s)
+        return sorted(self.reg(x.strip()) for x in s[1:-1].split(','))
+
+    def step(self, mnemonic, ops):
+        r = self.r
+        op = mnemonic[:-2] if mnemonic.endswith('.w') else mnemonic
+        a = self.split(ops)
+
+        if op in ('ldr', 'str'):
+            addr = self.address(a[1])
+            if op == 'ldr':
+                r[self.reg(a[0])] = self.load(addr)
+            else:
+                self.store(addr, r[self.reg(a[0])])
+        elif op in ('ldm', 'stm'):
+            if a[0].endswith('!'):
+                raise Unsupported('ldm/stm writeback')
+            addr = r[self.reg(a[0])]
+            for i in self.reglist(a[1]):
+                if op == 'ldm':
+                    r[i] = self.load(addr)
+                else:
+                    self.store(addr, r[i])
+                addr += 4
+        elif op == 'push':
+            regs = self.reglist(a[0])
+            r[13] -= 4 * len(regs)
+            for n, i in enumerate(regs):
+                self.store(r[13] + 4 * n, r[i])
+        elif op == 'pop':
+            regs = self.reglist(a[0])
+            for n, i in enumerate(regs):
+                r[i] = self.load(r[13] + 4 * n)
+            r[13] += 4 * len(regs)
+        elif op in ('umull', 'umlal'):
+            lo, hi, n, m = (self.reg(x) for x in a)
+            acc = (r[hi] << 32 | r[lo]) if op == 'umlal' else 0
+            v = (acc + r[n] * r[m]) & ((1 << 64) - 1)
+            r[lo], r[hi] = v & M32, v >> 32
+        elif op == 'mla':
+            d, n, m, acc = (self.reg(x) for x in a)
+            r[d] = (r[n] * r[m] + r[acc]) & M32
+        elif op == 'movw':
+            r[self.reg(a[0])] = self.imm(a[1]) & 0xffff
+        elif op in ('lsr', 'lsl'):
+            if len(a) != 3:
+                raise Unsupported('%s %s' % (mnemonic, ops))
+            v, s = r[self.reg(a[1])], self.imm(a[2])
+            r[self.reg(a[0])] = (v >> s if op == 'lsr' else v << s) & M32
+        elif op == 'ubfx':
+            lsb, width = self.imm(a[2]), self.imm(a[3])
+            r[self.reg(a[0])] = (r[self.reg(a[1])] >> lsb) & ((1 << width) - 1)
+        elif op in ('add', 'adds', 'sub', 'adc', 'orr', 'bic'):
+            # two operand forms are d, d, x
+            d, n, x = (a[0], a[0], a[1]) if len(a) == 2 else (a[0], a[1], a[2])
+            if len(a) > 3:
+                m = re.match(r'^lsl #(\d+)$', a[3])
+                if not m or op != 'orr':
+                    raise Unsupported('%s %s' % (mnemonic, ops))
+                y = (self.operand(x) << int(m.group(1))) & M32
+            else:
+                y = self.operand(x)
+            v = r[self.reg(n)]
+            if op in ('add', 'adds'):
+                full = v + y
+            elif op == 'adc':
+                full = v + y + self.c
+            elif op == 'sub':
+                full = v - y
+            elif op == 'orr':
+                full = v | y
+            else:
+                full = v & ~y
+            if op == 'adds':
+                self.c = 1 if full > M32 else 0
+            r[self.reg(d)] = full & M32
+        else:
+            raise Unsupported('%s %s' % (mnemonic, ops))
+
+    # runs code from its first instruction until it returns to RETURN,
+    # the number of instructions executed
+    def call(self, code, args):
+        by_addr = {addr: (size, mn, ops) for addr, size, mn, ops in code}
+        self.r = [0] * 16
+        self.r[:len(args)] = args
+        self.r[13], self.r[14] = STACK_TOP, RETURN
+        pc, count = code[0][0], 0
+        while True:
+            size, mn, ops = by_addr[pc]
+            self.step(mn, ops)
+            count += 1
+            if self.r[15] == RETURN:
+                return count
+            if self.r[15] != 0:
+                raise Unsupported('branch to %#x' % self.r[15])
+            pc += size
+
+    def put(self, addr, limbs):
+        for i, v in enumerate(limbs):
+            self.store(addr + 4 * i, v)
+
+    def get(self, addr):
+        return [self.load(addr + 4 * i) for i in range(10)]
+
+
+def vectors(exe):
+    for line in run([exe]).splitlines():
+        f = line.split()
+        yield f[0], [int(x, 16) for x in f[1:]]
+
+
+def check(funcs, exe):
+    cpu = Cpu()
+    counts, n = {}, 0
+    for op, w in vectors(exe):
+        if op == 'mul':
+            a, b, expected = w[:10], w[10:20], w[20:]
+            # r == a then r apart, fe_mul allows both
+            cases = [(A, [A, A, B]), (R, [R, A, B])]
+            code = funcs['secp256k1_fe_mul_inner']
+        else:
+            a, b, expected = w[:10], None, w[10:]
+            cases = [(A, [A, A]), (R, [R, A])]
+            code = funcs['secp256k1_fe_sqr_inner']
+        for out, args in cases:
+            cpu.put(A, a)
+            if b is not None:
+                cpu.put(B, b)
+            count = cpu.call(code, args)
+            got = cpu.get(out)
+            if got != expected:
+                sys.exit('%s %d differs\n  a %s\n  b %s\n  C    %s\n  asm  %s' % (
+                    op, n, ' '.join('%08x' % x for x in a),
+                    ' '.join('%08x' % x for x in b or []),
+                    ' '.join('%08x' % x for x in expected), ' '.join('%08x' % x for x in got)))
+            counts[op] = count
+        n += 1
+    if n == 0:
+        sys.exit('no vectors from %s' % exe)
+    return n, counts
+
+
+# llvm-mca cycles of one pass through a kernel, straight line code
+def mca_cycles(code, tmp):
+    with open(tmp, 'w') as f:
+        f.write('\t.syntax unified\n\t.thumb\n')
+        for _, _, mn, ops in code:
+            f.write('\t%s\t%s\n' % (mn, ops))
+    out = run([tool('llvm-mca'), '-mtriple=' + TRIPLE, '-mcpu=' + CPU, '-iterations=1', tmp])
+    return int(re.search(r'Total Cycles:\s+(\d+)', out).group(1))
+
+
+REPORT_HEAD = """# Thumb-2 field kernels
+
+Generated by `tests-desktop/field_thumb_check.py --report`. Both kernels are
+libsecp256k1's `field_10x26_arm.s` (UMULL/UMLAL) assembled as Thumb-2 by
+`src/crypt0_field_10x26_thumb.s`, not new code.
+
+%d vectors of the C kernels matched limb for limb, run by the interpreter of
+the script on the llvm-mc machine code. Cycles are the llvm-mca estimate of
+the LLVM %s scheduling model for one call. These are not measurements: no
+qemu-arm and no device run has been made, and there is no ARM C compiler in
+the build environment to estimate the portable C kernels the same way, so
+nothing here shows the signing latency on the nRF5340.
+"""
+
+
+def main(argv):
+    report = '--report' in argv
+    args = [a for a in argv if a != '--report']
+    if len(args) != 1:
+        sys.exit(__doc__)
+    tmp = os.environ.get('TMPDIR', '/tmp')
+    obj = os.path.join(tmp, 'crypt0_field_thumb_%d.o' % os.getpid())
+    try:
+        assemble(obj)
+        funcs = disassemble(obj)
+    finally:
+        if os.path.exists(obj):
+            os.remove(obj)
+
+    try:
+        n, counts = check(funcs, args[0])
+    except Unsupported as e:
+        sys.exit('interpreter: %s' % e)
+    if not report:
+        print('%d vectors, Thumb-2 kernels match the C kernels' % n)
+        return
+
+    src = os.path.join(tmp, 'crypt0_field_mca_%d.s' % os.getpid())
+    try:
+        print(REPORT_HEAD % (n, CPU))
+        print('| kernel | instructions executed | llvm-mca %s cycles |' % CPU)
+        print('|--------|----------------------:|-------------------:|')
+        for op in ('mul', 'sqr'):
+            code = funcs['secp256k1_fe_%s_inner' % op]
+            print('| fe_%s_inner | %d | %d |' % (op, counts[op], mca_cycles(code, src)))
+    finally:
+        if os.path.exists(src):
+            os.remove(src)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,104 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_address.h>
+#include <crypt0_bip32.h>
+#include <crypt0_ripemd160.h>
+#include <crypt0_secp256k1.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_address, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// addresses per second of a gap limit scan, receive chain 0..ADDRESSES-1:
+// each address from the seed through its path, through a cursor, and the
+// range pipeline from the account extended public key
+
+#define ADDRESSES 200
+
+static uint8_t seed[64];
+static uint8_t scratch[CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES];
+static char arena[CRYPT0_ADDRESS_RANGE_OUT_BYTES(ADDRESSES)];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void address_one(const uint8_t * secret, int format, char * out)
+{
+  uint8_t pub[33], hash[20];
+
+  crypt0_secp256k1_public_key_compressed(secret, 32, pub, sizeof(pub));
+  if (format == CRYPT0_ADDRESS_P2PKH) {
+    crypt0_base58_checksum_address(pub, 33, 0x00, out, 96);
+  } else {
+    crypt0_hash160(pub, 33, hash);
+    crypt0_bech32_witness_v0_encode(hash, 20, "bc", out, 96);
+  }
+}
+
+static void bench(int purpose, int format, const char * name)
+{
+  static uint8_t paths[ADDRESSES][CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t xpub[78], secret[64];
+  char out[96];
+  crypt0_bip32_cursor cursor;
+
+  for (int i = 0; i < ADDRESSES; i++) {
+    char str[32];
+    snprintf(str, sizeof(str), "m/%d'/0'/0'/0/%d", purpose, i);
+    crypt0_bip32_path_from_string(str, paths[i], CRYPT0_BIP32_PATH_MAX_BYTES);
+  }
+  crypt0_bip32_seed_to_account_pubkey(seed, xpub, purpose | CRYPT0_BIP32_INDEX_HARDENED,
+      CRYPT0_BIP32_INDEX_HARDENED, CRYPT0_BIP32_INDEX_HARDENED);
+
+  // best of a few alternating runs, the host is noisy
+  double from_seed = 1e9, with_cursor = 1e9, range = 1e9;
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_seed_to_secret(seed, secret);
+      crypt0_bip32_derive_secret_path(secret, paths[i]);
+      address_one(secret, format, out);
+    }
+    from_seed = min(from_seed, seconds_since(start));
+
+    start = chrono::steady_clock::now();
+    crypt0_bip32_cursor_init(&cursor, seed);
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_cursor_derive(&cursor, paths[i], secret);
+      address_one(secret, format, out);
+    }
+    with_cursor = min(with_cursor, seconds_since(start));
+    crypt0_bip32_cursor_wipe(&cursor);
+
+    start = chrono::steady_clock::now();
+    crypt0_address_range(xpub, 0, 0, ADDRESSES, CRYPT0_COIN_BTC, format,
+        arena, sizeof(arena), scratch, sizeof(scratch));
+    range = min(range, seconds_since(start));
+  }
+
+  printf("%-6s %d addresses/s: from seed %8.0f, cursor %8.0f, range %8.0f (x%.2f, x%.2f)\n",
+      name, ADDRESSES, ADDRESSES / from_seed, ADDRESSES / with_cursor, ADDRESSES / range,
+      from_seed / range, with_cursor / range);
+}
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(seed); i++) {
+    seed[i] = (uint8_t)(i * 7 + 1);
+  }
+
+  bench(44, CRYPT0_ADDRESS_P2PKH, "p2pkh");
+  bench(84, CRYPT0_ADDRESS_P2WPKH, "p2wpkh");
+  return 0;
+}
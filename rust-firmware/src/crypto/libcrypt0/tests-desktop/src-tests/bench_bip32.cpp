@@ -0,0 +1,152 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_bip32.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_bip32, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// receive addresses m/84'/0'/0'/0/i: each path from the seed against a
+// cursor that keeps the account and chain nodes. Then the address public
+// keys: crypt0_bip32_derive_secret_index from the chain node (parent and
+// child public key), through the cursor (child public key) and public
+// derivation from the chain node. Last, 20 ed25519 accounts (SLIP-10) each
+// from the seed against one cursor
+
+#define ADDRESSES 100
+
+static uint8_t seed[64];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void address_path(uint8_t * path, int i)
+{
+  char str[32];
+  snprintf(str, sizeof(str), "m/84'/0'/0'/0/%d", i);
+  crypt0_bip32_path_from_string(str, path, CRYPT0_BIP32_PATH_MAX_BYTES);
+}
+
+int main(void)
+{
+  static uint8_t paths[ADDRESSES][CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t secret[64];
+  crypt0_bip32_cursor cursor;
+
+  for (size_t i = 0; i < sizeof(seed); i++) {
+    seed[i] = (uint8_t)(i * 7 + 1);
+  }
+  for (int i = 0; i < ADDRESSES; i++) {
+    address_path(paths[i], i);
+  }
+
+  // best of a few alternating runs, the host is noisy
+  double from_seed = 1e9, with_cursor = 1e9;
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_seed_to_secret(seed, secret);
+      crypt0_bip32_derive_secret_path(secret, paths[i]);
+    }
+    from_seed = min(from_seed, seconds_since(start) / ADDRESSES);
+
+    start = chrono::steady_clock::now();
+    crypt0_bip32_cursor_init(&cursor, seed);
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_cursor_derive(&cursor, paths[i], secret);
+    }
+    with_cursor = min(with_cursor, seconds_since(start) / ADDRESSES);
+    crypt0_bip32_cursor_wipe(&cursor);
+  }
+
+  printf("%d addresses: from seed %8.1f us/path, cursor %8.1f us/path, x%.2f\n",
+      ADDRESSES, from_seed * 1e6, with_cursor * 1e6, from_seed / with_cursor);
+
+  static uint8_t pubs[ADDRESSES * 33];
+  static uint8_t scratch[CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(ADDRESSES)];
+  uint8_t chain[CRYPT0_BIP32_PUBNODE_BYTES], child[CRYPT0_BIP32_PUBNODE_BYTES];
+
+  crypt0_bip32_cursor_init(&cursor, seed);
+  crypt0_bip32_cursor_derive(&cursor, paths[0], secret);
+  crypt0_bip32_secret_to_pubnode(cursor.node[4], chain);
+
+  double index = 1e9, priv = 1e9, ckd_pub = 1e9, ckd_pub_batch = 1e9;
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ADDRESSES; i++) {
+      memcpy(secret, cursor.node[4], 64);
+      crypt0_bip32_derive_secret_index(secret, i);
+      crypt0_secp256k1_public_key_compressed(secret, 32, &pubs[33 * i], 33);
+    }
+    index = min(index, seconds_since(start) / ADDRESSES);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_cursor_derive(&cursor, paths[i], secret);
+      crypt0_secp256k1_public_key_compressed(secret, 32, &pubs[33 * i], 33);
+    }
+    priv = min(priv, seconds_since(start) / ADDRESSES);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < ADDRESSES; i++) {
+      crypt0_bip32_ckd_pub(chain, i, child);
+    }
+    ckd_pub = min(ckd_pub, seconds_since(start) / ADDRESSES);
+
+    start = chrono::steady_clock::now();
+    crypt0_bip32_ckd_pub_batch(chain, 0, ADDRESSES, pubs, scratch, sizeof(scratch));
+    ckd_pub_batch = min(ckd_pub_batch, seconds_since(start) / ADDRESSES);
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+
+  printf("%d address pubkeys: derive index %8.1f us, cursor %8.1f us x%.2f, "
+      "ckd_pub %8.1f us x%.2f, ckd_pub batch %8.1f us x%.2f\n",
+      ADDRESSES, index * 1e6, priv * 1e6, index / priv, ckd_pub * 1e6, index / ckd_pub,
+      ckd_pub_batch * 1e6, index / ckd_pub_batch);
+
+  static const struct {
+    const char * name;
+    const char * format;
+  } ed25519_paths[] = {
+    { "solana", "m/44'/501'/%d'/0'" },
+    { "near", "m/44'/397'/0'/0'/%d'" },
+  };
+  for (auto & p : ed25519_paths) {
+    for (int i = 0; i < 20; i++) {
+      char str[32];
+      snprintf(str, sizeof(str), p.format, i);
+      crypt0_bip32_path_from_string(str, paths[i], CRYPT0_BIP32_PATH_MAX_BYTES);
+    }
+
+    double ed_seed = 1e9, ed_cursor = 1e9;
+    for (int rep = 0; rep < 3; rep++) {
+      auto start = chrono::steady_clock::now();
+      for (int i = 0; i < 20; i++) {
+        crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, secret);
+        crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_ED25519, secret, paths[i]);
+      }
+      ed_seed = min(ed_seed, seconds_since(start) / 20);
+
+      start = chrono::steady_clock::now();
+      crypt0_slip10_cursor_init(&cursor, CRYPT0_SLIP10_ED25519, seed);
+      for (int i = 0; i < 20; i++) {
+        crypt0_bip32_cursor_derive(&cursor, paths[i], secret);
+      }
+      ed_cursor = min(ed_cursor, seconds_since(start) / 20);
+      crypt0_bip32_cursor_wipe(&cursor);
+    }
+    printf("20 %-6s accounts: from seed %8.2f us, cursor %8.2f us, x%.2f\n",
+        p.name, ed_seed * 1e6, ed_cursor * 1e6, ed_seed / ed_cursor);
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_bip39.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_bip39, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// word to index over the whole list: the linear scan and the binary search
+// a word entry screen would do against the perfect hash, then the next
+// letters of every 1 to 4 letter prefix (the keyboard of word entry)
+
+#define ROUNDS 20
+
+extern "C" const char * crypt0_bip39_english[];
+
+static volatile int sink;
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// best of a few runs of ROUNDS passes over the list, ns per word
+static double bench(void (*op)(const char *, size_t))
+{
+  double best = 1e9;
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+      for (int i = 0; i < 2048; i++) {
+        op(crypt0_bip39_english[i], strlen(crypt0_bip39_english[i]));
+      }
+    }
+    best = min(best, seconds_since(start) / ROUNDS / 2048);
+  }
+  return best * 1e9;
+}
+
+static void linear(const char * word, size_t len)
+{
+  for (int i = 0; i < 2048; i++) {
+    if (strncmp(crypt0_bip39_english[i], word, len) == 0 && crypt0_bip39_english[i][len] == 0) {
+      sink = i;
+      return;
+    }
+  }
+}
+
+static void binary(const char * word, size_t len)
+{
+  int lo = 0, hi = 2047;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    int cmp = strncmp(crypt0_bip39_english[mid], word, len);
+    if (cmp == 0 && crypt0_bip39_english[mid][len] != 0) {
+      cmp = 1;
+    }
+    if (cmp == 0) {
+      sink = mid;
+      return;
+    }
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+}
+
+static void mph(const char * word, size_t len)
+{
+  sink = crypt0_bip39_word_index(word, len);
+}
+
+// next letters by scanning the list for the prefix, against the trie
+static void prefixes_scan(const char * word, size_t len)
+{
+  for (size_t n = 1; n <= 4 && n <= len; n++) {
+    uint32_t letters = 0;
+    for (int i = 0; i < 2048; i++) {
+      const char * w = crypt0_bip39_english[i];
+      if (strncmp(w, word, n) == 0) {
+        letters |= w[n] ? 1u << (w[n] - 'a') : CRYPT0_BIP39_WORD_COMPLETE;
+      }
+    }
+    sink = letters;
+  }
+}
+
+static void prefixes_trie(const char * word, size_t len)
+{
+  for (size_t n = 1; n <= 4 && n <= len; n++) {
+    sink = crypt0_bip39_next_letters(word, n, NULL, NULL);
+  }
+}
+
+int main(void)
+{
+  double scan = bench(linear), search = bench(binary), hash = bench(mph);
+  printf("word index: linear %8.1f ns, binary search %8.1f ns, perfect hash %8.1f ns "
+      "(x%.1f, x%.1f)\n", scan, search, hash, scan / hash, search / hash);
+
+  double letters_scan = bench(prefixes_scan), letters_trie = bench(prefixes_trie);
+  printf("next letters of 4 prefixes: scan %8.1f ns, trie %8.1f ns (x%.1f)\n",
+      letters_scan, letters_trie, letters_scan / letters_trie);
+  return 0;
+}
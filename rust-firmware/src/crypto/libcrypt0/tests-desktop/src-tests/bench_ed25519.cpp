@@ -0,0 +1,159 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_bip32.h>
+#include <crypt0_ed25519.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef BENCH_WITH_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_ed25519, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// public keys one call per key against batches of 20 (Solana and NEAR
+// account lists), and signatures. Then a signing session of SESSION messages
+// by one Solana account: the key from the seed, its public key and the
+// signature per message against one expanded key pair for the session. With
+// OpenSSL, the EVP calls the desktop backend made before, a key object
+// created and freed per call
+
+#define ROUNDS 400
+#define ACCOUNTS 20
+#define SESSION 8
+
+static uint8_t priv[ACCOUNTS * 32];
+static uint8_t pub[ACCOUNTS * 32];
+static uint8_t msg[200];
+static uint8_t seed[64];
+static uint8_t solana_path[CRYPT0_BIP32_PATH_MAX_BYTES];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// best of a few runs of ROUNDS calls, us per call
+static double bench(void (*op)())
+{
+  double best = 1e9;
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+      op();
+    }
+    best = min(best, seconds_since(start) / ROUNDS);
+  }
+  return best * 1e6;
+}
+
+static void public_key_each()
+{
+  for (int i = 0; i < ACCOUNTS; i++) {
+    crypt0_ed25519_public_key(&priv[32 * i], 32, &pub[32 * i], 32);
+  }
+}
+
+static void public_keys_batch()
+{
+  crypt0_ed25519_public_keys(priv, ACCOUNTS, pub);
+}
+
+static void sign()
+{
+  uint8_t sig[64];
+  crypt0_ed25519_sign(msg, sizeof(msg), priv, 32, pub, 32, sig, sizeof(sig));
+}
+
+static void session_per_message()
+{
+  uint8_t secret[64], pub32[32], sig[64];
+  for (int i = 0; i < SESSION; i++) {
+    crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, secret);
+    crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_ED25519, secret, solana_path);
+    crypt0_ed25519_public_key(secret, 32, pub32, sizeof(pub32));
+    crypt0_ed25519_sign(msg, sizeof(msg), secret, 32, pub32, sizeof(pub32), sig, sizeof(sig));
+  }
+  crypt0_memzero(secret, sizeof(secret));
+}
+
+static void session_keypair()
+{
+  uint8_t secret[64], sig[64];
+  crypt0_ed25519_keypair keypair;
+
+  crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, secret);
+  crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_ED25519, secret, solana_path);
+  crypt0_ed25519_keypair_init(&keypair, secret, 32);
+  crypt0_memzero(secret, sizeof(secret));
+  for (int i = 0; i < SESSION; i++) {
+    crypt0_ed25519_keypair_sign(&keypair, msg, sizeof(msg), sig, sizeof(sig));
+  }
+  crypt0_ed25519_keypair_wipe(&keypair);
+}
+
+#ifdef BENCH_WITH_OPENSSL
+static void public_key_openssl()
+{
+  for (int i = 0; i < ACCOUNTS; i++) {
+    size_t publen = 32;
+    EVP_PKEY * pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, &priv[32 * i], 32);
+    EVP_PKEY_get_raw_public_key(pkey, &pub[32 * i], &publen);
+    EVP_PKEY_free(pkey);
+  }
+}
+
+static void sign_openssl()
+{
+  uint8_t sig[64];
+  size_t siglen = sizeof(sig);
+  EVP_MD_CTX * mdctx = EVP_MD_CTX_new();
+  EVP_PKEY * pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, priv, 32);
+  EVP_DigestSignInit(mdctx, NULL, NULL, NULL, pkey);
+  EVP_DigestSign(mdctx, sig, &siglen, msg, sizeof(msg));
+  EVP_PKEY_free(pkey);
+  EVP_MD_CTX_free(mdctx);
+}
+#endif
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(priv); i++) {
+    priv[i] = (uint8_t)(i * 7 + 1);
+  }
+  for (size_t i = 0; i < sizeof(msg); i++) {
+    msg[i] = (uint8_t)i;
+  }
+  for (size_t i = 0; i < sizeof(seed); i++) {
+    seed[i] = (uint8_t)(i * 7 + 1);
+  }
+  crypt0_bip32_path_from_string("m/44'/501'/0'/0'", solana_path, sizeof(solana_path));
+
+  double each = bench(public_key_each) / ACCOUNTS;
+  double batch = bench(public_keys_batch) / ACCOUNTS;
+  printf("%d public keys: one call each %8.1f us/key, batch %8.1f us/key, x%.2f\n",
+      ACCOUNTS, each, batch, each / batch);
+
+  crypt0_ed25519_public_key(priv, 32, pub, 32);
+  printf("sign %d bytes: %8.1f us\n", (int)sizeof(msg), bench(sign));
+
+  double per_message = bench(session_per_message) / SESSION;
+  double keypair = bench(session_keypair) / SESSION;
+  printf("session of %d: key per message %8.1f us/sig, key pair %8.1f us/sig, x%.2f\n",
+      SESSION, per_message, keypair, per_message / keypair);
+
+#ifdef BENCH_WITH_OPENSSL
+  printf("openssl: public key %8.1f us/key, sign %8.1f us\n",
+      bench(public_key_openssl) / ACCOUNTS, bench(sign_openssl));
+#endif
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_ripemd160.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_hash160, LOG_LEVEL_DBG);
+
+// the libbtc implementation libcrypt0 used before
+#include "ripemd160_.c"
+
+using namespace std;
+
+// ripemd160 of a sha256 digest and the hash160 of a compressed pubkey, the
+// old libbtc code against the word oriented one and the fused call
+
+#define ROUNDS 500000
+
+static uint8_t pub[33];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void hash160_libbtc(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  uint8_t sha[32];
+  crypt0_sha256(msg, len, sha, 32);
+  ripemd160(sha, 32, out);
+}
+
+static void hash160_separate(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  uint8_t sha[32];
+  crypt0_sha256(msg, len, sha, 32);
+  crypt0_ripemd160(sha, 32, out);
+}
+
+static void ripemd160_libbtc(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  ripemd160(msg, len, out);
+}
+
+static void ripemd160_crypt0(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  crypt0_ripemd160(msg, len, out);
+}
+
+typedef void (*hash_fn)(const uint8_t * msg, size_t len, uint8_t * out);
+
+static double bench(const char * name, hash_fn fn, size_t len)
+{
+  uint8_t out[20];
+  memcpy(out, pub, sizeof(out));
+
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; i++) {
+    // chain the output into the input so calls can't overlap
+    pub[1] = out[0];
+    fn(pub, len, out);
+  }
+  double rate = ROUNDS / seconds_since(start);
+  printf("%-28s %10.0f/s\n", name, rate);
+  return rate;
+}
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(pub); i++) {
+    pub[i] = (uint8_t)(i * 131 + 7);
+  }
+  pub[0] = 0x02;
+
+  double before = bench("ripemd160 32 bytes libbtc", ripemd160_libbtc, 32);
+  double after = bench("ripemd160 32 bytes crypt0", ripemd160_crypt0, 32);
+  printf("x%.2f\n", after / before);
+
+  before = bench("hash160 33 bytes libbtc", hash160_libbtc, 33);
+  bench("hash160 33 bytes separate", hash160_separate, 33);
+  after = bench("hash160 33 bytes fused", crypt0_hash160, 33);
+  printf("x%.2f\n", after / before);
+
+  return 0;
+}
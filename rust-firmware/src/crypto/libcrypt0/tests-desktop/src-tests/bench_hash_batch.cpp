@@ -0,0 +1,108 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_sha2.h>
+#include <crypt0_ripemd160.h>
+#include <crypt0_hash_batch.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_hash_batch, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// Gap limit style workload: hash160 of a run of compressed pubkeys and the
+// base58check double sha256 of the 21 byte payloads, serial against batch
+
+#define COUNT 1000
+
+static uint8_t pubs[COUNT * 33];
+static uint8_t payloads[COUNT * 21];
+static uint8_t out_serial[COUNT * 32];
+static uint8_t out_batch[COUNT * 32];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void hash160_serial(const uint8_t * in, size_t len, size_t n, uint8_t * out)
+{
+  uint8_t sha[32];
+
+  for (size_t i = 0; i < n; i++) {
+    crypt0_sha256(in + i * len, len, sha, 32);
+    crypt0_ripemd160(sha, 32, out + 20 * i);
+  }
+}
+
+static void dsha256_serial(const uint8_t * in, size_t len, size_t n, uint8_t * out)
+{
+  uint8_t sha[32];
+
+  for (size_t i = 0; i < n; i++) {
+    crypt0_sha256(in + i * len, len, sha, 32);
+    crypt0_sha256(sha, 32, out + 32 * i, 32);
+  }
+}
+
+typedef void (*batch_fn)(const uint8_t * in, size_t len, size_t n, uint8_t * out);
+
+static bool bench(const char * name, batch_fn serial, batch_fn batch,
+    const uint8_t * in, size_t len, size_t digest_len, int rounds)
+{
+  auto start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    serial(in, len, COUNT, out_serial);
+  }
+  double before = seconds_since(start);
+
+  start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    batch(in, len, COUNT, out_batch);
+  }
+  double after = seconds_since(start);
+
+  double total = (double)COUNT * rounds;
+  printf("%-24s %-7s %10.0f/s serial %10.0f/s batch  x%.2f\n", name,
+      crypt0_sha2_kernel_name(crypt0_sha2_kernel()), total / before, total / after,
+      before / after);
+
+  if (memcmp(out_serial, out_batch, COUNT * digest_len) != 0) {
+    LOG_ERR("%s: digests differ", name);
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  const crypt0_sha2_kernel_t kernels[] = {
+    CRYPT0_SHA2_KERNEL_SCALAR, CRYPT0_SHA2_KERNEL_AVX2, CRYPT0_SHA2_KERNEL_SHANI,
+  };
+  bool ok = true;
+
+  for (size_t i = 0; i < sizeof(pubs); i++) {
+    pubs[i] = (uint8_t)(i * 131 + 7);
+  }
+  for (size_t i = 0; i < sizeof(payloads); i++) {
+    payloads[i] = (uint8_t)(i * 151 + 3);
+  }
+
+  for (auto kernel : kernels) {
+    if (!crypt0_sha2_kernel_select(kernel)) {
+      continue;
+    }
+    ok &= bench("hash160 33 byte pubkey", hash160_serial, crypt0_hash160_batch,
+        pubs, 33, 20, 200);
+    ok &= bench("dsha256 21 byte payload", dsha256_serial, crypt0_dsha256_batch,
+        payloads, 21, 32, 200);
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_keccak.h>
+
+#include <chrono>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES 1
+#endif
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_keccak, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// Keccak-f[1600] implementations in cycles per permutation and cycles per
+// byte of keccak256 input (136 byte rate). Without a cycle counter the
+// numbers are nanoseconds instead.
+
+#define PERMUTATIONS 200000
+
+typedef void (*keccakf_fn)(uint64_t state[25]);
+
+static uint8_t data[4096];
+
+static uint64_t ticks()
+{
+#ifdef BENCH_CYCLES
+  return __rdtsc();
+#else
+  return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void bench(const char * name, keccakf_fn fn)
+{
+  uint64_t st[25];
+  memset(st, 0, sizeof(st));
+
+  uint64_t start = ticks();
+  for (int i = 0; i < PERMUTATIONS; i++) {
+    fn(st);
+  }
+  double per_perm = (double)(ticks() - start) / PERMUTATIONS;
+
+  printf("keccak-f[1600] %-4s %8.0f per permutation %6.2f per byte\n", name,
+      per_perm, per_perm / 136);
+}
+
+int main(void)
+{
+#ifdef BENCH_CYCLES
+  printf("units: cycles (rdtsc)\n");
+#else
+  printf("units: ns\n");
+#endif
+
+  bench("ref", crypt0_keccakf1600_ref);
+  bench("lc", crypt0_keccakf1600_lc);
+  bench("bi", crypt0_keccakf1600_bi);
+
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)(i * 131 + 7);
+  }
+
+  // the sponge on top of the build's permutation, one long and one
+  // address sized message
+  const size_t lens[] = { sizeof(data), 64 };
+  uint8_t out[32];
+
+  for (auto len : lens) {
+    int rounds = (int)(20000000 / (len + 64));
+    uint64_t start = ticks();
+    for (int r = 0; r < rounds; r++) {
+      crypt0_sha3_keccak(data, len, out, 32);
+    }
+    double per_msg = (double)(ticks() - start) / rounds;
+    printf("keccak256 %-4s %5d bytes %8.0f per message %6.2f per byte\n",
+        crypt0_keccakf1600_impl(), (int)len, per_msg, per_msg / len);
+  }
+
+  return 0;
+}
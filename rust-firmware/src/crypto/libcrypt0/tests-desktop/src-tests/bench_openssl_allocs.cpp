@@ -0,0 +1,144 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_hmac.h>
+#include <crypt0_secp256k1.h>
+#include <crypt0_ed25519.h>
+#include <crypt0_aes_ccm.h>
+
+#include <openssl/crypto.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_openssl_allocs, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// Heap allocations OpenSSL makes per libcrypt0 call on the OpenSSL backend,
+// counted through CRYPTO_set_mem_functions, and the call rate. The first
+// call of each operation is not counted, it may fetch algorithms and set up
+// per thread state.
+
+#define ROUNDS 2000
+
+static size_t allocs;
+
+static void * count_malloc(size_t num, const char * file, int line)
+{
+  allocs++;
+  return malloc(num);
+}
+
+static void * count_realloc(void * addr, size_t num, const char * file, int line)
+{
+  allocs++;
+  return realloc(addr, num);
+}
+
+static void count_free(void * addr, const char * file, int line)
+{
+  free(addr);
+}
+
+static uint8_t priv[32];
+static uint8_t msg[64];
+
+static void op_sha256()
+{
+  uint8_t out[32];
+  crypt0_sha256(msg, sizeof(msg), out, 32);
+}
+
+static void op_sha512()
+{
+  uint8_t out[64];
+  crypt0_sha512(msg, sizeof(msg), out, 64);
+}
+
+static void op_hmac_sha512()
+{
+  uint8_t out[64];
+  crypt0_hmac_sha512(priv, 32, msg, sizeof(msg), out);
+}
+
+static void op_secp256k1_public_key()
+{
+  uint8_t pub[65];
+  crypt0_secp256k1_public_key(priv, 32, pub, 65);
+}
+
+static void op_secp256k1_sign()
+{
+  uint8_t sig[64];
+  crypt0_secp256k1_sign(msg, 32, priv, 32, sig, 64);
+}
+
+static void op_ed25519_public_key()
+{
+  uint8_t pub[32];
+  crypt0_ed25519_public_key(priv, 32, pub, 32);
+}
+
+static void op_ed25519_sign()
+{
+  uint8_t pub[32];
+  uint8_t sig[64];
+  memset(pub, 0, sizeof(pub));
+  crypt0_ed25519_public_key(priv, 32, pub, 32);
+  crypt0_ed25519_sign(msg, sizeof(msg), priv, 32, pub, 32, sig, 64);
+}
+
+static void op_aes_ccm()
+{
+  uint8_t ct[64];
+  uint8_t pt[64];
+  uint8_t tag[8];
+  crypt0_encrypt_aes_ccm(msg, sizeof(msg), priv, 32, msg, 7, msg, 7, ct, tag, 8);
+  crypt0_decrypt_aes_ccm(ct, sizeof(msg), priv, 32, msg, 7, msg, 7, tag, 8, pt);
+}
+
+static void bench(const char * name, void (*op)())
+{
+  op();
+
+  size_t before = allocs;
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; i++) {
+    op();
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  printf("%-24s %8.1f allocs/call %10.0f/s\n", name,
+      (double)(allocs - before) / ROUNDS, ROUNDS / seconds);
+}
+
+int main(void)
+{
+  if (!CRYPTO_set_mem_functions(count_malloc, count_realloc, count_free)) {
+    LOG_ERR("OpenSSL allocated before main, counters unavailable");
+    return 1;
+  }
+
+  for (size_t i = 0; i < sizeof(priv); i++) {
+    priv[i] = (uint8_t)(i * 7 + 1);
+  }
+  for (size_t i = 0; i < sizeof(msg); i++) {
+    msg[i] = (uint8_t)(i * 13 + 5);
+  }
+
+  bench("sha256", op_sha256);
+  bench("sha512", op_sha512);
+  bench("hmac-sha512", op_hmac_sha512);
+  bench("secp256k1 public key", op_secp256k1_public_key);
+  bench("secp256k1 sign", op_secp256k1_sign);
+  bench("ed25519 public key", op_ed25519_public_key);
+  bench("ed25519 keypair + sign", op_ed25519_sign);
+  bench("aes-ccm encrypt+decrypt", op_aes_ccm);
+
+  return 0;
+}
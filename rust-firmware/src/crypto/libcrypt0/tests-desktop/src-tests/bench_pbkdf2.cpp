@@ -0,0 +1,123 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_hmac.h>
+#include <crypt0_pbkdf2.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_pbkdf2, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// Previous implementation: one-shot HMAC per iteration, the password is
+// re-keyed and both pads are hashed again every time
+static void pbkdf2_hmac_sha256_oneshot(int i, const uint8_t * pass, uint16_t pass_len,
+  const uint8_t * salt, uint16_t salt_len, uint8_t * key)
+{
+  uint8_t salt_tmp[68];
+  uint8_t digest[32];
+
+  memcpy(salt_tmp, salt, salt_len);
+  salt_tmp[salt_len + 0] = 0;
+  salt_tmp[salt_len + 1] = 0;
+  salt_tmp[salt_len + 2] = 0;
+  salt_tmp[salt_len + 3] = 1;
+  salt_len += 4;
+
+  for (int n = 0; n < i; n++) {
+    crypt0_hmac_sha256(pass, pass_len, salt_tmp, salt_len, digest);
+    salt_len = 32;
+    memcpy(salt_tmp, digest, 32);
+    for (int j = 0; j < 32; j++) {
+      key[j] = n == 0 ? digest[j] : key[j] ^ digest[j];
+    }
+  }
+}
+
+static void pbkdf2_hmac_sha512_oneshot(int i, const uint8_t * pass, uint16_t pass_len,
+  const uint8_t * salt, uint16_t salt_len, uint8_t * key)
+{
+  uint8_t salt_tmp[68];
+  uint8_t digest[64];
+
+  memcpy(salt_tmp, salt, salt_len);
+  salt_tmp[salt_len + 0] = 0;
+  salt_tmp[salt_len + 1] = 0;
+  salt_tmp[salt_len + 2] = 0;
+  salt_tmp[salt_len + 3] = 1;
+  salt_len += 4;
+
+  for (int n = 0; n < i; n++) {
+    crypt0_hmac_sha512(pass, pass_len, salt_tmp, salt_len, digest);
+    salt_len = 64;
+    memcpy(salt_tmp, digest, 64);
+    for (int j = 0; j < 64; j++) {
+      key[j] = n == 0 ? digest[j] : key[j] ^ digest[j];
+    }
+  }
+}
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static bool bench(const char * name, bool sha512, int iterations, int rounds,
+    const char * pass, const char * salt)
+{
+  uint8_t key_before[64];
+  uint8_t key_after[64];
+  uint16_t key_len = sha512 ? 64 : 32;
+
+  auto start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    if (sha512) {
+      pbkdf2_hmac_sha512_oneshot(iterations, (const uint8_t *)pass, strlen(pass),
+          (const uint8_t *)salt, strlen(salt), key_before);
+    } else {
+      pbkdf2_hmac_sha256_oneshot(iterations, (const uint8_t *)pass, strlen(pass),
+          (const uint8_t *)salt, strlen(salt), key_before);
+    }
+  }
+  double before = seconds_since(start);
+
+  start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    if (sha512) {
+      crypt0_pbkdf2_hmac_sha512(iterations, (const uint8_t *)pass, strlen(pass),
+          (const uint8_t *)salt, strlen(salt), key_after, key_len);
+    } else {
+      crypt0_pbkdf2_hmac_sha256(iterations, (const uint8_t *)pass, strlen(pass),
+          (const uint8_t *)salt, strlen(salt), key_after, key_len);
+    }
+  }
+  double after = seconds_since(start);
+
+  double total = (double)iterations * rounds;
+  printf("%-28s %10.0f it/s before %10.0f it/s after  x%.2f\n", name,
+      total / before, total / after, before / after);
+
+  if (memcmp(key_before, key_after, key_len) != 0) {
+    LOG_ERR("%s: keys differ", name);
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  const char * mnemonic = "wild casual icon cream oven boil";
+
+  bool ok = true;
+  ok &= bench("bip39 sha512 x2048", true, 2048, 20, mnemonic, "mnemonic");
+  ok &= bench("ton sha512 x100000", true, 100000, 1, mnemonic, "TON default seed");
+  ok &= bench("vault sha256 x10 (x1500)", false, 10, 1500,
+      "0123456789abcdef0123456789abcdef", "000000");
+
+  return ok ? 0 : 1;
+}
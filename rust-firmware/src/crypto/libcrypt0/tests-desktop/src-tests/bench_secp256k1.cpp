@@ -0,0 +1,275 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_secp256k1.h>
+#include <crypt0_hmac.h>
+
+#include <secp256k1.h>
+#include <secp256k1_recovery.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef BENCH_WITH_OPENSSL
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#endif
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_secp256k1, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// recoverable signing through the shared context against a context created
+// and destroyed per signature, as libcrypt0 did before, and the public key
+// of a derivation step: libsecp256k1 against the OpenSSL EC_POINT_mul with a
+// fresh group the desktop backend used. Then per key cost of batches of
+// n = 1, 20, 100 against one call per key, and signatures per second of
+// batches of one key signing n hashes against one call per hash. Last a
+// pairing handshake, ephemeral key and HKDF-extract over the ECDH point:
+// hashing the default sha256 secret again against the hash in the ECDH
+//
+// Every number is of the build host, none was measured on the Cortex-M33 of
+// the nRF5340 or under qemu. qemu would not give them either, it translates
+// the code and models no cycle timing. The public key line compares against
+// OpenSSL, the old desktop path; the old firmware path, a PSA key import and
+// export, only exists on the device and is not measured at all.
+
+#define ROUNDS 2000
+
+static uint8_t priv[32];
+static uint8_t msg_hash[32];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void sign_context_per_call(uint8_t * sig)
+{
+  int recid;
+  secp256k1_ecdsa_recoverable_signature sigr;
+  secp256k1_context * ctx =
+    secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+  secp256k1_ecdsa_sign_recoverable(ctx, &sigr, msg_hash, priv, NULL, NULL);
+  secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, sig, &recid, &sigr);
+  secp256k1_context_destroy(ctx);
+}
+
+static void sign_shared_context(uint8_t * sig)
+{
+  crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, sig, 65);
+}
+
+static void public_key_compressed(uint8_t * pub)
+{
+  crypt0_secp256k1_public_key_compressed(priv, 32, pub, 33);
+}
+
+static void public_key_uncompressed(uint8_t * pub)
+{
+  crypt0_secp256k1_public_key(priv, 32, pub, 65);
+}
+
+// verification runs the a*P + b*G multiply, the one ECMULT_WINDOW_SIZE sizes
+static secp256k1_pubkey verify_pubkey;
+static secp256k1_ecdsa_signature verify_sig;
+static uint8_t verify_hash[32];
+
+static void verify_setup()
+{
+  uint8_t pub[65], sig[64];
+  const secp256k1_context * ctx = secp256k1_context_no_precomp;
+
+  memcpy(verify_hash, msg_hash, 32);
+  crypt0_secp256k1_public_key(priv, 32, pub, 65);
+  crypt0_secp256k1_sign(verify_hash, 32, priv, 32, sig, 64);
+  if (!secp256k1_ec_pubkey_parse(ctx, &verify_pubkey, pub, 65) ||
+      !secp256k1_ecdsa_signature_parse_compact(ctx, &verify_sig, sig)) {
+    LOG_ERR("verify setup failed");
+  }
+}
+
+static void verify(uint8_t * out)
+{
+  out[1] = (uint8_t)secp256k1_ecdsa_verify(secp256k1_context_no_precomp,
+      &verify_sig, verify_hash, &verify_pubkey);
+}
+
+static uint8_t peer_pub[33];
+static crypt0_hmac_sha256_ctx hkdf_salt;
+
+static void handshake_hash_twice(uint8_t * out)
+{
+  uint8_t pub[33], secret[32];
+  crypt0_secp256k1_public_key_compressed(priv, 32, pub, 33);
+  crypt0_secp256k1_ecdh_secret(priv, 32, peer_pub, 33, secret, 32);
+  crypt0_hmac_sha256((const uint8_t *)"crypt0 pairing salt", 20, secret, 32, out);
+}
+
+static void handshake_hash_once(uint8_t * out)
+{
+  uint8_t pub[33];
+  crypt0_secp256k1_public_key_compressed(priv, 32, pub, 33);
+  crypt0_secp256k1_ecdh(priv, peer_pub, 33, out, 
+      crypt0_secp256k1_ecdh_hash_hkdf_extract, &hkdf_salt);
+}
+
+#ifdef BENCH_WITH_OPENSSL
+static void public_key_openssl(uint8_t * pub)
+{
+  EC_GROUP * group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+  EC_POINT * point = EC_POINT_new(group);
+  BIGNUM * k = BN_bin2bn(priv, 32, NULL);
+  EC_POINT_mul(group, point, k, NULL, NULL, NULL);
+  EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED, pub, 65, NULL);
+  BN_clear_free(k);
+  EC_POINT_free(point);
+  EC_GROUP_free(group);
+}
+#endif
+
+static double bench(const char * name, void (*op)(uint8_t * out))
+{
+  uint8_t out[65];
+  double rate = 0;
+
+  // best of three, the host is noisy
+  for (int rep = 0; rep < 3; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+      op(out);
+      // chain the output into the input so calls can't overlap
+      msg_hash[0] = out[1];
+      priv[31] = out[1] | 1;
+    }
+    rate = max(rate, ROUNDS / seconds_since(start));
+  }
+  printf("%-28s %10.0f/s\n", name, rate);
+  return rate;
+}
+
+// per key, a batch trades one field inversion for three field multiplies,
+// the rest of the key is the same ecmult_gen. What that is worth depends on
+// the cost of an inversion against a multiply, which is only known for the
+// host here: these lines are no estimate of the gain on the Cortex-M33
+static void bench_batch(size_t n)
+{
+  static uint8_t keys[100 * 32];
+  static uint8_t pubs[100 * 33];
+  static uint8_t scratch[CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(100)];
+  int rounds = ROUNDS / n;
+
+  for (size_t i = 0; i < n; i++) {
+    memcpy(keys + i * 32, priv, 32);
+    keys[i * 32] ^= (uint8_t)i;
+  }
+
+  // best of a few alternating runs, the host is noisy
+  double single = 1e9, batch = 1e9;
+  for (int rep = 0; rep < 5; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t i = 0; i < n; i++) {
+        crypt0_secp256k1_public_key_compressed(keys + i * 32, 32, pubs + i * 33, 33);
+      }
+      keys[31] = pubs[1];
+    }
+    single = min(single, seconds_since(start) / (rounds * n));
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      crypt0_secp256k1_pubkeys_batch(keys, n, pubs, scratch, sizeof(scratch));
+      keys[31] = pubs[1];
+    }
+    batch = min(batch, seconds_since(start) / (rounds * n));
+  }
+
+  printf("batch n=%-3d %8.2f us/key, one by one %8.2f us/key, x%.2f\n",
+      (int)n, batch * 1e6, single * 1e6, single / batch);
+}
+
+// signatures per second of the build host. Per signature a batch shares the
+// field inversion of k*G and the scalar inversion of k with the others, the
+// multiplies and the RFC6979 nonce stay. Throughput on the Cortex-M33 is not
+// measured, these lines are no estimate of it
+static void bench_sign_batch(size_t n)
+{
+  static uint8_t hashes[100 * 32];
+  static uint8_t sigs[100 * 65];
+  static uint8_t scratch[CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(100)];
+  static const uint8_t * keys[100];
+  int rounds = ROUNDS / n;
+
+  for (size_t i = 0; i < n; i++) {
+    memcpy(hashes + i * 32, msg_hash, 32);
+    hashes[i * 32] ^= (uint8_t)i;
+    keys[i] = priv;
+  }
+
+  double single = 0, batch = 0;
+  for (int rep = 0; rep < 5; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t i = 0; i < n; i++) {
+        crypt0_secp256k1_sign_recoverable(hashes + i * 32, 32, priv, 32, sigs + i * 65, 65);
+      }
+      hashes[31] = sigs[1];
+    }
+    single = max(single, rounds * n / seconds_since(start));
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      crypt0_secp256k1_sign_batch(hashes, keys, n, CRYPT0_SECP256K1_SIG_RECOVERABLE,
+          sigs, sizeof(sigs), NULL, scratch, sizeof(scratch));
+      hashes[31] = sigs[1];
+    }
+    batch = max(batch, rounds * n / seconds_since(start));
+  }
+
+  printf("sign batch n=%-3d %8.0f sig/s, one by one %8.0f sig/s, x%.2f\n",
+      (int)n, batch, single, batch / single);
+}
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(priv); i++) {
+    priv[i] = (uint8_t)(i * 7 + 1);
+    msg_hash[i] = (uint8_t)(i * 13 + 5);
+  }
+
+  verify_setup();
+  printf("build host only, no Cortex-M33 numbers\n");
+
+  double before = bench("sign, context per call", sign_context_per_call);
+  double after = bench("sign, shared context", sign_shared_context);
+  printf("x%.2f\n", after / before);
+
+  bench("verify", verify);
+
+  after = bench("public key compressed", public_key_compressed);
+  bench("public key uncompressed", public_key_uncompressed);
+#ifdef BENCH_WITH_OPENSSL
+  before = bench("public key openssl", public_key_openssl);
+  printf("x%.2f\n", after / before);
+#endif
+
+  bench_batch(1);
+  bench_batch(20);
+  bench_batch(100);
+
+  bench_sign_batch(1);
+  bench_sign_batch(20);
+  bench_sign_batch(100);
+
+  crypt0_secp256k1_public_key_compressed(msg_hash, 32, peer_pub, 33);
+  crypt0_hmac_sha256_init(&hkdf_salt, (const uint8_t *)"crypt0 pairing salt", 20);
+  before = bench("handshake, hash twice", handshake_hash_twice);
+  after = bench("handshake, hash in ecdh", handshake_hash_once);
+  printf("x%.2f, %.1f us per handshake\n", after / before, 1e6 / after);
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// the 10x26 field of the 32-bit target, see test_secp256k1_field.cpp
+#define USE_FORCE_WIDEMUL_INT64
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include <secp256k1.h>
+#include "util.h"
+#include "field_impl.h"
+#pragma GCC diagnostic pop
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES 1
+#endif
+
+// Field multiply and square per operation, in cycles where the host has a
+// cycle counter and nanoseconds otherwise (qemu-arm: compare the C and the
+// assembly build with each other only)
+
+#define OPS 1000000
+
+static uint64_t ticks(void)
+{
+#ifdef BENCH_CYCLES
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+int main(void)
+{
+  static const uint8_t seed[32] = {
+    0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95,
+    0xce, 0x87, 0x0b, 0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9,
+    0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98
+  };
+  secp256k1_fe x, y;
+  uint8_t out[32];
+
+#ifdef BENCH_CYCLES
+  printf("units: cycles (rdtsc)\n");
+#else
+  printf("units: ns\n");
+#endif
+#ifdef USE_EXTERNAL_ASM
+  printf("field 10x26 kernels: asm\n");
+#else
+  printf("field 10x26 kernels: C\n");
+#endif
+
+  secp256k1_fe_set_b32(&x, seed);
+  y = x;
+
+  // each result feeds the next call so the operations can't overlap
+  uint64_t start = ticks();
+  for (int i = 0; i < OPS; i++) {
+    secp256k1_fe_mul(&x, &x, &y);
+  }
+  double mul = (double)(ticks() - start) / OPS;
+
+  start = ticks();
+  for (int i = 0; i < OPS; i++) {
+    secp256k1_fe_sqr(&x, &x);
+  }
+  double sqr = (double)(ticks() - start) / OPS;
+
+  secp256k1_fe_normalize(&x);
+  secp256k1_fe_get_b32(out, &x);
+
+  printf("fe_mul %8.1f per op\n", mul);
+  printf("fe_sqr %8.1f per op\n", sqr);
+  printf("(%02x)\n", out[0]);
+
+  return 0;
+}
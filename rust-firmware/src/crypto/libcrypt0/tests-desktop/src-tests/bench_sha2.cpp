@@ -0,0 +1,173 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha2.h>
+#include <crypt0_hmac.h>
+
+#include <chrono>
+#include <iostream>
+
+#ifdef BENCH_WITH_OPENSSL
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#endif
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(bench_sha2, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// Each SHA-2 kernel against the OpenSSL path, the libcrypt0 numbers go through
+// the public streaming / hmac entry points so dispatch overhead is included
+
+static uint8_t data[16384];
+
+static double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void crypt0_sha256_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  crypt0_sha256_ctx ctx;
+  crypt0_sha256_init(&ctx);
+  crypt0_sha256_update(&ctx, msg, len);
+  crypt0_sha256_final(&ctx, out);
+}
+
+static void crypt0_sha512_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  crypt0_sha512_ctx ctx;
+  crypt0_sha512_init(&ctx);
+  crypt0_sha512_update(&ctx, msg, len);
+  crypt0_sha512_final(&ctx, out);
+}
+
+static void crypt0_hmac256_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  crypt0_hmac_sha256_ctx ctx;
+  crypt0_hmac_sha256_init(&ctx, data, 32);
+  crypt0_hmac_sha256_update(&ctx, msg, len);
+  crypt0_hmac_sha256_final(&ctx, out);
+}
+
+static void crypt0_hmac512_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  crypt0_hmac_sha512_ctx ctx;
+  crypt0_hmac_sha512_init(&ctx, data, 32);
+  crypt0_hmac_sha512_update(&ctx, msg, len);
+  crypt0_hmac_sha512_final(&ctx, out);
+}
+
+#ifdef BENCH_WITH_OPENSSL
+static void openssl_sha256_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  EVP_Digest(msg, len, out, NULL, EVP_sha256(), NULL);
+}
+
+static void openssl_sha512_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  EVP_Digest(msg, len, out, NULL, EVP_sha512(), NULL);
+}
+
+static void openssl_hmac256_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  HMAC(EVP_sha256(), data, 32, msg, len, out, NULL);
+}
+
+static void openssl_hmac512_run(const uint8_t * msg, size_t len, uint8_t * out)
+{
+  HMAC(EVP_sha512(), data, 32, msg, len, out, NULL);
+}
+#endif
+
+typedef void (*hash_fn)(const uint8_t * msg, size_t len, uint8_t * out);
+
+struct bench_case {
+  const char * name;
+  size_t out_len;
+  hash_fn crypt0;
+  hash_fn openssl;
+};
+
+static const bench_case cases[] = {
+#ifdef BENCH_WITH_OPENSSL
+  {"sha256", 32, crypt0_sha256_run, openssl_sha256_run},
+  {"sha512", 64, crypt0_sha512_run, openssl_sha512_run},
+  {"hmac-sha256", 32, crypt0_hmac256_run, openssl_hmac256_run},
+  {"hmac-sha512", 64, crypt0_hmac512_run, openssl_hmac512_run},
+#else
+  {"sha256", 32, crypt0_sha256_run, NULL},
+  {"sha512", 64, crypt0_sha512_run, NULL},
+  {"hmac-sha256", 32, crypt0_hmac256_run, NULL},
+  {"hmac-sha512", 64, crypt0_hmac512_run, NULL},
+#endif
+};
+
+static const size_t sizes[] = {32, 64, 1024, 16384};
+
+// MB/s over roughly the same amount of data for every size
+static double run(hash_fn fn, size_t len, uint8_t * out)
+{
+  size_t rounds = (size_t)(64 << 20) / (len + 64);
+
+  auto start = chrono::steady_clock::now();
+  for (size_t r = 0; r < rounds; r++) {
+    fn(data, len, out);
+  }
+  return (double)rounds * len / seconds_since(start) / 1e6;
+}
+
+int main(void)
+{
+  const crypt0_sha2_kernel_t kernels[] = {
+    CRYPT0_SHA2_KERNEL_SCALAR, CRYPT0_SHA2_KERNEL_AVX2, CRYPT0_SHA2_KERNEL_SHANI,
+  };
+  bool ok = true;
+
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)(i * 131 + 7);
+  }
+
+  printf("%-12s %6s", "MB/s", "bytes");
+  for (auto kernel : kernels) {
+    printf(" %10s", crypt0_sha2_kernel_name(kernel));
+  }
+  printf(" %10s\n", "openssl");
+
+  for (auto & c : cases) {
+    for (auto len : sizes) {
+      uint8_t expected[64], out[64];
+
+      printf("%-12s %6d", c.name, (int)len);
+      crypt0_sha2_kernel_select(CRYPT0_SHA2_KERNEL_SCALAR);
+      c.crypt0(data, len, expected);
+
+      for (auto kernel : kernels) {
+        if (!crypt0_sha2_kernel_select(kernel)) {
+          printf(" %10s", "-");
+          continue;
+        }
+        printf(" %10.0f", run(c.crypt0, len, out));
+        if (memcmp(out, expected, c.out_len) != 0) {
+          LOG_ERR("%s %s: digest differs", c.name, crypt0_sha2_kernel_name(kernel));
+          ok = false;
+        }
+      }
+
+      if (c.openssl) {
+        printf(" %10.0f\n", run(c.openssl, len, out));
+        if (memcmp(out, expected, c.out_len) != 0) {
+          LOG_ERR("%s openssl: digest differs", c.name);
+          ok = false;
+        }
+      } else {
+        printf(" %10s\n", "-");
+      }
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#include <string.h>
+#include <stdint.h>
+
+// The libsecp256k1 10x26 field for test_secp256k1_field.cpp, its internal
+// headers only build as C. An element crosses as the bytes of a secp256k1_fe
+// in a test_fe.
+#define USE_FORCE_WIDEMUL_INT64
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include <secp256k1.h>
+#include "util.h"
+#include "field_impl.h"
+#pragma GCC diagnostic pop
+
+typedef struct test_fe {
+  uint32_t words[16];
+} test_fe;
+
+_Static_assert(sizeof(secp256k1_fe) <= sizeof(test_fe), "test_fe too small for secp256k1_fe");
+
+static secp256k1_fe fe_in(const test_fe * a)
+{
+  secp256k1_fe r;
+  memcpy(&r, a, sizeof(r));
+  return r;
+}
+
+static void fe_out(test_fe * r, const secp256k1_fe * a)
+{
+  memcpy(r, a, sizeof(*a));
+}
+
+void test_fe_set_b32(test_fe * r, const uint8_t b[32])
+{
+  secp256k1_fe t;
+  secp256k1_fe_set_b32(&t, b);
+  fe_out(r, &t);
+}
+
+// value of a possibly non-normalized element
+void test_fe_value(uint8_t out[32], const test_fe * a)
+{
+  secp256k1_fe t = fe_in(a);
+  secp256k1_fe_normalize(&t);
+  secp256k1_fe_get_b32(out, &t);
+}
+
+void test_fe_mul(test_fe * r, const test_fe * a, const test_fe * b)
+{
+  secp256k1_fe ta = fe_in(a), tb = fe_in(b), t;
+  secp256k1_fe_mul(&t, &ta, &tb);
+  fe_out(r, &t);
+}
+
+void test_fe_sqr(test_fe * r, const test_fe * a)
+{
+  secp256k1_fe ta = fe_in(a), t;
+  secp256k1_fe_sqr(&t, &ta);
+  fe_out(r, &t);
+}
+
+void test_fe_add(test_fe * r, const test_fe * a)
+{
+  secp256k1_fe t = fe_in(r), ta = fe_in(a);
+  secp256k1_fe_add(&t, &ta);
+  fe_out(r, &t);
+}
+
+// -a with magnitude m + 1, a of magnitude at most m
+void test_fe_negate(test_fe * r, const test_fe * a, int m)
+{
+  secp256k1_fe ta = fe_in(a), t;
+  secp256k1_fe_negate(&t, &ta, m);
+  fe_out(r, &t);
+}
+
+// eof
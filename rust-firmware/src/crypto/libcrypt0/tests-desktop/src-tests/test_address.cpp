@@ -0,0 +1,174 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_address.h>
+#include <crypt0_bip32.h>
+#include <crypt0_bip39.h>
+#include <crypt0_ripemd160.h>
+#include <crypt0_secp256k1.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_address, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// "abandon abandon ... about", zero entropy
+static uint8_t seed[64];
+
+static uint8_t scratch[CRYPT0_ADDRESS_RANGE_SCRATCH_BYTES];
+static char arena[CRYPT0_ADDRESS_RANGE_OUT_BYTES(40)];
+
+static void account_xpub(uint8_t * xpub, int purpose, int coin)
+{
+  crypt0_bip32_seed_to_account_pubkey(seed, xpub, purpose | CRYPT0_BIP32_INDEX_HARDENED,
+      coin | CRYPT0_BIP32_INDEX_HARDENED, CRYPT0_BIP32_INDEX_HARDENED);
+}
+
+// BIP44 and BIP84 reference addresses
+bool test_address_vectors()
+{
+  static const struct {
+    int purpose;
+    int format;
+    uint32_t chain;
+    uint32_t start;
+    const char * addresses[2];
+  } vectors[] = {
+    { 84, CRYPT0_ADDRESS_P2WPKH, 0, 0,
+      { "bc1qcr8te4kr609gcawutmrza0j4xv80jy8z306fyu", "bc1qnjg0jd8228aq7egyzacy8cys3knf9xvrerkf9g" } },
+    { 84, CRYPT0_ADDRESS_P2WPKH, 1, 0,
+      { "bc1q8c6fshw2dlwun7ekn9qwf37cu2rn755upcp6el", NULL } },
+    { 44, CRYPT0_ADDRESS_P2PKH, 0, 0,
+      { "1LqBGSKuX5yYUonjxT5qGfpUsXKYYWeabA", "1Ak8PffB2meyfYnbXZR9EGfLfFZVpzJvQP" } },
+  };
+  uint8_t xpub[78];
+
+  for (auto & v : vectors) {
+    size_t count = v.addresses[1] ? 2 : 1;
+    account_xpub(xpub, v.purpose, CRYPT0_COIN_BTC);
+    int len = crypt0_address_range(xpub, v.chain, v.start, count, CRYPT0_COIN_BTC, v.format,
+        arena, sizeof(arena), scratch, sizeof(scratch));
+    const char * address = arena;
+    for (size_t i = 0; i < count; i++) {
+      if (len <= 0 || strcmp(address, v.addresses[i]) != 0) {
+        LOG_ERR("m/%d'/0'/0'/%u/%u: %s", v.purpose, v.chain, (unsigned)i, len > 0 ? address : "-");
+        return false;
+      }
+      address += strlen(address) + 1;
+    }
+    if (address - arena != len) {
+      LOG_ERR("m/%d'/0'/0'/%u: length %d", v.purpose, v.chain, len);
+      return false;
+    }
+  }
+  return true;
+}
+
+// ranges across chunks against every address from its private key
+bool test_address_range_coins()
+{
+  static const struct {
+    int coin;
+    uint8_t prefix;
+    const char * hrp;
+  } coins[] = {
+    { CRYPT0_COIN_BTC, 0x00, "bc" },
+    { CRYPT0_COIN_BTC_TEST, 0x6f, "tb" },
+    { CRYPT0_COIN_LTC, 0x30, "ltc" },
+    { CRYPT0_COIN_DOGE, 0x1e, NULL },
+  };
+  const uint32_t start = 3, count = 40;
+  uint8_t xpub[78], path[CRYPT0_BIP32_PATH_MAX_BYTES], secret[64], pub[33], hash[20];
+  char expected[CRYPT0_ADDRESS_MAX_BYTES + 32];
+  crypt0_bip32_cursor cursor;
+
+  crypt0_bip32_cursor_init(&cursor, seed);
+  for (auto & c : coins) {
+    for (int format = CRYPT0_ADDRESS_P2PKH; format <= CRYPT0_ADDRESS_P2WPKH; format++) {
+      int purpose = format == CRYPT0_ADDRESS_P2PKH ? 44 : 84;
+      if (c.hrp == NULL && format == CRYPT0_ADDRESS_P2WPKH) {
+        continue;
+      }
+      account_xpub(xpub, purpose, c.coin);
+      for (uint32_t chain = 0; chain < 2; chain++) {
+        int len = crypt0_address_range(xpub, chain, start, count, c.coin, format,
+            arena, sizeof(arena), scratch, sizeof(scratch));
+        if (len <= 0) {
+          LOG_ERR("coin %d format %d: %d", c.coin, format, len);
+          return false;
+        }
+
+        const char * address = arena;
+        for (uint32_t i = start; i < start + count; i++) {
+          char str[48];
+          snprintf(str, sizeof(str), "m/%d'/%d'/0'/%u/%u", purpose, c.coin, chain, i);
+          crypt0_bip32_path_from_string(str, path, sizeof(path));
+          crypt0_bip32_cursor_derive(&cursor, path, secret);
+          crypt0_secp256k1_public_key_compressed(secret, 32, pub, sizeof(pub));
+          if (format == CRYPT0_ADDRESS_P2PKH) {
+            crypt0_base58_checksum_address(pub, 33, c.prefix, expected, sizeof(expected));
+          } else {
+            crypt0_hash160(pub, 33, hash);
+            crypt0_bech32_witness_v0_encode(hash, 20, c.hrp, expected, sizeof(expected));
+          }
+          if (strcmp(address, expected) != 0) {
+            LOG_ERR("%s: %s, expected %s", str, address, expected);
+            return false;
+          }
+          address += strlen(address) + 1;
+        }
+      }
+    }
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+  return true;
+}
+
+bool test_address_range_errors()
+{
+  uint8_t xpub[78];
+  account_xpub(xpub, 44, CRYPT0_COIN_DOGE);
+
+  if (crypt0_address_range(xpub, 0, 0, 1, CRYPT0_COIN_DOGE, CRYPT0_ADDRESS_P2WPKH,
+        arena, sizeof(arena), scratch, sizeof(scratch)) != CRYPT0_ERR_FMT ||
+      crypt0_address_range(xpub, 0, 0, 1, 4, CRYPT0_ADDRESS_P2PKH,
+        arena, sizeof(arena), scratch, sizeof(scratch)) != CRYPT0_ERR_FMT ||
+      crypt0_address_range(xpub, CRYPT0_BIP32_INDEX_HARDENED, 0, 1, CRYPT0_COIN_DOGE,
+        CRYPT0_ADDRESS_P2PKH, arena, sizeof(arena), scratch, sizeof(scratch)) != CRYPT0_ERR_FMT ||
+      crypt0_address_range(xpub, 0, CRYPT0_BIP32_INDEX_HARDENED - 1, 2, CRYPT0_COIN_DOGE,
+        CRYPT0_ADDRESS_P2PKH, arena, sizeof(arena), scratch, sizeof(scratch)) != CRYPT0_ERR_FMT) {
+    LOG_ERR("bad coin, format or index accepted");
+    return false;
+  }
+  if (crypt0_address_range(xpub, 0, 0, 20, CRYPT0_COIN_DOGE, CRYPT0_ADDRESS_P2PKH,
+        arena, 19 * 35, scratch, sizeof(scratch)) != CRYPT0_ERR_OUTBUF_LEN ||
+      crypt0_address_range(xpub, 0, 0, 1, CRYPT0_COIN_DOGE, CRYPT0_ADDRESS_P2PKH,
+        arena, sizeof(arena), scratch, sizeof(scratch) - 1) != CRYPT0_ERR_OUTBUF_LEN) {
+    LOG_ERR("short arena or scratch accepted");
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  static const uint8_t entropy[16] = { 0 };
+  crypt0_bip39_entropy_to_seed_en(entropy, sizeof(entropy), seed, sizeof(seed));
+
+  if (!test_address_vectors()) {
+    return 1;
+  }
+  if (!test_address_range_coins()) {
+    return 1;
+  }
+  if (!test_address_range_errors()) {
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include <string.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include <crypt0_aes_ccm.h>
 
@@ -76,11 +77,66 @@ bool test_aes_ccm_encrypt_decrypt()
   return true;
 }
 
+static int unhex(const char * hex, uint8_t * out)
+{
+  int len = strlen(hex) / 2;
+  for (int i = 0; i < len; i++) {
+    sscanf(hex + 2 * i, "%2hhx", &out[i]);
+  }
+  return len;
+}
+
+// multi block message and AAD, 13 byte nonce, 16 byte tag, then a forged tag
+bool test_aes_ccm_long_nonce_tag()
+{
+  uint8_t key[32], nonce[13], aad[20], plaintext[45];
+  uint8_t ciphertext[45], decrypted[45], tag[16];
+  uint8_t ciphertext_expected[45], tag_expected[16];
+
+  for (int i = 0; i < 32; i++) key[i] = 0x40 + i;
+  for (int i = 0; i < 13; i++) nonce[i] = 0x10 + i;
+  for (int i = 0; i < 20; i++) aad[i] = i;
+  for (int i = 0; i < 45; i++) plaintext[i] = 0x20 + i;
+  unhex("40527dbf457197dcf6b47b20e974d1741c6ad6948f9f0e50e55923a959acf67c"
+        "1c945d6d4a27ba7a4c3420c4ce", ciphertext_expected);
+  unhex("2446aff79524589429927551abb6b688", tag_expected);
+
+  int res = crypt0_encrypt_aes_ccm(plaintext, sizeof(plaintext), key, sizeof(key),
+      nonce, sizeof(nonce), aad, sizeof(aad), ciphertext, tag, sizeof(tag));
+  if (res != sizeof(plaintext) ||
+      memcmp(ciphertext, ciphertext_expected, sizeof(ciphertext)) != 0 ||
+      memcmp(tag, tag_expected, sizeof(tag)) != 0) {
+    LOG_ERR("AES CCM encryption failed, 13 byte nonce");
+    return false;
+  }
+
+  res = crypt0_decrypt_aes_ccm(ciphertext, sizeof(ciphertext), key, sizeof(key),
+      nonce, sizeof(nonce), aad, sizeof(aad), tag, sizeof(tag), decrypted);
+  if (res != sizeof(plaintext) || memcmp(decrypted, plaintext, sizeof(plaintext)) != 0) {
+    LOG_ERR("AES CCM decryption failed, 13 byte nonce");
+    return false;
+  }
+
+  tag[15] ^= 0x01;
+  res = crypt0_decrypt_aes_ccm(ciphertext, sizeof(ciphertext), key, sizeof(key),
+      nonce, sizeof(nonce), aad, sizeof(aad), tag, sizeof(tag), decrypted);
+  if (res != -1) {
+    LOG_ERR("AES CCM accepted a forged tag");
+    return false;
+  }
+
+  return true;
+}
+
 int main(void) 
 {
   if (!test_aes_ccm_encrypt_decrypt()) {
     return 1;
   }
 
+  if (!test_aes_ccm_long_nonce_tag()) {
+    return 1;
+  }
+
   return 0;
 }
@@ -0,0 +1,371 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_bip32.h>
+#include <crypt0_secp256k1.h>
+#include <crypt0_ed25519.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_bip32, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// BIP32 test vector 2, its seed is 64 bytes like every crypt0 seed
+static const char * seed_hex =
+  "fffcf9f6f3f0edeae7e4e1dedbd8d5d2cfccc9c6c3c0bdbab7b4b1aeaba8a5a2"
+  "9f9c999693908d8a8784817e7b7875726f6c696663605d5a5754514e4b484542";
+
+static const struct {
+  const char * path;
+  const char * chain;
+  const char * priv;
+} vectors[] = {
+  { "m",
+    "60499f801b896d83179a4374aeb7822aaeaceaa0db1f85ee3e904c4defbd9689",
+    "4b03d6fc340455b363f51020ad3ecca4f0850280cf436c70c727923f6db46c3e" },
+  { "m/0",
+    "f0909affaa7ee7abe5dd4e100598d4dc53cd709d5a5c2cac40e7412f232f7c9c",
+    "abe74a98f6c7eabee0428f53798f0ab8aa1bd37873999041703c742f15ac7e1e" },
+  { "m/0/2147483647'",
+    "be17a268474a6bb9c61e1d720cf6215e2a88c5406c4aee7b38547f585c9a37d9",
+    "877c779ad9687164e9c2f4f0f4ff0340814392330693ce95a58fe18fd52e6e93" },
+  { "m/0/2147483647'/1",
+    "f366f48f1ea9f2d1d3fe958c95ca84ea18e4c4ddb9366c336c927eb246fb38cb",
+    "704addf544a06e5ee4bea37098463c23613da32020d604506da8c0518e1da4b7" },
+  { "m/0/2147483647'/1/2147483646h",
+    "637807030d55d01f9a0cb3a7839515d796bd07706386a6eddf06cc29a65a0e29",
+    "f1c7c871a54a804afe328b4c83a1c33b8e5ff48f5087273f04efa83b247d6a2d" },
+  { "m/0/2147483647'/1/2147483646H/2",
+    "9452b549be8cea3ecb7a84bec10dcfd94afe4d129ebfd3b3cb58eedf394ed271",
+    "bb7d39bdb83ecf58f2fd82b6d918341cbef428661ef01ab97c28a4842125ac23" },
+};
+
+// SLIP-10 ed25519 test vector 2, same seed
+static const struct {
+  const char * path;
+  const char * chain;
+  const char * priv;
+} slip10_vectors[] = {
+  { "m",
+    "ef70a74db9c3a5af931b5fe73ed8e1a53464133654fd55e7a66f8570b8e33c3b",
+    "171cb88b1b3c1db25add599712e36245d75bc65a1a5c9e18d76f9f2b1eab4012" },
+  { "m/0'",
+    "0b78a3226f915c082bf118f83618a618ab6dec793752624cbeb622acb562862d",
+    "1559eb2bbec5790b0c65d8693e4d0875b1747f4970ae8b650486ed7470845635" },
+  { "m/0'/2147483647'",
+    "138f0b2551bcafeca6ff2aa88ba8ed0ed8de070841f0c4ef0165df8181eaad7f",
+    "ea4f5bfe8694d8bb74b7b59404632fd5968b774ed545e810de9c32a4fb4192f4" },
+  { "m/0'/2147483647'/1'",
+    "73bd9fff1cfbde33a1b846c27085f711c0fe2d66fd32e139d3ebc28e5a4a6b90",
+    "3757c7577170179c7868353ada796c839135b3d30554bbb74a4b1e4a5a58505c" },
+  { "m/0'/2147483647'/1'/2147483646'",
+    "0902fe8a29f9140480a00ef244bd183e8a13288e4412d8389d140aac1794825a",
+    "5837736c89570de861ebc173b1086da4f505d4adb387c6a1b1342d5e4ac9ec72" },
+  { "m/0'/2147483647'/1'/2147483646'/2'",
+    "5d70af781f3a37b829f0d060924d5e960bdc02e85423494afc0b1a41bbe196d4",
+    "551d333177df541ad876a60ea71f00447931c0a9da16f227c11ea080d7391b8d" },
+};
+
+static uint8_t seed[64];
+
+static bool check_secret(const char * path, const uint8_t * secret, int i)
+{
+  char hex[65];
+
+  crypt0_bin2hex(secret, 32, hex, sizeof(hex));
+  if (strcmp(hex, vectors[i].priv) != 0) {
+    LOG_ERR("%s: private key %s", path, hex);
+    return false;
+  }
+  crypt0_bin2hex(secret + 32, 32, hex, sizeof(hex));
+  if (strcmp(hex, vectors[i].chain) != 0) {
+    LOG_ERR("%s: chain code %s", path, hex);
+    return false;
+  }
+  return true;
+}
+
+// every vector from the seed, through the path and through a cursor walking
+// the vectors in order, then backwards
+bool test_bip32_vectors()
+{
+  uint8_t path[CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t secret[64];
+  crypt0_bip32_cursor cursor;
+  const int n = sizeof(vectors) / sizeof(vectors[0]);
+
+  crypt0_bip32_cursor_init(&cursor, seed);
+  for (int k = 0; k < 2 * n; k++) {
+    int i = k < n ? k : 2 * n - 1 - k;
+    if (crypt0_bip32_path_from_string(vectors[i].path, path, sizeof(path)) !=
+        CRYPT0_BIP32_PATH_BYTES(i)) {
+      LOG_ERR("%s: parse failed", vectors[i].path);
+      return false;
+    }
+
+    crypt0_bip32_seed_to_secret(seed, secret);
+    if (crypt0_bip32_derive_secret_path(secret, path) != CRYPT0_OK ||
+        !check_secret(vectors[i].path, secret, i)) {
+      return false;
+    }
+
+    memset(secret, 0, sizeof(secret));
+    if (crypt0_bip32_cursor_derive(&cursor, path, secret) != CRYPT0_OK ||
+        !check_secret(vectors[i].path, secret, i)) {
+      LOG_ERR("cursor, step %d", k);
+      return false;
+    }
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+  return true;
+}
+
+// siblings and cousins through a cursor against each derived from the seed
+bool test_bip32_cursor_siblings()
+{
+  static const char * paths[] = {
+    "m/84'/0'/0'/0/0", "m/84'/0'/0'/0/1", "m/84'/0'/0'/0/2", "m/84'/0'/0'/1/0",
+    "m/84'/0'/0'/1/1", "m/84'/0'/1'/0/0", "m/84'/0'/0'/0/3", "m/44'/60'/0'/0/0",
+    "m/84'/0'/0'", "m/84'/0'/0'/0/4",
+  };
+  uint8_t path[CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t secret[64], expected[64];
+  crypt0_bip32_cursor cursor;
+
+  crypt0_bip32_cursor_init(&cursor, seed);
+  for (auto str : paths) {
+    crypt0_bip32_path_from_string(str, path, sizeof(path));
+    crypt0_bip32_seed_to_secret(seed, expected);
+    crypt0_bip32_derive_secret_path(expected, path);
+    if (crypt0_bip32_cursor_derive(&cursor, path, secret) != CRYPT0_OK ||
+        memcmp(secret, expected, 64) != 0) {
+      LOG_ERR("%s: cursor differs", str);
+      return false;
+    }
+  }
+
+  // account extended public key from the cursor against from the seed
+  uint8_t xpub[78], xpub_expected[78];
+  for (int account = 0; account < 3; account++) {
+    crypt0_bip32_seed_to_account_pubkey(seed, xpub_expected,
+        84 | CRYPT0_BIP32_INDEX_HARDENED, CRYPT0_BIP32_INDEX_HARDENED,
+        account | CRYPT0_BIP32_INDEX_HARDENED);
+    crypt0_bip32_cursor_account_pubkey(&cursor, xpub,
+        84 | CRYPT0_BIP32_INDEX_HARDENED, CRYPT0_BIP32_INDEX_HARDENED,
+        account | CRYPT0_BIP32_INDEX_HARDENED);
+    if (memcmp(xpub, xpub_expected, 78) != 0) {
+      LOG_ERR("account %d: xpub differs", account);
+      return false;
+    }
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+
+  // a child with the parent public key passed in against computed
+  uint8_t pub[33];
+  crypt0_bip32_seed_to_secret(seed, expected);
+  memcpy(secret, expected, 64);
+  crypt0_secp256k1_public_key_compressed(secret, 32, pub, sizeof(pub));
+  crypt0_bip32_derive_secret_index(expected, 7);
+  if (crypt0_bip32_derive_secret_index_pub(secret, 7, pub) != CRYPT0_OK ||
+      memcmp(secret, expected, 64) != 0) {
+    LOG_ERR("child with parent pub differs");
+    return false;
+  }
+  return true;
+}
+
+// public derivation against the public keys of the private derivation
+bool test_bip32_ckd_pub()
+{
+  uint8_t path[CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t secret[64];
+  uint8_t account[CRYPT0_BIP32_PUBNODE_BYTES], chain[CRYPT0_BIP32_PUBNODE_BYTES];
+  uint8_t expected[CRYPT0_BIP32_PUBNODE_BYTES], xpub[78];
+  static uint8_t pubs[20 * 33];
+  static uint8_t scratch[CRYPT0_BIP32_CKD_PUB_SCRATCH_BYTES(20)];
+  crypt0_bip32_cursor cursor;
+
+  // account node from its extended public key and from the private node
+  crypt0_bip32_cursor_init(&cursor, seed);
+  crypt0_bip32_path_from_string("m/84'/0'/0'", path, sizeof(path));
+  crypt0_bip32_cursor_derive(&cursor, path, secret);
+  crypt0_bip32_secret_to_pubnode(secret, expected);
+  crypt0_bip32_cursor_account_pubkey(&cursor, xpub,
+      84 | CRYPT0_BIP32_INDEX_HARDENED, CRYPT0_BIP32_INDEX_HARDENED,
+      CRYPT0_BIP32_INDEX_HARDENED);
+  crypt0_bip32_pubnode_from_xpub(xpub, account);
+  if (memcmp(account, expected, sizeof(expected)) != 0) {
+    LOG_ERR("pubnode from xpub differs");
+    return false;
+  }
+
+  // change and receive chain nodes
+  for (uint32_t change = 0; change < 2; change++) {
+    snprintf((char *)scratch, 32, "m/84'/0'/0'/%u", change);
+    crypt0_bip32_path_from_string((const char *)scratch, path, sizeof(path));
+    crypt0_bip32_cursor_derive(&cursor, path, secret);
+    crypt0_bip32_secret_to_pubnode(secret, expected);
+    if (crypt0_bip32_ckd_pub(account, change, chain) != CRYPT0_OK ||
+        memcmp(chain, expected, sizeof(expected)) != 0) {
+      LOG_ERR("ckd_pub chain %u differs", change);
+      return false;
+    }
+  }
+
+  // addresses 5..24 of the change chain one by one and as a batch
+  if (crypt0_bip32_ckd_pub_batch(chain, 5, 20, pubs, scratch, sizeof(scratch)) != CRYPT0_OK) {
+    LOG_ERR("ckd_pub_batch failed");
+    return false;
+  }
+  for (uint32_t i = 0; i < 20; i++) {
+    uint8_t child[CRYPT0_BIP32_PUBNODE_BYTES];
+    snprintf((char *)child, 32, "m/84'/0'/0'/1/%u", i + 5);
+    crypt0_bip32_path_from_string((const char *)child, path, sizeof(path));
+    crypt0_bip32_cursor_derive(&cursor, path, secret);
+    crypt0_bip32_secret_to_pubnode(secret, expected);
+    if (crypt0_bip32_ckd_pub(chain, i + 5, child) != CRYPT0_OK ||
+        memcmp(child, expected, sizeof(expected)) != 0) {
+      LOG_ERR("ckd_pub address %u differs", i + 5);
+      return false;
+    }
+    if (memcmp(&pubs[33 * i], expected, 33) != 0) {
+      LOG_ERR("ckd_pub_batch address %u differs", i + 5);
+      return false;
+    }
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+
+  uint8_t child[CRYPT0_BIP32_PUBNODE_BYTES];
+  if (crypt0_bip32_ckd_pub(chain, CRYPT0_BIP32_INDEX_HARDENED, child) != CRYPT0_ERR_FMT ||
+      crypt0_bip32_ckd_pub_batch(chain, CRYPT0_BIP32_INDEX_HARDENED - 1, 2, pubs,
+        scratch, sizeof(scratch)) != CRYPT0_ERR_FMT) {
+    LOG_ERR("hardened public derivation accepted");
+    return false;
+  }
+  if (crypt0_bip32_ckd_pub_batch(chain, 0, 20, pubs, scratch, sizeof(scratch) - 1) !=
+      CRYPT0_ERR_OUTBUF_LEN) {
+    LOG_ERR("short scratch accepted");
+    return false;
+  }
+  return true;
+}
+
+// SLIP-10 ed25519 vectors through the path, the cursor and index by index
+// with the older entry points, then accounts through one cursor
+bool test_slip10_ed25519()
+{
+  uint8_t path[CRYPT0_BIP32_PATH_MAX_BYTES];
+  uint8_t secret[64], near[64], expected[64];
+  char hex[65];
+  crypt0_bip32_cursor cursor;
+
+  crypt0_slip10_cursor_init(&cursor, CRYPT0_SLIP10_ED25519, seed);
+  crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, near);
+  for (int i = 0; i < (int)(sizeof(slip10_vectors) / sizeof(slip10_vectors[0])); i++) {
+    crypt0_bip32_path_from_string(slip10_vectors[i].path, path, sizeof(path));
+    crypt0_hex2bin(slip10_vectors[i].priv, 64, expected, 32);
+    crypt0_hex2bin(slip10_vectors[i].chain, 64, expected + 32, 32);
+
+    crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, secret);
+    if (crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_ED25519, secret, path) != CRYPT0_OK ||
+        memcmp(secret, expected, 64) != 0) {
+      crypt0_bin2hex(secret, 32, hex, sizeof(hex));
+      LOG_ERR("%s: private key %s", slip10_vectors[i].path, hex);
+      return false;
+    }
+    if (crypt0_bip32_cursor_derive(&cursor, path, secret) != CRYPT0_OK ||
+        memcmp(secret, expected, 64) != 0) {
+      LOG_ERR("%s: cursor differs", slip10_vectors[i].path);
+      return false;
+    }
+    if (i > 0) {
+      uint32_t index = (uint32_t)path[4 * i - 3] << 24 | (uint32_t)path[4 * i - 2] << 16 |
+        (uint32_t)path[4 * i - 1] << 8 | path[4 * i];
+      memcpy(secret, near, 64);
+      crypt0_bip32_derive_secret_index_near(near, index);
+      crypt0_ed25519_derive_secret_index(secret, index);
+      if (memcmp(near, expected, 64) != 0 || memcmp(secret, expected, 64) != 0) {
+        LOG_ERR("%s: index derivation differs", slip10_vectors[i].path);
+        return false;
+      }
+    }
+  }
+
+  crypt0_bip32_path_from_string("m/44'/501'/0'/0", path, sizeof(path));
+  if (crypt0_bip32_cursor_derive(&cursor, path, secret) != CRYPT0_ERR_FMT ||
+      crypt0_slip10_derive_secret_index(CRYPT0_SLIP10_ED25519, secret, 0) != CRYPT0_ERR_FMT ||
+      crypt0_bip32_cursor_account_pubkey(&cursor, secret, 44, 0, 0) != CRYPT0_ERR_FMT ||
+      crypt0_slip10_seed_to_secret(2, seed, secret) != CRYPT0_ERR_FMT) {
+    LOG_ERR("non-hardened ed25519 index, xpub or unknown curve accepted");
+    return false;
+  }
+
+  for (int account = 0; account < 20; account++) {
+    char str[32];
+    snprintf(str, sizeof(str), "m/44'/501'/%d'/0'", account);
+    crypt0_bip32_path_from_string(str, path, sizeof(path));
+    crypt0_slip10_seed_to_secret(CRYPT0_SLIP10_ED25519, seed, expected);
+    crypt0_slip10_derive_secret_path(CRYPT0_SLIP10_ED25519, expected, path);
+    if (crypt0_bip32_cursor_derive(&cursor, path, secret) != CRYPT0_OK ||
+        memcmp(secret, expected, 64) != 0) {
+      LOG_ERR("%s: cursor differs", str);
+      return false;
+    }
+  }
+  crypt0_bip32_cursor_wipe(&cursor);
+  return true;
+}
+
+bool test_bip32_path_from_string()
+{
+  static const char * bad[] = {
+    "m/", "m/84''", "m/x", "m//0", "m/2147483648", "m/4294967300", "m/5000000000",
+    "84/0", "m/0/1/2/3/4/5/6/7/8/9/10",
+  };
+  uint8_t path[CRYPT0_BIP32_PATH_MAX_BYTES];
+  static const uint8_t expected[] = { 3, 0x80, 0, 0, 84, 0, 0, 0, 0, 0x80, 0, 0, 7 };
+
+  if (crypt0_bip32_path_from_string("m/84'/0/7h", path, sizeof(path)) != 13 ||
+      memcmp(path, expected, 13) != 0) {
+    LOG_ERR("m/84'/0/7h parsed wrong");
+    return false;
+  }
+  if (crypt0_bip32_path_from_string("m/84'/0/7h", path, 12) != CRYPT0_ERR_FMT) {
+    LOG_ERR("short path buffer accepted");
+    return false;
+  }
+  for (auto str : bad) {
+    if (crypt0_bip32_path_from_string(str, path, sizeof(path)) != CRYPT0_ERR_FMT) {
+      LOG_ERR("%s accepted", str);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(void)
+{
+  crypt0_hex2bin(seed_hex, 128, seed, sizeof(seed));
+
+  if (!test_bip32_path_from_string()) {
+    return 1;
+  }
+  if (!test_bip32_vectors()) {
+    return 1;
+  }
+  if (!test_bip32_cursor_siblings()) {
+    return 1;
+  }
+  if (!test_bip32_ckd_pub()) {
+    return 1;
+  }
+  if (!test_slip10_ed25519()) {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_bip39.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_bip39, LOG_LEVEL_DBG);
+
+using namespace std;
+
+extern "C" const char * crypt0_bip39_english[];
+
+static uint32_t letter_bits(const char * letters)
+{
+  uint32_t bits = 0;
+  for (; *letters; letters++) {
+    bits |= 1u << (*letters - 'a');
+  }
+  return bits;
+}
+
+// every word of the list finds its index, through a copy not terminated
+bool test_bip39_word_index()
+{
+  for (int i = 0; i < 2048; i++) {
+    char word[9];
+    size_t len = strlen(crypt0_bip39_english[i]);
+    memcpy(word, crypt0_bip39_english[i], len);
+    word[len] = 'z';
+    if (crypt0_bip39_word_index(word, len) != i) {
+      LOG_ERR("word %d %s not found", i, crypt0_bip39_english[i]);
+      return false;
+    }
+  }
+
+  static const char * not_words[] = {
+    "", "ab", "aban", "abandonx", "abandom", "zzzz", "ABANDON", "abandon ", "xylophone",
+  };
+  for (auto word : not_words) {
+    if (crypt0_bip39_word_index(word, strlen(word)) != CRYPT0_ERR_FMT) {
+      LOG_ERR("%s accepted", word);
+      return false;
+    }
+  }
+  if (crypt0_bip39_word_index(NULL, 4) != CRYPT0_ERR_FMT) {
+    LOG_ERR("NULL accepted");
+    return false;
+  }
+  return true;
+}
+
+// next letters and word ranges against a scan of the list
+bool test_bip39_next_letters()
+{
+  static const char * prefixes[] = {
+    "", "a", "x", "z", "ab", "act", "acti", "actio", "action", "actionx", "zoo", "zoom",
+    "abandon", "abandonx", "qq", "wr", "wri", "writ", "A", "ac7",
+  };
+  for (auto prefix : prefixes) {
+    size_t len = strlen(prefix);
+    uint32_t expected = 0;
+    int first = -1, count = 0;
+    for (int i = 0; i < 2048; i++) {
+      const char * word = crypt0_bip39_english[i];
+      if (strncmp(word, prefix, len) != 0) {
+        continue;
+      }
+      expected |= word[len] ? 1u << (word[len] - 'a') : CRYPT0_BIP39_WORD_COMPLETE;
+      first = first < 0 ? i : first;
+      count++;
+    }
+
+    uint16_t start = 0xffff, n = 0xffff;
+    uint32_t letters = crypt0_bip39_next_letters(prefix, len, &start, &n);
+    if (letters != expected || n != count || (count > 0 && start != first)) {
+      LOG_ERR("%s: letters %x count %d first %d, expected %x %d %d", prefix,
+          letters, n, start, expected, count, first);
+      return false;
+    }
+  }
+
+  if (crypt0_bip39_next_letters("act", 3, NULL, NULL) !=
+      (CRYPT0_BIP39_WORD_COMPLETE | letter_bits("ioru"))) {
+    LOG_ERR("act: wrong letters");
+    return false;
+  }
+  return true;
+}
+
+// text mnemonic to entropy against the word index form, checksum checked
+bool test_bip39_mnemonic_en_to_entropy()
+{
+  for (int words = 12; words <= 24; words += 6) {
+    uint8_t entropy[32], result[32];
+    uint8_t mnemonic[24 * 9];
+    size_t entropy_len = words * 4 / 3;
+
+    for (size_t i = 0; i < entropy_len; i++) {
+      entropy[i] = (uint8_t)(i * 37 + words);
+    }
+    int len = crypt0_bip39_entropy_to_mnemonic_en(entropy, entropy_len, mnemonic, sizeof(mnemonic));
+    if (len <= 0) {
+      LOG_ERR("%d words: entropy_to_mnemonic failed", words);
+      return false;
+    }
+    len = strnlen((const char *)mnemonic, len);
+    if (!crypt0_bip39_mnemonic_en_to_entropy(mnemonic, len, result, entropy_len) ||
+        memcmp(entropy, result, entropy_len) != 0) {
+      LOG_ERR("%d words: wrong entropy", words);
+      return false;
+    }
+
+    uint16_t indexes[24];
+    if (crypt0_bip39_mnemonic_to_indexes(mnemonic, len, indexes, words) != words ||
+        crypt0_bip39_mnemonic_to_indexes(mnemonic, len, indexes, words - 1) != CRYPT0_ERR_OUTBUF_LEN) {
+      LOG_ERR("%d words: wrong indexes", words);
+      return false;
+    }
+  }
+
+  static const char * bad[] = {
+    "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon",
+    "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abuot",
+    "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+  };
+  for (auto mnemonic : bad) {
+    uint8_t result[16];
+    if (crypt0_bip39_mnemonic_en_to_entropy((const uint8_t *)mnemonic, strlen(mnemonic),
+          result, sizeof(result))) {
+      LOG_ERR("bad mnemonic accepted: %s", mnemonic);
+      return false;
+    }
+  }
+
+  // pasted text: any ASCII whitespace between and around the words
+  static const char * about[] = {
+    "  abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about ",
+    "abandon abandon abandon abandon\nabandon abandon abandon abandon\nabandon abandon abandon about\n",
+    "abandon\tabandon\tabandon\r\nabandon abandon abandon\r\n\vabandon abandon\fabandon "
+      "abandon abandon about",
+  };
+  static const uint8_t zero[16] = { 0 };
+  for (auto mnemonic : about) {
+    uint8_t result[16];
+    if (!crypt0_bip39_mnemonic_en_to_entropy((const uint8_t *)mnemonic, strlen(mnemonic),
+          result, sizeof(result)) || memcmp(result, zero, sizeof(zero)) != 0) {
+      LOG_ERR("abandon ... about: wrong entropy from \"%s\"", mnemonic);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(void)
+{
+  if (!test_bip39_word_index()) {
+    return 1;
+  }
+  if (!test_bip39_next_letters()) {
+    return 1;
+  }
+  if (!test_bip39_mnemonic_en_to_entropy()) {
+    return 1;
+  }
+
+  return 0;
+}
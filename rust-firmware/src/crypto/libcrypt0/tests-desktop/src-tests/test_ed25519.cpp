@@ -0,0 +1,232 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_ed25519.h>
+
+#include <iostream>
+
+#ifdef CRYPT0_USE_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_ed25519, LOG_LEVEL_DBG);
+
+using namespace std;
+
+struct ed25519_vector {
+  const char * priv;
+  const char * pub;
+  const char * msg;
+  const char * sig;
+};
+
+// RFC 8032, section 7.1, tests 1 - 3
+const ed25519_vector vectors[] = {
+  {"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+   "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+   "",
+   "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+   "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+  {"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+   "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+   "72",
+   "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+   "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+  {"c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+   "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+   "af82",
+   "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac"
+   "18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"},
+};
+
+static int unhex(const char * hex, uint8_t * out)
+{
+  int len = strlen(hex) / 2;
+  for (int i = 0; i < len; i++) {
+    sscanf(hex + 2 * i, "%2hhx", &out[i]);
+  }
+  return len;
+}
+
+bool test_ed25519_rfc8032()
+{
+  uint8_t priv[32], pub[32], msg[2], sig[64];
+  char hex[129];
+
+  for (auto & v : vectors) {
+    unhex(v.priv, priv);
+    int msg_len = unhex(v.msg, msg);
+
+    if (crypt0_ed25519_public_key(priv, sizeof(priv), pub, sizeof(pub)) != 0) {
+      LOG_ERR("crypt0_ed25519_public_key failed");
+      return false;
+    }
+    crypt0_bin2hex(pub, sizeof(pub), hex, sizeof(hex));
+    if (strcmp(hex, v.pub) != 0) {
+      LOG_ERR("expected pub %s, got %s", v.pub, hex);
+      return false;
+    }
+
+    if (crypt0_ed25519_sign(msg, msg_len, priv, sizeof(priv), pub, sizeof(pub),
+          sig, sizeof(sig)) != 0) {
+      LOG_ERR("crypt0_ed25519_sign failed");
+      return false;
+    }
+    crypt0_bin2hex(sig, sizeof(sig), hex, sizeof(hex));
+    if (strcmp(hex, v.sig) != 0) {
+      LOG_ERR("expected sig %s, got %s", v.sig, hex);
+      return false;
+    }
+  }
+  return true;
+}
+
+// batches across the 8 key chunks against one call per key
+bool test_ed25519_public_keys()
+{
+  static uint8_t priv[20 * 32], pub[20 * 32];
+  uint8_t expected[32];
+
+  for (size_t i = 0; i < sizeof(priv); i++) {
+    priv[i] = (uint8_t)(i * 7 + 1);
+  }
+  unhex(vectors[1].priv, &priv[9 * 32]);
+
+  for (size_t n : { 0, 1, 8, 9, 20 }) {
+    memset(pub, 0xaa, sizeof(pub));
+    if (crypt0_ed25519_public_keys(priv, n, pub) != 0) {
+      LOG_ERR("crypt0_ed25519_public_keys(%d) failed", (int)n);
+      return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+      crypt0_ed25519_public_key(&priv[32 * i], 32, expected, sizeof(expected));
+      if (memcmp(&pub[32 * i], expected, 32) != 0) {
+        LOG_ERR("batch of %d, key %d differs", (int)n, (int)i);
+        return false;
+      }
+    }
+    if (n < 20 && pub[32 * n] != 0xaa) {
+      LOG_ERR("batch of %d wrote past its keys", (int)n);
+      return false;
+    }
+  }
+
+  char hex[65];
+  crypt0_bin2hex(&pub[9 * 32], 32, hex, sizeof(hex));
+  if (strcmp(hex, vectors[1].pub) != 0) {
+    LOG_ERR("expected pub %s, got %s", vectors[1].pub, hex);
+    return false;
+  }
+  return true;
+}
+
+// expanded key pairs sign as the plain calls do
+bool test_ed25519_keypair()
+{
+  uint8_t priv[32], msg[2], sig[64], expected[64];
+  crypt0_ed25519_keypair keypair;
+
+  for (auto & v : vectors) {
+    unhex(v.priv, priv);
+    int msg_len = unhex(v.msg, msg);
+    unhex(v.sig, expected);
+
+    if (crypt0_ed25519_keypair_init(&keypair, priv, sizeof(priv)) != 0) {
+      LOG_ERR("crypt0_ed25519_keypair_init failed");
+      return false;
+    }
+    char hex[65];
+    crypt0_bin2hex(keypair.pub, sizeof(keypair.pub), hex, sizeof(hex));
+    if (strcmp(hex, v.pub) != 0) {
+      LOG_ERR("expected pub %s, got %s", v.pub, hex);
+      return false;
+    }
+    // several messages with one expansion
+    for (int i = 0; i < 3; i++) {
+      if (crypt0_ed25519_keypair_sign(&keypair, msg, msg_len, sig, sizeof(sig)) != 0 ||
+          memcmp(sig, expected, sizeof(sig)) != 0) {
+        LOG_ERR("keypair signature %d differs", i);
+        return false;
+      }
+    }
+  }
+
+  if (crypt0_ed25519_keypair_init(&keypair, priv, 31) != -1 ||
+      crypt0_ed25519_keypair_sign(&keypair, msg, 1, sig, 63) != -1) {
+    LOG_ERR("bad lengths accepted");
+    return false;
+  }
+
+  crypt0_ed25519_keypair_wipe(&keypair);
+  for (size_t i = 0; i < sizeof(keypair); i++) {
+    if (((uint8_t *)&keypair)[i] != 0) {
+      LOG_ERR("keypair not wiped");
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef CRYPT0_USE_OPENSSL
+// every table row and digit sign through many keys, against OpenSSL
+bool test_ed25519_openssl()
+{
+  uint8_t priv[32], pub[32], expected[32], msg[40], sig[64], expected_sig[64];
+
+  for (int k = 0; k < 256; k++) {
+    for (size_t i = 0; i < sizeof(priv); i++) {
+      priv[i] = (uint8_t)(k * 131 + i * 29 + (k >> 3) * i);
+    }
+    for (size_t i = 0; i < sizeof(msg); i++) {
+      msg[i] = (uint8_t)(k + i);
+    }
+
+    EVP_PKEY * pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, priv, 32);
+    EVP_MD_CTX * mdctx = EVP_MD_CTX_new();
+    size_t publen = sizeof(expected), siglen = sizeof(expected_sig);
+    bool ok = pkey != NULL && mdctx != NULL &&
+      EVP_PKEY_get_raw_public_key(pkey, expected, &publen) > 0 &&
+      EVP_DigestSignInit(mdctx, NULL, NULL, NULL, pkey) > 0 &&
+      EVP_DigestSign(mdctx, expected_sig, &siglen, msg, k % sizeof(msg)) > 0;
+    EVP_MD_CTX_free(mdctx);
+    EVP_PKEY_free(pkey);
+    if (!ok) {
+      LOG_ERR("OpenSSL ed25519 failed");
+      return false;
+    }
+
+    crypt0_ed25519_public_key(priv, sizeof(priv), pub, sizeof(pub));
+    crypt0_ed25519_sign(msg, k % sizeof(msg), priv, sizeof(priv), pub, sizeof(pub),
+        sig, sizeof(sig));
+    if (memcmp(pub, expected, 32) != 0 || memcmp(sig, expected_sig, 64) != 0) {
+      LOG_ERR("key %d differs from OpenSSL", k);
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+int main(void)
+{
+  if (!test_ed25519_rfc8032()) {
+    return 1;
+  }
+  if (!test_ed25519_public_keys()) {
+    return 1;
+  }
+  if (!test_ed25519_keypair()) {
+    return 1;
+  }
+#ifdef CRYPT0_USE_OPENSSL
+  if (!test_ed25519_openssl()) {
+    return 1;
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_sha2.h>
+#include <crypt0_ripemd160.h>
+#include <crypt0_hash_batch.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_hash_batch, LOG_LEVEL_DBG);
+
+using namespace std;
+
+static const crypt0_sha2_kernel_t kernels[] = {
+  CRYPT0_SHA2_KERNEL_SCALAR, CRYPT0_SHA2_KERNEL_AVX2, CRYPT0_SHA2_KERNEL_SHANI,
+};
+
+// lengths around the one / two block padding edges, pubkeys and address payloads
+static const size_t lengths[] = {0, 1, 20, 21, 33, 55, 56, 63, 64, 65, 119, 120, 200};
+
+static uint8_t data[20 * 200];
+
+static void fill_data()
+{
+  uint32_t x = 0x9e3779b9;
+  for (size_t i = 0; i < sizeof(data); i++) {
+    x = x * 1103515245 + 12345;
+    data[i] = (uint8_t)(x >> 16);
+  }
+}
+
+bool test_hash160_pubkey()
+{
+  const char * pub = "0378d430274f8c5ec1321338151e9f27f4c676a008bdf8638d07c0b6be9ab35c71";
+  uint8_t in[3 * 33];
+  uint8_t out[3 * 20];
+  char hex[41];
+
+  crypt0_hex2bin(pub, 66, in, 33);
+  memcpy(in + 33, in, 33);
+  memcpy(in + 66, in, 33);
+  crypt0_hash160_batch(in, 33, 3, out);
+  for (int i = 0; i < 3; i++) {
+    crypt0_bin2hex(out + 20 * i, 20, hex, sizeof(hex));
+    if (strcmp(hex, "79fbfc3f34e7745860d76137da68f362380c606c") != 0) {
+      LOG_ERR("hash160 lane %d: %s", i, hex);
+      return false;
+    }
+  }
+  return true;
+}
+
+// every n up to a couple of full avx2 batches, against one input at a time
+bool test_hash_batch(crypt0_sha2_kernel_t kernel)
+{
+  uint8_t out[20 * 32];
+  uint8_t sha[32];
+  uint8_t expected[32];
+
+  crypt0_sha2_kernel_select(kernel);
+
+  for (auto len : lengths) {
+    for (size_t n = 1; n <= 19; n++) {
+      crypt0_hash160_batch(data, len, n, out);
+      for (size_t i = 0; i < n; i++) {
+        crypt0_sha256(data + i * len, len, sha, 32);
+        crypt0_ripemd160(sha, 32, expected);
+        if (memcmp(out + 20 * i, expected, 20) != 0) {
+          LOG_ERR("%s: hash160 len %d n %d lane %d", crypt0_sha2_kernel_name(kernel),
+              (int)len, (int)n, (int)i);
+          return false;
+        }
+      }
+
+      crypt0_dsha256_batch(data, len, n, out);
+      for (size_t i = 0; i < n; i++) {
+        crypt0_sha256(data + i * len, len, sha, 32);
+        crypt0_sha256(sha, 32, expected, 32);
+        if (memcmp(out + 32 * i, expected, 32) != 0) {
+          LOG_ERR("%s: dsha256 len %d n %d lane %d", crypt0_sha2_kernel_name(kernel),
+              (int)len, (int)n, (int)i);
+          return false;
+        }
+      }
+    }
+  }
+
+  return test_hash160_pubkey();
+}
+
+int main(void)
+{
+  fill_data();
+
+  crypt0_sha2_kernel_t best = crypt0_sha2_kernel();
+
+  for (auto kernel : kernels) {
+    if (!crypt0_sha2_kernel_supported(kernel)) {
+      continue;
+    }
+    if (!test_hash_batch(kernel)) {
+      return 1;
+    }
+  }
+
+  crypt0_sha2_kernel_select(best);
+
+  // n == 0 must not touch the output
+  uint8_t out[20];
+  memset(out, 0xa5, sizeof(out));
+  crypt0_hash160_batch(data, 33, 0, out);
+  for (auto b : out) {
+    if (b != 0xa5) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
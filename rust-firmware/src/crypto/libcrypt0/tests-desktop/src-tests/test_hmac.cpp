@@ -0,0 +1,147 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_sha2.h>
+#include <crypt0_hmac.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_hmac, LOG_LEVEL_DBG);
+
+using namespace std;
+
+static uint8_t data[300];
+
+static void fill_data()
+{
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)(i * 131 + 7);
+  }
+}
+
+// streaming sha2 fed in uneven pieces against the one-shot digest
+bool test_sha2_streaming()
+{
+  uint8_t out[64], expected[64];
+
+  for (size_t len = 0; len <= sizeof(data); len += 13) {
+    for (size_t cut = 0; cut <= len; cut += 29) {
+      crypt0_sha256_ctx ctx256;
+      crypt0_sha256_init(&ctx256);
+      crypt0_sha256_update(&ctx256, data, cut);
+      crypt0_sha256_update(&ctx256, data + cut, len - cut);
+      crypt0_sha256_final(&ctx256, out);
+      crypt0_sha256(data, len, expected, 32);
+      if (memcmp(out, expected, 32) != 0) {
+        LOG_ERR("sha256 len %d cut %d", (int)len, (int)cut);
+        return false;
+      }
+
+      crypt0_sha512_ctx ctx512;
+      crypt0_sha512_init(&ctx512);
+      crypt0_sha512_update(&ctx512, data, cut);
+      crypt0_sha512_update(&ctx512, data + cut, len - cut);
+      crypt0_sha512_final(&ctx512, out);
+      crypt0_sha512(data, len, expected, 64);
+      if (memcmp(out, expected, 64) != 0) {
+        LOG_ERR("sha512 len %d cut %d", (int)len, (int)cut);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// RFC 4231 test case 2
+bool test_hmac_rfc4231()
+{
+  const char * key = "Jefe";
+  const char * msg = "what do ya want for nothing?";
+  uint8_t out[64];
+  char hex[129];
+  crypt0_hmac_sha256_ctx ctx256;
+  crypt0_hmac_sha512_ctx ctx512;
+
+  crypt0_hmac_sha256_init(&ctx256, (const uint8_t *)key, strlen(key));
+  crypt0_hmac_sha256_update(&ctx256, (const uint8_t *)msg, 10);
+  crypt0_hmac_sha256_update(&ctx256, (const uint8_t *)msg + 10, strlen(msg) - 10);
+  crypt0_hmac_sha256_final(&ctx256, out);
+  crypt0_bin2hex(out, 32, hex, sizeof(hex));
+  if (strcmp(hex, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843") != 0) {
+    LOG_ERR("hmac sha256: %s", hex);
+    return false;
+  }
+
+  crypt0_hmac_sha512_init(&ctx512, (const uint8_t *)key, strlen(key));
+  crypt0_hmac_sha512_update(&ctx512, (const uint8_t *)msg, strlen(msg));
+  crypt0_hmac_sha512_final(&ctx512, out);
+  crypt0_bin2hex(out, 64, hex, sizeof(hex));
+  if (strcmp(hex,
+        "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+        "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737") != 0) {
+    LOG_ERR("hmac sha512: %s", hex);
+    return false;
+  }
+  return true;
+}
+
+// one keyed state cloned for every message, short, block sized and long keys
+bool test_hmac_clone()
+{
+  const size_t key_lens[] = {0, 20, 32, 64, 65, 128, 129, 200};
+  uint8_t out[64], expected[64];
+
+  for (size_t key_len : key_lens) {
+    crypt0_hmac_sha256_ctx keyed256, ctx256;
+    crypt0_hmac_sha512_ctx keyed512, ctx512;
+
+    crypt0_hmac_sha256_init(&keyed256, data, key_len);
+    crypt0_hmac_sha512_init(&keyed512, data, key_len);
+
+    for (size_t len = 0; len < 200; len += 37) {
+      crypt0_hmac_sha256_clone(&ctx256, &keyed256);
+      crypt0_hmac_sha256_update(&ctx256, data + 50, len / 2);
+      crypt0_hmac_sha256_update(&ctx256, data + 50 + len / 2, len - len / 2);
+      crypt0_hmac_sha256_final(&ctx256, out);
+      crypt0_hmac_sha256(data, key_len, data + 50, len, expected);
+      if (memcmp(out, expected, 32) != 0) {
+        LOG_ERR("hmac sha256 key %d msg %d", (int)key_len, (int)len);
+        return false;
+      }
+
+      crypt0_hmac_sha512_clone(&ctx512, &keyed512);
+      crypt0_hmac_sha512_update(&ctx512, data + 50, len / 2);
+      crypt0_hmac_sha512_update(&ctx512, data + 50 + len / 2, len - len / 2);
+      crypt0_hmac_sha512_final(&ctx512, out);
+      crypt0_hmac_sha512(data, key_len, data + 50, len, expected);
+      if (memcmp(out, expected, 64) != 0) {
+        LOG_ERR("hmac sha512 key %d msg %d", (int)key_len, (int)len);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(void)
+{
+  fill_data();
+
+  if (!test_sha2_streaming()) {
+    return 1;
+  }
+
+  if (!test_hmac_rfc4231()) {
+    return 1;
+  }
+
+  if (!test_hmac_clone()) {
+    return 1;
+  }
+
+  return 0;
+}
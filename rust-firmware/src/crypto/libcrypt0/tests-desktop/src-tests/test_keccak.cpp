@@ -0,0 +1,220 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_keccak.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_keccak, LOG_LEVEL_DBG);
+
+using namespace std;
+
+typedef void (*keccakf_fn)(uint64_t state[25]);
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t next_rand()
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+// every implementation against the original SHA3IUF permutation
+bool test_permutation(const char * name, keccakf_fn fn)
+{
+  uint64_t ref[25];
+  uint64_t st[25];
+
+  // all zero state, first lane from the Keccak team test vectors
+  memset(st, 0, sizeof(st));
+  fn(st);
+  if (st[0] != 0xf1258f7940e1dde7ULL) {
+    LOG_ERR("%s: zero state lane 0 %016llx", name, (unsigned long long)st[0]);
+    return false;
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    for (int j = 0; j < 25; j++) {
+      ref[j] = next_rand();
+    }
+    memcpy(st, ref, sizeof(st));
+    crypt0_keccakf1600_ref(ref);
+    fn(st);
+    if (memcmp(st, ref, sizeof(st)) != 0) {
+      LOG_ERR("%s: random state %d differs", name, i);
+      return false;
+    }
+  }
+
+  // chained, so every output is also used as an input
+  memset(ref, 0, sizeof(ref));
+  memset(st, 0, sizeof(st));
+  for (int i = 0; i < 1000; i++) {
+    crypt0_keccakf1600_ref(ref);
+    fn(st);
+  }
+  if (memcmp(st, ref, sizeof(st)) != 0) {
+    LOG_ERR("%s: chained state differs", name);
+    return false;
+  }
+
+  return true;
+}
+
+// keccak256 sponge on the reference permutation
+static void keccak256_ref(const uint8_t * data, size_t len, uint8_t out[32])
+{
+  const size_t rate = 136;
+  uint64_t st[25];
+  uint8_t block[136];
+
+  memset(st, 0, sizeof(st));
+  for (;;) {
+    size_t n = len < rate ? len : rate;
+    memset(block, 0, rate);
+    memcpy(block, data, n);
+    if (n < rate) {
+      block[n] ^= 0x01;
+      block[rate - 1] ^= 0x80;
+    }
+    for (size_t i = 0; i < rate; i++) {
+      st[i / 8] ^= (uint64_t)block[i] << (8 * (i % 8));
+    }
+    crypt0_keccakf1600_ref(st);
+    if (n < rate) {
+      break;
+    }
+    data += n;
+    len -= n;
+  }
+  for (size_t i = 0; i < 32; i++) {
+    out[i] = (uint8_t)(st[i / 8] >> (8 * (i % 8)));
+  }
+}
+
+bool test_keccak256()
+{
+  static const struct {
+    const char * msg;
+    const char * hash;
+  } vectors[] = {
+    { "", "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470" },
+    { "abc", "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45" },
+  };
+  uint8_t data[500];
+  uint8_t out[32];
+  uint8_t expected[32];
+  char hex[65];
+
+  for (auto & v : vectors) {
+    crypt0_sha3_keccak((const uint8_t *)v.msg, strlen(v.msg), out, 32);
+    crypt0_bin2hex(out, 32, hex, sizeof(hex));
+    if (strcmp(hex, v.hash) != 0) {
+      LOG_ERR("keccak256(\"%s\") = %s", v.msg, hex);
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)next_rand();
+  }
+
+  // every length across the 136 byte rate boundaries, whole and split
+  for (size_t len = 0; len <= sizeof(data); len++) {
+    keccak256_ref(data, len, expected);
+    crypt0_sha3_keccak(data, len, out, 32);
+    if (memcmp(out, expected, 32) != 0) {
+      LOG_ERR("keccak256 len %d differs", (int)len);
+      return false;
+    }
+    crypt0_sha3_keccak2(data, len / 3, data + len / 3, len - len / 3, out, 32);
+    if (memcmp(out, expected, 32) != 0) {
+      LOG_ERR("keccak256 split len %d differs", (int)len);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// arbitrary chunking and prefix clones against one shot hashing
+bool test_keccak_ctx()
+{
+  uint8_t data[700];
+  uint8_t out[32];
+  uint8_t expected[32];
+
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)next_rand();
+  }
+
+  for (int i = 0; i < 200; i++) {
+    size_t len = next_rand() % sizeof(data);
+    crypt0_keccak_ctx ctx;
+    crypt0_keccak_init(&ctx);
+    for (size_t pos = 0; pos < len; ) {
+      size_t n = next_rand() % 150;
+      if (n > len - pos) {
+        n = len - pos;
+      }
+      crypt0_keccak_update(&ctx, data + pos, n);
+      pos += n;
+    }
+    crypt0_keccak_final(&ctx, out);
+    keccak256_ref(data, len, expected);
+    if (memcmp(out, expected, 32) != 0) {
+      LOG_ERR("keccak ctx len %d differs", (int)len);
+      return false;
+    }
+  }
+
+  // one prefix, many suffixes
+  crypt0_keccak_ctx prefix;
+  crypt0_keccak_init(&prefix);
+  crypt0_keccak_update(&prefix, data, 300);
+  for (size_t suffix = 0; suffix < 300; suffix += 37) {
+    crypt0_keccak_ctx ctx;
+    crypt0_keccak_clone(&ctx, &prefix);
+    crypt0_keccak_update(&ctx, data + 300, suffix);
+    crypt0_keccak_final(&ctx, out);
+    keccak256_ref(data, 300 + suffix, expected);
+    if (memcmp(out, expected, 32) != 0) {
+      LOG_ERR("keccak clone suffix %d differs", (int)suffix);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(void)
+{
+  LOG_DBG("keccak-f[1600]: %s", crypt0_keccakf1600_impl());
+
+  if (!test_permutation("ref", crypt0_keccakf1600_ref)) {
+    return 1;
+  }
+  if (!test_permutation("lc", crypt0_keccakf1600_lc)) {
+    return 1;
+  }
+  if (!test_permutation("bi", crypt0_keccakf1600_bi)) {
+    return 1;
+  }
+  if (!test_permutation("selected", crypt0_keccakf1600)) {
+    return 1;
+  }
+  if (!test_keccak256()) {
+    return 1;
+  }
+  if (!test_keccak_ctx()) {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_pbkdf2.h>
+#include <crypt0_bip39.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_pbkdf2, LOG_LEVEL_DBG);
+
+using namespace std;
+
+const char * long_pass =
+  "passwordPASSWORDpasswordpasswordPASSWORDpasswordpasswordPASSWORDpassword"
+  "passwordPASSWORDpasswordpasswordPASSWORDpasswordpasswordPASSWORDpassword";
+const char * long_salt =
+  "saltSALTsaltSALTsaltSALTsaltSALTsaltxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+
+struct pbkdf2_vector {
+  const char * pass;
+  const char * salt;
+  int iterations;
+  const char * sha256;
+  const char * sha512;
+};
+
+const pbkdf2_vector vectors[] = {
+  {"password", "salt", 1,
+   "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b",
+   "867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252"
+   "c02d470a285a0501bad999bfe943c08f050235d7d68b1da55e63f73b60a57fce"},
+  {"password", "salt", 2,
+   "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43",
+   "e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53c"
+   "f76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e"},
+  {"password", "salt", 4096,
+   "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a",
+   "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5"
+   "143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5"},
+  // password longer than a block, salt that spills into a second block
+  {long_pass, long_salt, 4096,
+   "1d4b4d9323f1f35f3df33bc677f8dc4250a471b0f0cc99866f44c3c345ed4a21",
+   "2d8de736f628293c05030198969d9ca5e3c80fb9570c63009ad94196a0f4d3a4"
+   "277fb48de6c9d56ac7083ddd8fed93847b6c6d7693f3c4ede056e1d272d5e6d8"},
+};
+
+bool test_pbkdf2_hmac_sha256()
+{
+  uint8_t key[32];
+  char hex[65];
+
+  for (auto & v : vectors) {
+    int res = crypt0_pbkdf2_hmac_sha256(v.iterations,
+        (const uint8_t *)v.pass, strlen(v.pass),
+        (const uint8_t *)v.salt, strlen(v.salt), key, sizeof(key));
+    if (res != CRYPT0_OK) {
+      LOG_ERR("crypt0_pbkdf2_hmac_sha256 failed: %d", res);
+      return false;
+    }
+    crypt0_bin2hex(key, sizeof(key), hex, sizeof(hex));
+    if (strcmp(hex, v.sha256) != 0) {
+      LOG_ERR("c = %d, expected %s, got %s", v.iterations, v.sha256, hex);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool test_pbkdf2_hmac_sha512()
+{
+  uint8_t key[64];
+  char hex[129];
+
+  for (auto & v : vectors) {
+    int res = crypt0_pbkdf2_hmac_sha512(v.iterations,
+        (const uint8_t *)v.pass, strlen(v.pass),
+        (const uint8_t *)v.salt, strlen(v.salt), key, sizeof(key));
+    if (res != CRYPT0_OK) {
+      LOG_ERR("crypt0_pbkdf2_hmac_sha512 failed: %d", res);
+      return false;
+    }
+    crypt0_bin2hex(key, sizeof(key), hex, sizeof(hex));
+    if (strcmp(hex, v.sha512) != 0) {
+      LOG_ERR("c = %d, expected %s, got %s", v.iterations, v.sha512, hex);
+      return false;
+    }
+  }
+  return true;
+}
+
+// runs the derivation in uneven slices, the key has to match the one-shot one
+bool test_pbkdf2_ctx_slices()
+{
+  const uint32_t slices[] = {1, 7, 1000, 0, 4096};
+
+  for (auto & v : vectors) {
+    for (int hash = 0; hash < 2; hash++) {
+      crypt0_pbkdf2_ctx ctx;
+      uint8_t key[64];
+      uint8_t expected[64];
+      uint16_t key_len = hash ? 64 : 32;
+
+      int res = crypt0_pbkdf2_init(&ctx, (crypt0_pbkdf2_hash_t)hash, v.iterations,
+          (const uint8_t *)v.pass, strlen(v.pass),
+          (const uint8_t *)v.salt, strlen(v.salt));
+      if (res != CRYPT0_OK) {
+        LOG_ERR("crypt0_pbkdf2_init failed: %d", res);
+        return false;
+      }
+
+      uint32_t left = v.iterations - 1;
+      for (int k = 0; left > 0; k++) {
+        if (crypt0_pbkdf2_finish(&ctx, key, key_len) != CRYPT0_ERR) {
+          LOG_ERR("finish before the last iteration must fail");
+          return false;
+        }
+        uint32_t n = slices[k % 5];
+        uint32_t next = crypt0_pbkdf2_step(&ctx, n);
+        if (next != (n > left ? 0 : left - n) || ctx.done != v.iterations - next) {
+          LOG_ERR("c = %d, wrong progress %u after %u", v.iterations, next, n);
+          return false;
+        }
+        left = next;
+      }
+      if (crypt0_pbkdf2_step(&ctx, 1) != 0) {
+        return false;
+      }
+
+      res = crypt0_pbkdf2_finish(&ctx, key, key_len);
+      if (res != CRYPT0_OK) {
+        LOG_ERR("crypt0_pbkdf2_finish failed: %d", res);
+        return false;
+      }
+      if (hash) {
+        crypt0_pbkdf2_hmac_sha512(v.iterations, (const uint8_t *)v.pass, strlen(v.pass),
+            (const uint8_t *)v.salt, strlen(v.salt), expected, key_len);
+      } else {
+        crypt0_pbkdf2_hmac_sha256(v.iterations, (const uint8_t *)v.pass, strlen(v.pass),
+            (const uint8_t *)v.salt, strlen(v.salt), expected, key_len);
+      }
+      if (memcmp(key, expected, key_len) != 0) {
+        LOG_ERR("c = %d, sliced key differs from one-shot", v.iterations);
+        return false;
+      }
+      if (ctx.iterations != 0 || ctx.done != 0) {
+        LOG_ERR("ctx is not wiped");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool test_bip39_seed_ctx()
+{
+  const char * mnemonic = "wild casual icon cream oven boil";
+  crypt0_pbkdf2_ctx ctx;
+  uint8_t seed[64];
+  uint8_t expected[64];
+
+  crypt0_bip39_mnemonic_to_seed((const uint8_t *)mnemonic, strlen(mnemonic),
+      expected, sizeof(expected));
+
+  if (crypt0_bip39_mnemonic_to_seed_init(&ctx, (const uint8_t *)mnemonic,
+        strlen(mnemonic)) != CRYPT0_OK) {
+    return false;
+  }
+  while (crypt0_pbkdf2_step(&ctx, 100) > 0)
+    ;
+  if (crypt0_pbkdf2_finish(&ctx, seed, sizeof(seed)) != CRYPT0_OK) {
+    return false;
+  }
+  if (memcmp(seed, expected, sizeof(seed)) != 0) {
+    LOG_ERR("bip39 seed differs");
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  if (!test_pbkdf2_hmac_sha256()) {
+    return 1;
+  }
+
+  if (!test_pbkdf2_hmac_sha512()) {
+    return 1;
+  }
+
+  if (!test_pbkdf2_ctx_slices()) {
+    return 1;
+  }
+
+  if (!test_bip39_seed_ctx()) {
+    return 1;
+  }
+
+  return 0;
+}
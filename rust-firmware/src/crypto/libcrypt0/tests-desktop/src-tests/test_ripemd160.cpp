@@ -0,0 +1,92 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_ripemd160.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_ripemd160, LOG_LEVEL_DBG);
+
+// the libbtc implementation libcrypt0 used before, as the reference
+#include "ripemd160_.c"
+
+using namespace std;
+
+static uint8_t data[300];
+
+bool test_ripemd160_vectors()
+{
+  static const struct {
+    const char * msg;
+    const char * hash;
+  } vectors[] = {
+    { "", "9c1185a5c5e9fc54612808977ee8f548b2258d31" },
+    { "a", "0bdc9d2d256b3ee9daae347be6f4dc835a467ffe" },
+    { "abc", "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc" },
+    { "message digest", "5d0689ef49d2fae572b881b123a85ffa21595f36" },
+    { "abcdefghijklmnopqrstuvwxyz", "f71c27109c692c1b56bbdceb5b9d2865b3708dbc" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+      "12a053384a9c0c88e405a06c27dcf49ada62eb2b" },
+    { "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+      "9b752e45573d4b39f4dbd3323cab82bf63326bfb" },
+  };
+  uint8_t out[20];
+  char hex[41];
+
+  for (auto & v : vectors) {
+    crypt0_ripemd160((const uint8_t *)v.msg, strlen(v.msg), out);
+    crypt0_bin2hex(out, 20, hex, sizeof(hex));
+    if (strcmp(hex, v.hash) != 0) {
+      LOG_ERR("ripemd160(\"%s\") = %s", v.msg, hex);
+      return false;
+    }
+  }
+  return true;
+}
+
+// every length over the 55 / 64 byte padding edges against libbtc, and
+// hash160 against sha256 + ripemd160
+bool test_ripemd160_lengths()
+{
+  uint8_t out[20];
+  uint8_t expected[20];
+  uint8_t sha[32];
+
+  for (size_t len = 0; len <= sizeof(data); len++) {
+    ripemd160(data, len, expected);
+    crypt0_ripemd160(data, len, out);
+    if (memcmp(out, expected, 20) != 0) {
+      LOG_ERR("ripemd160 len %d differs from libbtc", (int)len);
+      return false;
+    }
+
+    crypt0_sha256(data, len, sha, 32);
+    ripemd160(sha, 32, expected);
+    crypt0_hash160(data, len, out);
+    if (memcmp(out, expected, 20) != 0) {
+      LOG_ERR("hash160 len %d differs", (int)len);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)(i * 167 + 13);
+  }
+
+  if (!test_ripemd160_vectors()) {
+    return 1;
+  }
+  if (!test_ripemd160_lengths()) {
+    return 1;
+  }
+
+  return 0;
+}
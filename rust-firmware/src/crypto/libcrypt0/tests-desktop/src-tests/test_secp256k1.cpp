@@ -0,0 +1,456 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+#include <crypt0_hmac.h>
+#include <crypt0_secp256k1.h>
+
+#include <secp256k1.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_secp256k1, LOG_LEVEL_DBG);
+
+using namespace std;
+
+static uint8_t priv[32];
+static uint8_t msg_hash[32];
+
+static const char * G_HEX =
+  "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+  "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+
+// priv = 1 gives the generator
+bool test_secp256k1_public_key()
+{
+  uint8_t one[32] = { 0 };
+  uint8_t pub[65];
+  char hex[131];
+
+  one[31] = 1;
+  if (crypt0_secp256k1_public_key(one, 32, pub, 65) != CRYPT0_OK) {
+    LOG_ERR("public key failed");
+    return false;
+  }
+  crypt0_bin2hex(pub, 65, hex, sizeof(hex));
+  if (strcmp(hex, G_HEX) != 0) {
+    LOG_ERR("1 * G = %s", hex);
+    return false;
+  }
+  return true;
+}
+
+// RFC6979 signatures don't depend on the blinding, sign across several
+// re-randomizations of the shared context and compare with the first one
+bool test_secp256k1_rerandomize()
+{
+  uint8_t first[65], sig[65];
+
+  if (crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, first, 65) != CRYPT0_OK) {
+    LOG_ERR("sign recoverable failed");
+    return false;
+  }
+  for (int i = 0; i < 3 * CRYPT0_SECP256K1_RERANDOMIZE_EVERY; i++) {
+    if (i == CRYPT0_SECP256K1_RERANDOMIZE_EVERY / 2) {
+      crypt0_secp256k1_rerandomize();
+    }
+    if (crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, sig, 65) != CRYPT0_OK) {
+      LOG_ERR("sign recoverable %d failed", i);
+      return false;
+    }
+    if (memcmp(sig, first, 65) != 0) {
+      LOG_ERR("signature %d differs", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+// compact signature verifies against the public key
+bool test_secp256k1_sign()
+{
+  uint8_t sig[64], pub[65];
+  secp256k1_pubkey pubkey;
+  secp256k1_ecdsa_signature ecdsa_sig;
+  const secp256k1_context * ctx = secp256k1_context_no_precomp;
+
+  crypt0_secp256k1_public_key(priv, 32, pub, 65);
+  if (crypt0_secp256k1_sign(msg_hash, 32, priv, 32, sig, 64) != 64) {
+    LOG_ERR("sign failed");
+    return false;
+  }
+  if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pub, 65) ||
+      !secp256k1_ecdsa_signature_parse_compact(ctx, &ecdsa_sig, sig) ||
+      !secp256k1_ecdsa_verify(ctx, &ecdsa_sig, msg_hash, &pubkey)) {
+    LOG_ERR("signature does not verify");
+    return false;
+  }
+  return true;
+}
+
+// own signatures verify, a changed hash, a wrong key and bad lengths don't
+bool test_secp256k1_verify()
+{
+  uint8_t sig[65], pub[65], pubc[33], other[33], hash[32];
+  uint8_t other_priv[32] = { 0 };
+
+  other_priv[31] = 1;
+  crypt0_secp256k1_public_key(priv, 32, pub, 65);
+  crypt0_secp256k1_public_key_compressed(priv, 32, pubc, 33);
+  crypt0_secp256k1_public_key_compressed(other_priv, 32, other, 33);
+  if (crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, sig, 65) != CRYPT0_OK) {
+    LOG_ERR("sign recoverable failed");
+    return false;
+  }
+
+  if (crypt0_secp256k1_verify_signature(sig, 64, msg_hash, 32, pub, 65) != CRYPT0_OK ||
+      crypt0_secp256k1_verify_signature(sig, 65, msg_hash, 32, pubc, 33) != CRYPT0_OK) {
+    LOG_ERR("signature does not verify");
+    return false;
+  }
+
+  memcpy(hash, msg_hash, 32);
+  hash[0] ^= 1;
+  if (crypt0_secp256k1_verify_signature(sig, 64, hash, 32, pubc, 33) != CRYPT0_ERR ||
+      crypt0_secp256k1_verify_signature(sig, 64, msg_hash, 32, other, 33) != CRYPT0_ERR) {
+    LOG_ERR("signature verifies for another hash or key");
+    return false;
+  }
+
+  memset(other, 0, sizeof(other));
+  if (crypt0_secp256k1_verify_signature(sig, 64, msg_hash, 32, other, 33) != CRYPT0_ERR_IMPORT_KEY ||
+      crypt0_secp256k1_verify_signature(sig, 63, msg_hash, 32, pubc, 33) != CRYPT0_ERR_SIG_LEN ||
+      crypt0_secp256k1_verify_signature(sig, 64, msg_hash, 31, pubc, 33) != CRYPT0_ERR_HASH_LEN ||
+      crypt0_secp256k1_verify_signature(sig, 64, msg_hash, 32, pubc, 32) != CRYPT0_ERR_PUBKEY_LEN) {
+    LOG_ERR("bad input accepted");
+    return false;
+  }
+  return true;
+}
+
+// several threads sign and derive keys at once, through re-randomizations of
+// their contexts, with the results of this thread
+bool test_secp256k1_threads()
+{
+  uint8_t expected_sig[65], expected_pub[33];
+  std::atomic<int> failed(0);
+  std::vector<std::thread> threads;
+
+  crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, expected_sig, 65);
+  crypt0_secp256k1_public_key_compressed(priv, 32, expected_pub, 33);
+
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&]() {
+      uint8_t sig[65], pub[33];
+      for (int i = 0; i < 2 * CRYPT0_SECP256K1_RERANDOMIZE_EVERY; i++) {
+        if (crypt0_secp256k1_sign_recoverable(msg_hash, 32, priv, 32, sig, 65) != CRYPT0_OK ||
+            memcmp(sig, expected_sig, 65) != 0 ||
+            crypt0_secp256k1_public_key_compressed(priv, 32, pub, 33) != CRYPT0_OK ||
+            memcmp(pub, expected_pub, 33) != 0) {
+          failed++;
+        }
+      }
+      crypt0_release_thread();
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  if (failed != 0) {
+    LOG_ERR("%d results differ across threads", failed.load());
+    return false;
+  }
+  return true;
+}
+
+// batch keys against one by one, from a misaligned scratch, and an invalid
+// key in the batch
+bool test_secp256k1_pubkeys_batch()
+{
+  static uint8_t keys[100 * 32];
+  static uint8_t pubs[100 * 33];
+  static uint8_t scratch[CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(100) + 1];
+  uint8_t expected[33];
+
+  for (size_t i = 0; i < 100; i++) {
+    crypt0_sha256(keys + (i ? (i - 1) * 32 : 0), 32, keys + i * 32, 32);
+  }
+
+  for (size_t n : { 1, 2, 20, 100 }) {
+    if (crypt0_secp256k1_pubkeys_batch(keys, n, pubs, scratch + 1,
+          CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(n)) != CRYPT0_OK) {
+      LOG_ERR("batch of %d failed", (int)n);
+      return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+      crypt0_secp256k1_public_key_compressed(keys + i * 32, 32, expected, 33);
+      if (memcmp(pubs + i * 33, expected, 33) != 0) {
+        LOG_ERR("batch of %d, key %d differs", (int)n, (int)i);
+        return false;
+      }
+    }
+  }
+
+  if (crypt0_secp256k1_pubkeys_batch(keys, 100, pubs, scratch,
+        CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(100) / 2) != CRYPT0_ERR_OUTBUF_LEN) {
+    LOG_ERR("short scratch accepted");
+    return false;
+  }
+
+  memset(keys + 5 * 32, 0, 32);
+  if (crypt0_secp256k1_pubkeys_batch(keys, 20, pubs, scratch, 
+        sizeof(scratch)) != CRYPT0_ERR_IMPORT_KEY) {
+    LOG_ERR("zero key accepted");
+    return false;
+  }
+  return true;
+}
+
+// tweaked keys against libsecp256k1's one by one, a tweak of the order and a
+// tweak summing to infinity fail only their own entries
+bool test_secp256k1_tweak_add_batch()
+{
+  static const uint8_t order[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xfe, 0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b,
+    0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41 };
+  static uint8_t scratch[CRYPT0_SECP256K1_BATCH_SCRATCH_BYTES(20)];
+  const secp256k1_context * ctx = secp256k1_context_no_precomp;
+  uint8_t pub[33], tweaks[20 * 32], out[20 * 33], expected[33];
+  secp256k1_pubkey key;
+  size_t len;
+
+  crypt0_secp256k1_public_key_compressed(priv, 32, pub, 33);
+  for (size_t i = 0; i < 20; i++) {
+    crypt0_sha256(i ? tweaks + (i - 1) * 32 : priv, 32, tweaks + i * 32, 32);
+  }
+  // tweak 5 is the order, tweak 11 the order - priv so pub + tweak*G = 0
+  memcpy(tweaks + 5 * 32, order, 32);
+  for (int i = 31, borrow = 0; i >= 0; i--) {
+    int d = order[i] - priv[i] - borrow;
+    tweaks[11 * 32 + i] = (uint8_t)d;
+    borrow = d < 0;
+  }
+
+  if (crypt0_secp256k1_pubkey_tweak_add_batch(pub, tweaks, 20, out, scratch,
+        sizeof(scratch)) != 2) {
+    LOG_ERR("tweak batch did not skip 2 entries");
+    return false;
+  }
+  for (size_t i = 0; i < 20; i++) {
+    memset(expected, 0, 33);
+    len = 33;
+    if (i != 5 && i != 11 &&
+        (!secp256k1_ec_pubkey_parse(ctx, &key, pub, 33) ||
+         !secp256k1_ec_pubkey_tweak_add(ctx, &key, tweaks + i * 32) ||
+         !secp256k1_ec_pubkey_serialize(ctx, expected, &len, &key, SECP256K1_EC_COMPRESSED))) {
+      LOG_ERR("reference tweak %d failed", (int)i);
+      return false;
+    }
+    if (memcmp(out + i * 33, expected, 33) != 0) {
+      LOG_ERR("tweak batch entry %d differs", (int)i);
+      return false;
+    }
+  }
+  return true;
+}
+
+// batch signatures in every format against one by one, with a key shared by
+// consecutive entries, and an invalid key in the batch
+bool test_secp256k1_sign_batch()
+{
+  static uint8_t hashes[20 * 32];
+  static uint8_t sigs[20 * CRYPT0_SECP256_SIG_DER_MAX_BYTES];
+  static uint8_t scratch[CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(20) + 1];
+  uint8_t key_a[32], key_b[32], zero[32] = { 0 };
+  const uint8_t * keys[20];
+  uint8_t siglens[20];
+  uint8_t expected[65], der[72];
+
+  crypt0_sha256(priv, 32, key_a, 32);
+  crypt0_sha256(key_a, 32, key_b, 32);
+  for (size_t i = 0; i < 20; i++) {
+    crypt0_sha256(hashes + (i ? (i - 1) * 32 : 0), 32, hashes + i * 32, 32);
+    keys[i] = (i < 12 || i == 15) ? key_a : key_b;
+  }
+
+  for (int format : { CRYPT0_SECP256K1_SIG_COMPACT, CRYPT0_SECP256K1_SIG_RECOVERABLE,
+        CRYPT0_SECP256K1_SIG_DER }) {
+    for (size_t n : { 1, 2, 20 }) {
+      int len = crypt0_secp256k1_sign_batch(hashes, keys, n, format, sigs, sizeof(sigs),
+          siglens, scratch + 1, CRYPT0_SECP256K1_SIGN_BATCH_SCRATCH_BYTES(n));
+      if (len <= 0) {
+        LOG_ERR("format %d, batch of %d failed: %d", format, (int)n, len);
+        return false;
+      }
+      const uint8_t * sig = sigs;
+      for (size_t i = 0; i < n; i++) {
+        size_t explen = format == CRYPT0_SECP256K1_SIG_COMPACT ? 64 : 65;
+        crypt0_secp256k1_sign_recoverable(hashes + i * 32, 32, keys[i], 32, expected, 65);
+        if (format == CRYPT0_SECP256K1_SIG_DER) {
+          secp256k1_ecdsa_signature ecdsa_sig;
+          explen = sizeof(der);
+          secp256k1_ecdsa_signature_parse_compact(secp256k1_context_no_precomp,
+              &ecdsa_sig, expected);
+          secp256k1_ecdsa_signature_serialize_der(secp256k1_context_no_precomp,
+              der, &explen, &ecdsa_sig);
+          memcpy(expected, der, explen);
+        }
+        if (siglens[i] != explen || memcmp(sig, expected, explen) != 0) {
+          LOG_ERR("format %d, batch of %d, signature %d differs", format, (int)n, (int)i);
+          return false;
+        }
+        sig += explen;
+      }
+      if (sig != sigs + len) {
+        LOG_ERR("format %d, batch of %d, %d bytes written", format, (int)n, len);
+        return false;
+      }
+    }
+  }
+
+  if (crypt0_secp256k1_sign_batch(hashes, keys, 20, CRYPT0_SECP256K1_SIG_COMPACT, sigs,
+        19 * 64, NULL, scratch, sizeof(scratch)) != CRYPT0_ERR_SIG_LEN) {
+    LOG_ERR("short sigs accepted");
+    return false;
+  }
+  if (crypt0_secp256k1_sign_batch(hashes, keys, 20, CRYPT0_SECP256K1_SIG_COMPACT, sigs,
+        sizeof(sigs), NULL, scratch, sizeof(scratch) / 2) != CRYPT0_ERR_OUTBUF_LEN) {
+    LOG_ERR("short scratch accepted");
+    return false;
+  }
+
+  keys[7] = zero;
+  if (crypt0_secp256k1_sign_batch(hashes, keys, 20, CRYPT0_SECP256K1_SIG_COMPACT, sigs,
+        sizeof(sigs), NULL, scratch, sizeof(scratch)) != CRYPT0_ERR_IMPORT_KEY) {
+    LOG_ERR("zero key accepted");
+    return false;
+  }
+  return true;
+}
+
+// both sides of the exchange get the same secret
+bool test_secp256k1_ecdh()
+{
+  uint8_t a[32], b[32];
+  uint8_t pub_a[33], pub_b[33];
+  uint8_t secret_a[32], secret_b[32];
+
+  crypt0_sha256(priv, 32, a, 32);
+  crypt0_sha256(a, 32, b, 32);
+  crypt0_secp256k1_public_key_compressed(a, 32, pub_a, 33);
+  crypt0_secp256k1_public_key_compressed(b, 32, pub_b, 33);
+
+  if (crypt0_secp256k1_ecdh_secret(a, 32, pub_b, 33, secret_a, 32) != CRYPT0_OK ||
+      crypt0_secp256k1_ecdh_secret(b, 32, pub_a, 33, secret_b, 32) != CRYPT0_OK) {
+    LOG_ERR("ecdh failed");
+    return false;
+  }
+  if (memcmp(secret_a, secret_b, 32) != 0) {
+    LOG_ERR("ecdh secrets differ");
+    return false;
+  }
+  return true;
+}
+
+// custom hashes: both sides agree, and each is its definition over the raw x
+bool test_secp256k1_ecdh_hash()
+{
+  uint8_t a[32], b[32];
+  uint8_t pub_a[65], pub_b[33];
+  uint8_t x[32], secret_a[32], secret_b[32], expected[32];
+  uint8_t block[96];
+  static const uint8_t salt[] = "crypt0 pairing salt";
+  crypt0_sha256_ctx tag;
+  crypt0_hmac_sha256_ctx hkdf;
+
+  crypt0_sha256(priv, 32, a, 32);
+  crypt0_sha256(a, 32, b, 32);
+  crypt0_secp256k1_public_key(a, 32, pub_a, 65);
+  crypt0_secp256k1_public_key_compressed(b, 32, pub_b, 33);
+  crypt0_secp256k1_ecdh_tag_init(&tag, "crypt0/pairing");
+  crypt0_hmac_sha256_init(&hkdf, salt, sizeof(salt));
+
+  if (crypt0_secp256k1_ecdh(a, pub_b, 33, x, crypt0_secp256k1_ecdh_hash_x, NULL) != CRYPT0_OK ||
+      crypt0_secp256k1_ecdh(b, pub_a, 65, secret_b, crypt0_secp256k1_ecdh_hash_x, NULL) != CRYPT0_OK ||
+      memcmp(x, secret_b, 32) != 0) {
+    LOG_ERR("raw x ecdh differs");
+    return false;
+  }
+
+  crypt0_sha256("crypt0/pairing", 14, block, 32);
+  memcpy(block + 32, block, 32);
+  memcpy(block + 64, x, 32);
+  crypt0_sha256(block, 96, expected, 32);
+  for (int i = 0; i < 2; i++) {
+    if (crypt0_secp256k1_ecdh(a, pub_b, 33, secret_a, crypt0_secp256k1_ecdh_hash_tagged, &tag) != CRYPT0_OK ||
+        crypt0_secp256k1_ecdh(b, pub_a, 65, secret_b, crypt0_secp256k1_ecdh_hash_tagged, &tag) != CRYPT0_OK ||
+        memcmp(secret_a, expected, 32) != 0 || memcmp(secret_b, expected, 32) != 0) {
+      LOG_ERR("tagged ecdh differs, round %d", i);
+      return false;
+    }
+  }
+
+  crypt0_hmac_sha256(salt, sizeof(salt), x, 32, expected);
+  for (int i = 0; i < 2; i++) {
+    if (crypt0_secp256k1_ecdh(a, pub_b, 33, secret_a, crypt0_secp256k1_ecdh_hash_hkdf_extract, &hkdf) != CRYPT0_OK ||
+        crypt0_secp256k1_ecdh(b, pub_a, 65, secret_b, crypt0_secp256k1_ecdh_hash_hkdf_extract, &hkdf) != CRYPT0_OK ||
+        memcmp(secret_a, expected, 32) != 0 || memcmp(secret_b, expected, 32) != 0) {
+      LOG_ERR("hkdf extract ecdh differs, round %d", i);
+      return false;
+    }
+  }
+
+  if (crypt0_secp256k1_ecdh(a, pub_b, 32, secret_a, NULL, NULL) != CRYPT0_ERR_PUBKEY_LEN) {
+    LOG_ERR("short public key accepted");
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  for (size_t i = 0; i < sizeof(priv); i++) {
+    priv[i] = (uint8_t)(i * 7 + 1);
+    msg_hash[i] = (uint8_t)(i * 13 + 5);
+  }
+
+  if (!test_secp256k1_public_key()) {
+    return 1;
+  }
+  if (!test_secp256k1_rerandomize()) {
+    return 1;
+  }
+  if (!test_secp256k1_sign()) {
+    return 1;
+  }
+  if (!test_secp256k1_verify()) {
+    return 1;
+  }
+  if (!test_secp256k1_threads()) {
+    return 1;
+  }
+  if (!test_secp256k1_pubkeys_batch()) {
+    return 1;
+  }
+  if (!test_secp256k1_tweak_add_batch()) {
+    return 1;
+  }
+  if (!test_secp256k1_sign_batch()) {
+    return 1;
+  }
+  if (!test_secp256k1_ecdh()) {
+    return 1;
+  }
+  if (!test_secp256k1_ecdh_hash()) {
+    return 1;
+  }
+
+  return 0;
+}
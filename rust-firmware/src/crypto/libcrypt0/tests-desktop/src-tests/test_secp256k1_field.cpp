@@ -0,0 +1,259 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_secp256k1_field, LOG_LEVEL_DBG);
+
+using namespace std;
+
+// The 10x26 field the 32-bit target runs, on any host, through
+// secp256k1_field_fe.c. With the library built with CRYPT0_SECP256K1_ARM_ASM
+// the multiply and square are the Thumb-2 kernels of
+// crypt0_field_10x26_thumb.s, otherwise the portable C. On an x86 host this
+// only checks the libsecp256k1 C field code; field_thumb_check.py runs the
+// Thumb-2 machine code in an interpreter against the C kernels. No qemu-arm
+// or device run of this test has been made.
+
+// a test_fe, opaque here
+struct test_fe {
+  uint32_t words[16];
+};
+
+extern "C" {
+void test_fe_set_b32(test_fe * r, const uint8_t b[32]);
+void test_fe_value(uint8_t out[32], const test_fe * a);
+void test_fe_mul(test_fe * r, const test_fe * a, const test_fe * b);
+void test_fe_sqr(test_fe * r, const test_fe * a);
+void test_fe_add(test_fe * r, const test_fe * a);
+void test_fe_negate(test_fe * r, const test_fe * a, int m);
+}
+
+// Field multiply and square against a schoolbook reference mod p, over
+// random, edge and non-normalized inputs up to the magnitude 8 the kernels
+// accept
+
+#define RANDOM_ROUNDS 2000
+#define CHAIN_ROUNDS 10000
+
+static const uint32_t P[8] = {
+  0xFFFFFC2F, 0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
+};
+
+static void ref_from_b32(uint32_t r[8], const uint8_t b[32])
+{
+  for (int i = 0; i < 8; i++) {
+    r[i] = (uint32_t)b[31 - 4 * i] | (uint32_t)b[30 - 4 * i] << 8 |
+      (uint32_t)b[29 - 4 * i] << 16 | (uint32_t)b[28 - 4 * i] << 24;
+  }
+}
+
+static void ref_to_b32(uint8_t b[32], const uint32_t r[8])
+{
+  for (int i = 0; i < 8; i++) {
+    b[31 - 4 * i] = (uint8_t)r[i];
+    b[30 - 4 * i] = (uint8_t)(r[i] >> 8);
+    b[29 - 4 * i] = (uint8_t)(r[i] >> 16);
+    b[28 - 4 * i] = (uint8_t)(r[i] >> 24);
+  }
+}
+
+// a * b mod p, 2^256 = 2^32 + 977 mod p folded in until the top limbs are
+// zero, then at most one subtraction of p
+static void ref_mul(uint8_t out[32], const uint8_t a32[32], const uint8_t b32[32])
+{
+  uint32_t a[8], b[8], x[17] = { 0 };
+
+  ref_from_b32(a, a32);
+  ref_from_b32(b, b32);
+  for (int i = 0; i < 8; i++) {
+    uint64_t c = 0;
+    for (int j = 0; j < 8; j++) {
+      c += (uint64_t)a[i] * b[j] + x[i + j];
+      x[i + j] = (uint32_t)c;
+      c >>= 32;
+    }
+    x[i + 8] = (uint32_t)c;
+  }
+
+  for (int round = 0; round < 3; round++) {
+    uint32_t hi[9];
+    memcpy(hi, x + 8, sizeof(hi));
+    memset(x + 8, 0, sizeof(hi));
+    uint64_t c = 0;
+    for (int i = 0; i < 17; i++) {
+      c += (uint64_t)x[i] + (i < 9 ? (uint64_t)hi[i] * 977 : 0) +
+        (i >= 1 && i <= 9 ? hi[i - 1] : 0);
+      x[i] = (uint32_t)c;
+      c >>= 32;
+    }
+  }
+
+  int ge = 1;
+  for (int i = 7; i >= 0; i--) {
+    if (x[i] != P[i]) {
+      ge = x[i] > P[i];
+      break;
+    }
+  }
+  if (ge) {
+    int64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+      c += (int64_t)x[i] - P[i];
+      x[i] = (uint32_t)c;
+      c >>= 32;
+    }
+  }
+  ref_to_b32(out, x);
+}
+
+static bool check_mul(const char * what, int i, const test_fe * a, const test_fe * b)
+{
+  test_fe r;
+  uint8_t av[32], bv[32], rv[32], expected[32];
+
+  test_fe_value(av, a);
+  test_fe_value(bv, b);
+  ref_mul(expected, av, bv);
+
+  test_fe_mul(&r, a, b);
+  test_fe_value(rv, &r);
+  if (memcmp(rv, expected, 32) != 0) {
+    LOG_ERR("%s %d: mul differs", what, i);
+    return false;
+  }
+
+  ref_mul(expected, av, av);
+  test_fe_sqr(&r, a);
+  test_fe_value(rv, &r);
+  if (memcmp(rv, expected, 32) != 0) {
+    LOG_ERR("%s %d: sqr differs", what, i);
+    return false;
+  }
+  return true;
+}
+
+// 32 pseudo random bytes below p from a counter
+static void random_b32(uint8_t out[32], uint32_t counter)
+{
+  uint8_t in[4] = { (uint8_t)counter, (uint8_t)(counter >> 8),
+    (uint8_t)(counter >> 16), (uint8_t)(counter >> 24) };
+  crypt0_sha256(in, sizeof(in), out, 32);
+  out[0] &= 0x7f;
+}
+
+bool test_field_random()
+{
+  uint8_t ab[32], bb[32];
+  test_fe a, b, t;
+
+  for (int i = 0; i < RANDOM_ROUNDS; i++) {
+    random_b32(ab, 2 * i);
+    random_b32(bb, 2 * i + 1);
+    test_fe_set_b32(&a, ab);
+    test_fe_set_b32(&b, bb);
+    if (!check_mul("random", i, &a, &b)) {
+      return false;
+    }
+
+    // magnitudes 2..8 by repeated addition
+    t = a;
+    for (int m = 2; m <= 8; m++) {
+      test_fe_add(&t, &a);
+      if (!check_mul("magnitude", i * 8 + m, &t, &b)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool test_field_edges()
+{
+  static const uint8_t p_minus_1[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xfc, 0x2e
+  };
+  uint8_t b32[32];
+  test_fe v[8];
+  int nv = 0;
+
+  memset(b32, 0, 32);
+  test_fe_set_b32(&v[nv++], b32);          // 0
+  b32[31] = 1;
+  test_fe_set_b32(&v[nv++], b32);          // 1
+  test_fe_set_b32(&v[nv++], p_minus_1);    // p - 1
+  memset(b32, 0xff, 32);
+  b32[0] = 0x7f;
+  test_fe_set_b32(&v[nv++], b32);          // 2^255 - 1
+  memset(b32, 0, 32);
+  b32[27] = 1;
+  test_fe_set_b32(&v[nv++], b32);          // 2^32
+  // 0 and p - 1 as 16 p - a, the largest limbs of magnitude 8
+  test_fe_negate(&v[nv], &v[0], 7);
+  nv++;
+  test_fe_negate(&v[nv], &v[2], 7);
+  nv++;
+  test_fe_negate(&v[nv], &v[1], 7);
+  nv++;
+
+  for (int i = 0; i < nv; i++) {
+    for (int j = 0; j < nv; j++) {
+      if (!check_mul("edge", i * nv + j, &v[i], &v[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// a long chain of products, each output is the next input unnormalized
+bool test_field_chain()
+{
+  uint8_t xb[32], yb[32], expected[32], rv[32];
+  test_fe x, y;
+
+  random_b32(xb, 0xc0ffee);
+  random_b32(yb, 0xbeef);
+  test_fe_set_b32(&x, xb);
+  test_fe_set_b32(&y, yb);
+  memcpy(expected, xb, 32);
+
+  for (int i = 0; i < CHAIN_ROUNDS; i++) {
+    if (i & 1) {
+      test_fe_mul(&x, &x, &y);
+      ref_mul(expected, expected, yb);
+    } else {
+      test_fe_sqr(&x, &x);
+      ref_mul(expected, expected, expected);
+    }
+  }
+  test_fe_value(rv, &x);
+  if (memcmp(rv, expected, 32) != 0) {
+    LOG_ERR("chain differs");
+    return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  if (!test_field_edges()) {
+    return 1;
+  }
+  if (!test_field_random()) {
+    return 1;
+  }
+  if (!test_field_chain()) {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <crypt0.h>
+#include <crypt0_sha.h>
+
+// Field multiply and square vectors of the 10x26 C kernels for
+// field_thumb_check.py, which runs the Thumb-2 kernels on the same inputs in
+// its interpreter and compares the limbs. One line per operation:
+//
+//   mul a0..a9 b0..b9 r0..r9
+//   sqr a0..a9 r0..r9
+//
+// in hex. Inputs are edge values, random values and their sums and
+// negations up to the magnitude 8 the kernels accept.
+
+#define RANDOM_ROUNDS 100
+
+// a secp256k1_fe, opaque here, limbs first
+struct test_fe {
+  uint32_t words[16];
+};
+
+extern "C" {
+void test_fe_set_b32(test_fe * r, const uint8_t b[32]);
+void test_fe_mul(test_fe * r, const test_fe * a, const test_fe * b);
+void test_fe_sqr(test_fe * r, const test_fe * a);
+void test_fe_add(test_fe * r, const test_fe * a);
+void test_fe_negate(test_fe * r, const test_fe * a, int m);
+}
+
+static void print_limbs(const test_fe * a)
+{
+  for (int i = 0; i < 10; i++) {
+    printf(" %08x", a->words[i]);
+  }
+}
+
+static void vector(const test_fe * a, const test_fe * b)
+{
+  test_fe r;
+
+  test_fe_mul(&r, a, b);
+  printf("mul");
+  print_limbs(a);
+  print_limbs(b);
+  print_limbs(&r);
+  printf("\n");
+
+  test_fe_sqr(&r, a);
+  printf("sqr");
+  print_limbs(a);
+  print_limbs(&r);
+  printf("\n");
+}
+
+// 32 pseudo random bytes below p from a counter
+static void random_b32(uint8_t out[32], uint32_t counter)
+{
+  uint8_t in[4] = { (uint8_t)counter, (uint8_t)(counter >> 8),
+    (uint8_t)(counter >> 16), (uint8_t)(counter >> 24) };
+  crypt0_sha256(in, sizeof(in), out, 32);
+  out[0] &= 0x7f;
+}
+
+int main(void)
+{
+  uint8_t b32[32];
+  test_fe v[8], a, b, t;
+  int nv = 0;
+
+  memset(b32, 0, 32);
+  test_fe_set_b32(&v[nv++], b32);          // 0
+  b32[31] = 1;
+  test_fe_set_b32(&v[nv++], b32);          // 1
+  memset(b32, 0xff, 32);
+  b32[27] = 0xfe;
+  b32[30] = 0xfc;
+  b32[31] = 0x2e;
+  test_fe_set_b32(&v[nv++], b32);          // p - 1
+  memset(b32, 0xff, 32);
+  b32[0] = 0x7f;
+  test_fe_set_b32(&v[nv++], b32);          // 2^255 - 1
+  memset(b32, 0, 32);
+  b32[27] = 1;
+  test_fe_set_b32(&v[nv++], b32);          // 2^32
+  // 0, p - 1 and 1 negated to magnitude 8, the largest limbs
+  test_fe_negate(&v[nv++], &v[0], 7);
+  test_fe_negate(&v[nv++], &v[2], 7);
+  test_fe_negate(&v[nv++], &v[1], 7);
+
+  for (int i = 0; i < nv; i++) {
+    for (int j = 0; j < nv; j++) {
+      vector(&v[i], &v[j]);
+    }
+  }
+
+  for (int i = 0; i < RANDOM_ROUNDS; i++) {
+    random_b32(b32, 2 * i);
+    test_fe_set_b32(&a, b32);
+    random_b32(b32, 2 * i + 1);
+    test_fe_set_b32(&b, b32);
+    vector(&a, &b);
+
+    // magnitudes 2..8 by repeated addition, and a negation of magnitude 8
+    t = a;
+    for (int m = 2; m <= 8; m++) {
+      test_fe_add(&t, &a);
+      vector(&t, &b);
+    }
+    test_fe_negate(&t, &b, 7);
+    vector(&a, &t);
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypt0.h>
+#include <crypt0_sha2.h>
+#include <crypt0_pbkdf2.h>
+
+#include <iostream>
+
+#include <crypt0_log.h>
+LOG_MODULE_REGISTER(test_sha2, LOG_LEVEL_DBG);
+
+using namespace std;
+
+static const crypt0_sha2_kernel_t kernels[] = {
+  CRYPT0_SHA2_KERNEL_SCALAR, CRYPT0_SHA2_KERNEL_AVX2, CRYPT0_SHA2_KERNEL_SHANI,
+};
+
+static uint8_t data[1100];
+
+static void fill_data()
+{
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < sizeof(data); i++) {
+    x = x * 1103515245 + 12345;
+    data[i] = (uint8_t)(x >> 16);
+  }
+}
+
+static void sha256_hex(const uint8_t * msg, size_t len, char hex[65])
+{
+  crypt0_sha256_ctx ctx;
+  uint8_t out[32];
+
+  crypt0_sha256_init(&ctx);
+  crypt0_sha256_update(&ctx, msg, len);
+  crypt0_sha256_final(&ctx, out);
+  crypt0_bin2hex(out, sizeof(out), hex, 65);
+}
+
+static void sha512_hex(const uint8_t * msg, size_t len, char hex[129])
+{
+  crypt0_sha512_ctx ctx;
+  uint8_t out[64];
+
+  crypt0_sha512_init(&ctx);
+  crypt0_sha512_update(&ctx, msg, len);
+  crypt0_sha512_final(&ctx, out);
+  crypt0_bin2hex(out, sizeof(out), hex, 129);
+}
+
+// FIPS 180-2 examples, run on whatever kernel is selected
+bool test_sha2_vectors()
+{
+  const char * abc = "abc";
+  const char * two = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  char hex[129];
+
+  sha256_hex((const uint8_t *)abc, 3, hex);
+  if (strcmp(hex, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") != 0) {
+    LOG_ERR("sha256 abc: %s", hex);
+    return false;
+  }
+  sha256_hex((const uint8_t *)two, strlen(two), hex);
+  if (strcmp(hex, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1") != 0) {
+    LOG_ERR("sha256 two blocks: %s", hex);
+    return false;
+  }
+  sha512_hex((const uint8_t *)abc, 3, hex);
+  if (strcmp(hex,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f") != 0) {
+    LOG_ERR("sha512 abc: %s", hex);
+    return false;
+  }
+  return true;
+}
+
+// every length up to a few blocks, both through the byte path and through the
+// word path via pbkdf2, has to match the scalar kernel
+bool test_sha2_kernel(crypt0_sha2_kernel_t kernel)
+{
+  char expected[129], got[129];
+  uint8_t key_expected[64], key_got[64];
+
+  for (size_t len = 0; len <= sizeof(data); len += (len < 300 ? 1 : 37)) {
+    crypt0_sha2_kernel_select(CRYPT0_SHA2_KERNEL_SCALAR);
+    sha256_hex(data, len, expected);
+    crypt0_sha2_kernel_select(kernel);
+    sha256_hex(data, len, got);
+    if (strcmp(expected, got) != 0) {
+      LOG_ERR("%s: sha256 len %d differs", crypt0_sha2_kernel_name(kernel), (int)len);
+      return false;
+    }
+
+    crypt0_sha2_kernel_select(CRYPT0_SHA2_KERNEL_SCALAR);
+    sha512_hex(data, len, expected);
+    crypt0_sha2_kernel_select(kernel);
+    sha512_hex(data, len, got);
+    if (strcmp(expected, got) != 0) {
+      LOG_ERR("%s: sha512 len %d differs", crypt0_sha2_kernel_name(kernel), (int)len);
+      return false;
+    }
+  }
+
+  crypt0_sha2_kernel_select(CRYPT0_SHA2_KERNEL_SCALAR);
+  crypt0_pbkdf2_hmac_sha256(50, data, 77, data + 100, 20, key_expected, 32);
+  crypt0_sha2_kernel_select(kernel);
+  crypt0_pbkdf2_hmac_sha256(50, data, 77, data + 100, 20, key_got, 32);
+  if (memcmp(key_expected, key_got, 32) != 0) {
+    LOG_ERR("%s: pbkdf2 sha256 differs", crypt0_sha2_kernel_name(kernel));
+    return false;
+  }
+
+  crypt0_sha2_kernel_select(CRYPT0_SHA2_KERNEL_SCALAR);
+  crypt0_pbkdf2_hmac_sha512(50, data, 200, data + 300, 64, key_expected, 64);
+  crypt0_sha2_kernel_select(kernel);
+  crypt0_pbkdf2_hmac_sha512(50, data, 200, data + 300, 64, key_got, 64);
+  if (memcmp(key_expected, key_got, 64) != 0) {
+    LOG_ERR("%s: pbkdf2 sha512 differs", crypt0_sha2_kernel_name(kernel));
+    return false;
+  }
+
+  return test_sha2_vectors();
+}
+
+int main(void)
+{
+  fill_data();
+
+  crypt0_sha2_kernel_t best = crypt0_sha2_kernel();
+  LOG_DBG("sha2 kernel: %s", crypt0_sha2_kernel_name(best));
+
+  if (!test_sha2_vectors()) {
+    return 1;
+  }
+
+  for (auto kernel : kernels) {
+    if (!crypt0_sha2_kernel_supported(kernel)) {
+      LOG_DBG("%s: not supported, skipped", crypt0_sha2_kernel_name(kernel));
+      continue;
+    }
+    if (!test_sha2_kernel(kernel)) {
+      return 1;
+    }
+  }
+
+  if (!crypt0_sha2_kernel_select(best) || crypt0_sha2_kernel() != best) {
+    return 1;
+  }
+
+  return 0;
+}
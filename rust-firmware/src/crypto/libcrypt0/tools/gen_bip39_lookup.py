@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+Generates src/crypt0_bip39_lookup.h, the word lookup tables of crypt0_bip39.c,
+from the english list in src/crypt0_bip39_english.c.
+
+  gen_bip39_lookup.py [--check] [english.c] [lookup.h]
+
+--check compares instead of writing and fails if the committed header is not
+what the list gives, tests-desktop runs it as Test-BIP39-Lookup. The hash and
+key functions have to match bip39_fmix and bip39_key_index in crypt0_bip39.c.
+"""
+
+import os
+import re
+import sys
+
+BUCKET_BITS = 9
+M32 = 0xffffffff
+
+here = os.path.dirname(os.path.abspath(__file__))
+default_src = os.path.join(here, '..', 'src', 'crypt0_bip39_english.c')
+default_out = os.path.join(here, '..', 'src', 'crypt0_bip39_lookup.h')
+
+
+def fmix(h):
+    h ^= h >> 16
+    h = (h * 0x85ebca6b) & M32
+    h ^= h >> 13
+    h = (h * 0xc2b2ae35) & M32
+    h ^= h >> 16
+    return h
+
+
+# first 4 letters little endian, shorter words padded with zeros
+def word_key(word):
+    key = 0
+    for i, c in enumerate(word[:4].encode()):
+        key |= c << (8 * i)
+    return key
+
+
+def bucket(key):
+    return fmix(key) >> (32 - BUCKET_BITS)
+
+
+def slot(key, seed):
+    return fmix(key ^ ((seed * 0x9e3779b9) & M32)) >> 21
+
+
+# per bucket the first seed that puts its keys on free slots, biggest first
+def perfect_hash(keys):
+    buckets = [[] for _ in range(1 << BUCKET_BITS)]
+    for i, key in enumerate(keys):
+        buckets[bucket(key)].append(i)
+
+    slots = [None] * len(keys)
+    seeds = [0] * len(buckets)
+    for b in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for seed in range(1 << 16):
+            taken = [slot(keys[i], seed) for i in buckets[b]]
+            if len(set(taken)) == len(taken) and all(slots[s] is None for s in taken):
+                for s, i in zip(taken, buckets[b]):
+                    slots[s] = i
+                seeds[b] = seed
+                break
+        else:
+            sys.exit('no 16-bit seed for bucket %d' % b)
+    return seeds, slots
+
+
+# prefixes of 0..3 letters level by level in list order: letters, first
+# word, first child node
+def trie(words):
+    prefixes, levels = [], [0]
+    level = ['']
+    for depth in range(4):
+        prefixes += level
+        levels.append(len(prefixes))
+        level = sorted(set(w[:depth + 1] for w in words if len(w) > depth))
+    index = {p: i for i, p in enumerate(prefixes)}
+
+    nodes = []
+    for p in prefixes:
+        nexts = sorted(set(w[len(p)] for w in words if w.startswith(p) and len(w) > len(p)))
+        letters = 0
+        for c in nexts:
+            letters |= 1 << (ord(c) - ord('a'))
+        if p in words:
+            letters |= 1 << 26
+        first = next(i for i, w in enumerate(words) if w.startswith(p))
+        child = index[p + nexts[0]] if nexts and len(p) < 3 else 0
+        nodes.append((letters, first, child))
+    return nodes, levels
+
+
+def rows(values, per, fmt):
+    return '\n'.join('  ' + ', '.join(fmt % v for v in values[i:i + per]) + ','
+                     for i in range(0, len(values), per))
+
+
+def generate(words):
+    keys = [word_key(w) for w in words]
+    if len(set(keys)) != len(keys):
+        sys.exit('first 4 letters not unique')
+    seeds, slots = perfect_hash(keys)
+    nodes, levels = trie(words)
+
+    return '''#ifndef __crypt0_bip39_lookup_h_included__
+#define __crypt0_bip39_lookup_h_included__
+
+//-----------------------------------------------------------------------------
+// Lookup tables of crypt0_bip39.c over crypt0_bip39_english, generated by
+// tools/gen_bip39_lookup.py, do not edit. The key of a word is its first 4
+// letters (unique in the list, shorter words padded with zeros) packed little
+// endian in a uint32_t.
+//
+// Minimal perfect hash: key -> bucket of BIP39_MPH_BUCKET_BITS bits, the
+// bucket seed -> one of 2048 slots, the slot -> word index. 5 KB.
+//
+// Prefix trie of every prefix up to 3 letters, level by level in list order:
+// letters bit i for 'a' + i (bit 26 if the prefix is a word itself), the
+// first word with the prefix, the first child node. 10 KB.
+
+#define BIP39_MPH_BUCKET_BITS %d
+
+static const uint16_t m_mph_seeds[1 << BIP39_MPH_BUCKET_BITS] = {
+%s
+};
+
+static const uint16_t m_mph_slots[2048] = {
+%s
+};
+
+// first node of each prefix length 0..3, then the node count
+static const uint16_t m_trie_levels[5] = { %s };
+
+static const bip39_trie_node m_trie[%d] = {
+%s
+};
+
+#endif//__crypt0_bip39_lookup_h_included__
+''' % (BUCKET_BITS, rows(seeds, 12, '%5d'), rows(slots, 12, '%4d'),
+       ', '.join(str(x) for x in levels), len(nodes),
+       '\n'.join('  { 0x%07x, %4d, %4d },' % n for n in nodes))
+
+
+def main(argv):
+    check = '--check' in argv
+    args = [a for a in argv if a != '--check']
+    src = args[0] if len(args) > 0 else default_src
+    out = args[1] if len(args) > 1 else default_out
+
+    words = re.findall(r'^"([a-z]+)",?$', open(src).read(), re.M)
+    if len(words) != 2048 or words != sorted(words):
+        sys.exit('%s: expected 2048 sorted words' % src)
+    text = generate(words)
+
+    if check:
+        if open(out).read() != text:
+            sys.exit('%s is out of date, run tools/gen_bip39_lookup.py' % out)
+        return
+    with open(out, 'w') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
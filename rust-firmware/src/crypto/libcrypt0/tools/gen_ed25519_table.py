@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Generates src/crypt0_ed25519_table.h, the fixed base table of
+crypt0_ed25519_portable.c, from the curve constants of RFC 8032.
+
+  gen_ed25519_table.py [--check] [table.h]
+
+--check compares instead of writing and fails if the committed header is not
+what the curve gives, tests-desktop runs it as Test-Ed25519-Table. The entry
+layout has to match ge_precomp and the limbs fe in crypt0_ed25519_portable.c.
+"""
+
+import os
+import sys
+
+P = 2**255 - 19
+D = (-121665 * pow(121666, P - 2, P)) % P
+
+# fe limbs, radix 2^25.5: 26 bits then 25 bits, five times
+LIMB_BITS = [26, 25] * 5
+
+here = os.path.dirname(os.path.abspath(__file__))
+default_out = os.path.join(here, '..', 'src', 'crypt0_ed25519_table.h')
+
+
+def inv(x):
+    return pow(x, P - 2, P)
+
+
+# x of the point with y, the even root
+def x_recover(y):
+    xx = (y * y - 1) * inv(D * y * y + 1) % P
+    x = pow(xx, (P + 3) // 8, P)
+    if (x * x - xx) % P:
+        x = x * pow(2, (P - 1) // 4, P) % P
+    if x & 1:
+        x = P - x
+    return x
+
+
+def add(a, b):
+    x1, y1 = a
+    x2, y2 = b
+    t = D * x1 * x2 * y1 * y2 % P
+    return ((x1 * y2 + x2 * y1) * inv(1 + t) % P,
+            (y1 * y2 + x1 * x2) * inv(1 - t) % P)
+
+
+def limbs(v):
+    out = []
+    for bits in LIMB_BITS:
+        out.append(v & ((1 << bits) - 1))
+        v >>= bits
+    assert v == 0
+    return out
+
+
+def fe(v):
+    l = limbs(v)
+    return ('{ ' + ', '.join(str(x) for x in l[:5]) + ',\n      ' +
+            ', '.join(str(x) for x in l[5:]) + ' }')
+
+
+# (y + x, y - x, 2 * d * x * y) of an affine point
+def precomp(point):
+    x, y = point
+    return ('    { ' + fe((y + x) % P) + ',\n      ' + fe((y - x) % P) + ',\n      ' +
+            fe(2 * D * x * y % P) + ' },')
+
+
+def generate():
+    by = 4 * inv(5) % P
+    base = (x_recover(by), by)
+
+    rows = []
+    for i in range(32):
+        rows.append('  {')
+        point = base
+        for j in range(8):
+            rows.append(precomp(point))
+            point = add(point, base)
+        rows.append('  },')
+        for _ in range(8):
+            base = add(base, base)
+
+    return '''#ifndef __crypt0_ed25519_table_h_included__
+#define __crypt0_ed25519_table_h_included__
+
+//-----------------------------------------------------------------------------
+// Fixed base table of crypt0_ed25519_portable.c, generated by
+// tools/gen_ed25519_table.py, do not edit.
+// Entry [i][j] is (j + 1) * 256^i * B in affine form as (y + x, y - x,
+// 2 * d * x * y), limbs of radix 2^25.5 as fe. 32 * 8 entries, 30 KB of
+// flash, read with a constant time select of all 8 entries of a row.
+
+static const ge_precomp ge_base_table[32][8] = {
+%s
+};
+
+#endif//__crypt0_ed25519_table_h_included__
+''' % '\n'.join(rows)
+
+
+def main(argv):
+    check = '--check' in argv
+    args = [a for a in argv if a != '--check']
+    out = args[0] if len(args) > 0 else default_out
+
+    text = generate()
+
+    if check:
+        if open(out).read() != text:
+            sys.exit('%s is out of date, run tools/gen_ed25519_table.py' % out)
+        return
+    with open(out, 'w') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
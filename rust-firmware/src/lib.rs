@@ -119,11 +119,17 @@ unsafe impl core::alloc::GlobalAlloc for ZephyrAllocator {
 #[global_allocator]
 static GLOBAL: ZephyrAllocator = ZephyrAllocator;
 
+/// Time without touch input after which an unlocked vault locks, wiping the
+/// seed and every cached key, and the UI goes back to the lock screen
+const VAULT_IDLE_LOCK_US: u64 = 5 * 60 * 1_000_000;
+
+// true if there was touch input
 fn handle_touch_events(
     firmware: &mut HitoFirmware,
     window: &MinimalSoftwareWindow,
-) {
+) -> bool {
     let is_pressed = firmware.touch.is_pressed();
+    let has_touch = firmware.touch.has_touch();
     
     match is_pressed {
         Some(true) => {
@@ -152,7 +158,7 @@ fn handle_touch_events(
         }
         None => {}
     }
-    if firmware.touch.has_touch() {
+    if has_touch {
         let pos = firmware.touch.get_position();
         
         unsafe {
@@ -168,6 +174,7 @@ fn handle_touch_events(
             }
         }
     }
+    is_pressed.is_some() || has_touch
 }
 
 fn register_main_window_callbacks(
@@ -270,11 +277,25 @@ fn handle_main_window_loop_events(
 
 }
 
+// locks the vault after VAULT_IDLE_LOCK_US without input
+fn lock_vault_if_idle(
+    ui: &MainWindow,
+    firmware: &mut HitoFirmware,
+    last_input_us: u64
+) {
+    if firmware.vault.is_unlocked() && now_us().saturating_sub(last_input_us) >= VAULT_IDLE_LOCK_US {
+        firmware.vault.lock();
+        ui.global::<Router>().invoke_navigate(ScreenEnum::Lock);
+        log_info!("Vault locked after {} s idle", VAULT_IDLE_LOCK_US / 1_000_000);
+    }
+}
+
 fn run_main_loop(
     mut firmware: HitoFirmware,
     window: Rc<MinimalSoftwareWindow>,
 ) -> ! {
     let ui = MainWindow::new().unwrap();
+    let mut last_input_us = now_us();
 
     register_main_window_callbacks(&ui);
 
@@ -283,7 +304,10 @@ fn run_main_loop(
 
         handle_main_window_loop_events(&ui, &mut firmware);
 
-        handle_touch_events(&mut firmware, &*window);
+        if handle_touch_events(&mut firmware, &*window) {
+            last_input_us = now_us();
+        }
+        lock_vault_if_idle(&ui, &mut firmware, last_input_us);
 
         window.draw_if_needed(|renderer| {
             unsafe {
@@ -0,0 +1,94 @@
+use core::ffi::c_void;
+use crate::crypto::ffi;
+use super::node_cache::{NodeCache, NODE_MAX_DEPTH};
+
+const EMPTY_KEYPAIR: ffi::crypt0_ed25519_keypair =
+  ffi::crypt0_ed25519_keypair { secret: [0; 64], public: [0; 32] };
+
+/// Expanded ed25519 key pair of one SLIP-10 path (a Solana or NEAR account),
+/// derived on first use and kept for the signing session. The next messages
+/// of the account skip the derivation, the SHA-512 expansion of the key and
+/// its public key, a signature is then one base point multiply. Another path
+/// replaces it, derived through the node cache from the deepest prefix it
+/// shares with the paths before. Holds secrets: wipe() on lock, neither
+/// Clone nor Copy
+pub struct Ed25519Slot {
+  depth: u8,                     // path length, NODE_MAX_DEPTH + 1 is empty
+  path: [u32; NODE_MAX_DEPTH],
+  keypair: ffi::crypt0_ed25519_keypair,
+}
+
+impl Ed25519Slot {
+  pub const fn new() -> Self {
+    Self { depth: NODE_MAX_DEPTH as u8 + 1, path: [0; NODE_MAX_DEPTH], keypair: EMPTY_KEYPAIR }
+  }
+
+  pub fn wipe(&mut self) {
+    unsafe { ffi::crypt0_ed25519_keypair_wipe(&mut self.keypair) };
+    self.depth = NODE_MAX_DEPTH as u8 + 1;
+    self.path = [0; NODE_MAX_DEPTH];
+  }
+
+  /// No key pair held, as after wipe()
+  pub fn is_empty(&self) -> bool {
+    self.depth as usize > NODE_MAX_DEPTH && self.keypair.secret == [0; 64]
+  }
+
+  // the key pair of path, derived through cache unless the slot holds it
+  fn load(
+    &mut self,
+    cache: &mut NodeCache,
+    seed: &[u8; 64],
+    path: &[u32]
+  ) -> Result<&ffi::crypt0_ed25519_keypair, ()> {
+    if path.len() > NODE_MAX_DEPTH {
+      return Err(());
+    }
+    if self.depth as usize == path.len() && &self.path[..path.len()] == path {
+      return Ok(&self.keypair);
+    }
+
+    self.wipe();
+    let mut secret = [0u8; 64];
+    let rc = match cache.derive_secret(ffi::CRYPT0_SLIP10_ED25519, seed, path, &mut secret) {
+      Ok(()) => unsafe { ffi::crypt0_ed25519_keypair_init(&mut self.keypair, secret.as_ptr(), 32) },
+      Err(()) => -1,
+    };
+    unsafe { ffi::crypt0_memzero(secret.as_mut_ptr() as *mut c_void, secret.len()) };
+    if rc < 0 {
+      self.wipe();
+      return Err(());
+    }
+
+    self.path[..path.len()].copy_from_slice(path);
+    self.depth = path.len() as u8;
+    Ok(&self.keypair)
+  }
+
+  /// Public key of path (indexes with node_cache::HARDENED set) from seed
+  pub fn public_key(
+    &mut self,
+    cache: &mut NodeCache,
+    seed: &[u8; 64],
+    path: &[u32]
+  ) -> Result<[u8; 32], ()> {
+    self.load(cache, seed, path).map(|keypair| keypair.public)
+  }
+
+  /// Signature of message by the key of path, the slot keeps the key pair
+  pub fn sign(
+    &mut self,
+    cache: &mut NodeCache,
+    seed: &[u8; 64],
+    path: &[u32],
+    message: &[u8]
+  ) -> Result<[u8; 64], ()> {
+    let keypair = self.load(cache, seed, path)?;
+    let mut sig = [0u8; 64];
+    let rc = unsafe {
+      ffi::crypt0_ed25519_keypair_sign(keypair, message.as_ptr(), message.len(),
+        sig.as_mut_ptr(), sig.len())
+    };
+    if rc < 0 { Err(()) } else { Ok(sig) }
+  }
+}
@@ -1,8 +1,13 @@
+pub mod ed25519_slot;
 pub mod ffi;
+pub mod node_cache;
 use core::cell::Cell;
 use core::ptr;
 use core::slice;
 use crate::crypto;
+use crate::crypto::crypt0::Pbkdf2;
+use ed25519_slot::Ed25519Slot;
+use node_cache::{ExtendedKey, NodeCache};
 use crate::log_info;
 use crate::now_us;
 extern crate alloc;
@@ -102,6 +107,7 @@ pub enum VaultError {
     HardwareKeyError,
     InvalidKeyLength,
     BlockNotFound,
+    Locked,
 }
 
 pub type VaultResult<T> = Result<T, VaultError>;
@@ -116,7 +122,6 @@ enum UnlockPhase {
     Done,
 }
 
-#[derive(Clone)]
 struct UnlockJob {
     block: VaultEncryptedBlock,
     pass_buf: [u8; 32],
@@ -129,7 +134,7 @@ struct UnlockJob {
     derived: [u8; 32],
 
     hw_iters_left_in_this_step: u32,
-    pbkdf2_iters_left_in_this_step: u32,
+    pbkdf2: Option<Pbkdf2>,         // PBKDF2 of the current step, kept across polls
     now: NowFn,
 
     // outputs
@@ -155,7 +160,7 @@ impl UnlockJob {
             key,
             derived: [0u8; 32],
             hw_iters_left_in_this_step: 40,
-            pbkdf2_iters_left_in_this_step: 10,
+            pbkdf2: None,
             now: now_us,
             result: None,
             decrypted: None,
@@ -190,33 +195,30 @@ impl UnlockJob {
                 }
 
                 if self.hw_iters_left_in_this_step == 0 {
-                    // do remaining PBKDF2 for this step
-                    if self.pbkdf2_iters_left_in_this_step > 0 {
-                        let rc = unsafe {
-                            crypto::ffi::crypt0_pbkdf2_hmac_sha256(
-                                self.pbkdf2_iters_left_in_this_step,
-                                self.derived.as_ptr(),
-                                self.derived.len() as u32,
-                                self.pass_buf.as_ptr(),
-                                self.pass_len as i32,
-                                self.key.as_mut_ptr(),
-                                32,
-                            )
-                        };
-                        if rc != 0 {
+                    // PBKDF2 for this step, keyed once and advanced within the budget
+                    if self.pbkdf2.is_none() {
+                        match Pbkdf2::new_sha256(10, &self.derived, &self.pass_buf[..self.pass_len]) {
+                            Ok(p) => self.pbkdf2 = Some(p),
+                            Err(_) => { self.result = Some(Err(VaultError::CryptoError)); self.phase = UnlockPhase::Done; last_progress = Some(100); break 'budget; }
+                        }
+                    }
+                    if let Some(pbkdf2) = self.pbkdf2.as_mut() {
+                        while pbkdf2.step(1) > 0 {
+                            if (self.now)() - start >= budget_us { break 'budget; }
+                        }
+                        if pbkdf2.finish(&mut self.key).is_err() {
                             self.result = Some(Err(VaultError::CryptoError));
                             self.phase = UnlockPhase::Done;
                             last_progress = Some(100);
                             break 'budget;
                         }
-                        self.pbkdf2_iters_left_in_this_step = 0;
                     }
+                    self.pbkdf2 = None;
 
                     // step finished
                     self.step_idx += 1;
                     last_progress = Some(self.progress());
                     self.hw_iters_left_in_this_step = 40;
-                    self.pbkdf2_iters_left_in_this_step = 10;
 
                     if self.step_idx >= self.steps_total {
                         self.phase = UnlockPhase::Finalize;
@@ -248,7 +250,6 @@ impl UnlockJob {
 }
 
 
-#[derive(Clone)]
 #[repr(C)]
 pub struct HitoVault {
   initialized: bool,
@@ -265,6 +266,8 @@ pub struct HitoVault {
   mnemonic: [u8; 215],
   entropy_len: entropy_len_t,
   pub unlock_job: Option<UnlockJob>,
+  node_cache: NodeCache,         // intermediate keys of recent paths, wiped on lock
+  ed25519_slot: Ed25519Slot,     // expanded key pair of the signing account, wiped on lock
 }
 #[derive(Copy, Clone, Debug)]
 #[repr(C)]
@@ -366,7 +369,9 @@ impl HitoVault {
            solana_key: [0; 32], solana_addr: [0; 32], eth_addr: [0; 43],
            near_addr: [0; 64], btc_addr: [0; 75], mnemonic: [0; 215],
            entropy_len: entropy_len_t::ENTROPY_LEN_32,
-           unlock_job: None
+           unlock_job: None,
+           node_cache: NodeCache::new(),
+           ed25519_slot: Ed25519Slot::new(),
        }
   }
 
@@ -599,6 +604,8 @@ impl HitoVault {
                       }
                       self.entropy[..entropy_len].copy_from_slice(&decrypted[..entropy_len]);
                       self.seed.copy_from_slice(&decrypted[32..]);
+                      self.node_cache.wipe();
+                      self.ed25519_slot.wipe();
                       self.vaultIsUnlocked = true;
                   }
                   Err(e) => return Err(e),
@@ -730,6 +737,8 @@ impl HitoVault {
       };
 
       log_info!("Generated seed from entropy");
+      self.node_cache.wipe();
+      self.ed25519_slot.wipe();
       
       if result != crypto::ffi::CRYPT0_OK {
         return Err(VaultError::CryptoError);
@@ -773,6 +782,8 @@ impl HitoVault {
     if entropy_len > 0 && entropy_len <= 32 {
       self.entropy[..entropy_len].copy_from_slice(&decrypted[..entropy_len]);
       self.seed.copy_from_slice(&decrypted[32..]);
+      self.node_cache.wipe();
+      self.ed25519_slot.wipe();
     }
     
     self.vaultIsUnlocked = true;
@@ -783,6 +794,85 @@ impl HitoVault {
     self.vaultIsUnlocked
   }
 
+  /// Wipes the seed, entropy, private keys, the node cache and the ed25519
+  /// slot, the vault needs the passcode again. Public addresses stay for display
+  pub fn lock(&mut self) {
+    self.unlock_job = None;
+    self.node_cache.wipe();
+    self.ed25519_slot.wipe();
+    unsafe {
+      crypto::ffi::crypt0_memzero(self.entropy.as_mut_ptr() as *mut _, self.entropy.len());
+      crypto::ffi::crypt0_memzero(self.seed.as_mut_ptr() as *mut _, self.seed.len());
+      crypto::ffi::crypt0_memzero(self.eth_key.as_mut_ptr() as *mut _, self.eth_key.len());
+      crypto::ffi::crypt0_memzero(self.near_key.as_mut_ptr() as *mut _, self.near_key.len());
+      crypto::ffi::crypt0_memzero(self.solana_key.as_mut_ptr() as *mut _, self.solana_key.len());
+      crypto::ffi::crypt0_memzero(self.mnemonic.as_mut_ptr() as *mut _, self.mnemonic.len());
+    }
+    self.vaultIsUnlocked = false;
+    log_info!("Vault locked");
+  }
+
+  /// Extended private key of a BIP32 path, node_cache::HARDENED marks the
+  /// hardened indexes. Repeated paths of one account start at the deepest
+  /// cached node instead of the seed
+  pub fn derive_node(&mut self, path: &[u32]) -> VaultResult<ExtendedKey> {
+    if !self.vaultIsUnlocked {
+      return Err(VaultError::Locked);
+    }
+    self.node_cache.derive(&self.seed, path).map_err(|_| VaultError::CryptoError)
+  }
+
+  /// Public node (public key, chain code) of a path, e.g. an account for
+  /// public derivation of its addresses, see crypto::crypt0::crypt0_bip32_ckd_pub
+  pub fn pubnode(&mut self, path: &[u32]) -> VaultResult<crypto::crypt0::PubNode> {
+    let node = self.derive_node(path)?;
+    let mut pubnode = [0u8; 65];
+    pubnode[..33].copy_from_slice(&node.pubkey);
+    pubnode[33..].copy_from_slice(&node.chaincode);
+    Ok(pubnode)
+  }
+
+  /// Public keys of the addresses first.. of the receive (change 0) or change
+  /// (1) chain of an account, 33 bytes each, as many as fit pubkeys. Only the
+  /// account node comes from the private key cache, the rest is public
+  /// derivation with one shared inversion for the batch. Returns the number
+  /// of indexes BIP32 skips, left as 33 zero bytes
+  pub fn address_pubkeys(
+    &mut self,
+    account: &[u32],
+    change: u32,
+    first: u32,
+    pubkeys: &mut [u8]
+  ) -> VaultResult<usize> {
+    let account = self.pubnode(account)?;
+    let chain = crypto::crypt0::crypt0_bip32_ckd_pub(&account, change)
+      .map_err(|_| VaultError::CryptoError)?;
+    crypto::crypt0::crypt0_bip32_ckd_pub_batch(&chain, first, pubkeys)
+      .map_err(|_| VaultError::CryptoError)
+  }
+
+  /// Public key of an ed25519 SLIP-10 path (all indexes node_cache::HARDENED),
+  /// e.g. m/44'/501'/0'/0' for Solana. Keeps the key pair for ed25519_sign
+  pub fn ed25519_public_key(&mut self, path: &[u32]) -> VaultResult<[u8; 32]> {
+    if !self.vaultIsUnlocked {
+      return Err(VaultError::Locked);
+    }
+    self.ed25519_slot.public_key(&mut self.node_cache, &self.seed, path)
+      .map_err(|_| VaultError::CryptoError)
+  }
+
+  /// Ed25519 signature of message by the key of path. The key pair of the
+  /// last path stays expanded until lock, so the messages of a signing
+  /// session after the first cost one signature each. Another account of
+  /// the same coin derives only its changed levels from the node cache
+  pub fn ed25519_sign(&mut self, path: &[u32], message: &[u8]) -> VaultResult<[u8; 64]> {
+    if !self.vaultIsUnlocked {
+      return Err(VaultError::Locked);
+    }
+    self.ed25519_slot.sign(&mut self.node_cache, &self.seed, path, message)
+      .map_err(|_| VaultError::CryptoError)
+  }
+
   #[cfg(feature = "minifb")]
   fn hw_unique_key_is_written_sim() -> bool {
     unsafe {
@@ -840,3 +930,32 @@ impl HitoVault {
     }
   }
 }
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+  use node_cache::HARDENED;
+
+  #[test]
+  fn lock_wipes_the_key_caches() {
+    let mut vault = HitoVault::new();
+    vault.seed = [7; 64];
+    vault.vaultIsUnlocked = true;
+
+    let account = [84 | HARDENED, HARDENED, HARDENED];
+    let mut pubkeys = [0u8; 33 * 4];
+    vault.derive_node(&[84 | HARDENED, HARDENED, HARDENED, 0, 5]).unwrap();
+    assert_eq!(vault.address_pubkeys(&account, 0, 0, &mut pubkeys).unwrap(), 0);
+    vault.ed25519_sign(&[44 | HARDENED, 501 | HARDENED, HARDENED, HARDENED], b"message").unwrap();
+    assert!(!vault.node_cache.is_empty());
+    assert!(!vault.ed25519_slot.is_empty());
+
+    vault.lock();
+    assert!(vault.node_cache.is_empty());
+    assert!(vault.ed25519_slot.is_empty());
+    assert_eq!(vault.seed, [0; 64]);
+    assert!(!vault.is_unlocked());
+    assert!(vault.derive_node(&account).is_err());
+    assert!(vault.ed25519_public_key(&[44 | HARDENED, 501 | HARDENED]).is_err());
+  }
+}
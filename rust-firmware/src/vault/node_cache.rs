@@ -0,0 +1,261 @@
+use core::ffi::{c_int, c_void};
+use crate::crypto::ffi;
+
+/// Entries kept, about 150 bytes each
+pub const NODE_CACHE_ENTRIES: usize = 8;
+/// Deepest path derived, matches CRYPT0_BIP32_MAX_DEPTH
+pub const NODE_MAX_DEPTH: usize = 10;
+
+pub const HARDENED: u32 = ffi::CRYPT0_BIP32_INDEX_HARDENED;
+
+/// Extended private key of a derived path, wiped on drop, neither Clone nor
+/// Copy for the same reason as the cache entries
+pub struct ExtendedKey {
+  pub depth: u8,
+  pub child_index: u32,
+  pub parent_fingerprint: [u8; 4],
+  pub chaincode: [u8; 32],
+  pub key: [u8; 32],
+  pub pubkey: [u8; 33],
+}
+
+impl ExtendedKey {
+  /// First four bytes of hash160 of the public key, the parent fingerprint
+  /// of this key's children
+  pub fn fingerprint(&self) -> [u8; 4] {
+    fingerprint(&self.pubkey)
+  }
+}
+
+impl Drop for ExtendedKey {
+  fn drop(&mut self) {
+    wipe(&mut self.key);
+    wipe(&mut self.chaincode);
+  }
+}
+
+// no Clone or Copy: the key material only lives in the cache entries
+struct CachedNode {
+  tick: u32,                     // last use, 0 is a free entry
+  hash: u32,                     // path_hash of curve and path[..depth]
+  curve: u8,                     // CRYPT0_SLIP10_*
+  depth: u8,
+  path: [u32; NODE_MAX_DEPTH],
+  secret: [u8; 64],              // key then chaincode, the crypt0_bip32 layout
+  pubkey: [u8; 33],              // secp256k1 nodes only
+  parent_fingerprint: [u8; 4],   // secp256k1 nodes only
+}
+
+const FREE_NODE: CachedNode = CachedNode {
+  tick: 0, hash: 0, curve: 0, depth: 0, path: [0; NODE_MAX_DEPTH], secret: [0; 64],
+  pubkey: [0; 33], parent_fingerprint: [0; 4],
+};
+
+/// LRU cache of extended private keys keyed by SLIP-10 curve and derivation
+/// path, every prefix of a derived path is kept so the next path of the same
+/// account starts at the deepest node it shares with the cache instead of the
+/// seed. A secp256k1 node keeps its public key, a non-hardened child then
+/// costs one HMAC-SHA512 and the child's own public key. ed25519 nodes are
+/// hardened only and keep no public key. Holds secrets: wipe() on lock, and
+/// it is neither Clone nor Copy so there is no other copy to wipe
+pub struct NodeCache {
+  nodes: [CachedNode; NODE_CACHE_ENTRIES],
+  tick: u32,
+}
+
+fn wipe<T>(buf: &mut T) {
+  unsafe { ffi::crypt0_memzero(buf as *mut T as *mut c_void, core::mem::size_of::<T>()) }
+}
+
+fn fingerprint(pubkey: &[u8; 33]) -> [u8; 4] {
+  let mut hash = [0u8; 20];
+  unsafe { ffi::crypt0_hash160(pubkey.as_ptr(), pubkey.len(), hash.as_mut_ptr()) };
+  [hash[0], hash[1], hash[2], hash[3]]
+}
+
+// FNV-1a over the indexes, depth and curve included so m and m/0 differ
+fn path_hash(curve: u8, path: &[u32]) -> u32 {
+  let mut h: u32 = 0x811c9dc5 ^ path.len() as u32 ^ (curve as u32) << 8;
+  for index in path {
+    for b in index.to_be_bytes() {
+      h = (h ^ b as u32).wrapping_mul(0x01000193);
+    }
+  }
+  h
+}
+
+fn node_public_key(node: &mut CachedNode) -> Result<(), ()> {
+  let rc = unsafe {
+    ffi::crypt0_secp256k1_public_key_compressed(node.secret.as_ptr(), 32,
+      node.pubkey.as_mut_ptr(), node.pubkey.len())
+  };
+  if rc < 0 { Err(()) } else { Ok(()) }
+}
+
+impl NodeCache {
+  pub const fn new() -> Self {
+    Self { nodes: [FREE_NODE; NODE_CACHE_ENTRIES], tick: 0 }
+  }
+
+  pub fn wipe(&mut self) {
+    wipe(&mut self.nodes);
+    self.tick = 0;
+  }
+
+  /// No entry in use and no key material left, as after wipe()
+  pub fn is_empty(&self) -> bool {
+    self.nodes.iter().all(|n| n.tick == 0 && n.secret == [0; 64])
+  }
+
+  fn find(&self, curve: u8, path: &[u32], hash: u32) -> Option<usize> {
+    self.nodes.iter().position(|n| {
+      n.tick != 0 && n.hash == hash && n.curve == curve && n.depth as usize == path.len() &&
+        &n.path[..path.len()] == path
+    })
+  }
+
+  fn touch(&mut self, i: usize) {
+    self.tick = self.tick.wrapping_add(1);
+    if self.tick == 0 {
+      // wrapped, restart the ages keeping the entries
+      for n in self.nodes.iter_mut().filter(|n| n.tick != 0) {
+        n.tick = 1;
+      }
+      self.tick = 2;
+    }
+    self.nodes[i].tick = self.tick;
+  }
+
+  // least recently used entry, free ones first, wiped for a new node
+  fn victim(&mut self) -> usize {
+    let mut victim = 0;
+    for (i, n) in self.nodes.iter().enumerate() {
+      if n.tick < self.nodes[victim].tick {
+        victim = i;
+      }
+    }
+    wipe(&mut self.nodes[victim]);
+    victim
+  }
+
+  // the master node of seed on curve, in a free or the least recently used
+  // entry
+  fn derive_master(&mut self, curve: u8, seed: &[u8; 64]) -> Result<usize, ()> {
+    let i = self.victim();
+    let node = &mut self.nodes[i];
+    let rc = unsafe {
+      ffi::crypt0_slip10_seed_to_secret(curve as c_int, seed.as_ptr(), node.secret.as_mut_ptr())
+    };
+    if rc < 0 || (curve as c_int == ffi::CRYPT0_SLIP10_SECP256K1 && node_public_key(node).is_err()) {
+      wipe(node);
+      return Err(());
+    }
+    node.curve = curve;
+    node.hash = path_hash(curve, &[]);
+    self.touch(i);
+    Ok(i)
+  }
+
+  // child index of the entry parent, derived in place into another entry:
+  // the parent was used last, so it is never the one replaced
+  fn derive_child(&mut self, parent: usize, index: u32) -> Result<usize, ()> {
+    let i = self.victim();
+    let (node, child) = if parent < i {
+      let (head, tail) = self.nodes.split_at_mut(i);
+      (&head[parent], &mut tail[0])
+    } else {
+      let (head, tail) = self.nodes.split_at_mut(parent);
+      (&tail[0], &mut head[i])
+    };
+    let level = node.depth as usize;
+
+    child.secret.copy_from_slice(&node.secret);
+    if node.curve as c_int == ffi::CRYPT0_SLIP10_SECP256K1 {
+      let rc = unsafe {
+        ffi::crypt0_bip32_derive_secret_index_pub(child.secret.as_mut_ptr(), index,
+          node.pubkey.as_ptr())
+      };
+      if rc < 0 || node_public_key(child).is_err() {
+        wipe(child);
+        return Err(());
+      }
+      child.parent_fingerprint = fingerprint(&node.pubkey);
+    } else {
+      // hardened only, a plain index fails here
+      let rc = unsafe {
+        ffi::crypt0_slip10_derive_secret_index(node.curve as c_int, child.secret.as_mut_ptr(), index)
+      };
+      if rc < 0 {
+        wipe(child);
+        return Err(());
+      }
+    }
+    child.curve = node.curve;
+    child.path[..level].copy_from_slice(&node.path[..level]);
+    child.path[level] = index;
+    child.depth = level as u8 + 1;
+    child.hash = path_hash(child.curve, &child.path[..=level]);
+    self.touch(i);
+    Ok(i)
+  }
+
+  // entry of path on curve, derived from the deepest cached prefix of path
+  fn node(&mut self, curve: c_int, seed: &[u8; 64], path: &[u32]) -> Result<usize, ()> {
+    if path.len() > NODE_MAX_DEPTH {
+      return Err(());
+    }
+    let curve = curve as u8;
+
+    let mut cached = None;
+    for len in (0..=path.len()).rev() {
+      if let Some(i) = self.find(curve, &path[..len], path_hash(curve, &path[..len])) {
+        self.touch(i);
+        cached = Some((i, len));
+        break;
+      }
+    }
+    let (mut i, mut level) = match cached {
+      Some(found) => found,
+      None => (self.derive_master(curve, seed)?, 0),
+    };
+
+    while level < path.len() {
+      i = self.derive_child(i, path[level])?;
+      level += 1;
+    }
+    Ok(i)
+  }
+
+  /// Extended private key of path (indexes, HARDENED set for hardened ones)
+  /// from seed, starting at the deepest cached prefix of path
+  pub fn derive(&mut self, seed: &[u8; 64], path: &[u32]) -> Result<ExtendedKey, ()> {
+    let i = self.node(ffi::CRYPT0_SLIP10_SECP256K1, seed, path)?;
+    let node = &self.nodes[i];
+    let mut key = ExtendedKey {
+      depth: node.depth,
+      child_index: if node.depth == 0 { 0 } else { node.path[node.depth as usize - 1] },
+      parent_fingerprint: node.parent_fingerprint,
+      chaincode: [0; 32],
+      key: [0; 32],
+      pubkey: node.pubkey,
+    };
+    key.key.copy_from_slice(&node.secret[..32]);
+    key.chaincode.copy_from_slice(&node.secret[32..]);
+    Ok(key)
+  }
+
+  /// SLIP-10 secret (key then chain code) of path on curve
+  /// (ffi::CRYPT0_SLIP10_*) from seed, starting at the deepest cached prefix
+  /// of path. The caller wipes secret
+  pub fn derive_secret(
+    &mut self,
+    curve: c_int,
+    seed: &[u8; 64],
+    path: &[u32],
+    secret: &mut [u8; 64]
+  ) -> Result<(), ()> {
+    let i = self.node(curve, seed, path)?;
+    secret.copy_from_slice(&self.nodes[i].secret);
+    Ok(())
+  }
+}